@@ -11,6 +11,13 @@ const { EventEmitter } = require('events');
 const path = require('path');
 const readline = require('readline');
 
+// Compact playback record layout (core/vlc-player/src/vlc_event_aggregator.h)
+const PLAYBACK_RECORD_SIZE = 24;
+const PLAYBACK_RECORD_VERSION = 1;
+const PLAYBACK_FIELD_TIME = 1 << 0;
+const PLAYBACK_FIELD_POSITION = 1 << 1;
+const PLAYBACK_FIELD_BUFFERING = 1 << 2;
+
 class VlcProcessManager extends EventEmitter {
   constructor() {
     super();
@@ -21,6 +28,7 @@ class VlcProcessManager extends EventEmitter {
     this.callId = 0;
     this.restartCount = 0;
     this.maxRestarts = 3;
+    this.binaryPending = null;
   }
 
   /**
@@ -53,13 +61,15 @@ class VlcProcessManager extends EventEmitter {
       console.log('[VLC Manager] isDev:', isDev);
 
       // Spawn standalone Node.js process (NOT fork - fully isolated)
-      // stdio: stdin=pipe, stdout=inherit(to suppress VLC debug), stderr=pipe, fd3=pipe(for JSON)
+      // stdio: stdin=pipe, stdout=inherit(to suppress VLC debug), stderr=pipe, fd3=pipe(for JSON),
+      // fd4=pipe(binary playback records)
       this.process = spawn('node', [scriptPath], {
-        stdio: ['pipe', 'inherit', 'pipe', 'pipe'], // stdin, stdout(inherit), stderr, fd3(JSON output)
+        stdio: ['pipe', 'inherit', 'pipe', 'pipe', 'pipe'], // stdin, stdout(inherit), stderr, fd3(JSON), fd4(binary)
         env: {
           ...process.env,
           DISPLAY: process.env.DISPLAY, // Critical: Inherit X11 DISPLAY
           VLC_JSON_FD: '3', // Tell child to use fd 3 for JSON output
+          VLC_BINARY_FD: '4', // Time/position/buffering as fixed-size records on fd 4
         },
       });
 
@@ -81,6 +91,10 @@ class VlcProcessManager extends EventEmitter {
         }
       });
 
+      // FD4 reader for compact playback records (no JSON parsing at event rate)
+      this.binaryPending = null;
+      this.process.stdio[4].on('data', (chunk) => this._handleBinary(chunk));
+
       // STDERR forwarding for debugging
       this.process.stderr.on('data', (data) => {
         console.error(data.toString());
@@ -126,6 +140,9 @@ class VlcProcessManager extends EventEmitter {
           this.restartCount = 0;
           console.log('[VLC Manager] Process ready');
           resolve();
+
+          // Load libVLC plugins in the background while the UI boots
+          this.warmup();
         }
       };
 
@@ -207,6 +224,25 @@ class VlcProcessManager extends EventEmitter {
     });
   }
 
+  /**
+   * Pre-warm libVLC in the child process (plugin cache + pooled players)
+   * Failures are logged only, the first open() will initialize libVLC anyway
+   * @param {Object} [options] - { pluginCache: 'reuse'|'rebuild'|'off', warm: number }
+   * @returns {Promise<Object|null>} Warmup stats
+   */
+  async warmup(options = {}) {
+    if (!this.ready) return null;
+
+    try {
+      const stats = await this.call('warmup', options);
+      console.log('[VLC Manager] Warmup completed:', stats);
+      return stats;
+    } catch (error) {
+      console.error('[VLC Manager] Warmup failed:', error);
+      return null;
+    }
+  }
+
   /**
    * Update window bounds using unified API
    * @param {Object} options - Window options
@@ -257,6 +293,34 @@ class VlcProcessManager extends EventEmitter {
     }
   }
 
+  /**
+   * Decode fixed-size playback records and forward them as regular vlcEvent payloads
+   * @private
+   */
+  _handleBinary(chunk) {
+    let buffer = this.binaryPending ? Buffer.concat([this.binaryPending, chunk]) : chunk;
+    let offset = 0;
+
+    while (buffer.length - offset >= PLAYBACK_RECORD_SIZE) {
+      const version = buffer.readUInt8(offset);
+      const fields = buffer.readUInt16LE(offset + 2);
+
+      if (version === PLAYBACK_RECORD_VERSION) {
+        const currentVideo = {};
+        if (fields & PLAYBACK_FIELD_TIME) currentVideo.time = buffer.readDoubleLE(offset + 8);
+        if (fields & PLAYBACK_FIELD_POSITION) currentVideo.position = buffer.readFloatLE(offset + 16);
+        if (fields & PLAYBACK_FIELD_BUFFERING) currentVideo.buffering = buffer.readFloatLE(offset + 20);
+        this.emit('vlcEvent', { currentVideo });
+      } else {
+        console.warn('[VLC Manager] Unknown playback record version:', version);
+      }
+
+      offset += PLAYBACK_RECORD_SIZE;
+    }
+
+    this.binaryPending = offset < buffer.length ? buffer.subarray(offset) : null;
+  }
+
   /**
    * Handle result message
    * @private
@@ -8,6 +8,8 @@
  * - STDIN: Receives commands from parent process
  * - STDOUT: Sends responses and events to parent process
  * - STDERR: Logs for debugging
+ * - VLC_BINARY_FD (optional): Fixed 24-byte playback records (time/position/buffering),
+ *   see PLAYBACK_RECORD_SIZE in core/vlc-player/src/vlc_event_aggregator.h
  */
 
 const readline = require('readline');
@@ -102,16 +104,25 @@ function setupEventListeners() {
   if (!player) return;
 
   // Use unified event callback - forward entire event data to parent
+  // Time/position/buffering updates are merged natively and flushed at most every THROTTLE_MS
+  const compact = binaryStream !== null;
   player.setEventCallback((eventData) => {
+    // High-frequency fields arrive as a binary record, pass the bytes through untouched
+    if (eventData.playback) {
+      binaryStream.write(eventData.playback);
+      delete eventData.playback;
+      if (Object.keys(eventData).length === 0) return;
+    }
+
     // Forward the unified event structure directly
     sendEvent('vlcEvent', eventData);
-  });
+  }, { interval: THROTTLE_MS, compact });
 }
 
 /**
  * Handle incoming messages from parent process
  */
-function handleMessage(message) {
+async function handleMessage(message) {
   const { type, method, args = [], id } = message;
 
   if (type !== 'method') {
@@ -123,6 +134,14 @@ function handleMessage(message) {
     let result;
 
     switch (method) {
+      // Pre-load libVLC (plugins + pooled players) on a worker thread
+      case 'warmup': {
+        const vlc = loadVlcModule();
+        result = await vlc.VlcPlayer.warmup(args[0] || {});
+        sendLog('info', `VLC warmup completed in ${result.elapsedMs} ms`);
+        break;
+      }
+
       // Initialization
       case 'init':
         initializePlayer();
@@ -188,6 +207,11 @@ function handleMessage(message) {
         throw new Error(`Unknown method: ${method}`);
     }
 
+    // Async native methods return Promises
+    if (result && typeof result.then === 'function') {
+      result = await result;
+    }
+
     // Send result back to parent
     sendResult(id, result);
   } catch (error) {
@@ -232,6 +256,10 @@ function sendLog(level, message, data = null) {
 const jsonFd = process.env.VLC_JSON_FD ? parseInt(process.env.VLC_JSON_FD) : 1;
 const jsonStream = jsonFd === 1 ? process.stdout : fs.createWriteStream(null, { fd: jsonFd });
 
+// Binary playback record stream (compact events), only when the parent provides the fd
+const binaryFd = process.env.VLC_BINARY_FD ? parseInt(process.env.VLC_BINARY_FD) : null;
+const binaryStream = binaryFd ? fs.createWriteStream(null, { fd: binaryFd }) : null;
+
 /**
  * Send JSON message to parent via JSON stream (fd 3 or stdout)
  * Uses JSON Lines format (newline-delimited JSON)
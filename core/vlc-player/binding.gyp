@@ -1,94 +1,191 @@
 {
-  "targets": [
-    {
-      "target_name": "vlc_player",
-      "cflags!": ["-fno-exceptions"],
-      "cflags_cc!": ["-fno-exceptions"],
-      "sources": [
-        "src/vlc_player.cpp",
-        "src/vlc_callbacks.cpp",
-        "src/vlc_playback.cpp",
-        "src/vlc_audio.cpp",
-        "src/vlc_video.cpp",
-        "src/vlc_subtitle.cpp",
-        "src/vlc_window.cpp",
-        "src/vlc_info.cpp",
-        "src/vlc_shortcuts.cpp",
-        "src/vlc_vmem.cpp",
-        "src/vlc_context_menu.cpp",
-        "src/vlc_context_menu_actions.cpp",
-        "src/os/window_base.cpp",
-        "src/os/base_osd.cpp"
-      ],
-      "include_dirs": [
-        "node_modules/node-addon-api"
-      ],
-      "defines": ["NAPI_DISABLE_CPP_EXCEPTIONS"],
-      "msvs_settings": {
-        "VCCLCompilerTool": {
-          "ExceptionHandling": 1,
-          "RuntimeLibrary": 3,
-          "MultiProcessorCompilation": "true",
-          "AdditionalOptions": ["/MP"]
-        }
+  "variables": {
+    "build_bench%": 0,
+    "vlc_sources": [
+      "src/vlc_player.cpp",
+      "src/vlc_callbacks.cpp",
+      "src/vlc_event_aggregator.cpp",
+      "src/vlc_playback.cpp",
+      "src/vlc_audio.cpp",
+      "src/vlc_video.cpp",
+      "src/vlc_subtitle.cpp",
+      "src/vlc_window.cpp",
+      "src/vlc_info.cpp",
+      "src/vlc_shortcuts.cpp",
+      "src/vlc_vmem.cpp",
+      "src/vlc_frame_ring.cpp",
+      "src/vlc_shared_frames.cpp",
+      "src/vlc_frame_reader.cpp",
+      "src/vlc_png.cpp",
+      "src/vlc_thumbnail_service.cpp",
+      "src/vlc_thumbnailer.cpp",
+      "src/vlc_scrub.cpp",
+      "src/vlc_m3u_catalog.cpp",
+      "src/vlc_catalog.cpp",
+      "src/vlc_latency.cpp",
+      "src/vlc_hw_decode.cpp",
+      "src/vlc_track_cache.cpp",
+      "src/vlc_trace.cpp",
+      "src/vlc_instance_pool.cpp",
+      "src/vlc_preload.cpp",
+      "src/vlc_timeshift_buffer.cpp",
+      "src/vlc_timeshift.cpp",
+      "src/vlc_mosaic.cpp",
+      "src/vlc_context_menu.cpp",
+      "src/vlc_context_menu_actions.cpp",
+      "src/os/window_base.cpp",
+      "src/os/base_osd.cpp",
+      "src/os/osd_cache.cpp",
+      "src/os/osd_surface.cpp",
+      "src/os/osd_blend.cpp"
+    ]
+  },
+  "target_defaults": {
+    "cflags!": ["-fno-exceptions"],
+    "cflags_cc!": ["-fno-exceptions"],
+    "include_dirs": [
+      "node_modules/node-addon-api"
+    ],
+    "defines": ["NAPI_DISABLE_CPP_EXCEPTIONS"],
+    "msvs_settings": {
+      "VCCLCompilerTool": {
+        "ExceptionHandling": 1,
+        "RuntimeLibrary": 3,
+        "MultiProcessorCompilation": "true",
+        "AdditionalOptions": ["/MP"]
+      }
+    },
+    "configurations": {
+      "Debug": {
+        "msvs_settings": {
+          "VCCLCompilerTool": {
+            "RuntimeLibrary": 3,
+            "Optimization": 0,
+            "MinimalRebuild": "false",
+            "OmitFramePointers": "false",
+            "BasicRuntimeChecks": 3
+          },
+          "VCLinkerTool": {
+            "LinkIncremental": 2,
+            "GenerateDebugInformation": "true"
+          }
+        },
+        "defines": ["DEBUG", "_DEBUG"]
       },
-      "configurations": {
-        "Debug": {
-          "msvs_settings": {
-            "VCCLCompilerTool": {
-              "RuntimeLibrary": 3,
-              "Optimization": 0,
-              "MinimalRebuild": "false",
-              "OmitFramePointers": "false",
-              "BasicRuntimeChecks": 3
-            },
-            "VCLinkerTool": {
-              "LinkIncremental": 2,
-              "GenerateDebugInformation": "true"
-            }
+      "Release": {
+        "msvs_settings": {
+          "VCCLCompilerTool": {
+            "RuntimeLibrary": 2,
+            "Optimization": 3,
+            "FavorSizeOrSpeed": 1,
+            "InlineFunctionExpansion": 2,
+            "WholeProgramOptimization": "true",
+            "OmitFramePointers": "true",
+            "EnableFunctionLevelLinking": "true",
+            "EnableIntrinsicFunctions": "true"
           },
-          "defines": ["DEBUG", "_DEBUG"]
+          "VCLinkerTool": {
+            "LinkTimeCodeGeneration": 1,
+            "OptimizeReferences": 2,
+            "EnableCOMDATFolding": 2,
+            "LinkIncremental": 1,
+            "GenerateDebugInformation": "false"
+          }
         },
-        "Release": {
-          "msvs_settings": {
-            "VCCLCompilerTool": {
-              "RuntimeLibrary": 2,
-              "Optimization": 3,
-              "FavorSizeOrSpeed": 1,
-              "InlineFunctionExpansion": 2,
-              "WholeProgramOptimization": "true",
-              "OmitFramePointers": "true",
-              "EnableFunctionLevelLinking": "true",
-              "EnableIntrinsicFunctions": "true"
-            },
-            "VCLinkerTool": {
-              "LinkTimeCodeGeneration": 1,
-              "OptimizeReferences": 2,
-              "EnableCOMDATFolding": 2,
-              "LinkIncremental": 1,
-              "GenerateDebugInformation": "false"
-            }
+        "defines": ["NDEBUG"]
+      }
+    },
+    "conditions": [
+      [
+        "OS=='win'",
+        {
+          "sources+": [
+            "src/os/win32/window.cpp",
+            "src/os/win32/osd.cpp"
+          ]
+        }
+      ],
+      [
+        "OS=='win' and target_arch=='arm64'",
+        {
+          "include_dirs": ["lib/win32-arm64/sdk/include"],
+          "libraries": [
+            "<(module_root_dir)/lib/win32-arm64/sdk/lib/libvlc.lib"
+          ]
+        }
+      ],
+      [
+        "OS=='win' and target_arch=='x64'",
+        {
+          "include_dirs": ["lib/win32/sdk/include"],
+          "libraries": [
+            "<(module_root_dir)/lib/win32/sdk/lib/libvlc.lib"
+          ]
+        }
+      ],
+      [
+        "OS=='win' and target_arch!='arm64' and target_arch!='x64'",
+        {
+          "include_dirs": ["lib/win32/sdk/include"],
+          "libraries": [
+            "<(module_root_dir)/lib/win32/sdk/lib/libvlc.lib"
+          ]
+        }
+      ],
+      [
+        "OS=='linux'",
+        {
+          "sources+": [
+            "src/os/linux/window.cpp",
+            "src/os/linux/context_menu.cpp",
+            "src/os/linux/osd.cpp",
+            "src/os/linux/draw.cpp"
+          ],
+          "cflags_cc": ["-std=c++17"],
+          "include_dirs": [
+            "/usr/include/vlc",
+            "/usr/include/freetype2"
+          ],
+          "libraries": [
+            "-lvlc",
+            "-lX11",
+            "-lXft",
+            "-lXrender",
+            "-lXcomposite",
+            "-lXext",
+            "-lrt",
+            "-ldl"
+          ]
+        }
+      ],
+      [
+        "OS=='mac'",
+        {
+          "sources+": ["src/vlc_window_mac.cpp", "src/vlc_context_menu_mac.cpp"],
+          "xcode_settings": {
+            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+            "CLANG_CXX_LIBRARY": "libc++",
+            "MACOSX_DEPLOYMENT_TARGET": "10.15"
           },
-          "defines": ["NDEBUG"]
+          "include_dirs": [
+            "/Applications/VLC.app/Contents/MacOS/include"
+          ],
+          "libraries": [
+            "-L/Applications/VLC.app/Contents/MacOS/lib",
+            "-lvlc"
+          ]
         }
-      },
+      ]
+    ]
+  },
+  "targets": [
+    {
+      "target_name": "vlc_player",
+      "sources": ["<@(vlc_sources)"],
       "conditions": [
-        [
-          "OS=='win'",
-          {
-            "sources+": [
-              "src/os/win32/window.cpp",
-              "src/os/win32/osd.cpp"
-            ]
-          }
-        ],
         [
           "OS=='win' and target_arch=='arm64'",
           {
-            "include_dirs": ["lib/win32-arm64/sdk/include"],
-            "libraries": [
-              "<(module_root_dir)/lib/win32-arm64/sdk/lib/libvlc.lib"
-            ],
             "copies": [
               {
                 "destination": "<(PRODUCT_DIR)",
@@ -103,10 +200,6 @@
         [
           "OS=='win' and target_arch=='x64'",
           {
-            "include_dirs": ["lib/win32/sdk/include"],
-            "libraries": [
-              "<(module_root_dir)/lib/win32/sdk/lib/libvlc.lib"
-            ],
             "copies": [
               {
                 "destination": "<(PRODUCT_DIR)",
@@ -121,10 +214,6 @@
         [
           "OS=='win' and target_arch!='arm64' and target_arch!='x64'",
           {
-            "include_dirs": ["lib/win32/sdk/include"],
-            "libraries": [
-              "<(module_root_dir)/lib/win32/sdk/lib/libvlc.lib"
-            ],
             "copies": [
               {
                 "destination": "<(PRODUCT_DIR)",
@@ -135,49 +224,22 @@
               }
             ]
           }
-        ],
-        [
-          "OS=='linux'",
-          {
-            "sources+": [
-              "src/os/linux/window.cpp",
-              "src/os/linux/context_menu.cpp",
-              "src/os/linux/osd.cpp",
-              "src/os/linux/draw.cpp"
-            ],
-            "cflags_cc": ["-std=c++17"],
-            "include_dirs": [
-              "/usr/include/vlc",
-              "/usr/include/freetype2"
-            ],
-            "libraries": [
-              "-lvlc",
-              "-lX11",
-              "-lXft",
-              "-lXrender",
-              "-lXcomposite"
-            ]
-          }
-        ],
-        [
-          "OS=='mac'",
-          {
-            "sources+": ["src/vlc_window_mac.cpp", "src/vlc_context_menu_mac.cpp"],
-            "xcode_settings": {
-              "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
-              "CLANG_CXX_LIBRARY": "libc++",
-              "MACOSX_DEPLOYMENT_TARGET": "10.15"
-            },
-            "include_dirs": [
-              "/Applications/VLC.app/Contents/MacOS/include"
-            ],
-            "libraries": [
-              "-L/Applications/VLC.app/Contents/MacOS/lib",
-              "-lvlc"
-            ]
-          }
         ]
       ]
     }
+  ],
+  "conditions": [
+    [
+      "build_bench==1",
+      {
+        "targets": [
+          {
+            "target_name": "vlc_bench",
+            "sources": ["<@(vlc_sources)", "src/vlc_bench.cpp"],
+            "defines": ["VLC_BENCH"]
+          }
+        ]
+      }
+    ]
   ]
 }
@@ -79,11 +79,41 @@ function createPlayer() {
   return new VlcPlayer();
 }
 
+/**
+ * Attach to a shared frame ring published with player.video({ sharedFrames: name })
+ * (usually from another process)
+ * @param {string} name - Ring name
+ * @returns {FrameReader}
+ */
+function createFrameReader(name) {
+  const native = loadNativeModule();
+  return new native.FrameReader(name);
+}
+
+/**
+ * Create a mosaic decoding several streams into the tiles of one memory surface
+ * @param {{ width?: number, height?: number, columns?: number, rows?: number, gap?: number,
+ *           tiles?: { x: number, y: number, width: number, height: number }[] }} [options]
+ * @returns {Mosaic}
+ */
+function createMosaic(options) {
+  const native = loadNativeModule();
+  return new native.Mosaic(options);
+}
+
 module.exports = {
   isAvailable,
   getVlcPlayer,
   createPlayer,
+  createFrameReader,
+  createMosaic,
   get VlcPlayer() {
     return getVlcPlayer();
   },
+  get FrameReader() {
+    return loadNativeModule().FrameReader;
+  },
+  get Mosaic() {
+    return loadNativeModule().Mosaic;
+  },
 };
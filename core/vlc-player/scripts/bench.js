@@ -0,0 +1,179 @@
+#!/usr/bin/env node
+
+/**
+ * VLC Player Benchmarks
+ *
+ * Runs the native benchmark suite of the vlc_bench build target and prints the results as one
+ * JSON document, so runs can be diffed or checked against a baseline before shipping.
+ *
+ *   vmem    Synthetic imem source through the vmem callbacks: delivered frames/s, dropped
+ *           frames and getFrame() copy bandwidth, per resolution
+ *   events  ThreadSafeFunction flood from native threads, raw and coalesced
+ *   osd     Off-screen render and frame blend cost per OSD type
+ *
+ * Usage:
+ *   npm run bench -- --out bench.json   # configures and builds vlc_bench, then runs it
+ *   node scripts/bench.js --only osd,events --seconds 3 --out bench.json
+ *
+ * vlc_bench is only part of the build when configured with -Dbuild_bench=1 (build.sh bench).
+ *
+ * Without --out the JSON goes to stdout, where the addon's log lines end up as well.
+ */
+
+const path = require('path');
+const fs = require('fs');
+
+function parseArgs(argv) {
+  const args = { only: ['vmem', 'events', 'osd'], seconds: 5, out: null };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--only') args.only = argv[++i].split(',');
+    else if (argv[i] === '--seconds') args.seconds = Number(argv[++i]);
+    else if (argv[i] === '--out') args.out = argv[++i];
+  }
+  return args;
+}
+
+function loadBench() {
+  const candidates = [
+    path.join(__dirname, '..', 'build', 'Release', 'vlc_bench.node'),
+    path.join(__dirname, '..', 'build', 'Debug', 'vlc_bench.node'),
+  ];
+  const found = candidates.find((candidate) => fs.existsSync(candidate));
+  if (!found) {
+    throw new Error('vlc_bench.node not found, build it first (bash scripts/build.sh bench)');
+  }
+  return require(found);
+}
+
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+async function waitFor(predicate, timeoutMs) {
+  const deadline = Date.now() + timeoutMs;
+  while (Date.now() < deadline) {
+    const value = predicate();
+    if (value) return value;
+    await sleep(20);
+  }
+  return null;
+}
+
+// =================================================================================================
+// vmem
+// =================================================================================================
+
+const VMEM_CASES = [
+  { width: 1280, height: 720, fps: 60 },
+  { width: 1920, height: 1080, fps: 60 },
+  { width: 3840, height: 2160, fps: 30 },
+];
+
+async function benchVmem(native, seconds) {
+  const results = [];
+
+  for (const source of VMEM_CASES) {
+    const player = new native.VlcPlayer();
+    player.video({ memoryRender: true });
+
+    const result = { ...source };
+    try {
+      native.bench.openImem(player, source);
+
+      const format = await waitFor(() => player.getVideoFormat(), 5000);
+      if (!format) throw new Error('no video format within 5 s');
+      result.frameSize = format.frameSize;
+
+      // Delivery rate: frames the vout handed to the ring over the window
+      player.getStats({ reset: true });
+      const started = process.hrtime.bigint();
+      await sleep(seconds * 1000);
+      const elapsedS = Number(process.hrtime.bigint() - started) / 1e9;
+      const stats = player.getStats();
+
+      result.deliveredFps = stats.vmem.decoded / elapsedS;
+      result.dropped = stats.vmem.dropped;
+      result.overwritten = stats.vmem.overwritten;
+      result.lockToDisplayUs = stats.vmem.lockToDisplay;
+
+      // Copy bandwidth: back-to-back getFrame() copies of the latest frame
+      let copies = 0;
+      let bytes = 0;
+      const copyStarted = process.hrtime.bigint();
+      const copyDeadline = copyStarted + BigInt(Math.round(seconds * 1e9));
+      while (process.hrtime.bigint() < copyDeadline) {
+        const frame = player.getFrame();
+        if (!frame) break;
+        copies++;
+        bytes += frame.length;
+      }
+      const copyS = Number(process.hrtime.bigint() - copyStarted) / 1e9;
+
+      result.getFrame = {
+        copies,
+        copiesPerSecond: copies / copyS,
+        bytesPerSecond: bytes / copyS,
+        readLatencyUs: player.getStats().vmem.readLatency,
+      };
+    } catch (err) {
+      result.error = err.message;
+    } finally {
+      result.source = native.bench.closeImem(player);
+      player.dispose();
+    }
+    results.push(result);
+  }
+
+  return results;
+}
+
+// =================================================================================================
+// events
+// =================================================================================================
+
+async function benchEvents(native) {
+  const results = [];
+  for (const mode of ['raw', 'coalesced']) {
+    for (const threads of [1, 4]) {
+      results.push(await native.bench.eventFlood({ mode, threads, count: 50000 }));
+    }
+  }
+  // Paced like a busy player: 4 threads at 250 events/s each
+  results.push(await native.bench.eventFlood({ mode: 'coalesced', threads: 4, count: 500, rate: 250 }));
+  return results;
+}
+
+// =================================================================================================
+// osd
+// =================================================================================================
+
+function benchOsd(native) {
+  return [
+    native.bench.osd({ width: 1920, height: 1080, iterations: 2000 }),
+    native.bench.osd({ width: 3840, height: 2160, iterations: 500 }),
+  ];
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const native = loadBench();
+
+  const results = {
+    version: 1,
+    timestamp: new Date().toISOString(),
+    platform: process.platform,
+    arch: process.arch,
+    node: process.version,
+  };
+
+  if (args.only.includes('vmem')) results.vmem = await benchVmem(native, args.seconds);
+  if (args.only.includes('events')) results.events = await benchEvents(native);
+  if (args.only.includes('osd')) results.osd = benchOsd(native);
+
+  const json = JSON.stringify(results, null, 2);
+  if (args.out) fs.writeFileSync(args.out, json + '\n');
+  else process.stdout.write(json + '\n');
+}
+
+main().catch((err) => {
+  console.error('[Bench] Failed:', err.message);
+  process.exit(1);
+});
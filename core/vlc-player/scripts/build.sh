@@ -121,11 +121,11 @@ download_sdk() {
     log_info "VLC SDK downloaded successfully"
 }
 
-# Configure node-gyp
+# Configure node-gyp (extra arguments go to node-gyp, e.g. -- -Dbuild_bench=1)
 configure() {
     log_info "Configuring node-gyp..."
     cd "$PROJECT_DIR"
-    node-gyp configure
+    node-gyp configure "$@"
     log_info "Configuration complete"
 }
 
@@ -190,6 +190,13 @@ rebuild() {
     copy_plugins
 }
 
+# Benchmark build (configure with the vlc_bench target + build + copy plugins)
+bench() {
+    configure -- -Dbuild_bench=1
+    build_addon
+    copy_plugins
+}
+
 # Full install (download SDK + rebuild)
 install() {
     download_sdk
@@ -204,13 +211,14 @@ postinstall() {
 
 # Show usage
 usage() {
-    echo "Usage: $0 {clean|configure|build|rebuild|install|postinstall}"
+    echo "Usage: $0 {clean|configure|build|rebuild|bench|install|postinstall}"
     echo ""
     echo "Commands:"
     echo "  clean       - Remove build directory"
     echo "  configure   - Run node-gyp configure"
     echo "  build       - Build native addon and copy plugins (Windows)"
     echo "  rebuild     - Clean + configure + build"
+    echo "  bench       - Configure with the vlc_bench target + build"
     echo "  install     - Download SDK + rebuild"
     echo "  postinstall - Copy plugins only (after node-gyp rebuild)"
     echo ""
@@ -234,6 +242,9 @@ case "$COMMAND" in
     rebuild)
         rebuild
         ;;
+    bench)
+        bench
+        ;;
     install)
         install
         ;;
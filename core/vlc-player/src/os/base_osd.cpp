@@ -49,13 +49,33 @@ bool OSDWindow::IsCurrentlyVisible(std::chrono::steady_clock::time_point now) co
   return true;
 }
 
+std::chrono::steady_clock::time_point OSDWindow::NextUpdateAt(std::chrono::steady_clock::time_point now) const
+{
+  const auto fade_duration = std::chrono::milliseconds(200);
+
+  // Hidden and already rendered as such
+  if (expire_at <= now && _opacity <= 0)
+    return std::chrono::steady_clock::time_point::max();
+
+  if (_sliding || now - created_at < fade_duration || expire_at - now <= fade_duration)
+    return now;
+
+  return expire_at - fade_duration;
+}
+
 void OSDWindow::SetData(
     const std::string &text,
     const std::string &subtext,
     float progress,
     OSDIcon icon)
 {
-  this->progress = std::clamp(progress, 0.0f, 1.0f);
+  progress = std::clamp(progress, 0.0f, 1.0f);
+  std::string old_text = this->text;
+  std::string old_subtext = this->subtext;
+  if (this->progress != progress || this->icon != icon)
+    _dirty = true;
+
+  this->progress = progress;
   this->icon = icon;
 
   // Type-specific text generation
@@ -80,11 +100,17 @@ void OSDWindow::SetData(
     break;
   }
 
+  // Same strings as last time: the measurements and the layout still hold
+  if (this->text == old_text && this->subtext == old_subtext &&
+      (text_dim_.width != 0 || this->text.empty()))
+    return;
+  _dirty = true;
+
   // Measure and store text dimensions
-  text_dim_ = window->MeasureText(window->defaultFont, this->text);
+  text_dim_ = window->MeasureTextCached(window->defaultFont, this->text);
   if (!this->subtext.empty())
   {
-    subtext_dim_ = window->MeasureText(window->boldFont, this->subtext);
+    subtext_dim_ = window->MeasureTextCached(window->boldFont, this->subtext);
   }
   else
   {
@@ -105,6 +131,23 @@ void OSDWindow::SetData(
   }
 }
 
+void OSDWindow::SetPreview(std::shared_ptr<const OSDImage> image)
+{
+  if (image && (image->width <= 0 || image->height <= 0))
+    image.reset();
+  if (preview_ == image)
+    return;
+
+  preview_ = std::move(image);
+  _dirty = true;
+
+  if (_type == OSDType::SEEK)
+  {
+    int preview_height = preview_ ? preview_->height + SPACING : 0;
+    SetSize(_width, 80 + preview_height);
+  }
+}
+
 void OSDWindow::DrawProgressBar(int x, int y,
                                 int width, int height,
                                 float progress,
@@ -233,6 +276,7 @@ void OSDWindow::Create(int x, int y)
   {
     CreateWindowInternal(x, y);
     SetOpacity(0.0f);
+    _dirty = true;
   }
 }
 
@@ -242,6 +286,7 @@ void OSDWindow::SetOpacity(int opacity)
   if (_opacity != opacity)
   {
     _opacity = opacity;
+    _dirty = true;
     SetOpacityInternal(opacity / 100.0f);
   }
 }
@@ -263,6 +308,7 @@ void OSDWindow::SetSize(int width, int height)
     SetSizeInternal(width, height);
     _width = width;
     _height = height;
+    _dirty = true;
   }
 }
 
@@ -287,7 +333,7 @@ void OSDWindow::SetType(OSDType type)
 
   case OSDType::PLAYBACK:
   {
-    auto dimension = window->MeasureText(window->defaultFont, "Pause");
+    auto dimension = window->MeasureTextCached(window->defaultFont, "Pause");
     _width = dimension.width + 30;
     _height = dimension.height + 20;
     duration = 2000;
@@ -351,6 +397,7 @@ void OSDWindow::Update(WindowBounds bounds, int offsetY, float time)
   {
     SetOpacity(0);
     _offsetY = 0;
+    _sliding = false;
     return;
   }
 
@@ -372,7 +419,11 @@ void OSDWindow::Update(WindowBounds bounds, int offsetY, float time)
     else
     {
       _offsetY -= (_offsetY - offsetY) * time;
+      // The ease never lands exactly, snap once it is under a pixel
+      if (_offsetY - offsetY < 0.5f)
+        _offsetY = offsetY;
     }
+    _sliding = _offsetY != offsetY;
     y = bounds.y + 20 + _offsetY;
     break;
 
@@ -388,13 +439,16 @@ void OSDWindow::Update(WindowBounds bounds, int offsetY, float time)
   {
     CreateWindowInternal(x, y);
     SetOpacity(0.0f);
+    _dirty = true;
   }
 }
 
 void OSDWindow::Render()
 {
-  if (_opacity < 0)
+  if (_opacity < 0 || !_dirty)
     return;
+  _dirty = false;
+  TRACE_SCOPE("osd.render");
 
   ClearDrawable(0, 0, _width, _height, window->background);
 
@@ -471,12 +525,25 @@ void OSDWindow::RenderSeek()
   int bar_y = _height - PROGRESS_BAR_HEIGHT_THIN - PADDING - 12;
   int bar_width = _width - PADDING * 2;
 
+  int marker_x = PADDING + static_cast<int>(bar_width * progress);
+  int content_top = bar_y;
+
   // Position text above progress bar with spacing
   if (!subtext.empty() && subtext_dim_.width > 0)
   {
     int text_x = (_width - subtext_dim_.width) / 2;
     int text_y = bar_y - subtext_dim_.height - 8; // 8px spacing above bar
     DrawText(subtext, text_x, text_y, window->text_primary, window->boldFont);
+    content_top = text_y;
+  }
+
+  // Scrub preview, centred on the marker but kept inside the OSD
+  if (preview_)
+  {
+    int preview_x = std::clamp(marker_x - preview_->width / 2, PADDING,
+                               std::max(PADDING, _width - PADDING - preview_->width));
+    int preview_y = std::max(0, content_top - SPACING - preview_->height);
+    DrawImage(*preview_, preview_x, preview_y);
   }
 
   // Draw progress bar
@@ -486,7 +553,6 @@ void OSDWindow::RenderSeek()
   // Draw position marker (circle)
   if (progress > 0.0f && progress < 1.0f)
   {
-    int marker_x = PADDING + static_cast<int>(bar_width * progress);
     DrawCircle(marker_x, bar_y + PROGRESS_BAR_HEIGHT_THIN / 2, 6, window->text_primary);
   }
 }
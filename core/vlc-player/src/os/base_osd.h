@@ -2,8 +2,11 @@
 #define VLC_OS_BASE_OSD_H
 
 #include "common.h"
+#include <memory>
 
 class OSWindow;
+class OSDSurface;
+struct OSDRect;
 
 class OSDWindow
 {
@@ -11,19 +14,20 @@ class OSDWindow
   int _x, _y, _width, _height;
   int _opacity; /* 0-100*/
   float _offsetY = 0;
+  bool _sliding = false; // Notification still moving towards its queue slot
+  bool _dirty = true;    // Content, size or opacity changed since the last Render()
   std::string text;
   std::string subtext;
   float progress;
   OSDIcon icon;
   int duration;
+  std::shared_ptr<const OSDImage> preview_; // Seek only: scrub preview above the marker
 
   std::chrono::steady_clock::time_point created_at;
   std::chrono::steady_clock::time_point expire_at;
 
   // Layout constants
   static constexpr int PADDING = 15;
-  static constexpr int ICON_SIZE_LARGE = 24;
-  static constexpr int ICON_SIZE_SMALL = 20;
   static constexpr int SPACING = 10;
   static constexpr int PROGRESS_BAR_HEIGHT_THICK = 8;
   static constexpr int PROGRESS_BAR_HEIGHT_THIN = 4;
@@ -68,12 +72,20 @@ protected:
                         int x, int y,
                         OSDColor color,
                         OSDFont font) = 0;
-  void DrawIcon(const OSDIcon &icon,
-                int x, int y,
-                int size,
-                OSDColor color);
+  // Vector path, backends override it to composite from OSWindow::GetIconAtlas()
+  virtual void DrawIcon(const OSDIcon &icon,
+                        int x, int y,
+                        int size,
+                        OSDColor color);
+  // Opaque picture at (x, y), drawn at the current opacity. Backends without image support
+  // leave the preview out.
+  virtual void DrawImage(const OSDImage &image, int x, int y) {}
 
 public:
+  // Icon sizes, also the sizes OSWindow::GetIconAtlas() rasterizes
+  static constexpr int ICON_SIZE_LARGE = 24;
+  static constexpr int ICON_SIZE_SMALL = 20;
+
   OSDType GetType() const { return _type; }
   int x() const { return _x; }
   int y() const { return _y; }
@@ -106,12 +118,25 @@ public:
    */
   bool IsCurrentlyVisible(std::chrono::steady_clock::time_point now) const;
 
+  /**
+   * When the render loop has to call Update() on this OSD again
+   * @param now Current time point
+   * @return now (or earlier) while fading or sliding, the start of the fade-out while fully
+   *         visible, time_point::max() once hidden
+   */
+  std::chrono::steady_clock::time_point NextUpdateAt(std::chrono::steady_clock::time_point now) const;
+
   std::string FormatTime(int64_t time_ms) const;
 
   void SetCreatedAt(std::chrono::steady_clock::time_point time);
 
   void SetData(const std::string &text, const std::string &subtext, float progress = 0, OSDIcon icon = OSDIcon::NONE);
 
+  /**
+   * Picture shown above the seek marker, the seek OSD grows to fit it (nullptr removes it)
+   */
+  void SetPreview(std::shared_ptr<const OSDImage> image);
+
   void Create(int x, int y);
 
   void SetOpacity(int opacity);
@@ -122,6 +147,16 @@ public:
 
   virtual void Flush() = 0;
 
+  // Damage flag consulted by Render(), the surface compositor invalidates every OSD it redraws
+  bool IsDirty() const { return _dirty; }
+  void Invalidate() { _dirty = true; }
+
+  /**
+   * Upload dirty of a composited OSDSurface (same size as this window) and present it.
+   * Only the single overlay window of the surface mode is used this way.
+   */
+  virtual void PresentSurface(const OSDSurface &surface, const OSDRect &dirty) {}
+
   OSDWindow(OSWindow *window);
 
   virtual ~OSDWindow() = default;
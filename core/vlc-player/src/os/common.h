@@ -1,6 +1,7 @@
 #ifndef VLC_OS_COMMON_H
 #define VLC_OS_COMMON_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
@@ -78,6 +79,14 @@ enum class OSDType
 typedef void *OSDColor;
 typedef void *OSDFont;
 
+// Picture shown inside an OSD (seek preview), tightly packed 32-bit BGRA with alpha 255
+struct OSDImage
+{
+  std::vector<uint8_t> pixels;
+  int width = 0;
+  int height = 0;
+};
+
 // Menu Item
 
 struct MenuItem
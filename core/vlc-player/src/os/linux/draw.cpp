@@ -1,4 +1,5 @@
 #include "osd.h"
+#include "window.h"
 #include "../../vlc_player.h"
 
 // =================================================================================================
@@ -34,23 +35,6 @@ void LinuxOSDWindow::DrawRoundedRect(int x, int y, int width, int height, OSDCol
         return;
     }
 
-    // Try to find pre-computed mask for this radius
-    Picture corner_mask = 0;
-    auto it = corner_masks_.find(radius);
-    if (it != corner_masks_.end())
-    {
-        corner_mask = it->second;
-    }
-    else
-    {
-        // Radius not cached, create on-the-fly (rare case)
-        corner_mask = CreateCornerMask(radius);
-        if (corner_mask)
-        {
-            corner_masks_[radius] = corner_mask;
-        }
-    }
-
     // Draw main rectangle (center area + edges without corners)
     XRenderFillRectangle(display_, PictOpOver, pixmap_picture_, &render_color,
                          x + radius, y, width - 2 * radius, height);
@@ -59,52 +43,20 @@ void LinuxOSDWindow::DrawRoundedRect(int x, int y, int width, int height, OSDCol
     XRenderFillRectangle(display_, PictOpOver, pixmap_picture_, &render_color,
                          x + width - radius, y + radius, radius, height - 2 * radius);
 
-    if (corner_mask)
-    {
-        // Draw rounded corners using pre-computed mask (FAST!)
-        // Create a solid color Picture for the fill
-        XRenderPictFormat *format = XRenderFindStandardFormat(display_, PictStandardARGB32);
-        Pixmap color_pixmap = XCreatePixmap(display_, window_, 1, 1, 32);
-        Picture color_picture = XRenderCreatePicture(display_, color_pixmap, format, 0, nullptr);
-        XRenderFillRectangle(display_, PictOpSrc, color_picture, &render_color, 0, 0, 1, 1);
+    const CornerMasks *masks = GetCornerMasks(radius);
+    Picture fill = masks ? GetSolidFill(color) : 0;
 
-        // Composite each corner with mask
-        // Top-left
-        XRenderComposite(display_, PictOpOver, color_picture, corner_mask, pixmap_picture_,
+    if (fill)
+    {
+        // Corners through the cached per-corner masks, no temporary pictures or transforms
+        XRenderComposite(display_, PictOpOver, fill, masks->corners[CORNER_TOP_LEFT], pixmap_picture_,
                          0, 0, 0, 0, x, y, radius, radius);
-        // Top-right (flip horizontally)
-        XTransform xform_h = {{{-XDoubleToFixed(1), 0, XDoubleToFixed(radius)},
-                               {0, XDoubleToFixed(1), 0},
-                               {0, 0, XDoubleToFixed(1)}}};
-        XRenderSetPictureTransform(display_, corner_mask, &xform_h);
-        XRenderComposite(display_, PictOpOver, color_picture, corner_mask, pixmap_picture_,
+        XRenderComposite(display_, PictOpOver, fill, masks->corners[CORNER_TOP_RIGHT], pixmap_picture_,
                          0, 0, 0, 0, x + width - radius, y, radius, radius);
-
-        // Bottom-left (flip vertically)
-        XTransform xform_v = {{{XDoubleToFixed(1), 0, 0},
-                               {0, XDoubleToFixed(-1), XDoubleToFixed(radius)},
-                               {0, 0, XDoubleToFixed(1)}}};
-        XRenderSetPictureTransform(display_, corner_mask, &xform_v);
-        XRenderComposite(display_, PictOpOver, color_picture, corner_mask, pixmap_picture_,
+        XRenderComposite(display_, PictOpOver, fill, masks->corners[CORNER_BOTTOM_LEFT], pixmap_picture_,
                          0, 0, 0, 0, x, y + height - radius, radius, radius);
-
-        // Bottom-right (flip both)
-        XTransform xform_hv = {{{XDoubleToFixed(-1), 0, XDoubleToFixed(radius)},
-                                {0, XDoubleToFixed(-1), XDoubleToFixed(radius)},
-                                {0, 0, XDoubleToFixed(1)}}};
-        XRenderSetPictureTransform(display_, corner_mask, &xform_hv);
-        XRenderComposite(display_, PictOpOver, color_picture, corner_mask, pixmap_picture_,
+        XRenderComposite(display_, PictOpOver, fill, masks->corners[CORNER_BOTTOM_RIGHT], pixmap_picture_,
                          0, 0, 0, 0, x + width - radius, y + height - radius, radius, radius);
-
-        // Reset transform
-        XTransform identity = {{{XDoubleToFixed(1), 0, 0},
-                                {0, XDoubleToFixed(1), 0},
-                                {0, 0, XDoubleToFixed(1)}}};
-        XRenderSetPictureTransform(display_, corner_mask, &identity);
-
-        // Cleanup temporary Picture
-        XRenderFreePicture(display_, color_picture);
-        XFreePixmap(display_, color_pixmap);
     }
     else
     {
@@ -213,6 +165,15 @@ void LinuxOSDWindow::DrawText(const std::string &text, int x, int y, OSDColor co
         return;
     }
 
+    // Steady state: one composite of the cached coverage
+    LinuxWindow *linux_window = static_cast<LinuxWindow *>(window);
+    const LinuxWindow::TextRun *run = linux_window->GetTextRun(font, text);
+    if (run && pixmap_picture_)
+    {
+        CompositeMask(run->mask, 0, 0, x - run->origin_x, y, run->width, run->height, color);
+        return;
+    }
+
     XftColor *xft_color = static_cast<XftColor *>(color);
     XftFont *xft_font = static_cast<XftFont *>(font);
 
@@ -237,3 +198,72 @@ void LinuxOSDWindow::DrawText(const std::string &text, int x, int y, OSDColor co
                       reinterpret_cast<const XftChar8 *>(text.c_str()),
                       static_cast<int>(text.length()));
 }
+
+void LinuxOSDWindow::DrawIcon(const OSDIcon &icon, int x, int y, int size, OSDColor color)
+{
+    if (!display_ || !pixmap_picture_)
+    {
+        return;
+    }
+
+    LinuxWindow *linux_window = static_cast<LinuxWindow *>(window);
+    Picture atlas_mask = linux_window->GetIconAtlasMask();
+    int atlas_x = 0, atlas_y = 0;
+    if (!atlas_mask || !window->GetIconAtlas().Lookup(icon, size, &atlas_x, &atlas_y))
+    {
+        // Size not in the atlas, vector path
+        OSDWindow::DrawIcon(icon, x, y, size, color);
+        return;
+    }
+
+    CompositeMask(atlas_mask, atlas_x, atlas_y, x, y, size, size, color);
+}
+
+void LinuxOSDWindow::DrawImage(const OSDImage &image, int x, int y)
+{
+    if (!display_ || !pixmap_picture_ || image.pixels.empty())
+    {
+        return;
+    }
+
+    // Previews change with every scrub step, so they are uploaded per draw rather than cached
+    XImage *upload = XCreateImage(display_, visual_, 32, ZPixmap, 0,
+                                  reinterpret_cast<char *>(const_cast<uint8_t *>(image.pixels.data())),
+                                  image.width, image.height, 32, image.width * 4);
+    if (!upload)
+    {
+        return;
+    }
+
+    Pixmap source_pixmap = XCreatePixmap(display_, window_, image.width, image.height, 32);
+    XPutImage(display_, source_pixmap, gc_, upload, 0, 0, 0, 0, image.width, image.height);
+    upload->data = nullptr; // Owned by the image
+    XDestroyImage(upload);
+
+    XRenderPictFormat *format = XRenderFindStandardFormat(display_, PictStandardARGB32);
+    Picture source = XRenderCreatePicture(display_, source_pixmap, format, 0, nullptr);
+
+    // The fade is a constant alpha mask
+    XRenderColor fade = {0, 0, 0, static_cast<unsigned short>(current_opacity_ * 0xFFFF)};
+    Picture mask = XRenderCreateSolidFill(display_, &fade);
+
+    XRenderComposite(display_, PictOpOver, source, mask, pixmap_picture_,
+                     0, 0, 0, 0, x, y, image.width, image.height);
+
+    XRenderFreePicture(display_, mask);
+    XRenderFreePicture(display_, source);
+    XFreePixmap(display_, source_pixmap);
+}
+
+void LinuxOSDWindow::CompositeMask(Picture mask, int mask_x, int mask_y,
+                                   int x, int y, int width, int height, OSDColor color)
+{
+    Picture fill = GetSolidFill(color);
+    if (!fill)
+    {
+        return;
+    }
+
+    XRenderComposite(display_, PictOpOver, fill, mask, pixmap_picture_,
+                     0, 0, mask_x, mask_y, x, y, width, height);
+}
@@ -1,10 +1,13 @@
 #include "osd.h"
 #include "window.h"
+#include "../osd_surface.h"
 #include "../../vlc_player.h"
 #include <X11/Xatom.h>
 #include <X11/extensions/Xcomposite.h>
+#include <X11/extensions/shape.h>
 #include <cstring>
 #include <cmath>
+#include <vector>
 
 // Undefine X11 macros that conflict with our code
 #undef None
@@ -123,8 +126,8 @@ void LinuxOSDWindow::InitializeXRender()
     xft_draw_ = XftDrawCreate(display_, pixmap_, visual_, colormap_);
 
     // Pre-compute corner masks for common radius values (2 and 4)
-    corner_masks_[2] = CreateCornerMask(2);
-    corner_masks_[4] = CreateCornerMask(4);
+    GetCornerMasks(2);
+    GetCornerMasks(4);
 }
 
 void LinuxOSDWindow::CleanupXRender()
@@ -159,75 +162,166 @@ void LinuxOSDWindow::CleanupXRender()
         gc_ = nullptr;
     }
 
-    // Cleanup corner masks
+    // Cleanup corner masks and fill sources
     CleanupCornerMasks();
+    CleanupSolidFills();
 }
 
 void LinuxOSDWindow::CleanupCornerMasks()
 {
     for (auto &pair : corner_masks_)
     {
-        if (pair.second && display_)
+        for (Picture corner : pair.second.corners)
         {
-            XRenderFreePicture(display_, pair.second);
+            if (corner && display_)
+            {
+                XRenderFreePicture(display_, corner);
+            }
         }
     }
     corner_masks_.clear();
 }
 
-Picture LinuxOSDWindow::CreateCornerMask(int radius)
+const LinuxOSDWindow::CornerMasks *LinuxOSDWindow::GetCornerMasks(int radius)
 {
-    if (!display_ || radius <= 0)
+    if (radius <= 0)
     {
-        return 0;
+        return nullptr;
     }
 
-    // Create alpha-only pixmap for mask (8-bit depth)
-    Pixmap mask_pixmap = XCreatePixmap(display_, RootWindow(display_, screen_),
-                                       radius, radius, 8);
-    if (!mask_pixmap)
+    auto it = corner_masks_.find(radius);
+    if (it == corner_masks_.end())
     {
-        return 0;
+        it = corner_masks_.emplace(radius, CreateCornerMasks(radius)).first;
+    }
+
+    // A failed creation stays cached as empty so it is not retried every frame
+    return it->second.corners[CORNER_TOP_LEFT] ? &it->second : nullptr;
+}
+
+LinuxOSDWindow::CornerMasks LinuxOSDWindow::CreateCornerMasks(int radius)
+{
+    CornerMasks masks;
+    if (!display_ || radius <= 0)
+    {
+        return masks;
     }
 
-    // Create Picture for alpha mask
     XRenderPictFormat *alpha_format = XRenderFindStandardFormat(display_, PictStandardA8);
     if (!alpha_format)
     {
-        XFreePixmap(display_, mask_pixmap);
-        return 0;
+        return masks;
     }
 
-    Picture mask_picture = XRenderCreatePicture(display_, mask_pixmap, alpha_format, 0, nullptr);
-    if (!mask_picture)
+    // Coverage of the quarter circle, 4x4 supersampled, circle centre at the inner corner
+    const int samples = 4;
+    std::vector<char> coverage(static_cast<size_t>(radius) * radius);
+
+    for (int corner = 0; corner < CORNER_COUNT; corner++)
     {
+        float center_x = (corner == CORNER_TOP_LEFT || corner == CORNER_BOTTOM_LEFT) ? radius : 0.0f;
+        float center_y = (corner == CORNER_TOP_LEFT || corner == CORNER_TOP_RIGHT) ? radius : 0.0f;
+
+        for (int py = 0; py < radius; py++)
+        {
+            for (int px = 0; px < radius; px++)
+            {
+                int covered = 0;
+                for (int sy = 0; sy < samples; sy++)
+                {
+                    for (int sx = 0; sx < samples; sx++)
+                    {
+                        float dx = px + (sx + 0.5f) / samples - center_x;
+                        float dy = py + (sy + 0.5f) / samples - center_y;
+                        if (dx * dx + dy * dy <= radius * radius)
+                            covered++;
+                    }
+                }
+                coverage[py * radius + px] = static_cast<char>(covered * 255 / (samples * samples));
+            }
+        }
+
+        Pixmap mask_pixmap = XCreatePixmap(display_, RootWindow(display_, screen_), radius, radius, 8);
+        if (!mask_pixmap)
+        {
+            break;
+        }
+
+        XImage *image = XCreateImage(display_, nullptr, 8, ZPixmap, 0, coverage.data(),
+                                     radius, radius, 8, radius);
+        if (image)
+        {
+            GC mask_gc = XCreateGC(display_, mask_pixmap, 0, nullptr);
+            XPutImage(display_, mask_pixmap, mask_gc, image, 0, 0, 0, 0, radius, radius);
+            XFreeGC(display_, mask_gc);
+
+            // Pixels belong to coverage
+            image->data = nullptr;
+            XDestroyImage(image);
+
+            masks.corners[corner] = XRenderCreatePicture(display_, mask_pixmap, alpha_format, 0, nullptr);
+        }
+
+        // Free pixmap (Picture holds reference)
         XFreePixmap(display_, mask_pixmap);
-        return 0;
     }
 
-    // Clear mask to transparent
-    XRenderColor transparent = {0, 0, 0, 0};
-    XRenderFillRectangle(display_, PictOpSrc, mask_picture, &transparent, 0, 0, radius, radius);
-
-    // Fill circle area with opaque (create rounded corner)
-    XRenderColor opaque = {0, 0, 0, 0xFFFF}; // Full alpha
-    for (int dy = 0; dy < radius; dy++)
+    // All four or nothing
+    for (Picture corner : masks.corners)
     {
-        for (int dx = 0; dx < radius; dx++)
+        if (!corner)
         {
-            int dist_sq = (dx - radius) * (dx - radius) + (dy - radius) * (dy - radius);
-            if (dist_sq <= radius * radius)
+            for (Picture &created : masks.corners)
             {
-                XRenderFillRectangle(display_, PictOpOver, mask_picture, &opaque,
-                                     dx, dy, 1, 1);
+                if (created)
+                {
+                    XRenderFreePicture(display_, created);
+                }
+                created = 0;
             }
+            break;
         }
     }
 
-    // Free pixmap (Picture holds reference)
-    XFreePixmap(display_, mask_pixmap);
+    return masks;
+}
+
+// =================================================================================================
+// Solid Fill Cache
+// =================================================================================================
 
-    return mask_picture;
+Picture LinuxOSDWindow::GetSolidFill(OSDColor color)
+{
+    if (!display_)
+    {
+        return 0;
+    }
+
+    auto it = solid_fills_.find(color);
+    if (it != solid_fills_.end())
+    {
+        return it->second;
+    }
+
+    XRenderColor render_color = ConvertToXRenderColor(color);
+    Picture fill = XRenderCreateSolidFill(display_, &render_color);
+    if (fill)
+    {
+        solid_fills_[color] = fill;
+    }
+    return fill;
+}
+
+void LinuxOSDWindow::CleanupSolidFills()
+{
+    for (auto &pair : solid_fills_)
+    {
+        if (pair.second && display_)
+        {
+            XRenderFreePicture(display_, pair.second);
+        }
+    }
+    solid_fills_.clear();
 }
 
 // =================================================================================================
@@ -301,6 +395,9 @@ void LinuxOSDWindow::CreateWindowInternal(int x, int y)
     XChangeProperty(display_, window_, wmWindowType, XA_ATOM, 32, PropModeReplace,
                     reinterpret_cast<unsigned char *>(&wmWindowTypeNotification), 1);
 
+    // Empty input region: clicks go through to the video window below
+    XShapeCombineRectangles(display_, window_, ShapeInput, 0, 0, nullptr, 0, ShapeSet, Unsorted);
+
     // Create GC
     gc_ = XCreateGC(display_, window_, 0, nullptr);
 
@@ -374,6 +471,11 @@ void LinuxOSDWindow::SetOpacityInternal(float opacity)
         return;
     }
 
+    // Fill sources carry the opacity premultiplied in
+    if (current_opacity_ != opacity)
+    {
+        CleanupSolidFills();
+    }
     current_opacity_ = opacity;
 
     // Set window opacity property (for compositing window managers)
@@ -426,6 +528,43 @@ void LinuxOSDWindow::Flush()
     XRaiseWindow(display_, window_);
 }
 
+void LinuxOSDWindow::PresentSurface(const OSDSurface &surface, const OSDRect &dirty)
+{
+    if (!display_ || !window_ || !pixmap_ || !pixmap_picture_ || !window_picture_)
+    {
+        return;
+    }
+
+    // The surface is already ARGB32 premultiplied, wrap it instead of copying
+    XImage *image = XCreateImage(display_, visual_, 32, ZPixmap, 0,
+                                 reinterpret_cast<char *>(const_cast<uint8_t *>(surface.Pixels())),
+                                 surface.Width(), surface.Height(), 32, surface.Stride());
+    if (!image)
+    {
+        return;
+    }
+
+    // Only the damaged rect crosses the wire
+    XPutImage(display_, pixmap_, gc_, image,
+              dirty.x, dirty.y, dirty.x, dirty.y, dirty.width, dirty.height);
+    image->data = nullptr; // Owned by the surface
+    XDestroyImage(image);
+
+    XRenderComposite(
+        display_,
+        PictOpSrc,
+        pixmap_picture_,
+        0, // No mask
+        window_picture_,
+        dirty.x, dirty.y, // src x, y
+        0, 0,             // mask x, y
+        dirty.x, dirty.y, // dst x, y
+        dirty.width, dirty.height);
+
+    XFlush(display_);
+    XRaiseWindow(display_, window_);
+}
+
 // =================================================================================================
 // XRender Color Conversion
 // =================================================================================================
@@ -28,6 +28,9 @@ public:
     // Buffer flush
     void Flush() override;
 
+    // Single-surface compositing (OSWindow's overlay window)
+    void PresentSurface(const OSDSurface &surface, const OSDRect &dirty) override;
+
 protected:
     // Window lifecycle
     void CreateWindowInternal(int x, int y) override;
@@ -47,6 +50,9 @@ protected:
     void ClearDrawable(int x, int y, int width, int height, OSDColor color) override;
     void DrawText(const std::string &text, int x, int y,
                   OSDColor color, OSDFont font) override;
+    void DrawIcon(const OSDIcon &icon, int x, int y,
+                  int size, OSDColor color) override;
+    void DrawImage(const OSDImage &image, int x, int y) override;
 
 private:
     Display *display_;               // X11 display connection
@@ -66,8 +72,26 @@ private:
     bool has_composite_;             // XComposite extension available?
     float current_opacity_;          // Current opacity (0.0-1.0)
 
-    // Pre-computed corner masks (for rounded rectangles)
-    std::map<int, Picture> corner_masks_;  // radius -> XRender Picture
+    // Pre-computed corner masks (for rounded rectangles), one picture per corner so drawing
+    // never has to set a picture transform
+    enum Corner
+    {
+        CORNER_TOP_LEFT,
+        CORNER_TOP_RIGHT,
+        CORNER_BOTTOM_LEFT,
+        CORNER_BOTTOM_RIGHT,
+        CORNER_COUNT
+    };
+
+    struct CornerMasks
+    {
+        Picture corners[CORNER_COUNT] = {0, 0, 0, 0};
+    };
+
+    std::map<int, CornerMasks> corner_masks_; // radius -> A8 masks
+
+    // Solid fill sources at current_opacity_, dropped when the opacity changes
+    std::map<OSDColor, Picture> solid_fills_;
 
     // Helper methods
     bool FindARGBVisual();           // Find 32-bit ARGB visual
@@ -76,12 +100,21 @@ private:
     void UpdateWindow();             // Copy pixmap to window with alpha
 
     // Corner mask creation
-    Picture CreateCornerMask(int radius);  // Create pre-computed corner mask
-    void CleanupCornerMasks();             // Cleanup all corner masks
+    const CornerMasks *GetCornerMasks(int radius); // Cached, created on first use
+    CornerMasks CreateCornerMasks(int radius);     // Antialiased quarter circles
+    void CleanupCornerMasks();                     // Cleanup all corner masks
+
+    // Solid fill cache
+    Picture GetSolidFill(OSDColor color);
+    void CleanupSolidFills();
 
     // XRender helper conversions
     void SetXRenderColor(const XRenderColor *color);
     XRenderColor ConvertToXRenderColor(OSDColor color);
+
+    // Tint a cached A8 mask with color (opacity applied) onto the offscreen buffer
+    void CompositeMask(Picture mask, int mask_x, int mask_y,
+                       int x, int y, int width, int height, OSDColor color);
 };
 
 #endif // VLC_OS_LINUX_OSD_H
@@ -11,6 +11,9 @@
 #include <X11/keysym.h>
 #include <cstring>
 #include <algorithm>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 // =================================================================================================
 // Motif Window Manager Hints (for window decorations)
@@ -224,6 +227,9 @@ void LinuxWindow::Destroy()
         xft_draw_ = nullptr;
     }
 
+    // Cleanup OSD raster caches (before the fonts they were keyed on)
+    ReleaseOSDCaches();
+
     // Cleanup colors
     for (auto *color : colors_)
     {
@@ -343,8 +349,16 @@ WindowBounds LinuxWindow::GetClientArea() const
             int x_return, y_return;
             unsigned int width_return, height_return, border_width_return, depth_return;
             
-            if (XGetGeometry(display_, window_, &root_return, &x_return, &y_return, 
-                             &width_return, &height_return, &border_width_return, &depth_return))
+            bool ok = XGetGeometry(display_, window_, &root_return, &x_return, &y_return,
+                                   &width_return, &height_return, &border_width_return, &depth_return);
+
+            // The replies may have pulled events into Xlib's queue behind the loop's back
+            if (std::this_thread::get_id() != message_thread_.get_id())
+            {
+                WakeMessageLoop();
+            }
+
+            if (ok)
             {
                 return {x, y, static_cast<int>(width_return), static_cast<int>(height_return)};
             }
@@ -482,6 +496,168 @@ void LinuxWindow::DestroyFont(OSDFont font)
     }
 }
 
+// =================================================================================================
+// OSD Raster Caches
+// =================================================================================================
+
+const LinuxWindow::TextRun *LinuxWindow::GetTextRun(OSDFont font, const std::string &text)
+{
+    if (!display_ || !font || text.empty())
+    {
+        return nullptr;
+    }
+
+    if (const TextRun *cached = text_runs_.Find(font, text))
+    {
+        return cached->mask ? cached : nullptr;
+    }
+
+    XftFont *xft_font = static_cast<XftFont *>(font);
+    XGlyphInfo extents;
+    XftTextExtentsUtf8(display_, xft_font,
+                       reinterpret_cast<const XftChar8 *>(text.c_str()),
+                       static_cast<int>(text.length()), &extents);
+
+    // Ink can start left of the pen (extents.x > 0) and end past the advance
+    TextRun run;
+    run.origin_x = std::max(0, static_cast<int>(extents.x));
+    run.width = std::max(static_cast<int>(extents.xOff), static_cast<int>(extents.width) - extents.x) + run.origin_x;
+    run.height = xft_font->ascent + xft_font->descent;
+
+    XRenderPictFormat *alpha_format = XRenderFindStandardFormat(display_, PictStandardA8);
+    Pixmap pixmap = 0;
+    if (alpha_format && run.width > 0 && run.height > 0)
+    {
+        pixmap = XCreatePixmap(display_, RootWindow(display_, screen_), run.width, run.height, 8);
+    }
+
+    if (pixmap)
+    {
+        run.mask = XRenderCreatePicture(display_, pixmap, alpha_format, 0, nullptr);
+    }
+
+    if (run.mask)
+    {
+        XRenderColor transparent = {0, 0, 0, 0};
+        XRenderFillRectangle(display_, PictOpSrc, run.mask, &transparent, 0, 0, run.width, run.height);
+
+        // Full-strength coverage, color and opacity are applied by the composite source
+        XftDraw *draw = XftDrawCreateAlpha(display_, pixmap, 8);
+        if (draw)
+        {
+            XftColor coverage = {};
+            coverage.color.red = coverage.color.green = coverage.color.blue = coverage.color.alpha = 0xFFFF;
+            XftDrawStringUtf8(draw, &coverage, xft_font, run.origin_x, xft_font->ascent,
+                              reinterpret_cast<const XftChar8 *>(text.c_str()),
+                              static_cast<int>(text.length()));
+            XftDrawDestroy(draw);
+        }
+    }
+
+    if (run.mask)
+    {
+        // Kept alongside the picture for GetTextCoverage() read-backs
+        run.pixmap = pixmap;
+    }
+    else if (pixmap)
+    {
+        XFreePixmap(display_, pixmap);
+    }
+
+    // Failures are cached too, so a broken XRender does not retry every frame
+    const TextRun *stored = text_runs_.Insert(font, text, run);
+    return stored->mask ? stored : nullptr;
+}
+
+bool LinuxWindow::GetTextCoverage(OSDFont font, const std::string &text, OSDCoverage *coverage)
+{
+    // GetTextRun() rasterizes on a miss, the mutable entry is then fetched from the cache
+    TextRun *run = GetTextRun(font, text) ? text_runs_.Find(font, text) : nullptr;
+    if (!run || !run->pixmap)
+    {
+        return false;
+    }
+
+    if (run->coverage.empty())
+    {
+        XImage *image = XGetImage(display_, run->pixmap, 0, 0, run->width, run->height, AllPlanes, ZPixmap);
+        if (!image)
+        {
+            return false;
+        }
+
+        run->coverage.resize(static_cast<size_t>(run->width) * run->height);
+        for (int y = 0; y < run->height; y++)
+        {
+            for (int x = 0; x < run->width; x++)
+            {
+                run->coverage[static_cast<size_t>(y) * run->width + x] =
+                    static_cast<uint8_t>(XGetPixel(image, x, y));
+            }
+        }
+        XDestroyImage(image);
+    }
+
+    coverage->pixels = run->coverage.data();
+    coverage->stride = run->width;
+    coverage->width = run->width;
+    coverage->height = run->height;
+    coverage->origin_x = run->origin_x;
+    return true;
+}
+
+Picture LinuxWindow::GetIconAtlasMask()
+{
+    if (icon_atlas_mask_ || !display_)
+    {
+        return icon_atlas_mask_;
+    }
+
+    const OSDIconAtlas &atlas = GetIconAtlas();
+    XRenderPictFormat *alpha_format = XRenderFindStandardFormat(display_, PictStandardA8);
+    if (!alpha_format)
+    {
+        return 0;
+    }
+
+    Pixmap pixmap = XCreatePixmap(display_, RootWindow(display_, screen_), atlas.Width(), atlas.Height(), 8);
+    if (!pixmap)
+    {
+        return 0;
+    }
+
+    // ZPixmap with one byte per pixel, rows are exactly Width() bytes
+    XImage *image = XCreateImage(display_, nullptr, 8, ZPixmap, 0,
+                                 reinterpret_cast<char *>(const_cast<uint8_t *>(atlas.Coverage())),
+                                 atlas.Width(), atlas.Height(), 8, atlas.Width());
+    if (image)
+    {
+        GC gc = XCreateGC(display_, pixmap, 0, nullptr);
+        XPutImage(display_, pixmap, gc, image, 0, 0, 0, 0, atlas.Width(), atlas.Height());
+        XFreeGC(display_, gc);
+
+        // The pixels belong to the atlas
+        image->data = nullptr;
+        XDestroyImage(image);
+
+        icon_atlas_mask_ = XRenderCreatePicture(display_, pixmap, alpha_format, 0, nullptr);
+    }
+
+    XFreePixmap(display_, pixmap);
+    return icon_atlas_mask_;
+}
+
+void LinuxWindow::ReleaseOSDCaches()
+{
+    text_runs_.Clear();
+
+    if (icon_atlas_mask_ && display_)
+    {
+        XRenderFreePicture(display_, icon_atlas_mask_);
+    }
+    icon_atlas_mask_ = 0;
+}
+
 // =================================================================================================
 // OSD Management
 // =================================================================================================
@@ -601,6 +777,13 @@ void LinuxWindow::StartMessageLoop()
         return;
     }
 
+    // Wakes the loop out of poll() for shutdown
+    message_wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (message_wake_fd_ < 0)
+    {
+        VlcPlayer::Log("WARNING: eventfd failed, message loop falls back to timed polls");
+    }
+
     message_thread_running_ = true;
     message_thread_ = std::thread([this]()
                                   { ProcessEvents(); });
@@ -614,18 +797,39 @@ void LinuxWindow::StopMessageLoop()
     }
 
     message_thread_running_ = false;
+    WakeMessageLoop();
+
     if (message_thread_.joinable())
     {
         message_thread_.join();
     }
+
+    if (message_wake_fd_ >= 0)
+    {
+        close(message_wake_fd_);
+        message_wake_fd_ = -1;
+    }
+}
+
+void LinuxWindow::WakeMessageLoop() const
+{
+    if (message_wake_fd_ >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t written = write(message_wake_fd_, &one, sizeof(one));
+        (void)written;
+    }
 }
 
 void LinuxWindow::ProcessEvents()
 {
+    Trace::SetThreadName("x11-events");
     XEvent event;
 
     while (message_thread_running_)
     {
+        int connection_fd = -1;
+
         {
             std::lock_guard<std::mutex> lock(window_mutex_);
 
@@ -635,8 +839,9 @@ void LinuxWindow::ProcessEvents()
                 break;
             }
 
-            // Process pending events (X11 is not thread-safe, must lock)
-            if (XPending(display_) > 0)
+            // Drain everything that is pending (X11 is not thread-safe, must lock)
+            TRACE_SCOPE("x11.events");
+            while (message_thread_running_ && XPending(display_) > 0)
             {
                 XNextEvent(display_, &event);
 
@@ -666,10 +871,39 @@ void LinuxWindow::ProcessEvents()
                     break;
                 }
             }
+
+            // Requests queued by the handlers must reach the server before we sleep
+            XFlush(display_);
+            connection_fd = ConnectionNumber(display_);
+
+            // Already read off the socket, poll() would not see them
+            if (XEventsQueued(display_, QueuedAlready) > 0)
+            {
+                continue;
+            }
         } // Lock released here
 
-        // Sleep outside lock to allow other threads to access display
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Sleep outside the lock until the server sends something or we are stopped.
+        // Round trips made by other threads (OSD, window API) can move events into Xlib's
+        // queue without making the socket readable: GetClientArea() writes the wake eventfd
+        // after its replies, the idle timeout covers the remaining calls.
+        struct pollfd fds[2];
+        fds[0].fd = connection_fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = message_wake_fd_;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+
+        int timeout = message_wake_fd_ >= 0 ? MESSAGE_LOOP_IDLE_TIMEOUT_MS : 10;
+        int ready = poll(fds, message_wake_fd_ >= 0 ? 2 : 1, timeout);
+
+        if (ready > 0 && (fds[1].revents & POLLIN))
+        {
+            uint64_t value;
+            ssize_t consumed = read(message_wake_fd_, &value, sizeof(value));
+            (void)consumed;
+        }
     }
 }
 
@@ -681,7 +915,7 @@ void LinuxWindow::HandleKeyPress(XEvent *event)
     if (!keyCode.empty())
     {
         bool ctrl, shift, alt, meta;
-        GetKeyModifiers(ctrl, shift, alt, meta);
+        GetKeyModifiers(event->xkey.state, ctrl, shift, alt, meta);
         OnInput(keyCode, ctrl, shift, alt, meta);
     }
 }
@@ -980,28 +1214,11 @@ std::string LinuxWindow::GetKeyName(KeySym keysym)
     }
 }
 
-bool LinuxWindow::GetKeyModifiers(bool &ctrl, bool &shift, bool &alt, bool &meta)
+// The key event carries the modifier state, no XQueryPointer round trip per key press
+void LinuxWindow::GetKeyModifiers(unsigned int state, bool &ctrl, bool &shift, bool &alt, bool &meta)
 {
-    if (!display_ || !window_)
-    {
-        ctrl = shift = alt = meta = false;
-        return false;
-    }
-
-    ::Window root_return, child_return;
-    int root_x, root_y, win_x, win_y;
-    unsigned int mask;
-
-    if (XQueryPointer(display_, window_, &root_return, &child_return,
-                      &root_x, &root_y, &win_x, &win_y, &mask))
-    {
-        ctrl = (mask & ControlMask) != 0;
-        shift = (mask & ShiftMask) != 0;
-        alt = (mask & Mod1Mask) != 0;
-        meta = (mask & Mod4Mask) != 0;
-        return true;
-    }
-
-    ctrl = shift = alt = meta = false;
-    return false;
+    ctrl = (state & ControlMask) != 0;
+    shift = (state & ShiftMask) != 0;
+    alt = (state & Mod1Mask) != 0;
+    meta = (state & Mod4Mask) != 0;
 }
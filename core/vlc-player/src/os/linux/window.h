@@ -5,6 +5,7 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xft/Xft.h>
+#include <X11/extensions/Xrender.h>
 #include <map>
 #include <vector>
 #include <thread>
@@ -58,6 +59,34 @@ public:
     Display *GetDisplay() const { return display_; }
     int GetScreen() const { return screen_; }
 
+    // =================================================================================================
+    // OSD Raster Caches (render thread, under the OSD lock)
+    // =================================================================================================
+
+    struct TextRun
+    {
+        Picture mask = 0; // A8 coverage of the string, tinted at composite time
+        Pixmap pixmap = 0; // Backing store of mask, read back for the software compositor
+        int origin_x = 0;  // Ink left of the pen origin
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> coverage; // Client-side copy, fetched on first GetTextCoverage()
+    };
+
+    /**
+     * Rasterized coverage of text in font, rendered once per (font, string)
+     * @return nullptr if XRender could not allocate the mask
+     */
+    const TextRun *GetTextRun(OSDFont font, const std::string &text);
+
+    /**
+     * GetIconAtlas() uploaded as an A8 picture on first use, 0 on failure
+     */
+    Picture GetIconAtlasMask();
+
+    // Single-surface compositing reads the cached masks back once per string
+    bool GetTextCoverage(OSDFont font, const std::string &text, OSDCoverage *coverage) override;
+
 protected:
     // =================================================================================================
     // Color/Font Management (OSWindow abstract methods)
@@ -124,9 +153,23 @@ private:
     std::vector<XftColor *> colors_; // Stored colors (for cleanup)
     std::vector<XftFont *> fonts_;   // Stored fonts (for cleanup)
 
-    // Message loop thread
+    // OSD raster caches
+    static constexpr size_t TEXT_RUN_CACHE_SIZE = 64;
+    OSDTextCache<TextRun> text_runs_{TEXT_RUN_CACHE_SIZE, [this](TextRun &run)
+                                     {
+                                         if (display_ && run.mask)
+                                             XRenderFreePicture(display_, run.mask);
+                                         if (display_ && run.pixmap)
+                                             XFreePixmap(display_, run.pixmap);
+                                     }};
+    Picture icon_atlas_mask_ = 0;
+    void ReleaseOSDCaches();
+
+    // Message loop thread (sleeps in poll() on the X connection + wake eventfd)
+    static constexpr int MESSAGE_LOOP_IDLE_TIMEOUT_MS = 500;
     std::thread message_thread_;
     std::atomic<bool> message_thread_running_{false};
+    int message_wake_fd_ = -1;
     std::mutex window_mutex_;
 
     // =================================================================================================
@@ -135,6 +178,7 @@ private:
 
     void StartMessageLoop();
     void StopMessageLoop();
+    void WakeMessageLoop() const;
     void ProcessEvents();
 
     // Event handlers
@@ -154,7 +198,7 @@ private:
     void UpdateClientArea();
     void SendWindowStateMessage(Atom state_atom, bool enable);
     std::string GetKeyName(KeySym keysym);
-    bool GetKeyModifiers(bool &ctrl, bool &shift, bool &alt, bool &meta);
+    void GetKeyModifiers(unsigned int state, bool &ctrl, bool &shift, bool &alt, bool &meta);
 
     // =================================================================================================
     // Context Menu Structures and Methods (implemented in context_menu.cpp)
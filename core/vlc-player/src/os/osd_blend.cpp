@@ -0,0 +1,263 @@
+#include "osd_blend.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OSD_BLEND_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OSD_BLEND_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang only emit AVX2 inside functions that ask for it, MSVC accepts the intrinsics anywhere
+#if defined(__GNUC__) || defined(__clang__)
+#define OSD_BLEND_TARGET(isa) __attribute__((target(isa)))
+#else
+#define OSD_BLEND_TARGET(isa)
+#endif
+
+// x / 255 rounded, exact for every product of two bytes
+static inline uint32_t Div255(uint32_t value)
+{
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+// =================================================================================================
+// Scalar
+// =================================================================================================
+
+void OSDBlendRowScalar(uint8_t *target, const uint8_t *source, int pixels)
+{
+    for (int x = 0; x < pixels; x++, source += 4, target += 4)
+    {
+        uint32_t alpha = source[3];
+        if (alpha == 0)
+            continue;
+
+        // Saturating like the vector kernels, a non-premultiplied source must not wrap
+        uint32_t inverse = 255 - alpha;
+        target[0] = static_cast<uint8_t>(std::min<uint32_t>(source[0] + Div255(target[0] * inverse), 255));
+        target[1] = static_cast<uint8_t>(std::min<uint32_t>(source[1] + Div255(target[1] * inverse), 255));
+        target[2] = static_cast<uint8_t>(std::min<uint32_t>(source[2] + Div255(target[2] * inverse), 255));
+    }
+}
+
+#ifdef OSD_BLEND_X86
+
+// =================================================================================================
+// SSE2 (4 pixels per step)
+// =================================================================================================
+
+OSD_BLEND_TARGET("sse2")
+static inline __m128i Div255SSE2(__m128i value)
+{
+    // Products stay below 65153 after the bias, so the 16-bit lanes cannot overflow
+    value = _mm_add_epi16(value, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+OSD_BLEND_TARGET("sse2")
+static void BlendRowSSE2(uint8_t *target, const uint8_t *source, int pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int x = 0;
+    for (; x + 4 <= pixels; x += 4)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x * 4));
+
+        // Most of an OSD's bounding box is fully transparent
+        __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alpha_mask), zero);
+        if (_mm_movemask_epi8(transparent) == 0xFFFF)
+            continue;
+
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + x * 4));
+
+        // 255 - alpha broadcast over each pixel's four 16-bit lanes
+        __m128i src_lo = _mm_unpacklo_epi8(src, zero);
+        __m128i src_hi = _mm_unpackhi_epi8(src, zero);
+        __m128i inv_lo = _mm_sub_epi16(max, _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xFF), 0xFF));
+        __m128i inv_hi = _mm_sub_epi16(max, _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xFF), 0xFF));
+
+        __m128i dst_lo = Div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), inv_lo));
+        __m128i dst_hi = Div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), inv_hi));
+        __m128i blended = _mm_adds_epu8(src, _mm_packus_epi16(dst_lo, dst_hi));
+
+        // Keep the frame's own alpha byte
+        blended = _mm_or_si128(_mm_andnot_si128(alpha_mask, blended), _mm_and_si128(alpha_mask, dst));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target + x * 4), blended);
+    }
+
+    OSDBlendRowScalar(target + x * 4, source + x * 4, pixels - x);
+}
+
+// =================================================================================================
+// AVX2 (8 pixels per step, same math as SSE2 per 128-bit lane)
+// =================================================================================================
+
+OSD_BLEND_TARGET("avx2")
+static inline __m256i Div255AVX2(__m256i value)
+{
+    value = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+}
+
+OSD_BLEND_TARGET("avx2")
+static void BlendRowAVX2(uint8_t *target, const uint8_t *source, int pixels)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi16(255);
+    const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int x = 0;
+    for (; x + 8 <= pixels; x += 8)
+    {
+        __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x * 4));
+
+        __m256i transparent = _mm256_cmpeq_epi32(_mm256_and_si256(src, alpha_mask), zero);
+        if (_mm256_movemask_epi8(transparent) == -1)
+            continue;
+
+        __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(target + x * 4));
+
+        // Unpack and pack both work per 128-bit lane, so the pixel order survives the round trip
+        __m256i src_lo = _mm256_unpacklo_epi8(src, zero);
+        __m256i src_hi = _mm256_unpackhi_epi8(src, zero);
+        __m256i inv_lo = _mm256_sub_epi16(max, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_lo, 0xFF), 0xFF));
+        __m256i inv_hi = _mm256_sub_epi16(max, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_hi, 0xFF), 0xFF));
+
+        __m256i dst_lo = Div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), inv_lo));
+        __m256i dst_hi = Div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), inv_hi));
+        __m256i blended = _mm256_adds_epu8(src, _mm256_packus_epi16(dst_lo, dst_hi));
+
+        blended = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, blended), _mm256_and_si256(alpha_mask, dst));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(target + x * 4), blended);
+    }
+
+    // At most 7 pixels left, still worth a 4-wide step
+    BlendRowSSE2(target + x * 4, source + x * 4, pixels - x);
+}
+
+static bool CpuHasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX + OSXSAVE, and the OS saving the YMM state on context switches
+    __cpuid(info, 1);
+    bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28));
+    if (!avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static bool CpuHasSSE2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true; // Baseline of x86-64
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // OSD_BLEND_X86
+
+#ifdef OSD_BLEND_NEON
+
+// =================================================================================================
+// NEON (8 pixels per step, always present on ARM64)
+// =================================================================================================
+
+static inline uint8x8_t Div255NEON(uint16x8_t value)
+{
+    // (v + ((v + 128) >> 8) + 128) >> 8, the same rounding as Div255()
+    return vrshrn_n_u16(vrsraq_n_u16(value, value, 8), 8);
+}
+
+static void BlendRowNEON(uint8_t *target, const uint8_t *source, int pixels)
+{
+    int x = 0;
+    for (; x + 8 <= pixels; x += 8)
+    {
+        // De-interleaved into B, G, R, A planes
+        uint8x8x4_t src = vld4_u8(source + x * 4);
+        if (vmaxv_u8(src.val[3]) == 0)
+            continue;
+
+        uint8x8x4_t dst = vld4_u8(target + x * 4);
+        uint8x8_t inverse = vmvn_u8(src.val[3]);
+        for (int channel = 0; channel < 3; channel++)
+        {
+            uint8x8_t scaled = Div255NEON(vmull_u8(dst.val[channel], inverse));
+            dst.val[channel] = vqadd_u8(src.val[channel], scaled);
+        }
+        vst4_u8(target + x * 4, dst);
+    }
+
+    OSDBlendRowScalar(target + x * 4, source + x * 4, pixels - x);
+}
+
+#endif // OSD_BLEND_NEON
+
+// =================================================================================================
+// Dispatch
+// =================================================================================================
+
+struct BlendKernel
+{
+    OSDBlendRowFunc row;
+    const char *name;
+};
+
+static BlendKernel SelectBlendKernel()
+{
+#ifdef OSD_BLEND_X86
+    if (CpuHasAVX2())
+        return {BlendRowAVX2, "avx2"};
+    if (CpuHasSSE2())
+        return {BlendRowSSE2, "sse2"};
+#endif
+
+#ifdef OSD_BLEND_NEON
+    return {BlendRowNEON, "neon"};
+#else
+    return {OSDBlendRowScalar, "scalar"};
+#endif
+}
+
+static const BlendKernel &GetBlendKernel()
+{
+    // Probed once, thread-safe static initialization
+    static const BlendKernel kernel = SelectBlendKernel();
+    return kernel;
+}
+
+OSDBlendRowFunc GetOSDBlendRow()
+{
+    return GetBlendKernel().row;
+}
+
+const char *GetOSDBlendKernelName()
+{
+    return GetBlendKernel().name;
+}
@@ -0,0 +1,29 @@
+#ifndef VLC_OS_OSD_BLEND_H
+#define VLC_OS_OSD_BLEND_H
+
+#include <cstdint>
+
+// =================================================================================================
+// OSD Blend Kernels - Premultiplied source-over of an OSD row onto a 32-bit BGRX/BGRA frame row
+// =================================================================================================
+// target.rgb = source.rgb + target.rgb * (255 - source.a) / 255, the target alpha byte is kept.
+// Results are identical across kernels (exact rounded division by 255), so the pick only
+// changes speed. The kernel is chosen once from what the CPU supports at runtime:
+// AVX2 -> SSE2 on x86, NEON on ARM64, scalar everywhere else.
+
+using OSDBlendRowFunc = void (*)(uint8_t *target, const uint8_t *source, int pixels);
+
+/**
+ * Fastest blend kernel for this CPU
+ */
+OSDBlendRowFunc GetOSDBlendRow();
+
+/**
+ * Name of the kernel GetOSDBlendRow() picked ("avx2", "sse2", "neon" or "scalar")
+ */
+const char *GetOSDBlendKernelName();
+
+// Reference implementation, also blends the tails the vector kernels leave over
+void OSDBlendRowScalar(uint8_t *target, const uint8_t *source, int pixels);
+
+#endif // VLC_OS_OSD_BLEND_H
@@ -0,0 +1,190 @@
+#include "osd_cache.h"
+#include <algorithm>
+#include <cmath>
+
+// =================================================================================================
+// Shape Coverage (icon-local coordinates, same geometry as OSDWindow::DrawIcon)
+// =================================================================================================
+
+struct IconPoint
+{
+    float x;
+    float y;
+};
+
+static bool InsidePolygon(const IconPoint *points, int count, float x, float y)
+{
+    // Even-odd crossing test
+    bool inside = false;
+    for (int i = 0, j = count - 1; i < count; j = i++)
+    {
+        const IconPoint &a = points[i];
+        const IconPoint &b = points[j];
+        if ((a.y > y) != (b.y > y) &&
+            x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static bool InsideRoundedRect(float x, float y, float left, float top, float width, float height, float radius)
+{
+    if (x < left || y < top || x >= left + width || y >= top + height)
+        return false;
+
+    // Distance to the nearest corner centre, only matters inside the corner squares
+    float cx = std::clamp(x, left + radius, left + width - radius);
+    float cy = std::clamp(y, top + radius, top + height - radius);
+    float dx = x - cx;
+    float dy = y - cy;
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+static bool NearSegment(float x, float y, IconPoint a, IconPoint b, float half_width)
+{
+    float vx = b.x - a.x;
+    float vy = b.y - a.y;
+    float length_sq = vx * vx + vy * vy;
+    float t = length_sq > 0.0f ? ((x - a.x) * vx + (y - a.y) * vy) / length_sq : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+
+    float dx = x - (a.x + vx * t);
+    float dy = y - (a.y + vy * t);
+    return dx * dx + dy * dy <= half_width * half_width;
+}
+
+static bool IconCovers(OSDIcon icon, int size, float x, float y)
+{
+    // Same stroke width as the 2px pens of the vector path
+    const float half_stroke = 1.0f;
+
+    switch (icon)
+    {
+    case PLAY:
+    {
+        IconPoint points[3] = {{0.0f, 0.0f},
+                               {(float)size, (float)(size / 2)},
+                               {0.0f, (float)size}};
+        return InsidePolygon(points, 3, x, y);
+    }
+
+    case PAUSE:
+    {
+        int bar_width = size / 3;
+        return (x >= 0 && x < bar_width) || (x >= size - bar_width && x < size);
+    }
+
+    case STOP:
+        return InsideRoundedRect(x, y, 0.0f, 0.0f, (float)size, (float)size, 2.0f);
+
+    case VOLUME_UP:
+    case VOLUME_DOWN:
+    case VOLUME_MUTE:
+    {
+        IconPoint speaker[4] = {{0.0f, (float)(size / 3)},
+                                {(float)(size / 2), 0.0f},
+                                {(float)(size / 2), (float)size},
+                                {0.0f, (float)(2 * size / 3)}};
+        if (InsidePolygon(speaker, 4, x, y))
+            return true;
+
+        if (icon == VOLUME_UP)
+        {
+            // Sound wave ring inscribed in (size/2, size/4, size/2, size/2)
+            float radius = (size / 2) / 2.0f;
+            float dx = x - (size / 2 + radius);
+            float dy = y - (size / 4 + radius);
+            float distance = std::sqrt(dx * dx + dy * dy);
+            return std::fabs(distance - radius) <= half_stroke;
+        }
+
+        if (icon == VOLUME_MUTE)
+        {
+            IconPoint a = {(float)(size / 2), 0.0f};
+            IconPoint b = {(float)size, (float)size};
+            IconPoint c = {(float)size, 0.0f};
+            IconPoint d = {(float)(size / 2), (float)size};
+            return NearSegment(x, y, a, b, half_stroke) || NearSegment(x, y, c, d, half_stroke);
+        }
+        return false;
+    }
+
+    default:
+        return false;
+    }
+}
+
+// =================================================================================================
+// OSDIconAtlas
+// =================================================================================================
+
+OSDIconAtlas::OSDIconAtlas(const std::vector<int> &sizes)
+    : sizes_(sizes)
+{
+    // 1px gutter between cells so filtering never bleeds into a neighbour
+    int max_size = 0;
+    for (int size : sizes_)
+    {
+        rows_.push_back(height_);
+        height_ += size + 1;
+        max_size = std::max(max_size, size);
+    }
+    width_ = ICON_COUNT * (max_size + 1);
+    coverage_.assign(static_cast<size_t>(width_) * height_, 0);
+
+    for (size_t row = 0; row < sizes_.size(); row++)
+    {
+        for (int icon = PLAY; icon < ICON_COUNT; icon++)
+        {
+            RasterizeIcon(static_cast<OSDIcon>(icon), sizes_[row], icon * (max_size + 1), rows_[row]);
+        }
+    }
+}
+
+bool OSDIconAtlas::Lookup(OSDIcon icon, int size, int *x, int *y) const
+{
+    if (icon <= NONE || icon >= ICON_COUNT)
+        return false;
+
+    for (size_t row = 0; row < sizes_.size(); row++)
+    {
+        if (sizes_[row] != size)
+            continue;
+
+        int max_size = width_ / ICON_COUNT - 1;
+        *x = icon * (max_size + 1);
+        *y = rows_[row];
+        return true;
+    }
+    return false;
+}
+
+void OSDIconAtlas::RasterizeIcon(OSDIcon icon, int size, int origin_x, int origin_y)
+{
+    const int samples = 4;
+    const float step = 1.0f / samples;
+
+    // Shapes may reach one pen width past size (ring, mute cross), clip to the cell
+    for (int py = 0; py < size; py++)
+    {
+        for (int px = 0; px < size; px++)
+        {
+            int covered = 0;
+            for (int sy = 0; sy < samples; sy++)
+            {
+                for (int sx = 0; sx < samples; sx++)
+                {
+                    float x = px + (sx + 0.5f) * step;
+                    float y = py + (sy + 0.5f) * step;
+                    if (IconCovers(icon, size, x, y))
+                        covered++;
+                }
+            }
+
+            coverage_[static_cast<size_t>(origin_y + py) * width_ + origin_x + px] =
+                static_cast<uint8_t>(covered * 255 / (samples * samples));
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef VLC_OS_OSD_CACHE_H
+#define VLC_OS_OSD_CACHE_H
+
+#include "common.h"
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+// =================================================================================================
+// OSDTextCache - (font, string) keyed cache, least recently used entry evicted past capacity
+// =================================================================================================
+// Shared by the text measurement cache in OSWindow and the rasterized text runs of the
+// platform backends. Not thread-safe, callers hold the OSD lock.
+
+template <typename T>
+class OSDTextCache
+{
+public:
+    using Release = std::function<void(T &)>;
+
+    explicit OSDTextCache(size_t capacity, Release release = nullptr)
+        : capacity_(capacity), release_(std::move(release))
+    {
+    }
+
+    ~OSDTextCache() { Clear(); }
+
+    OSDTextCache(const OSDTextCache &) = delete;
+    OSDTextCache &operator=(const OSDTextCache &) = delete;
+
+    T *Find(OSDFont font, const std::string &text)
+    {
+        auto it = entries_.find(Key(font, text));
+        if (it == entries_.end())
+            return nullptr;
+
+        it->second.last_used = ++tick_;
+        return &it->second.value;
+    }
+
+    T *Insert(OSDFont font, const std::string &text, T value)
+    {
+        Key key(font, text);
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            // The replaced value is not reachable afterwards
+            if (release_)
+                release_(it->second.value);
+        }
+        else if (entries_.size() >= capacity_)
+        {
+            EvictOldest();
+        }
+
+        Entry &entry = entries_[key];
+        entry.value = std::move(value);
+        entry.last_used = ++tick_;
+        return &entry.value;
+    }
+
+    void Clear()
+    {
+        if (release_)
+        {
+            for (auto &pair : entries_)
+                release_(pair.second.value);
+        }
+        entries_.clear();
+    }
+
+    size_t Size() const { return entries_.size(); }
+
+private:
+    using Key = std::pair<OSDFont, std::string>;
+
+    struct Entry
+    {
+        T value;
+        uint64_t last_used = 0;
+    };
+
+    void EvictOldest()
+    {
+        auto oldest = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (oldest == entries_.end() || it->second.last_used < oldest->second.last_used)
+                oldest = it;
+        }
+
+        if (oldest == entries_.end())
+            return;
+
+        if (release_)
+            release_(oldest->second.value);
+        entries_.erase(oldest);
+    }
+
+    std::map<Key, Entry> entries_;
+    size_t capacity_;
+    uint64_t tick_ = 0;
+    Release release_;
+};
+
+// =================================================================================================
+// OSDIconAtlas - Pre-rasterized OSDIcon set (8-bit coverage)
+// =================================================================================================
+// One row per icon size, one column per OSDIcon. The shapes follow OSDWindow::DrawIcon and
+// are antialiased with 4x4 supersampling once, backends upload the coverage as an alpha mask
+// (or tint it) and composite icons out of it instead of drawing polygons every frame.
+
+class OSDIconAtlas
+{
+public:
+    static constexpr int ICON_COUNT = VOLUME_MUTE + 1;
+
+    explicit OSDIconAtlas(const std::vector<int> &sizes);
+
+    /**
+     * Top-left corner of icon at size inside the atlas
+     * @return false if the size was not rasterized or icon is NONE
+     */
+    bool Lookup(OSDIcon icon, int size, int *x, int *y) const;
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+    // Width() * Height() bytes, 0 = transparent, 255 = fully covered
+    const uint8_t *Coverage() const { return coverage_.data(); }
+
+private:
+    void RasterizeIcon(OSDIcon icon, int size, int origin_x, int origin_y);
+
+    std::vector<int> sizes_;
+    std::vector<int> rows_; // Atlas y of each size
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<uint8_t> coverage_;
+};
+
+#endif // VLC_OS_OSD_CACHE_H
@@ -0,0 +1,428 @@
+#include "osd_surface.h"
+#include "window_base.h"
+#include "osd_blend.h"
+#include <cmath>
+#include <cstring>
+
+#ifdef DrawText
+#undef DrawText
+#endif
+
+// x / 255 rounded, exact for every product of two bytes
+static inline uint32_t Div255(uint32_t value)
+{
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+// =================================================================================================
+// OSDRect
+// =================================================================================================
+
+OSDRect OSDRect::Union(const OSDRect &other) const
+{
+    if (IsEmpty())
+        return other;
+    if (other.IsEmpty())
+        return *this;
+
+    int left = std::min(x, other.x);
+    int top = std::min(y, other.y);
+    int right = std::max(x + width, other.x + other.width);
+    int bottom = std::max(y + height, other.y + other.height);
+    return {left, top, right - left, bottom - top};
+}
+
+// =================================================================================================
+// OSDSurface
+// =================================================================================================
+
+void OSDSurface::Resize(int width, int height)
+{
+    width = std::max(width, 0);
+    height = std::max(height, 0);
+    if (width == width_ && height == height_)
+        return;
+
+    width_ = width;
+    height_ = height;
+    pixels_.assign(static_cast<size_t>(width_) * height_ * 4, 0);
+    content_ = {0, 0, 0, 0};
+}
+
+void OSDSurface::Clear()
+{
+    // Only what was drawn since the last clear can be non-transparent
+    for (int y = content_.y; y < content_.y + content_.height; y++)
+    {
+        memset(PixelAt(content_.x, y), 0, static_cast<size_t>(content_.width) * 4);
+    }
+    content_ = {0, 0, 0, 0};
+}
+
+OSDRect OSDSurface::Clip(const OSDRect &rect) const
+{
+    int left = std::max(rect.x, 0);
+    int top = std::max(rect.y, 0);
+    int right = std::min(rect.x + rect.width, width_);
+    int bottom = std::min(rect.y + rect.height, height_);
+    if (right <= left || bottom <= top)
+        return {0, 0, 0, 0};
+    return {left, top, right - left, bottom - top};
+}
+
+uint32_t OSDSurface::Premultiply(OSDRGBA color, uint8_t opacity)
+{
+    uint32_t alpha = Div255(color.a * opacity);
+    uint32_t red = Div255(color.r * alpha);
+    uint32_t green = Div255(color.g * alpha);
+    uint32_t blue = Div255(color.b * alpha);
+    return blue | (green << 8) | (red << 16) | (alpha << 24);
+}
+
+void OSDSurface::BlendPixel(uint8_t *pixel, uint32_t source, uint8_t coverage)
+{
+    uint32_t alpha = source >> 24;
+    if (coverage != 255)
+        alpha = Div255(alpha * coverage);
+    if (alpha == 0)
+        return;
+
+    uint32_t inverse = 255 - alpha;
+    for (int channel = 0; channel < 4; channel++)
+    {
+        uint32_t value = (source >> (channel * 8)) & 0xFF;
+        if (coverage != 255)
+            value = Div255(value * coverage);
+        pixel[channel] = static_cast<uint8_t>(value + Div255(pixel[channel] * inverse));
+    }
+}
+
+void OSDSurface::FillRect(int x, int y, int width, int height, OSDRGBA color, uint8_t opacity)
+{
+    OSDRect rect = Clip({x, y, width, height});
+    uint32_t source = Premultiply(color, opacity);
+    if (rect.IsEmpty() || (source >> 24) == 0)
+        return;
+
+    for (int py = rect.y; py < rect.y + rect.height; py++)
+    {
+        uint8_t *pixel = PixelAt(rect.x, py);
+        for (int px = 0; px < rect.width; px++, pixel += 4)
+        {
+            BlendPixel(pixel, source, 255);
+        }
+    }
+    MarkContent(rect);
+}
+
+void OSDSurface::FillRoundedRect(int x, int y, int width, int height, OSDRGBA color, uint8_t opacity, int radius)
+{
+    radius = std::min(radius, std::min(width, height) / 2);
+    if (radius <= 0)
+    {
+        FillRect(x, y, width, height, color, opacity);
+        return;
+    }
+
+    OSDRect rect = Clip({x, y, width, height});
+    uint32_t source = Premultiply(color, opacity);
+    if (rect.IsEmpty() || (source >> 24) == 0)
+        return;
+
+    // Coverage from the distance to the corner circle, a one pixel ramp is the antialiasing
+    float left = x + radius;
+    float right = x + width - radius;
+    float top = y + radius;
+    float bottom = y + height - radius;
+
+    for (int py = rect.y; py < rect.y + rect.height; py++)
+    {
+        uint8_t *pixel = PixelAt(rect.x, py);
+        for (int px = rect.x; px < rect.x + rect.width; px++, pixel += 4)
+        {
+            float cx = px + 0.5f;
+            float cy = py + 0.5f;
+            float dx = cx < left ? left - cx : (cx > right ? cx - right : 0.0f);
+            float dy = cy < top ? top - cy : (cy > bottom ? cy - bottom : 0.0f);
+
+            uint8_t coverage = 255;
+            if (dx > 0.0f && dy > 0.0f)
+            {
+                float edge = radius + 0.5f - std::sqrt(dx * dx + dy * dy);
+                if (edge <= 0.0f)
+                    continue;
+                if (edge < 1.0f)
+                    coverage = static_cast<uint8_t>(edge * 255.0f);
+            }
+            BlendPixel(pixel, source, coverage);
+        }
+    }
+    MarkContent(rect);
+}
+
+void OSDSurface::BlendMask(const uint8_t *mask, int mask_stride, int x, int y, int width, int height,
+                           OSDRGBA color, uint8_t opacity)
+{
+    if (!mask)
+        return;
+
+    OSDRect rect = Clip({x, y, width, height});
+    uint32_t source = Premultiply(color, opacity);
+    if (rect.IsEmpty() || (source >> 24) == 0)
+        return;
+
+    for (int py = rect.y; py < rect.y + rect.height; py++)
+    {
+        const uint8_t *coverage = mask + static_cast<size_t>(py - y) * mask_stride + (rect.x - x);
+        uint8_t *pixel = PixelAt(rect.x, py);
+        for (int px = 0; px < rect.width; px++, pixel += 4)
+        {
+            if (coverage[px])
+                BlendPixel(pixel, source, coverage[px]);
+        }
+    }
+    MarkContent(rect);
+}
+
+void OSDSurface::BlendImage(const uint8_t *bgrx, int image_stride, int x, int y, int width, int height,
+                            uint8_t opacity)
+{
+    OSDRect rect = Clip({x, y, width, height});
+    if (!bgrx || rect.IsEmpty() || opacity == 0)
+        return;
+
+    uint32_t inverse = 255 - opacity;
+    for (int py = rect.y; py < rect.y + rect.height; py++)
+    {
+        const uint8_t *source = bgrx + static_cast<size_t>(py - y) * image_stride + (rect.x - x) * 4;
+        uint8_t *pixel = PixelAt(rect.x, py);
+        for (int px = 0; px < rect.width; px++, pixel += 4, source += 4)
+        {
+            for (int channel = 0; channel < 3; channel++)
+                pixel[channel] = static_cast<uint8_t>(Div255(source[channel] * opacity) +
+                                                      Div255(pixel[channel] * inverse));
+            pixel[3] = static_cast<uint8_t>(opacity + Div255(pixel[3] * inverse));
+        }
+    }
+    MarkContent(rect);
+}
+
+std::shared_ptr<OSDSurface> OSDSurface::CropContent() const
+{
+    auto crop = std::make_shared<OSDSurface>();
+    if (!HasContent())
+        return crop;
+
+    crop->Resize(content_.width, content_.height);
+    crop->SetOrigin(origin_x_ + content_.x, origin_y_ + content_.y);
+    for (int y = 0; y < content_.height; y++)
+    {
+        memcpy(crop->PixelAt(0, y),
+               pixels_.data() + static_cast<size_t>(content_.y + y) * Stride() + content_.x * 4,
+               static_cast<size_t>(content_.width) * 4);
+    }
+    crop->content_ = {0, 0, content_.width, content_.height};
+    return crop;
+}
+
+void OSDSurface::BlendOnto(uint8_t *frame, int pitch, int width, int height) const
+{
+    if (!frame || !HasContent())
+        return;
+
+    // Content rect in frame coordinates, clipped to the frame
+    int left = std::max(origin_x_ + content_.x, 0);
+    int top = std::max(origin_y_ + content_.y, 0);
+    int right = std::min(origin_x_ + content_.x + content_.width, width);
+    int bottom = std::min(origin_y_ + content_.y + content_.height, height);
+
+    if (right <= left || bottom <= top)
+        return;
+
+    // SIMD kernel picked for this CPU at first use
+    OSDBlendRowFunc blend_row = GetOSDBlendRow();
+    for (int y = top; y < bottom; y++)
+    {
+        const uint8_t *source = pixels_.data() + static_cast<size_t>(y - origin_y_) * Stride() + (left - origin_x_) * 4;
+        uint8_t *target = frame + static_cast<size_t>(y) * pitch + left * 4;
+        blend_row(target, source, right - left);
+    }
+}
+
+// =================================================================================================
+// SurfaceOSDWindow
+// =================================================================================================
+
+SurfaceOSDWindow::SurfaceOSDWindow(OSWindow *window, OSDSurface *surface)
+    : OSDWindow(window), surface_(surface)
+{
+}
+
+void SurfaceOSDWindow::CreateWindowInternal(int x, int y)
+{
+    created_ = true;
+}
+
+void SurfaceOSDWindow::DestroyWindowInternal()
+{
+    created_ = false;
+}
+
+void SurfaceOSDWindow::MoveInternal(int x, int y)
+{
+    // Nothing moves by itself on a shared surface, the OSD has to be drawn at its new place
+    Invalidate();
+}
+
+void SurfaceOSDWindow::SetSizeInternal(int width, int height)
+{
+}
+
+void SurfaceOSDWindow::SetOpacityInternal(float opacity)
+{
+    opacity_ = static_cast<uint8_t>(std::clamp(opacity, 0.0f, 1.0f) * 255.0f);
+}
+
+OSDRGBA SurfaceOSDWindow::Color(OSDColor color) const
+{
+    OSDRGBA rgba = {0, 0, 0, 0};
+    window->GetColorRGBA(color, &rgba);
+    return rgba;
+}
+
+void SurfaceOSDWindow::ClearDrawable(int x, int y, int width, int height, OSDColor color)
+{
+    // The surface is cleared once per frame, an OSD background is blended so overlapping
+    // OSDs do not punch holes into each other
+    surface_->FillRect(SurfaceX(x), SurfaceY(y), width, height, Color(color), opacity_);
+}
+
+void SurfaceOSDWindow::DrawRoundedRect(int x, int y, int width, int height, OSDColor color, int radius)
+{
+    surface_->FillRoundedRect(SurfaceX(x), SurfaceY(y), width, height, Color(color), opacity_, radius);
+}
+
+void SurfaceOSDWindow::DrawPolygon(Point *points, int pointSize, OSDColor color)
+{
+    if (!points || pointSize < 3)
+        return;
+
+    std::vector<Point> shape(points, points + pointSize);
+    for (Point &point : shape)
+    {
+        point.x = SurfaceX(point.x);
+        point.y = SurfaceY(point.y);
+    }
+
+    int x0 = shape[0].x, x1 = shape[0].x, y0 = shape[0].y, y1 = shape[0].y;
+    for (const Point &point : shape)
+    {
+        x0 = std::min(x0, point.x);
+        x1 = std::max(x1, point.x);
+        y0 = std::min(y0, point.y);
+        y1 = std::max(y1, point.y);
+    }
+
+    // Even-odd crossing test against the pixel centre
+    surface_->FillShape(x0, y0, x1 + 1, y1 + 1, Color(color), opacity_, [&shape](float px, float py)
+                        {
+        bool inside = false;
+        for (size_t i = 0, j = shape.size() - 1; i < shape.size(); j = i++)
+        {
+            const Point &a = shape[i];
+            const Point &b = shape[j];
+            if ((a.y > py) != (b.y > py) &&
+                px < (float)(b.x - a.x) * (py - a.y) / (float)(b.y - a.y) + a.x)
+            {
+                inside = !inside;
+            }
+        }
+        return inside; });
+}
+
+void SurfaceOSDWindow::DrawArc(int x, int y, int width, int height,
+                               int startAngle, int endAngle, OSDColor color)
+{
+    // DrawIcon only uses full circles, drawn as a 2px ring like the GDI+ pen
+    float rx = width / 2.0f;
+    float ry = height / 2.0f;
+    float cx = SurfaceX(x) + rx;
+    float cy = SurfaceY(y) + ry;
+    float radius = std::min(rx, ry);
+    if (radius <= 0.0f)
+        return;
+
+    surface_->FillShape(SurfaceX(x) - 1, SurfaceY(y) - 1, SurfaceX(x) + width + 1, SurfaceY(y) + height + 1,
+                        Color(color), opacity_, [=](float px, float py)
+                        {
+        float nx = (px - cx) / rx;
+        float ny = (py - cy) / ry;
+        float distance = std::sqrt(nx * nx + ny * ny);
+        return std::fabs(distance - 1.0f) * radius <= 1.0f; });
+}
+
+void SurfaceOSDWindow::DrawLine(int x1, int y1, int x2, int y2, OSDColor color)
+{
+    float ax = SurfaceX(x1), ay = SurfaceY(y1);
+    float bx = SurfaceX(x2), by = SurfaceY(y2);
+    float vx = bx - ax, vy = by - ay;
+    float length_sq = vx * vx + vy * vy;
+
+    surface_->FillShape((int)std::min(ax, bx) - 1, (int)std::min(ay, by) - 1,
+                        (int)std::max(ax, bx) + 2, (int)std::max(ay, by) + 2,
+                        Color(color), opacity_, [=](float px, float py)
+                        {
+        float t = length_sq > 0.0f ? ((px - ax) * vx + (py - ay) * vy) / length_sq : 0.0f;
+        t = std::clamp(t, 0.0f, 1.0f);
+        float dx = px - (ax + vx * t);
+        float dy = py - (ay + vy * t);
+        return dx * dx + dy * dy <= 1.0f; });
+}
+
+void SurfaceOSDWindow::DrawCircle(int x, int y, int radius, OSDColor color)
+{
+    float cx = SurfaceX(x) + 0.5f;
+    float cy = SurfaceY(y) + 0.5f;
+    float radius_sq = static_cast<float>(radius * radius);
+
+    surface_->FillShape(SurfaceX(x) - radius, SurfaceY(y) - radius,
+                        SurfaceX(x) + radius + 1, SurfaceY(y) + radius + 1,
+                        Color(color), opacity_, [=](float px, float py)
+                        { return (px - cx) * (px - cx) + (py - cy) * (py - cy) <= radius_sq; });
+}
+
+void SurfaceOSDWindow::DrawText(const std::string &text, int x, int y, OSDColor color, OSDFont font)
+{
+    if (text.empty())
+        return;
+
+    OSDCoverage coverage;
+    if (!window->GetTextCoverage(font, text, &coverage))
+        return;
+
+    surface_->BlendMask(coverage.pixels, coverage.stride,
+                        SurfaceX(x) - coverage.origin_x, SurfaceY(y),
+                        coverage.width, coverage.height, Color(color), opacity_);
+}
+
+void SurfaceOSDWindow::DrawIcon(const OSDIcon &icon, int x, int y, int size, OSDColor color)
+{
+    const OSDIconAtlas &atlas = window->GetIconAtlas();
+    int atlas_x = 0, atlas_y = 0;
+    if (!atlas.Lookup(icon, size, &atlas_x, &atlas_y))
+    {
+        // Size not in the atlas, vector path
+        OSDWindow::DrawIcon(icon, x, y, size, color);
+        return;
+    }
+
+    const uint8_t *cell = atlas.Coverage() + static_cast<size_t>(atlas_y) * atlas.Width() + atlas_x;
+    surface_->BlendMask(cell, atlas.Width(), SurfaceX(x), SurfaceY(y), size, size, Color(color), opacity_);
+}
+
+void SurfaceOSDWindow::DrawImage(const OSDImage &image, int x, int y)
+{
+    surface_->BlendImage(image.pixels.data(), image.width * 4, SurfaceX(x), SurfaceY(y),
+                         image.width, image.height, opacity_);
+}
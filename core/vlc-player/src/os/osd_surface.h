@@ -0,0 +1,174 @@
+#ifndef VLC_OS_OSD_SURFACE_H
+#define VLC_OS_OSD_SURFACE_H
+
+#include "base_osd.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+// =================================================================================================
+// OSDSurface - Single ARGB buffer every OSD is composited into
+// =================================================================================================
+// Pixels are premultiplied 32-bit BGRA in memory order, which is what an X11 ARGB32 visual, a
+// Win32 DIB section and libVLC's RV32/BGRA vmem chromas all use on little-endian hosts, so a
+// present is a straight upload and the frame overlay a straight blend.
+//
+// The surface tracks the bounding rect of everything drawn since the last Clear(), which is
+// both what Clear() wipes and what a present has to upload.
+
+struct OSDRGBA
+{
+    uint8_t r, g, b, a; // Straight (not premultiplied) alpha
+};
+
+struct OSDRect
+{
+    int x, y, width, height;
+
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+    OSDRect Union(const OSDRect &other) const;
+};
+
+// A8 coverage of a text run (see OSWindow::GetTextCoverage)
+struct OSDCoverage
+{
+    const uint8_t *pixels = nullptr;
+    int stride = 0;
+    int width = 0;
+    int height = 0;
+    int origin_x = 0; // Ink left of the pen origin
+};
+
+class OSDSurface
+{
+public:
+    void Resize(int width, int height);
+    void Clear();
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+    int Stride() const { return width_ * 4; }
+    const uint8_t *Pixels() const { return pixels_.data(); }
+
+    // Position of the top-left pixel: screen space for the composite (OSDs are laid out there),
+    // frame space for the vmem overlay
+    void SetOrigin(int x, int y)
+    {
+        origin_x_ = x;
+        origin_y_ = y;
+    }
+    int OriginX() const { return origin_x_; }
+    int OriginY() const { return origin_y_; }
+
+    bool HasContent() const { return !content_.IsEmpty(); }
+    const OSDRect &ContentRect() const { return content_; }
+
+    // Source-over primitives, opacity (0-255) multiplies the color's alpha
+    void FillRect(int x, int y, int width, int height, OSDRGBA color, uint8_t opacity);
+    void FillRoundedRect(int x, int y, int width, int height, OSDRGBA color, uint8_t opacity, int radius);
+    void BlendMask(const uint8_t *mask, int mask_stride, int x, int y, int width, int height,
+                   OSDRGBA color, uint8_t opacity);
+    // Opaque BGRX picture, opacity (0-255) makes it translucent
+    void BlendImage(const uint8_t *bgrx, int image_stride, int x, int y, int width, int height,
+                    uint8_t opacity);
+
+    /**
+     * Fill the pixels of [x0, x1) x [y0, y1) whose centre satisfies inside(px, py)
+     * Unantialiased, only used by the vector icon fallback
+     */
+    template <typename Inside>
+    void FillShape(int x0, int y0, int x1, int y1, OSDRGBA color, uint8_t opacity, Inside inside)
+    {
+        OSDRect rect = Clip({x0, y0, x1 - x0, y1 - y0});
+        uint32_t source = Premultiply(color, opacity);
+        if (rect.IsEmpty() || (source >> 24) == 0)
+            return;
+
+        for (int y = rect.y; y < rect.y + rect.height; y++)
+        {
+            for (int x = rect.x; x < rect.x + rect.width; x++)
+            {
+                if (inside(x + 0.5f, y + 0.5f))
+                    BlendPixel(PixelAt(x, y), source, 255);
+            }
+        }
+        MarkContent(rect);
+    }
+
+    /**
+     * Copy of the content rect only, its origin moved so it still lands on the same pixels
+     */
+    std::shared_ptr<OSDSurface> CropContent() const;
+
+    /**
+     * Blend the surface (source-over) onto a 32-bit BGRX/BGRA frame, the surface origin being
+     * the frame position of its top-left pixel. Only the content rect is touched and the
+     * frame's alpha byte is left as it is.
+     */
+    void BlendOnto(uint8_t *frame, int pitch, int width, int height) const;
+
+private:
+    static uint32_t Premultiply(OSDRGBA color, uint8_t opacity);
+    static void BlendPixel(uint8_t *pixel, uint32_t source, uint8_t coverage);
+
+    uint8_t *PixelAt(int x, int y) { return pixels_.data() + static_cast<size_t>(y) * Stride() + x * 4; }
+    OSDRect Clip(const OSDRect &rect) const;
+    void MarkContent(const OSDRect &rect) { content_ = content_.Union(rect); }
+
+    std::vector<uint8_t> pixels_;
+    int width_ = 0;
+    int height_ = 0;
+    int origin_x_ = 0;
+    int origin_y_ = 0;
+    OSDRect content_ = {0, 0, 0, 0};
+};
+
+// =================================================================================================
+// SurfaceOSDWindow - OSDWindow drawing into the shared OSDSurface instead of its own window
+// =================================================================================================
+// Layout, fades and damage tracking are the regular OSDWindow ones. There is no native window,
+// Flush() is a no-op and OSWindow presents the whole surface once per frame.
+
+class SurfaceOSDWindow : public OSDWindow
+{
+public:
+    SurfaceOSDWindow(OSWindow *window, OSDSurface *surface);
+
+    bool isWindowCreated() const override { return created_; }
+    void Flush() override {}
+
+protected:
+    void CreateWindowInternal(int x, int y) override;
+    void DestroyWindowInternal() override;
+    void MoveInternal(int x, int y) override;
+    void SetSizeInternal(int width, int height) override;
+    void SetOpacityInternal(float opacity) override;
+
+    void DrawRoundedRect(int x, int y, int width, int height,
+                         OSDColor color, int radius) override;
+    void DrawPolygon(Point *points, int pointSize, OSDColor color) override;
+    void DrawArc(int x, int y, int width, int height,
+                 int startAngle, int endAngle, OSDColor color) override;
+    void DrawLine(int x1, int y1, int x2, int y2, OSDColor color) override;
+    void DrawCircle(int x, int y, int radius, OSDColor color) override;
+    void ClearDrawable(int x, int y, int width, int height, OSDColor color) override;
+    void DrawText(const std::string &text, int x, int y,
+                  OSDColor color, OSDFont font) override;
+    void DrawIcon(const OSDIcon &icon, int x, int y,
+                  int size, OSDColor color) override;
+    void DrawImage(const OSDImage &image, int x, int y) override;
+
+private:
+    // OSD-local to surface coordinates
+    int SurfaceX(int local_x) const { return x() - surface_->OriginX() + local_x; }
+    int SurfaceY(int local_y) const { return y() - surface_->OriginY() + local_y; }
+    OSDRGBA Color(OSDColor color) const;
+
+    OSDSurface *surface_;
+    bool created_ = false;
+    uint8_t opacity_ = 0;
+};
+
+#endif // VLC_OS_OSD_SURFACE_H
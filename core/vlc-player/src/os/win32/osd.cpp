@@ -1,7 +1,9 @@
 #include "osd.h"
-#include "../window_base.h"
+#include "window.h"
+#include "../osd_surface.h"
 #include "../../vlc_player.h"
 #include <algorithm>
+#include <cstring>
 
 // Win32 window class name for OSD windows
 static const wchar_t* OSD_WINDOW_CLASS = L"VLC_OSD_Window";
@@ -228,6 +230,23 @@ void Win32OSDWindow::Flush()
     UpdateLayeredWindow();
 }
 
+void Win32OSDWindow::PresentSurface(const OSDSurface &surface, const OSDRect &dirty)
+{
+    if (!bitmap_bits_ || surface.Width() != width() || surface.Height() != height())
+        return;
+
+    // Same layout as the DIB section (top-down, premultiplied BGRA), copy the damaged rows only
+    uint8_t *bits = static_cast<uint8_t *>(bitmap_bits_);
+    for (int y = dirty.y; y < dirty.y + dirty.height; y++)
+    {
+        size_t offset = static_cast<size_t>(y) * surface.Stride() + dirty.x * 4;
+        memcpy(bits + offset, surface.Pixels() + offset, dirty.width * 4);
+    }
+
+    GdiFlush();
+    UpdateLayeredWindow();
+}
+
 void Win32OSDWindow::UpdateLayeredWindow()
 {
     if (!isWindowCreated() || !mem_dc_)
@@ -372,6 +391,14 @@ void Win32OSDWindow::DrawText(const std::string &text, int x, int y,
     if (!graphics_ || text.empty())
         return;
 
+    // Steady state: one blit of the cached run
+    Win32Window *win32_window = static_cast<Win32Window *>(window);
+    if (Gdiplus::Bitmap *run = win32_window->GetTextRun(font, text, color))
+    {
+        graphics_->DrawImage(run, x, y, (INT)run->GetWidth(), (INT)run->GetHeight());
+        return;
+    }
+
     Gdiplus::Color* gdi_color = GetGdiplusColor(color);
     Gdiplus::SolidBrush brush(*gdi_color);
 
@@ -388,6 +415,36 @@ void Win32OSDWindow::DrawText(const std::string &text, int x, int y,
     delete[] wtext;
 }
 
+void Win32OSDWindow::DrawIcon(const OSDIcon &icon, int x, int y, int size, OSDColor color)
+{
+    if (!graphics_)
+        return;
+
+    Win32Window *win32_window = static_cast<Win32Window *>(window);
+    Gdiplus::Bitmap *atlas_bitmap = win32_window->GetIconAtlasBitmap(color);
+    int atlas_x = 0, atlas_y = 0;
+    if (!atlas_bitmap || !window->GetIconAtlas().Lookup(icon, size, &atlas_x, &atlas_y))
+    {
+        // Size not in the atlas, vector path
+        OSDWindow::DrawIcon(icon, x, y, size, color);
+        return;
+    }
+
+    Gdiplus::Rect destination(x, y, size, size);
+    graphics_->DrawImage(atlas_bitmap, destination, atlas_x, atlas_y, size, size, Gdiplus::UnitPixel);
+}
+
+void Win32OSDWindow::DrawImage(const OSDImage &image, int x, int y)
+{
+    if (!graphics_ || image.pixels.empty())
+        return;
+
+    // Wraps the pixels, the fade is applied when the layered window is updated
+    Gdiplus::Bitmap bitmap(image.width, image.height, image.width * 4, PixelFormat32bppRGB,
+                           const_cast<BYTE *>(image.pixels.data()));
+    graphics_->DrawImage(&bitmap, x, y, image.width, image.height);
+}
+
 // =================================================================================================
 // Helper Conversions
 // =================================================================================================
@@ -26,6 +26,9 @@ public:
     // Buffer flush
     void Flush() override;
 
+    // Single-surface compositing (OSWindow's overlay window)
+    void PresentSurface(const OSDSurface &surface, const OSDRect &dirty) override;
+
 protected:
     // Window lifecycle
     void CreateWindowInternal(int x, int y) override;
@@ -45,6 +48,9 @@ protected:
     void ClearDrawable(int x, int y, int width, int height, OSDColor color) override;
     void DrawText(const std::string &text, int x, int y,
                   OSDColor color, OSDFont font) override;
+    void DrawIcon(const OSDIcon &icon, int x, int y,
+                  int size, OSDColor color) override;
+    void DrawImage(const OSDImage &image, int x, int y) override;
 
 private:
     HWND hwnd_;                          // Layered window handle
@@ -98,6 +98,11 @@ Win32Window::~Win32Window()
 {
     VlcPlayer::Log("Win32Window destructor started");
     Destroy();
+    if (message_wake_event_)
+    {
+        CloseHandle(message_wake_event_);
+        message_wake_event_ = nullptr;
+    }
     VlcPlayer::Log("Win32Window destructor completed");
 }
 
@@ -122,9 +127,14 @@ bool Win32Window::Create(int width, int height)
 
     // Start message pump thread
     VlcPlayer::Log("Starting message pump thread...");
+    if (!message_wake_event_)
+    {
+        message_wake_event_ = CreateEventW(NULL, FALSE, FALSE, NULL);
+    }
     message_thread_running_ = true;
     message_thread_ = std::thread([this, width, height]()
                                   {
+        Trace::SetThreadName("win32-messages");
         VlcPlayer::Log("Message pump thread started");
         // Store thread ID for debugging
         window_thread_id_ = GetCurrentThreadId();
@@ -198,7 +208,7 @@ bool Win32Window::Create(int width, int height)
         boldFont = CreateOSDFont(true);
 
         VlcPlayer::Log("Starting message loop...");
-        // Message loop (~60fps with 16ms sleep)
+        // Message loop: sleeps until a message arrives or Destroy() signals the wake event
         MSG msg;
         while (message_thread_running_)
         {
@@ -209,10 +219,17 @@ bool Win32Window::Create(int width, int height)
                     message_thread_running_ = false;
                     return;
                 }
+                TRACE_SCOPE("win32.message");
                 TranslateMessage(&msg);
                 DispatchMessage(&msg);
             }
-            Sleep(16); // ~60fps
+
+            if (!message_thread_running_)
+                break;
+
+            // MWMO_INPUTAVAILABLE: also return for input that arrived before the wait began
+            MsgWaitForMultipleObjectsEx(message_wake_event_ ? 1 : 0, &message_wake_event_, INFINITE,
+                                        QS_ALLINPUT, MWMO_INPUTAVAILABLE);
         } });
 
     // Wait for window creation (timeout after 5 seconds)
@@ -226,6 +243,13 @@ bool Win32Window::Create(int width, int height)
         if (std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() >= 5)
         {
             message_thread_running_ = false;
+
+            // The loop may already sit in MsgWaitForMultipleObjectsEx
+            if (message_wake_event_)
+            {
+                SetEvent(message_wake_event_);
+            }
+
             if (message_thread_.joinable())
             {
                 message_thread_.join();
@@ -247,6 +271,12 @@ void Win32Window::Destroy()
     {
         message_thread_running_ = false;
 
+        // Wake the loop out of MsgWaitForMultipleObjectsEx
+        if (message_wake_event_)
+        {
+            SetEvent(message_wake_event_);
+        }
+
         // Send WM_QUIT to exit message loop
         if (hwnd_)
         {
@@ -267,6 +297,9 @@ void Win32Window::Destroy()
         media_player_ = nullptr;
     }
 
+    // Cleanup OSD raster caches (GDI+ objects, before shutdown)
+    ReleaseOSDCaches();
+
     // Cleanup fonts
     for (auto *font : fonts_)
     {
@@ -548,6 +581,174 @@ Dimension Win32Window::MeasureText(OSDFont font, const std::string &text)
     return {(int)boundingBox.Width, (int)boundingBox.Height};
 }
 
+// =================================================================================================
+// OSD Raster Caches
+// =================================================================================================
+
+Gdiplus::Bitmap *Win32Window::RasterizeText(OSDFont font, const std::string &text, const Gdiplus::Color &color)
+{
+    Dimension size = MeasureText(font, text);
+    if (size.width <= 0 || size.height <= 0)
+        return nullptr;
+
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, NULL, 0);
+    if (wlen <= 0)
+        return nullptr;
+
+    wchar_t *wtext = new wchar_t[wlen];
+    MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, wtext, wlen);
+
+    // MeasureText truncates, keep the fractional pixel of the last glyph
+    auto *bitmap = new Gdiplus::Bitmap(size.width + 1, size.height + 1, PixelFormat32bppPARGB);
+    if (bitmap->GetLastStatus() != Gdiplus::Ok)
+    {
+        delete bitmap;
+        delete[] wtext;
+        return nullptr;
+    }
+
+    {
+        Gdiplus::Graphics graphics(bitmap);
+        graphics.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAlias);
+        graphics.Clear(Gdiplus::Color(0, 0, 0, 0));
+
+        Gdiplus::SolidBrush brush(color);
+        graphics.DrawString(wtext, -1, static_cast<Gdiplus::Font *>(font), Gdiplus::PointF(0, 0), &brush);
+    }
+    delete[] wtext;
+
+    return bitmap;
+}
+
+Gdiplus::Bitmap *Win32Window::GetTextRun(OSDFont font, const std::string &text, OSDColor color)
+{
+    if (!font || !color || text.empty())
+        return nullptr;
+
+    TextRun *run = text_runs_.Find(font, text);
+    if (run && run->bitmap && run->color == color)
+        return run->bitmap;
+
+    Gdiplus::Bitmap *bitmap = RasterizeText(font, text, *static_cast<Gdiplus::Color *>(color));
+    if (!bitmap)
+        return nullptr;
+
+    if (run)
+    {
+        delete run->bitmap;
+        run->bitmap = bitmap;
+        run->color = color;
+        return bitmap;
+    }
+
+    TextRun fresh;
+    fresh.bitmap = bitmap;
+    fresh.color = color;
+    return text_runs_.Insert(font, text, fresh)->bitmap;
+}
+
+bool Win32Window::GetTextCoverage(OSDFont font, const std::string &text, OSDCoverage *coverage)
+{
+    if (!font || text.empty())
+        return false;
+
+    TextRun *run = text_runs_.Find(font, text);
+    if (!run || run->coverage.empty())
+    {
+        Gdiplus::Bitmap *bitmap = RasterizeText(font, text, Gdiplus::Color(255, 255, 255, 255));
+        if (!bitmap)
+            return false;
+
+        int width = static_cast<int>(bitmap->GetWidth());
+        int height = static_cast<int>(bitmap->GetHeight());
+        Gdiplus::Rect rect(0, 0, width, height);
+        Gdiplus::BitmapData data;
+        if (bitmap->LockBits(&rect, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &data) != Gdiplus::Ok)
+        {
+            delete bitmap;
+            return false;
+        }
+
+        // Drawn in opaque white, so the alpha byte is the coverage
+        std::vector<uint8_t> alpha(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t *row = static_cast<const uint8_t *>(data.Scan0) + y * data.Stride;
+            for (int x = 0; x < width; x++)
+            {
+                alpha[static_cast<size_t>(y) * width + x] = row[x * 4 + 3];
+            }
+        }
+        bitmap->UnlockBits(&data);
+        delete bitmap;
+
+        if (!run)
+            run = text_runs_.Insert(font, text, TextRun());
+        run->coverage = std::move(alpha);
+        run->coverage_width = width;
+        run->coverage_height = height;
+    }
+
+    coverage->pixels = run->coverage.data();
+    coverage->stride = run->coverage_width;
+    coverage->width = run->coverage_width;
+    coverage->height = run->coverage_height;
+    coverage->origin_x = 0;
+    return true;
+}
+
+Gdiplus::Bitmap *Win32Window::GetIconAtlasBitmap(OSDColor color)
+{
+    if (!color)
+        return nullptr;
+
+    if (icon_atlas_bitmap_ && icon_atlas_color_ == color)
+        return icon_atlas_bitmap_;
+
+    const OSDIconAtlas &atlas = GetIconAtlas();
+    auto *bitmap = new Gdiplus::Bitmap(atlas.Width(), atlas.Height(), PixelFormat32bppPARGB);
+
+    Gdiplus::Rect rect(0, 0, atlas.Width(), atlas.Height());
+    Gdiplus::BitmapData data;
+    if (bitmap->GetLastStatus() != Gdiplus::Ok ||
+        bitmap->LockBits(&rect, Gdiplus::ImageLockModeWrite, PixelFormat32bppPARGB, &data) != Gdiplus::Ok)
+    {
+        delete bitmap;
+        return nullptr;
+    }
+
+    // Premultiplied BGRA, coverage scales the color's own alpha
+    const Gdiplus::Color *tint = static_cast<Gdiplus::Color *>(color);
+    const uint8_t *coverage = atlas.Coverage();
+    for (int y = 0; y < atlas.Height(); y++)
+    {
+        auto *row = reinterpret_cast<uint8_t *>(data.Scan0) + y * data.Stride;
+        for (int x = 0; x < atlas.Width(); x++)
+        {
+            uint32_t alpha = tint->GetA() * coverage[y * atlas.Width() + x] / 255;
+            row[x * 4 + 0] = static_cast<uint8_t>(tint->GetB() * alpha / 255);
+            row[x * 4 + 1] = static_cast<uint8_t>(tint->GetG() * alpha / 255);
+            row[x * 4 + 2] = static_cast<uint8_t>(tint->GetR() * alpha / 255);
+            row[x * 4 + 3] = static_cast<uint8_t>(alpha);
+        }
+    }
+    bitmap->UnlockBits(&data);
+
+    delete icon_atlas_bitmap_;
+    icon_atlas_bitmap_ = bitmap;
+    icon_atlas_color_ = color;
+    return icon_atlas_bitmap_;
+}
+
+void Win32Window::ReleaseOSDCaches()
+{
+    text_runs_.Clear();
+
+    delete icon_atlas_bitmap_;
+    icon_atlas_bitmap_ = nullptr;
+    icon_atlas_color_ = nullptr;
+}
+
 // =================================================================================================
 // OSD Management
 // =================================================================================================
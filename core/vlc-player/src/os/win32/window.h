@@ -50,6 +50,24 @@ public:
 
     Dimension MeasureText(OSDFont font, const std::string &text) override;
 
+    // =================================================================================================
+    // OSD Raster Caches (render thread, under the OSD lock)
+    // =================================================================================================
+
+    /**
+     * text drawn once into a premultiplied bitmap per (font, string), redrawn if color changes
+     * @return nullptr if the bitmap could not be allocated
+     */
+    Gdiplus::Bitmap *GetTextRun(OSDFont font, const std::string &text, OSDColor color);
+
+    /**
+     * GetIconAtlas() tinted with color into a premultiplied bitmap, nullptr on failure
+     */
+    Gdiplus::Bitmap *GetIconAtlasBitmap(OSDColor color);
+
+    // Single-surface compositing: alpha of the string drawn in white, extracted once
+    bool GetTextCoverage(OSDFont font, const std::string &text, OSDCoverage *coverage) override;
+
 protected:
     // =================================================================================================
     // Color/Font Management (OSWindow abstract methods)
@@ -109,6 +127,25 @@ private:
     std::vector<Gdiplus::Color *> colors_;
     std::vector<Gdiplus::Font *> fonts_;
 
+    // OSD raster caches
+    struct TextRun
+    {
+        Gdiplus::Bitmap *bitmap = nullptr;
+        OSDColor color = nullptr;
+        std::vector<uint8_t> coverage; // GetTextCoverage() copy, color independent
+        int coverage_width = 0;
+        int coverage_height = 0;
+    };
+
+    Gdiplus::Bitmap *RasterizeText(OSDFont font, const std::string &text, const Gdiplus::Color &color);
+
+    static constexpr size_t TEXT_RUN_CACHE_SIZE = 64;
+    OSDTextCache<TextRun> text_runs_{TEXT_RUN_CACHE_SIZE, [](TextRun &run)
+                                     { delete run.bitmap; }};
+    Gdiplus::Bitmap *icon_atlas_bitmap_ = nullptr;
+    OSDColor icon_atlas_color_ = nullptr;
+    void ReleaseOSDCaches();
+
     // Context menu tracking
     std::map<UINT, MenuItem> menu_item_map_;
     UINT next_menu_id_;
@@ -116,6 +153,7 @@ private:
     // Message pump thread
     std::thread message_thread_;
     std::atomic<bool> message_thread_running_{false};
+    HANDLE message_wake_event_ = nullptr; // Auto-reset, signaled by Destroy()
     DWORD window_thread_id_;
 
     // =================================================================================================
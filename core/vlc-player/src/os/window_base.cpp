@@ -28,7 +28,12 @@ std::shared_ptr<OSDWindow> OSWindow::FindOrCreateOSD(OSDType type, bool allow_vi
     // Not found, create new
     try
     {
-        auto osd = CreateOSDWindow();
+        // Composited OSDs draw into the shared surface instead of owning a native window
+        std::shared_ptr<OSDWindow> osd;
+        if (IsOSDCompositing())
+            osd = std::make_shared<SurfaceOSDWindow>(this, &osd_surface_);
+        else
+            osd = CreateOSDWindow();
         if (!osd)
         {
             VlcPlayer::Log("ERROR: CreateOSDWindow returned null for type %d", (int)type);
@@ -50,7 +55,7 @@ std::shared_ptr<OSDWindow> OSWindow::FindOrCreateOSD(OSDType type, bool allow_vi
  */
 void OSWindow::ShowVolumeOSD(float progress)
 {
-    if (!IsCreated() || !IsVisible())
+    if (!CanShowOSD())
     {
         VlcPlayer::Log("Window not created or not visible, skipping OSD");
         return;
@@ -63,21 +68,26 @@ void OSWindow::ShowVolumeOSD(float progress)
         return;
     }
 
-    auto now = std::chrono::steady_clock::now();
-
-    // Skip fade_in if already visible
-    if (osd->IsCurrentlyVisible(now))
-    {
-        osd->SetCreatedAt(now - std::chrono::milliseconds(200));
-    }
-    else
     {
-        osd->SetCreatedAt(now);
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        // Skip fade_in if already visible
+        if (osd->IsCurrentlyVisible(now))
+        {
+            osd->SetCreatedAt(now - std::chrono::milliseconds(200));
+        }
+        else
+        {
+            osd->SetCreatedAt(now);
+        }
+
+        // Text is auto-generated inside SetData for VOLUME type
+        osd->SetData("", "", progress,
+                     progress == 0.0f ? OSDIcon::VOLUME_MUTE : OSDIcon::VOLUME_UP);
     }
 
-    // Text is auto-generated inside SetData for VOLUME type
-    osd->SetData("", "", progress,
-                 progress == 0.0f ? OSDIcon::VOLUME_MUTE : OSDIcon::VOLUME_UP);
+    WakeOSDRenderLoop();
 }
 
 /**
@@ -85,7 +95,7 @@ void OSWindow::ShowVolumeOSD(float progress)
  */
 void OSWindow::ShowSeekOSD(int64_t time, int64_t duration)
 {
-    if (!IsCreated() || !IsVisible())
+    if (!CanShowOSD())
         return;
 
     auto osd = FindOrCreateOSD(OSDType::SEEK, true);
@@ -100,20 +110,42 @@ void OSWindow::ShowSeekOSD(int64_t time, int64_t duration)
     // Calculate progress
     float progress = (duration > 0) ? static_cast<float>(time) / duration : 0.0f;
 
-    auto now = std::chrono::steady_clock::now();
-
-    // Skip fade_in if already visible
-    if (osd->IsCurrentlyVisible(now))
     {
-        osd->SetCreatedAt(now - std::chrono::milliseconds(200));
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        // Skip fade_in if already visible
+        if (osd->IsCurrentlyVisible(now))
+        {
+            osd->SetCreatedAt(now - std::chrono::milliseconds(200));
+        }
+        else
+        {
+            osd->SetCreatedAt(now);
+        }
+
+        // time_display goes to subtext for SEEK type
+        osd->SetData("", time_display, progress, OSDIcon::NONE);
     }
-    else
+
+    WakeOSDRenderLoop();
+}
+
+void OSWindow::SetSeekPreview(std::shared_ptr<const OSDImage> image)
+{
+    if (!CanShowOSD())
+        return;
+
+    auto osd = FindOrCreateOSD(OSDType::SEEK, true);
+    if (!osd)
+        return;
+
     {
-        osd->SetCreatedAt(now);
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        osd->SetPreview(std::move(image));
     }
 
-    // time_display goes to subtext for SEEK type
-    osd->SetData("", time_display, progress, OSDIcon::NONE);
+    WakeOSDRenderLoop();
 }
 
 /**
@@ -121,7 +153,7 @@ void OSWindow::ShowSeekOSD(int64_t time, int64_t duration)
  */
 void OSWindow::ShowPlaybackOSD(const std::string &state)
 {
-    if (!IsCreated() || !IsVisible())
+    if (!CanShowOSD())
         return;
 
     auto osd = FindOrCreateOSD(OSDType::PLAYBACK, true);
@@ -153,19 +185,24 @@ void OSWindow::ShowPlaybackOSD(const std::string &state)
         icon = OSDIcon::NONE;
     }
 
-    auto now = std::chrono::steady_clock::now();
-
-    // Skip fade_in if already visible
-    if (osd->IsCurrentlyVisible(now))
     {
-        osd->SetCreatedAt(now - std::chrono::milliseconds(200));
-    }
-    else
-    {
-        osd->SetCreatedAt(now);
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        // Skip fade_in if already visible
+        if (osd->IsCurrentlyVisible(now))
+        {
+            osd->SetCreatedAt(now - std::chrono::milliseconds(200));
+        }
+        else
+        {
+            osd->SetCreatedAt(now);
+        }
+
+        osd->SetData(text, "", 0.0f, icon);
     }
 
-    osd->SetData(text, "", 0.0f, icon);
+    WakeOSDRenderLoop();
 }
 
 /**
@@ -173,7 +210,7 @@ void OSWindow::ShowPlaybackOSD(const std::string &state)
  */
 void OSWindow::ShowNotificationOSD(const std::string &text, OSDIcon icon)
 {
-    if (!IsCreated() || !IsVisible())
+    if (!CanShowOSD())
         return;
 
     // Never reuse visible notifications (allow_visible_reuse = false)
@@ -181,20 +218,43 @@ void OSWindow::ShowNotificationOSD(const std::string &text, OSDIcon icon)
     if (!osd)
         return;
 
-    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(osd_mutex_);
 
-    // Always start fresh (no fade_in skip for notifications)
-    osd->SetCreatedAt(now);
-    osd->SetData(text, "", 0.0f, icon);
+        // Always start fresh (no fade_in skip for notifications)
+        osd->SetCreatedAt(std::chrono::steady_clock::now());
+        osd->SetData(text, "", 0.0f, icon);
+    }
+
+    WakeOSDRenderLoop();
+}
+
+Dimension OSWindow::MeasureTextCached(OSDFont font, const std::string &text)
+{
+    if (Dimension *cached = text_measure_cache_.Find(font, text))
+        return *cached;
+
+    return *text_measure_cache_.Insert(font, text, MeasureText(font, text));
+}
+
+const OSDIconAtlas &OSWindow::GetIconAtlas()
+{
+    if (!icon_atlas_)
+    {
+        icon_atlas_ = std::make_unique<OSDIconAtlas>(
+            std::vector<int>{OSDWindow::ICON_SIZE_SMALL, OSDWindow::ICON_SIZE_LARGE});
+    }
+    return *icon_atlas_;
 }
 
 void OSWindow::ClearOSDs()
 {
     std::lock_guard<std::mutex> lock(osd_mutex_);
+    DestroyOSDsLocked();
+}
 
-    if (active_osds_.empty())
-        return;
-
+void OSWindow::DestroyOSDsLocked()
+{
     for (auto &osd : active_osds_)
     {
         if (osd && osd->isWindowCreated())
@@ -202,12 +262,144 @@ void OSWindow::ClearOSDs()
             osd->Destroy();
         }
     }
-
     active_osds_.clear();
+
+    if (osd_overlay_window_)
+    {
+        osd_overlay_window_->Destroy();
+        osd_overlay_window_.reset();
+    }
+    osd_surface_.Clear();
+    osd_presented_rect_ = {0, 0, 0, 0};
+
+    std::lock_guard<std::mutex> frame_lock(osd_frame_mutex_);
+    osd_frame_snapshot_.reset();
+}
+
+// =================================================================================================
+// OSD Compositing
+// =================================================================================================
+
+void OSWindow::SetOSDSurfaceMode(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        if (osd_surface_mode_ == enabled)
+            return;
+
+        // Existing OSDs were built for the other mode
+        DestroyOSDsLocked();
+        osd_surface_mode_ = enabled;
+    }
+    WakeOSDRenderLoop();
+}
+
+void OSWindow::SetOSDFrameOverlay(bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        if (osd_frame_overlay_ == enabled)
+            return;
+
+        DestroyOSDsLocked();
+        osd_frame_overlay_ = enabled;
+    }
+    WakeOSDRenderLoop();
+}
+
+void OSWindow::SetOSDFrameSize(unsigned width, unsigned height)
+{
+    {
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        if (osd_frame_width_ == width && osd_frame_height_ == height)
+            return;
+
+        osd_frame_width_ = width;
+        osd_frame_height_ = height;
+    }
+    WakeOSDRenderLoop();
+}
+
+std::shared_ptr<const OSDSurface> OSWindow::GetOSDFrameOverlay()
+{
+    std::lock_guard<std::mutex> lock(osd_frame_mutex_);
+    return osd_frame_snapshot_;
+}
+
+WindowBounds OSWindow::GetOSDBounds() const
+{
+    // The frame overlay lays OSDs out on the video frame itself
+    if (osd_frame_overlay_)
+        return {0, 0, static_cast<int>(osd_frame_width_), static_cast<int>(osd_frame_height_)};
+
+    return GetClientArea();
+}
+
+void OSWindow::CompositeOSDSurface(const WindowBounds &bounds)
+{
+    TRACE_SCOPE("osd.composite");
+    bool resized = osd_surface_.Width() != bounds.width || osd_surface_.Height() != bounds.height;
+    bool damaged = resized || osd_surface_.OriginX() != bounds.x || osd_surface_.OriginY() != bounds.y;
+    for (auto &osd : active_osds_)
+    {
+        damaged = damaged || osd->IsDirty();
+    }
+
+    if (!damaged)
+        return;
+
+    // One damaged OSD means a full redraw, they share the surface
+    osd_surface_.Resize(bounds.width, bounds.height);
+    osd_surface_.SetOrigin(bounds.x, bounds.y);
+    osd_surface_.Clear();
+    for (auto &osd : active_osds_)
+    {
+        osd->Invalidate();
+        osd->Render();
+    }
+
+    if (osd_frame_overlay_)
+    {
+        // Only the content rect is copied, the vmem thread keeps it as long as it blends
+        std::shared_ptr<const OSDSurface> snapshot;
+        if (osd_surface_.HasContent())
+            snapshot = osd_surface_.CropContent();
+
+        std::lock_guard<std::mutex> frame_lock(osd_frame_mutex_);
+        osd_frame_snapshot_ = std::move(snapshot);
+        return;
+    }
+
+    if (!osd_surface_mode_ || !IsCreated())
+        return;
+
+    if (!osd_overlay_window_)
+    {
+        osd_overlay_window_ = CreateOSDWindow();
+        if (!osd_overlay_window_)
+            return;
+        resized = true;
+    }
+
+    // What was presented last time has to be erased as well
+    OSDRect dirty = resized ? OSDRect{0, 0, bounds.width, bounds.height}
+                            : osd_presented_rect_.Union(osd_surface_.ContentRect());
+    osd_presented_rect_ = osd_surface_.ContentRect();
+    if (dirty.IsEmpty())
+        return;
+
+    osd_overlay_window_->SetSize(bounds.width, bounds.height);
+    osd_overlay_window_->Create(bounds.x, bounds.y);
+    osd_overlay_window_->SetOpacity(100); // Fades are in the pixels already
+    osd_overlay_window_->PresentSurface(osd_surface_, dirty);
 }
 
 /**
- * Start OSD render loop (60 FPS)
+ * Start OSD render loop
+ *
+ * Runs at ~60 FPS only while a fade or slide is in progress. Otherwise it sleeps until the next
+ * fade-out starts, or on osd_cv_ until a Show*OSD call / resize wakes it, so an idle player
+ * costs no wakeups at all. OSDs only redraw when their content, size or opacity changed.
  */
 void OSWindow::StartOSDRenderLoop()
 {
@@ -220,17 +412,19 @@ void OSWindow::StartOSDRenderLoop()
     osd_thread_running_ = true;
     osd_render_thread_ = std::thread([this]()
                                      {
+        Trace::SetThreadName("osd-render");
         const auto frame_duration = std::chrono::milliseconds(16); // ~60 FPS
         const auto timing = 1.0f / frame_duration.count();
 
-        while (osd_thread_running_)
         {
-            auto frame_start = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(osd_mutex_);
 
+            while (osd_thread_running_)
             {
-                std::lock_guard<std::mutex> lock(osd_mutex_);
+                auto frame_start = std::chrono::steady_clock::now();
+                osd_wake_ = false;
 
-                auto bound = this->GetClientArea();
+                auto bound = GetOSDBounds();
 
                 float offsetY = 0.0f;
                 for (auto &osd : active_osds_)
@@ -239,17 +433,42 @@ void OSWindow::StartOSDRenderLoop()
                     offsetY += osd->GetHeight();
                 }
 
+                if (IsOSDCompositing())
+                {
+                    CompositeOSDSurface(bound);
+                }
+                else
+                {
+                    for (auto &osd : active_osds_)
+                    {
+                        osd->Render();
+                    }
+                }
+
+                auto next_update = std::chrono::steady_clock::time_point::max();
                 for (auto &osd : active_osds_)
                 {
-                    osd->Render();
+                    next_update = std::min(next_update, osd->NextUpdateAt(frame_start));
                 }
-            }
 
-            // Maintain 60 FPS
-            auto elapsed = std::chrono::steady_clock::now() - frame_start;
-            if (elapsed < frame_duration)
-            {
-                std::this_thread::sleep_for(frame_duration - elapsed);
+                auto wake = [this]()
+                { return !osd_thread_running_ || osd_wake_; };
+
+                if (next_update <= frame_start)
+                {
+                    // Animating: keep the frame cadence
+                    osd_cv_.wait_until(lock, frame_start + frame_duration, wake);
+                }
+                else if (next_update != std::chrono::steady_clock::time_point::max())
+                {
+                    // Fully visible: nothing changes until the fade-out starts
+                    osd_cv_.wait_until(lock, next_update, wake);
+                }
+                else
+                {
+                    // Nothing on screen
+                    osd_cv_.wait(lock, wake);
+                }
             }
         }
 
@@ -266,6 +485,7 @@ void OSWindow::StopOSDRenderLoop()
         return;
 
     osd_thread_running_ = false;
+    WakeOSDRenderLoop();
 
     if (osd_render_thread_.joinable())
     {
@@ -273,6 +493,18 @@ void OSWindow::StopOSDRenderLoop()
     }
 }
 
+/**
+ * Run the OSD render loop once as soon as possible
+ */
+void OSWindow::WakeOSDRenderLoop()
+{
+    {
+        std::lock_guard<std::mutex> lock(osd_mutex_);
+        osd_wake_ = true;
+    }
+    osd_cv_.notify_one();
+}
+
 // =================================================================================================
 // Group 2: Constructor & Destructor
 // =================================================================================================
@@ -301,17 +533,44 @@ OSWindow::~OSWindow()
 void OSWindow::Initialize()
 {
     VlcPlayer::Log("OSWindow::Initialize() started");
+
+    // Fonts are (re)created with the window, cached extents keyed on old handles are stale
+    text_measure_cache_.Clear();
     
-    background = CreateColor(0x1a, 0x1a, 0x1a, 0xE0);
-    text_primary = CreateColor(0xff, 0xff, 0xff, 0xff);
-    text_secondary = CreateColor(0xb0, 0xb0, 0xb0, 0xff);
-    progress_fg = CreateColor(0x4a, 0x9e, 0xff, 0xff);
-    progress_bg = CreateColor(0x3a, 0x3a, 0x3a, 0xff);
-    border = CreateColor(0x2a, 0x2a, 0x2a, 0xff);
+    palette_.clear();
+    background = CreatePaletteColor(0x1a, 0x1a, 0x1a, 0xE0);
+    text_primary = CreatePaletteColor(0xff, 0xff, 0xff, 0xff);
+    text_secondary = CreatePaletteColor(0xb0, 0xb0, 0xb0, 0xff);
+    progress_fg = CreatePaletteColor(0x4a, 0x9e, 0xff, 0xff);
+    progress_bg = CreatePaletteColor(0x3a, 0x3a, 0x3a, 0xff);
+    border = CreatePaletteColor(0x2a, 0x2a, 0x2a, 0xff);
 
     StartOSDRenderLoop();
 }
 
+OSDColor OSWindow::CreatePaletteColor(int r, int g, int b, int a)
+{
+    OSDColor color = CreateColor(r, g, b, a);
+
+    // Kept for the software compositor, backend colors are opaque handles
+    if (color)
+    {
+        palette_[color] = {static_cast<uint8_t>(r), static_cast<uint8_t>(g),
+                           static_cast<uint8_t>(b), static_cast<uint8_t>(a)};
+    }
+    return color;
+}
+
+bool OSWindow::GetColorRGBA(OSDColor color, OSDRGBA *rgba) const
+{
+    auto it = palette_.find(color);
+    if (it == palette_.end())
+        return false;
+
+    *rgba = it->second;
+    return true;
+}
+
 // =================================================================================================
 // Group 4: Window Manipulation
 // =================================================================================================
@@ -373,10 +632,14 @@ void OSWindow::SetVisible(bool visible)
 {
     if (!visible)
     {
-        for (auto &osd : active_osds_)
         {
-            osd->Hide();
+            std::lock_guard<std::mutex> lock(osd_mutex_);
+            for (auto &osd : active_osds_)
+            {
+                osd->Hide();
+            }
         }
+        WakeOSDRenderLoop();
     }
 }
 
@@ -391,7 +654,9 @@ void OSWindow::SetStyle(const WindowStyle &style)
 
 void OSWindow::OnInput(const std::string &key_code, bool ctrl, bool shift, bool alt, bool meta)
 {
-    player->ProcessKeyPress(key_code);
+    unsigned modifiers = (ctrl ? VlcPlayer::SHORTCUT_CTRL : 0) | (shift ? VlcPlayer::SHORTCUT_SHIFT : 0) |
+                         (alt ? VlcPlayer::SHORTCUT_ALT : 0) | (meta ? VlcPlayer::SHORTCUT_META : 0);
+    player->ProcessKeyPress(key_code, modifiers);
     OnContextMenuClose();
 }
 
@@ -423,7 +688,8 @@ void OSWindow::OnMinimize(bool minimized)
         ClearOSDs();
 
         // Smart pause: remember playback state and pause if playing
-        if (player && player->media_player_)
+        VlcPlayer::PlayerLock lock = player ? player->TryLockPlayer() : VlcPlayer::PlayerLock();
+        if (lock.owns_lock() && player->media_player_)
         {
             bool is_playing = libvlc_media_player_is_playing(player->media_player_);
             was_playing_before_minimize_ = is_playing;
@@ -436,7 +702,8 @@ void OSWindow::OnMinimize(bool minimized)
     else
     {
         // Smart resume: resume playback if it was playing before minimize
-        if (was_playing_before_minimize_ && player && player->media_player_)
+        VlcPlayer::PlayerLock lock = player ? player->TryLockPlayer() : VlcPlayer::PlayerLock();
+        if (was_playing_before_minimize_ && lock.owns_lock() && player->media_player_)
         {
             libvlc_media_player_play(player->media_player_);
             was_playing_before_minimize_ = false;
@@ -458,4 +725,7 @@ void OSWindow::OnResize(int x, int y, int width, int height)
     {
         _freeBounds = {x, y, width, height};
     }
+
+    // Visible OSDs follow the client area
+    WakeOSDRenderLoop();
 }
@@ -13,8 +13,11 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <condition_variable>
 #include "common.h"
 #include "base_osd.h"
+#include "osd_cache.h"
+#include "osd_surface.h"
 
 // =================================================================================================
 // Forward Declarations
@@ -107,6 +110,12 @@ public:
      */
     void ShowSeekOSD(int64_t time, int64_t duration);
 
+    /**
+     * Picture shown above the seek marker while scrubbing (thread-safe)
+     * @param image Preview frame, nullptr removes it
+     */
+    void SetSeekPreview(std::shared_ptr<const OSDImage> image);
+
     /**
      * Show playback state OSD (Play/Pause/Stop)
      * @param state Playback state string ("playing", "paused", "stopped")
@@ -132,6 +141,58 @@ public:
 
     virtual Dimension MeasureText(OSDFont font, const std::string &text) = 0;
 
+    /**
+     * MeasureText() through a per-window (font, string) cache
+     * Caller holds the OSD lock (every OSDWindow path does)
+     */
+    Dimension MeasureTextCached(OSDFont font, const std::string &text);
+
+    /**
+     * Icon set pre-rasterized for the sizes OSDWindow draws, built on first use
+     * Caller holds the OSD lock
+     */
+    const OSDIconAtlas &GetIconAtlas();
+
+    /**
+     * Straight RGBA of a palette color created in Initialize()
+     * @return false for colors that did not come from the palette
+     */
+    bool GetColorRGBA(OSDColor color, OSDRGBA *rgba) const;
+
+    /**
+     * A8 coverage of text rendered in font, for the software compositor
+     * Caller holds the OSD lock, the pixels stay valid until the next call
+     * @return false if the backend cannot provide it (text is then skipped)
+     */
+    virtual bool GetTextCoverage(OSDFont font, const std::string &text, OSDCoverage *coverage) { return false; }
+
+    // =================================================================================================
+    // OSD Compositing
+    // =================================================================================================
+    // By default every OSD is its own native window. In surface mode all active OSDs are
+    // composited into one ARGB OSDSurface and presented through a single overlay window, once
+    // per frame. The frame overlay composites the same way without any native window, sized to
+    // the memory-rendered video, and the vmem path blends the last snapshot into each frame.
+
+    void SetOSDSurfaceMode(bool enabled);
+    bool IsOSDSurfaceMode() const { return osd_surface_mode_; }
+
+    /**
+     * Enable/disable compositing OSDs into memory-rendered frames
+     */
+    void SetOSDFrameOverlay(bool enabled);
+    bool IsOSDFrameOverlay() const { return osd_frame_overlay_; }
+
+    /**
+     * Size of the frames the overlay is blended into (vmem format callback)
+     */
+    void SetOSDFrameSize(unsigned width, unsigned height);
+
+    /**
+     * Last composited overlay, nullptr while no OSD is visible (any thread)
+     */
+    std::shared_ptr<const OSDSurface> GetOSDFrameOverlay();
+
 protected:
     virtual OSDColor CreateColor(int r, int g, int b, int a) = 0;
     virtual OSDFont CreateOSDFont(bool bold) = 0;
@@ -179,8 +240,18 @@ private:
 
     void StartOSDRenderLoop();
     void StopOSDRenderLoop();
+    void WakeOSDRenderLoop();
     void ClearOSDs();
 
+    // OSD compositing (caller holds osd_mutex_)
+    bool IsOSDCompositing() const { return osd_surface_mode_ || osd_frame_overlay_; }
+    bool CanShowOSD() const { return (IsCreated() && IsVisible()) || osd_frame_overlay_; }
+    WindowBounds GetOSDBounds() const;
+    void CompositeOSDSurface(const WindowBounds &bounds);
+    void DestroyOSDsLocked();
+
+    OSDColor CreatePaletteColor(int r, int g, int b, int a);
+
     /**
      * Find existing OSD of given type or create new one
      * @param type OSD type to find/create
@@ -189,8 +260,28 @@ private:
      */
     std::shared_ptr<OSDWindow> FindOrCreateOSD(OSDType type, bool allow_visible_reuse);
 
+    static constexpr size_t TEXT_MEASURE_CACHE_SIZE = 128;
+
     std::vector<std::shared_ptr<OSDWindow>> active_osds_;
+    OSDTextCache<Dimension> text_measure_cache_{TEXT_MEASURE_CACHE_SIZE};
+    std::unique_ptr<OSDIconAtlas> icon_atlas_;
+    std::map<OSDColor, OSDRGBA> palette_;
+
+    // Compositing state (guarded by osd_mutex_)
+    std::atomic<bool> osd_surface_mode_{false};
+    std::atomic<bool> osd_frame_overlay_{false};
+    OSDSurface osd_surface_;
+    std::shared_ptr<OSDWindow> osd_overlay_window_; // Presents osd_surface_ in surface mode
+    OSDRect osd_presented_rect_ = {0, 0, 0, 0};     // Content of the last present
+    unsigned osd_frame_width_ = 0;
+    unsigned osd_frame_height_ = 0;
+
+    std::mutex osd_frame_mutex_; // Guards only the snapshot, taken by the vmem thread
+    std::shared_ptr<const OSDSurface> osd_frame_snapshot_;
+
     std::mutex osd_mutex_;
+    std::condition_variable osd_cv_; // Render loop sleeps here while nothing animates
+    bool osd_wake_ = false;          // Guarded by osd_mutex_
     std::atomic<bool> osd_thread_running_{false};
     std::thread osd_render_thread_;
 };
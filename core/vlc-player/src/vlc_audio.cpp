@@ -11,7 +11,7 @@ Napi::Value VlcPlayer::Audio(const Napi::CallbackInfo &info)
         return env.Undefined();
 
     Napi::Object options = info[0].As<Napi::Object>();
-    std::lock_guard<std::mutex> lock(mutex_);
+    PlayerLock lock(player_mutex_);
 
     if (!media_player_)
         return env.Undefined();
@@ -24,8 +24,8 @@ Napi::Value VlcPlayer::Audio(const Napi::CallbackInfo &info)
         // Show Volume OSD (text is auto-generated)
         osd_window_->ShowVolumeOSD(vol / 100.0f);
 
-        EmitPlayerInfo([vol](Napi::Env env, Napi::Object &playerInfo)
-                       { playerInfo.Set("volume", Napi::Number::New(env, vol)); });
+        if (event_aggregator_.UpdateVolume(vol))
+            ScheduleEventFlush();
     }
 
     if (options.Has("mute"))
@@ -37,14 +37,15 @@ Napi::Value VlcPlayer::Audio(const Napi::CallbackInfo &info)
         int vol = libvlc_audio_get_volume(media_player_);
         osd_window_->ShowVolumeOSD(mute ? 0.0f : vol / 100.0f);
 
-        EmitPlayerInfo([mute](Napi::Env env, Napi::Object &playerInfo)
-                       { playerInfo.Set("muted", Napi::Boolean::New(env, mute)); });
+        if (event_aggregator_.UpdateMuted(mute))
+            ScheduleEventFlush();
     }
 
     if (options.Has("track"))
     {
         int track = options.Get("track").As<Napi::Number>().Int32Value();
         libvlc_audio_set_track(media_player_, track);
+        track_cache_.Invalidate(); // ESSelected follows from the input thread
 
         // Show Audio Track OSD
         std::string text = "Audio Track: " + std::to_string(track);
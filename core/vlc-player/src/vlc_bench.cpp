@@ -0,0 +1,651 @@
+#include "vlc_bench.h"
+#include "vlc_player.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+// =================================================================================================
+// Helpers
+// =================================================================================================
+
+static int IntOption(const Napi::Object& options, const char* name, int fallback) {
+    if (!options.Has(name) || !options.Get(name).IsNumber()) {
+        return fallback;
+    }
+    return options.Get(name).As<Napi::Number>().Int32Value();
+}
+
+static VlcPlayer* PlayerArgument(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::FunctionReference* constructor = env.GetInstanceData<Napi::FunctionReference>();
+
+    if (info.Length() < 1 || !info[0].IsObject() || !constructor ||
+        !info[0].As<Napi::Object>().InstanceOf(constructor->Value())) {
+        Napi::TypeError::New(env, "VlcPlayer expected").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    return VlcPlayer::Unwrap(info[0].As<Napi::Object>());
+}
+
+// { avg, p50, p95, max } of the samples, sorts them
+static Napi::Object TimingToObject(Napi::Env env, std::vector<double>* samples) {
+    Napi::Object result = Napi::Object::New(env);
+    if (samples->empty()) {
+        return result;
+    }
+
+    std::sort(samples->begin(), samples->end());
+    double total = 0.0;
+    for (double sample : *samples) {
+        total += sample;
+    }
+
+    auto percentile = [samples](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(samples->size() - 1) + 0.5);
+        return (*samples)[index];
+    };
+
+    result.Set("avg", Napi::Number::New(env, total / static_cast<double>(samples->size())));
+    result.Set("p50", Napi::Number::New(env, percentile(0.50)));
+    result.Set("p95", Napi::Number::New(env, percentile(0.95)));
+    result.Set("max", Napi::Number::New(env, samples->back()));
+    return result;
+}
+
+// =================================================================================================
+// ImemSource - Synthetic RV32 video fed to libVLC through the imem access
+// =================================================================================================
+// A handful of pictures with a moving bar are generated once and handed out in turn, so the
+// source costs nothing and what is measured is libVLC's raw video path into the vmem callbacks,
+// the frame ring and getFrame(). imem timestamps the pictures at the requested rate and the
+// clock paces them, the result shows whether the pipeline keeps up with that rate.
+
+class ImemSource {
+public:
+    static constexpr size_t PATTERN_FRAMES = 8;
+
+    ImemSource(unsigned width, unsigned height, unsigned fps, uint64_t frames)
+        : width_(width), height_(height), fps_(fps), frames_(frames),
+          frame_size_(static_cast<size_t>(width) * height * 4),
+          started_(std::chrono::steady_clock::now()) {
+        pictures_.resize(PATTERN_FRAMES);
+        for (size_t i = 0; i < PATTERN_FRAMES; i++) {
+            std::vector<uint8_t>& picture = pictures_[i];
+            picture.resize(frame_size_);
+
+            unsigned bar = static_cast<unsigned>(i * width / PATTERN_FRAMES);
+            for (unsigned y = 0; y < height; y++) {
+                uint8_t* row = picture.data() + static_cast<size_t>(y) * width * 4;
+                for (unsigned x = 0; x < width; x++) {
+                    bool on_bar = x >= bar && x < bar + width / 16;
+                    row[x * 4 + 0] = on_bar ? 0xff : static_cast<uint8_t>(x * 255 / width);
+                    row[x * 4 + 1] = on_bar ? 0xff : static_cast<uint8_t>(y * 255 / height);
+                    row[x * 4 + 2] = on_bar ? 0xff : 0x40;
+                    row[x * 4 + 3] = 0xff;
+                }
+            }
+        }
+    }
+
+    // imem reads its callbacks back with sscanf("%p")
+    std::vector<std::string> Options() {
+        char get[32], release[32], data[32];
+        snprintf(get, sizeof(get), "%p", reinterpret_cast<void*>(&ImemSource::Get));
+        snprintf(release, sizeof(release), "%p", reinterpret_cast<void*>(&ImemSource::Release));
+        snprintf(data, sizeof(data), "%p", static_cast<void*>(this));
+
+        return {
+            std::string(":imem-get=") + get,
+            std::string(":imem-release=") + release,
+            std::string(":imem-data=") + data,
+            ":imem-cat=2",
+            ":imem-codec=RV32",
+            ":imem-width=" + std::to_string(width_),
+            ":imem-height=" + std::to_string(height_),
+            ":imem-fps=" + std::to_string(fps_),
+        };
+    }
+
+    size_t FrameSize() const { return frame_size_; }
+    uint64_t Produced() const { return produced_.load(std::memory_order_relaxed); }
+
+    double ElapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_).count();
+    }
+
+private:
+    static int Get(void* data, const char* cookie, int64_t* dts, int64_t* pts, unsigned* flags,
+                   size_t* size, void** buffer) {
+        ImemSource* source = static_cast<ImemSource*>(data);
+
+        uint64_t index = source->produced_.load(std::memory_order_relaxed);
+        if (source->frames_ > 0 && index >= source->frames_) {
+            return 1; // End of stream
+        }
+        source->produced_.store(index + 1, std::memory_order_relaxed);
+
+        *dts = *pts = static_cast<int64_t>(index * 1000000 / source->fps_);
+        *flags = 0;
+        *size = source->frame_size_;
+        *buffer = source->pictures_[index % PATTERN_FRAMES].data();
+        return 0;
+    }
+
+    static void Release(void* data, const char* cookie, size_t size, void* buffer) {
+        // Pictures belong to the source
+    }
+
+    unsigned width_;
+    unsigned height_;
+    unsigned fps_;
+    uint64_t frames_; // 0 = endless
+    size_t frame_size_;
+    std::chrono::steady_clock::time_point started_;
+    std::vector<std::vector<uint8_t>> pictures_;
+    std::atomic<uint64_t> produced_{0}; // Written by the imem thread only
+};
+
+// JS thread only, keyed by the player the source is playing on
+static std::map<VlcPlayer*, std::unique_ptr<ImemSource>> imem_sources;
+
+static Napi::Object ImemStatsToObject(Napi::Env env, const ImemSource& source) {
+    double elapsed_ms = source.ElapsedMs();
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("produced", Napi::Number::New(env, static_cast<double>(source.Produced())));
+    result.Set("elapsedMs", Napi::Number::New(env, elapsed_ms));
+    result.Set("fps", Napi::Number::New(env, elapsed_ms > 0.0 ? source.Produced() * 1000.0 / elapsed_ms : 0.0));
+    result.Set("frameSize", Napi::Number::New(env, static_cast<double>(source.FrameSize())));
+    return result;
+}
+
+// The media player has to let go of the callbacks before the source is freed
+static std::unique_ptr<ImemSource> StopImem(VlcPlayer* player) {
+    auto it = imem_sources.find(player);
+    if (it == imem_sources.end()) {
+        return nullptr;
+    }
+
+    {
+        VlcPlayer::PlayerLock lock(player->player_mutex_);
+        if (player->media_player_) {
+            libvlc_media_player_stop(player->media_player_);
+        }
+    }
+
+    std::unique_ptr<ImemSource> source = std::move(it->second);
+    imem_sources.erase(it);
+    return source;
+}
+
+/**
+ * openImem(player, { width, height, fps, frames }) -> { produced, elapsedMs, fps, frameSize }
+ * The player must render to memory (video({ memoryRender: true })), call closeImem() before
+ * disposing it.
+ */
+Napi::Value VlcBench::OpenImem(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    VlcPlayer* player = PlayerArgument(info);
+    if (!player) {
+        return env.Undefined();
+    }
+
+    Napi::Object options = info.Length() > 1 && info[1].IsObject() ? info[1].As<Napi::Object>()
+                                                                    : Napi::Object::New(env);
+    int width = IntOption(options, "width", 1280);
+    int height = IntOption(options, "height", 720);
+    int fps = IntOption(options, "fps", 60);
+    int frames = IntOption(options, "frames", 0);
+
+    if (width < 16 || height < 16 || width > 7680 || height > 4320 || fps < 1 || fps > 1000 || frames < 0) {
+        Napi::RangeError::New(env, "openImem() expects 16-7680 x 16-4320 pixels at 1-1000 fps")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (!player->media_player_ || !player->vlc_instance_) {
+        Napi::Error::New(env, "libVLC is not initialized").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (!player->memory_render_) {
+        Napi::Error::New(env, "openImem() needs video({ memoryRender: true })").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    StopImem(player);
+
+    auto source = std::make_unique<ImemSource>(width, height, fps, frames);
+    libvlc_media_t* media = libvlc_media_new_location(player->vlc_instance_, "imem://");
+    if (!media) {
+        Napi::Error::New(env, "Failed to create imem media").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    for (const std::string& option : source->Options()) {
+        libvlc_media_add_option(media, option.c_str());
+    }
+
+    {
+        VlcPlayer::PlayerLock lock(player->player_mutex_);
+
+        // Same bookkeeping as open(), an open() still in flight must not replace the source
+        ++player->open_generation_;
+        player->event_aggregator_.ResetCurrentVideo();
+        player->latency_.OnMediaChanged();
+
+        libvlc_media_player_set_media(player->media_player_, media);
+        player->track_cache_.Invalidate();
+        libvlc_media_player_play(player->media_player_);
+    }
+    libvlc_media_release(media);
+
+    Napi::Object result = ImemStatsToObject(env, *source);
+    imem_sources[player] = std::move(source);
+    return result;
+}
+
+Napi::Value VlcBench::ImemStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    VlcPlayer* player = PlayerArgument(info);
+    if (!player) {
+        return env.Undefined();
+    }
+
+    auto it = imem_sources.find(player);
+    if (it == imem_sources.end()) {
+        return env.Null();
+    }
+    return ImemStatsToObject(env, *it->second);
+}
+
+Napi::Value VlcBench::CloseImem(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    VlcPlayer* player = PlayerArgument(info);
+    if (!player) {
+        return env.Undefined();
+    }
+
+    std::unique_ptr<ImemSource> source = StopImem(player);
+    if (!source) {
+        return env.Null();
+    }
+    return ImemStatsToObject(env, *source);
+}
+
+// =================================================================================================
+// Event Flood - ThreadSafeFunction load from native threads
+// =================================================================================================
+// "raw" queues one call per event like the unmerged handlers did, "coalesced" goes through an
+// EventAggregator and the single-flush scheduling the player uses for playback events. Every
+// delivery builds a currentVideo payload and calls the JS callback, so the JS side of the
+// bridge is part of the measurement. The promise resolves from the TSFN finalizer, once every
+// producer released it and the queue is drained.
+
+struct FloodRun {
+    explicit FloodRun(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+
+    bool coalesced = false;
+    int threads = 1;
+    uint64_t count = 0; // Per thread
+    int rate = 0;       // Events/s per thread, 0 = as fast as possible
+
+    Napi::Promise::Deferred deferred;
+    Napi::ThreadSafeFunction tsfn;
+    std::vector<std::thread> producers;
+    EventAggregator aggregator;
+
+    int64_t started_us = 0;
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> rejected{0};
+
+    // JS thread only
+    uint64_t delivered = 0;
+    int64_t latency_total_us = 0;
+    int64_t latency_max_us = 0;
+    int64_t js_us = 0;
+};
+
+static void DeliverFlood(FloodRun* flood, Napi::Env env, Napi::Function callback, int64_t queued_us,
+                         uint64_t time) {
+    TRACE_SCOPE("tsfn.bench");
+    int64_t begin_us = Trace::NowUs();
+
+    Napi::Object payload = Napi::Object::New(env);
+    Napi::Object currentVideo = Napi::Object::New(env);
+    currentVideo.Set("time", Napi::Number::New(env, static_cast<double>(time)));
+    payload.Set("currentVideo", currentVideo);
+    callback.Call({payload});
+
+    int64_t end_us = Trace::NowUs();
+    int64_t latency_us = begin_us - queued_us;
+    flood->delivered++;
+    flood->latency_total_us += latency_us;
+    flood->latency_max_us = std::max(flood->latency_max_us, latency_us);
+    flood->js_us += end_us - begin_us;
+}
+
+static void ScheduleFloodFlush(FloodRun* flood) {
+    int64_t queued_us = Trace::NowUs();
+    napi_status status = flood->tsfn.NonBlockingCall([flood, queued_us](Napi::Env env, Napi::Function callback) {
+        PlaybackEventState state;
+        if (flood->aggregator.Take(&state) == 0) return;
+        DeliverFlood(flood, env, callback, queued_us, static_cast<uint64_t>(state.time));
+    });
+
+    if (status != napi_ok) {
+        flood->aggregator.CancelFlush();
+        flood->rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void RunFloodProducer(FloodRun* flood) {
+    auto started = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 0; i < flood->count; i++) {
+        uint64_t time = flood->sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        if (flood->coalesced) {
+            flood->sent.fetch_add(1, std::memory_order_relaxed);
+            if (flood->aggregator.UpdateTime(static_cast<int64_t>(time))) {
+                ScheduleFloodFlush(flood);
+            }
+        } else {
+            int64_t queued_us = Trace::NowUs();
+            napi_status status = flood->tsfn.NonBlockingCall([flood, queued_us, time](Napi::Env env, Napi::Function callback) {
+                DeliverFlood(flood, env, callback, queued_us, time);
+            });
+            (status == napi_ok ? flood->sent : flood->rejected).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (flood->rate > 0) {
+            std::this_thread::sleep_until(started + std::chrono::microseconds((i + 1) * 1000000 / flood->rate));
+        }
+    }
+
+    flood->tsfn.Release();
+}
+
+static void FinishFlood(Napi::Env env, FloodRun* flood) {
+    for (std::thread& producer : flood->producers) {
+        producer.join();
+    }
+
+    double elapsed_ms = (Trace::NowUs() - flood->started_us) / 1000.0;
+    EventAggregatorStats aggregator = flood->aggregator.GetStats();
+
+    // Values recorded after the last flush are what a coalescing consumer is still owed
+    PlaybackEventState state;
+    bool pending = flood->coalesced && flood->aggregator.Take(&state) != 0;
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("mode", Napi::String::New(env, flood->coalesced ? "coalesced" : "raw"));
+    result.Set("threads", Napi::Number::New(env, flood->threads));
+    result.Set("sent", Napi::Number::New(env, static_cast<double>(flood->sent.load())));
+    result.Set("rejected", Napi::Number::New(env, static_cast<double>(flood->rejected.load())));
+    result.Set("delivered", Napi::Number::New(env, static_cast<double>(flood->delivered)));
+    result.Set("pending", Napi::Boolean::New(env, pending));
+    result.Set("aggregatorDropped", Napi::Number::New(env, static_cast<double>(aggregator.dropped)));
+    result.Set("elapsedMs", Napi::Number::New(env, elapsed_ms));
+    result.Set("sentPerSecond", Napi::Number::New(env, elapsed_ms > 0.0 ? flood->sent.load() * 1000.0 / elapsed_ms : 0.0));
+    result.Set("deliveredPerSecond", Napi::Number::New(env, elapsed_ms > 0.0 ? flood->delivered * 1000.0 / elapsed_ms : 0.0));
+    result.Set("latencyAvgUs", Napi::Number::New(env, flood->delivered > 0
+                                                       ? static_cast<double>(flood->latency_total_us) / flood->delivered
+                                                       : 0.0));
+    result.Set("latencyMaxUs", Napi::Number::New(env, static_cast<double>(flood->latency_max_us)));
+    result.Set("jsMs", Napi::Number::New(env, flood->js_us / 1000.0));
+
+    flood->deferred.Resolve(result);
+    delete flood;
+}
+
+/**
+ * eventFlood({ count, threads, mode: 'raw' | 'coalesced', interval, queueSize, rate, callback })
+ *   -> Promise<{ sent, rejected, delivered, elapsedMs, deliveredPerSecond, latencyAvgUs, ... }>
+ * count is per thread, interval (ms) is the aggregator's flush interval in coalesced mode
+ */
+Napi::Value VlcBench::EventFlood(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object options = info.Length() > 0 && info[0].IsObject() ? info[0].As<Napi::Object>()
+                                                                    : Napi::Object::New(env);
+
+    int count = IntOption(options, "count", 100000);
+    int threads = IntOption(options, "threads", 4);
+    int queue_size = IntOption(options, "queueSize", 0);
+    int rate = IntOption(options, "rate", 0);
+    if (count < 1 || threads < 1 || threads > 64 || queue_size < 0 || rate < 0) {
+        Napi::RangeError::New(env, "eventFlood() expects count >= 1 and 1-64 threads").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    std::string mode = options.Has("mode") ? options.Get("mode").ToString().Utf8Value() : "raw";
+    if (mode != "raw" && mode != "coalesced") {
+        Napi::TypeError::New(env, "mode must be 'raw' or 'coalesced'").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Function callback = options.Has("callback") && options.Get("callback").IsFunction()
+                                  ? options.Get("callback").As<Napi::Function>()
+                                  : Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+
+    FloodRun* flood = new FloodRun(env);
+    flood->coalesced = mode == "coalesced";
+    flood->threads = threads;
+    flood->count = static_cast<uint64_t>(count);
+    flood->rate = rate;
+    if (options.Has("interval") && options.Get("interval").IsNumber()) {
+        flood->aggregator.SetInterval(static_cast<int64_t>(options.Get("interval").As<Napi::Number>().DoubleValue() * 1000.0));
+    }
+
+    Napi::Promise promise = flood->deferred.Promise();
+    flood->tsfn = Napi::ThreadSafeFunction::New(env, callback, "VlcBenchFlood", static_cast<size_t>(queue_size),
+                                                static_cast<size_t>(threads), flood, FinishFlood);
+
+    flood->started_us = Trace::NowUs();
+    for (int i = 0; i < threads; i++) {
+        flood->producers.emplace_back(RunFloodProducer, flood);
+    }
+    return promise;
+}
+
+// =================================================================================================
+// OSD Render Timing - SurfaceOSDWindow layout and drawing without a display
+// =================================================================================================
+// HeadlessWindow stands in for the platform window: metrics are fixed per glyph and text
+// coverage is a box per glyph, cached like the platform text runs are. What is timed is the
+// shared OSDWindow code and the software compositor, i.e. layout, icons, progress bars, text
+// blending and the blend into a frame (the vmem overlay). Native text rasterization and the
+// X11 / Win32 present are not part of it.
+
+class HeadlessWindow : public OSWindow {
+public:
+    static constexpr int GLYPH_WIDTH = 8;
+    static constexpr int GLYPH_HEIGHT = 16;
+
+    HeadlessWindow(int width, int height) : OSWindow(nullptr), width_(width), height_(height) {
+        defaultFont = &fonts_[0];
+        boldFont = &fonts_[1];
+        Initialize();
+    }
+
+    bool Create(int width, int height) override { return true; }
+    void Destroy() override {}
+    bool IsCreated() const override { return true; }
+    bool Bind(libvlc_media_player_t* media_player) override { return false; }
+
+    bool IsVisible() const override { return true; }
+    bool IsMinimized() const override { return false; }
+    bool IsFullscreen() const override { return false; }
+    bool IsOnTop() const override { return false; }
+
+    void GetBounds(WindowBounds* bounds) const override { *bounds = GetClientArea(); }
+    WindowBounds GetClientArea() const override { return {0, 0, width_, height_}; }
+
+    Dimension MeasureText(OSDFont font, const std::string& text) override {
+        return {static_cast<int>(text.size()) * GlyphWidth(font), GLYPH_HEIGHT};
+    }
+
+    bool GetTextCoverage(OSDFont font, const std::string& text, OSDCoverage* coverage) override {
+        std::vector<uint8_t>& mask = text_masks_[{font, text}];
+        int width = static_cast<int>(text.size()) * GlyphWidth(font);
+        if (mask.empty()) {
+            mask.assign(static_cast<size_t>(width) * GLYPH_HEIGHT, 0);
+            for (size_t i = 0; i < text.size(); i++) {
+                if (text[i] == ' ') continue;
+                int left = static_cast<int>(i) * GlyphWidth(font);
+                for (int y = 3; y < GLYPH_HEIGHT - 3; y++) {
+                    memset(mask.data() + static_cast<size_t>(y) * width + left + 1, 0xc0, GlyphWidth(font) - 2);
+                }
+            }
+        }
+
+        coverage->pixels = mask.data();
+        coverage->stride = width;
+        coverage->width = width;
+        coverage->height = GLYPH_HEIGHT;
+        coverage->origin_x = 0;
+        return true;
+    }
+
+protected:
+    OSDColor CreateColor(int r, int g, int b, int a) override {
+        // Any unique handle, the compositor reads the RGBA back from the palette
+        colors_.push_back(std::make_unique<int>(0));
+        return colors_.back().get();
+    }
+    OSDFont CreateOSDFont(bool bold) override { return &fonts_[bold ? 1 : 0]; }
+    void DestroyColor(OSDColor color) override {}
+    void DestroyFont(OSDFont font) override {}
+
+    // The bench owns its SurfaceOSDWindows, ShowXxxOSD() is never called on this window
+    std::shared_ptr<OSDWindow> CreateOSDWindow() override { return nullptr; }
+
+    void CreateContextMenu(std::vector<MenuItem> items, int x, int y) override {}
+    void DestroyContextMenu() override {}
+    void SetBoundsInternal(int x, int y, int width, int height) override {}
+    void SetStyleInternal(const WindowStyle& style) override {}
+
+private:
+    int GlyphWidth(OSDFont font) const { return font == &fonts_[1] ? GLYPH_WIDTH + 1 : GLYPH_WIDTH; }
+
+    int width_;
+    int height_;
+    int fonts_[2] = {0, 1};
+    std::vector<std::unique_ptr<int>> colors_;
+    std::map<std::pair<OSDFont, std::string>, std::vector<uint8_t>> text_masks_;
+};
+
+struct OsdBenchCase {
+    const char* name;
+    OSDType type;
+    std::string text;
+    std::string subtext;
+    float progress;
+    OSDIcon icon;
+    bool preview;
+};
+
+/**
+ * osd({ iterations, width, height }) -> { width, height, iterations, types: { <name>: {
+ *   renderUs: { avg, p50, p95, max }, blendUs: { ... }, pixels } } }
+ * width / height are the client area and the frame the overlay is blended into
+ */
+Napi::Value VlcBench::Osd(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object options = info.Length() > 0 && info[0].IsObject() ? info[0].As<Napi::Object>()
+                                                                    : Napi::Object::New(env);
+
+    int iterations = IntOption(options, "iterations", 2000);
+    int width = IntOption(options, "width", 1920);
+    int height = IntOption(options, "height", 1080);
+    if (iterations < 1 || width < 640 || height < 360 || width > 7680 || height > 4320) {
+        Napi::RangeError::New(env, "osd() expects iterations >= 1 and 640-7680 x 360-4320 pixels")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    const OsdBenchCase cases[] = {
+        {"volume", OSDType::VOLUME, "", "", 0.65f, OSDIcon::VOLUME_UP, false},
+        {"seek", OSDType::SEEK, "", "01:23:45 / 02:00:00", 0.42f, OSDIcon::NONE, false},
+        {"seekPreview", OSDType::SEEK, "", "01:23:45 / 02:00:00", 0.42f, OSDIcon::NONE, true},
+        {"playback", OSDType::PLAYBACK, "Paused", "", 0.0f, OSDIcon::PAUSE, false},
+        {"notification", OSDType::NOTIFICATION, "Subtitle track: English", "", 0.0f, OSDIcon::NONE, false},
+    };
+
+    auto preview = std::make_shared<OSDImage>();
+    preview->width = 160;
+    preview->height = 90;
+    preview->pixels.assign(static_cast<size_t>(preview->width) * preview->height * 4, 0x80);
+
+    // Single-threaded: the window's render loop has no OSDs and stays asleep
+    HeadlessWindow window(width, height);
+    WindowBounds bounds = window.GetClientArea();
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4, 0x20);
+
+    Napi::Object types = Napi::Object::New(env);
+    for (const OsdBenchCase& bench_case : cases) {
+        OSDSurface surface;
+        surface.Resize(width, height);
+        surface.SetOrigin(0, 0);
+
+        SurfaceOSDWindow osd(&window, &surface);
+        osd.SetType(bench_case.type);
+        // Past the fade-in, so Update() lays it out fully opaque
+        osd.SetCreatedAt(std::chrono::steady_clock::now() - std::chrono::milliseconds(500));
+        osd.SetData(bench_case.text, bench_case.subtext, bench_case.progress, bench_case.icon);
+        if (bench_case.preview) {
+            osd.SetPreview(preview);
+        }
+        osd.Update(bounds, 0, 1.0f);
+
+        std::vector<double> render_us;
+        std::vector<double> blend_us;
+        render_us.reserve(iterations);
+        blend_us.reserve(iterations);
+
+        for (int i = 0; i < iterations; i++) {
+            surface.Clear();
+            osd.Invalidate();
+
+            auto begin = std::chrono::steady_clock::now();
+            osd.Render();
+            auto rendered = std::chrono::steady_clock::now();
+            surface.BlendOnto(frame.data(), width * 4, width, height);
+            auto blended = std::chrono::steady_clock::now();
+
+            render_us.push_back(std::chrono::duration<double, std::micro>(rendered - begin).count());
+            blend_us.push_back(std::chrono::duration<double, std::micro>(blended - rendered).count());
+        }
+
+        const OSDRect& content = surface.ContentRect();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("renderUs", TimingToObject(env, &render_us));
+        result.Set("blendUs", TimingToObject(env, &blend_us));
+        result.Set("pixels", Napi::Number::New(env, static_cast<double>(content.width) * content.height));
+        types.Set(bench_case.name, result);
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("width", Napi::Number::New(env, width));
+    result.Set("height", Napi::Number::New(env, height));
+    result.Set("iterations", Napi::Number::New(env, iterations));
+    result.Set("types", types);
+    return result;
+}
+
+// =================================================================================================
+// Module
+// =================================================================================================
+
+Napi::Object VlcBench::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Object bench = Napi::Object::New(env);
+    bench.Set("openImem", Napi::Function::New(env, VlcBench::OpenImem, "openImem"));
+    bench.Set("imemStats", Napi::Function::New(env, VlcBench::ImemStats, "imemStats"));
+    bench.Set("closeImem", Napi::Function::New(env, VlcBench::CloseImem, "closeImem"));
+    bench.Set("eventFlood", Napi::Function::New(env, VlcBench::EventFlood, "eventFlood"));
+    bench.Set("osd", Napi::Function::New(env, VlcBench::Osd, "osd"));
+
+    exports.Set("bench", bench);
+    return exports;
+}
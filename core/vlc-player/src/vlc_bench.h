@@ -0,0 +1,31 @@
+#ifndef VLC_BENCH_H
+#define VLC_BENCH_H
+
+#include <napi.h>
+
+// =================================================================================================
+// VlcBench - Native side of the benchmark suite (vlc_bench target only)
+// =================================================================================================
+// Exported as `bench` by the vlc_bench build of the addon, which is vlc_player compiled with
+// VLC_BENCH, so every measurement runs the shipping code paths. scripts/bench.js drives it and
+// prints the results as JSON.
+//
+//   openImem(player, { width, height, fps, frames })  synthetic RV32 source through imem, the
+//                                                     decoded frames reach the player's vmem ring
+//   imemStats(player) / closeImem(player)             frames produced so far / stop the source
+//   eventFlood({ count, threads, mode, ... })         ThreadSafeFunction load -> Promise<result>
+//   osd({ iterations, width, height })                OSD render cost per OSDType, off-screen
+
+class VlcBench {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+private:
+    static Napi::Value OpenImem(const Napi::CallbackInfo& info);
+    static Napi::Value ImemStats(const Napi::CallbackInfo& info);
+    static Napi::Value CloseImem(const Napi::CallbackInfo& info);
+    static Napi::Value EventFlood(const Napi::CallbackInfo& info);
+    static Napi::Value Osd(const Napi::CallbackInfo& info);
+};
+
+#endif // VLC_BENCH_H
@@ -8,6 +8,7 @@ void VlcPlayer::EmitShortcut(const std::string& action) {
     if (!tsfn_events_) return;
 
     tsfn_events_.NonBlockingCall([action](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.shortcut");
         Napi::Object payload = Napi::Object::New(env);
         payload.Set("shortcut", Napi::String::New(env, action));
         callback.Call({payload});
@@ -18,6 +19,7 @@ void VlcPlayer::EmitCurrentVideo(std::function<void(Napi::Env, Napi::Object&)> b
     if (!tsfn_events_) return;
 
     tsfn_events_.NonBlockingCall([builder](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.currentVideo");
         Napi::Object payload = Napi::Object::New(env);
         Napi::Object currentVideo = Napi::Object::New(env);
 
@@ -32,6 +34,7 @@ void VlcPlayer::EmitPlayerInfo(std::function<void(Napi::Env, Napi::Object&)> bui
     if (!tsfn_events_) return;
 
     tsfn_events_.NonBlockingCall([builder](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.playerInfo");
         Napi::Object payload = Napi::Object::New(env);
         Napi::Object playerInfo = Napi::Object::New(env);
 
@@ -45,13 +48,168 @@ void VlcPlayer::EmitPlayerInfo(std::function<void(Napi::Env, Napi::Object&)> bui
 void VlcPlayer::EmitMediaInfo() {
     if (!tsfn_events_ || !media_player_ || disposed_) return;
 
-    tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+    // One in flight: the lists are re-read when it runs, so ES events queued behind it add nothing
+    if (media_info_event_pending_.exchange(true)) return;
+
+    napi_status status = tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.mediaInfo");
+        media_info_event_pending_ = false;
         if (disposed_ || !media_player_) return;
 
+        // Same track set as last sent (a selection change, ES churn on open)
+        uint64_t version = 0;
+        track_cache_.Get(media_player_, &version);
+        if (version == emitted_track_version_) return;
+
         Napi::Object payload = Napi::Object::New(env);
-        Napi::Object mediaInfo = GetMediaInfoObject(env);
+        Napi::Object mediaInfo = GetMediaInfoObject(env, &emitted_track_version_);
         payload.Set("mediaInfo", mediaInfo);
 
         callback.Call({payload});
     });
+
+    if (status != napi_ok) {
+        media_info_event_pending_ = false;
+    }
+}
+
+void VlcPlayer::EmitFrame() {
+    if (!tsfn_events_ || disposed_) return;
+
+    // Called from the vout thread on every display, keep it cheap and never queue up
+    int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int64_t interval = frame_event_interval_us_.load(std::memory_order_relaxed);
+    if (interval > 0 && now - last_frame_event_us_ < interval) {
+        frame_events_coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (frame_event_pending_.exchange(true)) {
+        frame_events_coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    last_frame_event_us_ = now;
+
+    napi_status status = tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.frame");
+        // Clear first so a frame displayed while JS handles this one is not lost
+        frame_event_pending_ = false;
+        if (disposed_) return;
+
+        uint64_t coalesced = frame_events_coalesced_.exchange(0);
+
+        Napi::Object payload = Napi::Object::New(env);
+        Napi::Object frame = Napi::Object::New(env);
+        frame.Set("sequence", Napi::Number::New(env, static_cast<double>(frame_ring_.GetDecodedFrames())));
+        frame.Set("generation", Napi::Number::New(env, frame_ring_.GetGeneration()));
+        frame.Set("coalesced", Napi::Number::New(env, static_cast<double>(coalesced)));
+        frame.Set("droppedFrames", Napi::Number::New(env, static_cast<double>(frame_ring_.GetDroppedFrames())));
+
+        payload.Set("frame", frame);
+        callback.Call({payload});
+    });
+
+    if (status != napi_ok) {
+        frame_event_pending_ = false;
+    }
+}
+
+void VlcPlayer::EmitStats() {
+    int64_t interval = stats_interval_ms_.load(std::memory_order_relaxed);
+    if (interval <= 0 || !tsfn_events_ || disposed_) return;
+
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (now < next_stats_event_ms_.load(std::memory_order_relaxed)) return;
+    next_stats_event_ms_ = now + interval;
+
+    // One in flight, a JS thread that falls behind skips periods instead of queueing them
+    if (stats_event_pending_.exchange(true)) return;
+
+    napi_status status = tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.stats");
+        stats_event_pending_ = false;
+        if (disposed_) return;
+
+        PlaybackStatsSnapshot snapshot;
+        SnapshotStats(&snapshot);
+
+        Napi::Object payload = Napi::Object::New(env);
+        payload.Set("stats", StatsSnapshotToObject(env, snapshot));
+        callback.Call({payload});
+    });
+
+    if (status != napi_ok) {
+        stats_event_pending_ = false;
+    }
+}
+
+void VlcPlayer::ScheduleEventFlush() {
+    // The aggregator allows one scheduled flush at a time, late values ride along with it
+    if (!tsfn_events_ || disposed_) {
+        event_aggregator_.CancelFlush();
+        return;
+    }
+
+    napi_status status = tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.playback");
+        PlaybackEventState state;
+        uint32_t fields = event_aggregator_.Take(&state);
+        if (disposed_ || fields == 0) return;
+
+        Napi::Object payload = Napi::Object::New(env);
+
+        uint32_t object_fields = fields;
+        if (compact_events_ && (fields & EVENT_FIELDS_RECORD)) {
+            Napi::Buffer<uint8_t> record = Napi::Buffer<uint8_t>::New(env, PLAYBACK_RECORD_SIZE);
+            EncodePlaybackRecord(state, fields, playback_record_seq_++, record.Data());
+            payload.Set("playback", record);
+            object_fields &= ~EVENT_FIELDS_RECORD;
+        }
+
+        if (object_fields & EVENT_FIELDS_CURRENT_VIDEO) {
+            Napi::Object currentVideo = Napi::Object::New(env);
+            if (object_fields & EVENT_FIELD_TIME) {
+                currentVideo.Set("time", Napi::Number::New(env, static_cast<double>(state.time)));
+            }
+            if (object_fields & EVENT_FIELD_POSITION) {
+                currentVideo.Set("position", Napi::Number::New(env, state.position));
+            }
+            if (object_fields & EVENT_FIELD_BUFFERING) {
+                currentVideo.Set("buffering", Napi::Number::New(env, state.buffering));
+            }
+            if (fields & EVENT_FIELD_STATE) {
+                currentVideo.Set("state", Napi::String::New(env, state.state));
+            }
+            if (fields & EVENT_FIELD_END_REACHED) {
+                currentVideo.Set("endReached", Napi::Boolean::New(env, true));
+            }
+            if (fields & EVENT_FIELD_ERROR) {
+                currentVideo.Set("error", Napi::String::New(env, state.error));
+            }
+            payload.Set("currentVideo", currentVideo);
+        }
+
+        if (fields & EVENT_FIELDS_PLAYER_INFO) {
+            Napi::Object playerInfo = Napi::Object::New(env);
+            if (fields & EVENT_FIELD_VOLUME) {
+                playerInfo.Set("volume", Napi::Number::New(env, state.volume));
+            }
+            if (fields & EVENT_FIELD_MUTED) {
+                playerInfo.Set("muted", Napi::Boolean::New(env, state.muted == 1));
+            }
+            if (fields & EVENT_FIELD_RATE) {
+                playerInfo.Set("rate", Napi::Number::New(env, state.rate));
+            }
+            payload.Set("playerInfo", playerInfo);
+        }
+
+        callback.Call({payload});
+    });
+
+    if (status != napi_ok) {
+        event_aggregator_.CancelFlush();
+    }
 }
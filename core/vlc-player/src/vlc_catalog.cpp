@@ -0,0 +1,294 @@
+#include "vlc_catalog.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// =================================================================================================
+// CatalogLoadWorker - reads and parses a playlist off the JS thread
+// =================================================================================================
+
+class CatalogLoadWorker : public Napi::AsyncWorker {
+public:
+    CatalogLoadWorker(Napi::Env env, VlcCatalog* owner, Napi::Promise::Deferred deferred,
+                      const std::string& file, std::string content, uint64_t generation)
+        : Napi::AsyncWorker(env, "VlcCatalogLoad"),
+          owner_(owner),
+          owner_ref_(Napi::Persistent(owner->Value())),
+          deferred_(deferred),
+          file_(file),
+          content_(std::move(content)),
+          generation_(generation) {
+    }
+
+protected:
+    void Execute() override {
+        auto started = std::chrono::steady_clock::now();
+        auto catalog = std::make_shared<M3UCatalog>();
+        M3UParser parser(catalog.get());
+
+        if (!file_.empty()) {
+            // Streamed, the file is never held in memory as a whole
+            std::ifstream stream(std::filesystem::u8path(file_), std::ios::binary);
+            if (!stream) {
+                SetError("Failed to open " + file_);
+                return;
+            }
+
+            std::vector<char> chunk(CHUNK_SIZE);
+            while (stream) {
+                stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                parser.Feed(chunk.data(), static_cast<size_t>(stream.gcount()));
+            }
+            if (stream.bad()) {
+                SetError("Failed to read " + file_);
+                return;
+            }
+        } else {
+            parser.Feed(content_.data(), content_.size());
+            std::string().swap(content_);
+        }
+
+        parser.Finish();
+        if (!parser.SawHeader()) {
+            SetError("Invalid M3U file: missing #EXTM3U header");
+            return;
+        }
+
+        catalog_ = catalog;
+        elapsed_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+
+        // A newer load() or clear() happened meanwhile, that one owns the catalogue
+        bool current = owner_->load_generation_ == generation_;
+        if (current) {
+            owner_->catalog_ = catalog_;
+        }
+
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("entries", Napi::Number::New(env, static_cast<double>(catalog_->Size())));
+        result.Set("groups", Napi::Number::New(env, static_cast<double>(catalog_->GroupCount())));
+        result.Set("bytes", Napi::Number::New(env, static_cast<double>(catalog_->Bytes())));
+        result.Set("ms", Napi::Number::New(env, elapsed_ms_));
+        result.Set("superseded", Napi::Boolean::New(env, !current));
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    VlcCatalog* owner_;
+    Napi::ObjectReference owner_ref_;
+    Napi::Promise::Deferred deferred_;
+    std::string file_;
+    std::string content_;
+    uint64_t generation_;
+    std::shared_ptr<const M3UCatalog> catalog_;
+    double elapsed_ms_ = 0;
+};
+
+// =================================================================================================
+// VlcCatalog
+// =================================================================================================
+
+static Napi::String ToJsString(Napi::Env env, std::string_view text) {
+    return Napi::String::New(env, text.data(), text.size());
+}
+
+Napi::Object VlcCatalog::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "M3UCatalog", {
+        InstanceMethod("load", &VlcCatalog::Load),
+        InstanceMethod("getInfo", &VlcCatalog::GetInfo),
+        InstanceMethod("groups", &VlcCatalog::Groups),
+        InstanceMethod("query", &VlcCatalog::Query),
+        InstanceMethod("get", &VlcCatalog::Get),
+        InstanceMethod("clear", &VlcCatalog::Clear),
+    });
+
+    exports.Set("M3UCatalog", func);
+    return exports;
+}
+
+VlcCatalog::VlcCatalog(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<VlcCatalog>(info) {
+}
+
+/**
+ * load({ file } | { content: string | Buffer })
+ *   -> Promise<{ entries, groups, bytes, ms, superseded }>
+ */
+Napi::Value VlcCatalog::Load(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Options object expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Object options = info[0].As<Napi::Object>();
+    std::string file;
+    std::string content;
+
+    if (options.Has("file") && options.Get("file").IsString()) {
+        file = options.Get("file").As<Napi::String>().Utf8Value();
+    } else if (options.Has("content") && options.Get("content").IsBuffer()) {
+        Napi::Buffer<char> buffer = options.Get("content").As<Napi::Buffer<char>>();
+        content.assign(buffer.Data(), buffer.Length());
+    } else if (options.Has("content") && options.Get("content").IsString()) {
+        content = options.Get("content").As<Napi::String>().Utf8Value();
+    } else {
+        Napi::TypeError::New(env, "file or content is required").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    CatalogLoadWorker* worker = new CatalogLoadWorker(env, this, deferred, file, std::move(content),
+                                                      ++load_generation_);
+    worker->Queue();
+
+    return deferred.Promise();
+}
+
+Napi::Value VlcCatalog::GetInfo(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("entries", Napi::Number::New(env, catalog_ ? static_cast<double>(catalog_->Size()) : 0));
+    result.Set("groups", Napi::Number::New(env, catalog_ ? static_cast<double>(catalog_->GroupCount()) : 0));
+    result.Set("bytes", Napi::Number::New(env, catalog_ ? static_cast<double>(catalog_->Bytes()) : 0));
+    return result;
+}
+
+/**
+ * groups({ category? }) -> [{ name, count, live, movie, series }] in playlist order
+ * With a category, count is that category's and groups without any are left out.
+ */
+Napi::Value VlcCatalog::Groups(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    int category = -1;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("category")) {
+            category = M3UCatalog::ParseCategory(options.Get("category").As<Napi::String>().Utf8Value());
+            if (category < 0) {
+                Napi::TypeError::New(env, "category must be one of live, movie, series").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+    }
+
+    Napi::Array result = Napi::Array::New(env);
+    if (!catalog_) return result;
+
+    uint32_t count = 0;
+    for (size_t g = 0; g < catalog_->GroupCount(); g++) {
+        M3UGroupInfo group = catalog_->Group(g);
+        uint32_t entries = category < 0 ? group.count : group.by_category[category];
+        if (entries == 0) continue;
+
+        Napi::Object item = Napi::Object::New(env);
+        item.Set("name", ToJsString(env, group.name));
+        item.Set("count", Napi::Number::New(env, entries));
+        item.Set("live", Napi::Number::New(env, group.by_category[static_cast<size_t>(M3UCategory::LIVE)]));
+        item.Set("movie", Napi::Number::New(env, group.by_category[static_cast<size_t>(M3UCategory::MOVIE)]));
+        item.Set("series", Napi::Number::New(env, group.by_category[static_cast<size_t>(M3UCategory::SERIES)]));
+        result.Set(count++, item);
+    }
+    return result;
+}
+
+/**
+ * query({ group?, category?, prefix?, offset = 0, limit = 100 }) -> { total, offset, items }
+ * Playlist order, or name order when a prefix is given. limit is capped at 10000.
+ */
+Napi::Value VlcCatalog::Query(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    M3UQuery query;
+    size_t offset = 0;
+    size_t limit = 100;
+
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("group") && options.Get("group").IsString()) {
+            query.group = options.Get("group").As<Napi::String>().Utf8Value();
+        }
+        if (options.Has("prefix") && options.Get("prefix").IsString()) {
+            query.prefix = options.Get("prefix").As<Napi::String>().Utf8Value();
+        }
+        if (options.Has("category")) {
+            query.category = M3UCatalog::ParseCategory(options.Get("category").As<Napi::String>().Utf8Value());
+            if (query.category < 0) {
+                Napi::TypeError::New(env, "category must be one of live, movie, series").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+        if (options.Has("offset")) {
+            offset = static_cast<size_t>(std::max(options.Get("offset").As<Napi::Number>().Int64Value(), int64_t(0)));
+        }
+        if (options.Has("limit")) {
+            limit = static_cast<size_t>(std::clamp(options.Get("limit").As<Napi::Number>().Int64Value(), int64_t(0), int64_t(10000)));
+        }
+    }
+
+    std::vector<uint32_t> indices;
+    size_t total = catalog_ ? catalog_->Select(query, offset, limit, &indices) : 0;
+
+    Napi::Array items = Napi::Array::New(env, indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        items.Set(static_cast<uint32_t>(i), EntryToObject(env, indices[i]));
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("total", Napi::Number::New(env, static_cast<double>(total)));
+    result.Set("offset", Napi::Number::New(env, static_cast<double>(offset)));
+    result.Set("items", items);
+    return result;
+}
+
+Napi::Value VlcCatalog::Get(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Index expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    int64_t index = info[0].As<Napi::Number>().Int64Value();
+    if (!catalog_ || index < 0 || static_cast<size_t>(index) >= catalog_->Size()) {
+        return env.Null();
+    }
+    return EntryToObject(env, static_cast<uint32_t>(index));
+}
+
+Napi::Value VlcCatalog::Clear(const Napi::CallbackInfo& info) {
+    // Loads still running finish as superseded
+    load_generation_++;
+    catalog_.reset();
+    return info.Env().Undefined();
+}
+
+Napi::Object VlcCatalog::EntryToObject(Napi::Env env, uint32_t index) {
+    const M3UEntry& entry = catalog_->At(index);
+
+    Napi::Object item = Napi::Object::New(env);
+    item.Set("index", Napi::Number::New(env, index));
+    item.Set("name", ToJsString(env, catalog_->String(entry.name)));
+    item.Set("url", ToJsString(env, catalog_->String(entry.url)));
+    item.Set("group", ToJsString(env, catalog_->GroupName(entry.group)));
+    item.Set("tvgId", ToJsString(env, catalog_->String(entry.tvg_id)));
+    item.Set("tvgName", ToJsString(env, catalog_->String(entry.tvg_name)));
+    item.Set("logo", ToJsString(env, catalog_->String(entry.logo)));
+    item.Set("duration", Napi::Number::New(env, entry.duration));
+    item.Set("category", Napi::String::New(env, M3UCatalog::CategoryName(entry.category)));
+    return item;
+}
@@ -0,0 +1,39 @@
+#ifndef VLC_CATALOG_H
+#define VLC_CATALOG_H
+
+#include <napi.h>
+#include <cstdint>
+#include <memory>
+#include "vlc_m3u_catalog.h"
+
+// =================================================================================================
+// M3UCatalog - JS front of the native playlist catalogue
+// =================================================================================================
+// load({ file } | { content }) parses off the JS thread and swaps the new catalogue in when it
+// is complete, so queries keep answering from the previous one meanwhile. groups() / query()
+// / get() only build objects for the requested page.
+
+class CatalogLoadWorker;
+
+class VlcCatalog : public Napi::ObjectWrap<VlcCatalog> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    VlcCatalog(const Napi::CallbackInfo& info);
+
+private:
+    friend class CatalogLoadWorker;
+
+    Napi::Value Load(const Napi::CallbackInfo& info);
+    Napi::Value GetInfo(const Napi::CallbackInfo& info);
+    Napi::Value Groups(const Napi::CallbackInfo& info);
+    Napi::Value Query(const Napi::CallbackInfo& info);
+    Napi::Value Get(const Napi::CallbackInfo& info);
+    Napi::Value Clear(const Napi::CallbackInfo& info);
+
+    Napi::Object EntryToObject(Napi::Env env, uint32_t index);
+
+    std::shared_ptr<const M3UCatalog> catalog_; // JS thread only
+    uint64_t load_generation_ = 0;              // Newer load() calls supersede older ones
+};
+
+#endif // VLC_CATALOG_H
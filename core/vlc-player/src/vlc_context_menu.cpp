@@ -10,17 +10,26 @@ std::vector<MenuItem> VlcPlayer::BuildContextMenu()
 {
     std::vector<MenuItem> menu;
 
+    // Built on the window thread: while the player is being swapped the menu has no player state
+    PlayerLock lock = TryLockPlayer();
+    bool has_player = lock.owns_lock() && media_player_;
+
     // Get current player state
     bool isPlaying = false;
     bool hasMedia = false;
 
-    if (media_player_)
+    if (has_player)
     {
         isPlaying = libvlc_media_player_is_playing(media_player_);
         libvlc_state_t state = libvlc_media_player_get_state(media_player_);
         hasMedia = (state != libvlc_NothingSpecial && state != libvlc_Stopped);
     }
 
+    // Track submenus come from the cache, opening the menu does not re-query libVLC
+    TrackLists tracks;
+    if (has_player)
+        tracks = track_cache_.Get(media_player_);
+
     // =================================================================================================
     // Playback Controls
     // =================================================================================================
@@ -145,30 +154,18 @@ std::vector<MenuItem> VlcPlayer::BuildContextMenu()
     subtitleMenu.submenu.push_back(subSep);
 
     // Get subtitle tracks
-    if (media_player_)
+    for (const MediaTrackSnapshot &track : tracks.subtitle)
     {
-        libvlc_track_description_t *tracks = libvlc_video_get_spu_description(media_player_);
-        int currentTrack = libvlc_video_get_spu(media_player_);
-
-        if (tracks)
+        MenuItem trackItem;
+        trackItem.label = track.name.empty() ? "Unknown" : track.name;
+        trackItem.action = "subtitleTrack_" + std::to_string(track.id);
+        trackItem.enabled = true;
+        // Add checkmark if current track
+        if (track.id == tracks.subtitle_current)
         {
-            libvlc_track_description_t *track = tracks;
-            while (track)
-            {
-                MenuItem trackItem;
-                trackItem.label = track->psz_name ? track->psz_name : "Unknown";
-                trackItem.action = "subtitleTrack_" + std::to_string(track->i_id);
-                trackItem.enabled = true;
-                // Add checkmark if current track
-                if (track->i_id == currentTrack)
-                {
-                    trackItem.label = "✓ " + trackItem.label;
-                }
-                subtitleMenu.submenu.push_back(trackItem);
-                track = track->p_next;
-            }
-            libvlc_track_description_list_release(tracks);
+            trackItem.label = "✓ " + trackItem.label;
         }
+        subtitleMenu.submenu.push_back(trackItem);
     }
 
     // Disable subtitles
@@ -215,30 +212,18 @@ std::vector<MenuItem> VlcPlayer::BuildContextMenu()
     audioMenu.submenu.push_back(audioSep);
 
     // Get audio tracks
-    if (media_player_)
+    for (const MediaTrackSnapshot &track : tracks.audio)
     {
-        libvlc_track_description_t *tracks = libvlc_audio_get_track_description(media_player_);
-        int currentTrack = libvlc_audio_get_track(media_player_);
-
-        if (tracks)
+        MenuItem trackItem;
+        trackItem.label = track.name.empty() ? "Unknown" : track.name;
+        trackItem.action = "audioTrack_" + std::to_string(track.id);
+        trackItem.enabled = true;
+        // Add checkmark if current track
+        if (track.id == tracks.audio_current)
         {
-            libvlc_track_description_t *track = tracks;
-            while (track)
-            {
-                MenuItem trackItem;
-                trackItem.label = track->psz_name ? track->psz_name : "Unknown";
-                trackItem.action = "audioTrack_" + std::to_string(track->i_id);
-                trackItem.enabled = true;
-                // Add checkmark if current track
-                if (track->i_id == currentTrack)
-                {
-                    trackItem.label = "✓ " + trackItem.label;
-                }
-                audioMenu.submenu.push_back(trackItem);
-                track = track->p_next;
-            }
-            libvlc_track_description_list_release(tracks);
+            trackItem.label = "✓ " + trackItem.label;
         }
+        audioMenu.submenu.push_back(trackItem);
     }
 
     menu.push_back(audioMenu);
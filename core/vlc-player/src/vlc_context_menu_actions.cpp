@@ -7,14 +7,12 @@
 // =================================================================================================
 
 void VlcPlayer::ExecuteMenuAction(const std::string& action) {
-    printf("[VLC] Executing menu action: %s\n", action.c_str());
-    fflush(stdout);
+    Log("Executing menu action: %s", action.c_str());
 
     // Check if this action is in our known shortcuts list (key atanmış olsun veya olmasın)
     // If yes, emit as shortcut event to frontend and return (frontend handles everything)
     if (IsKnownAction(action)) {
-        printf("[VLC] Known action '%s', emitting shortcut event to frontend\n", action.c_str());
-        fflush(stdout);
+        Log("Known action '%s', emitting shortcut event to frontend", action.c_str());
 
         if (tsfn_events_) {
             auto callback = [action](Napi::Env env, Napi::Function jsCallback) {
@@ -29,9 +27,10 @@ void VlcPlayer::ExecuteMenuAction(const std::string& action) {
         return;
     }
 
-    if (!media_player_) {
-        printf("[VLC] No media player available\n");
-        fflush(stdout);
+    // Window thread: skipped while the JS thread swaps or releases the player
+    PlayerLock lock = TryLockPlayer();
+    if (!lock.owns_lock() || !media_player_) {
+        Log("No media player available");
         return;
     }
 
@@ -41,12 +40,14 @@ void VlcPlayer::ExecuteMenuAction(const std::string& action) {
     if (action.find("subtitleTrack_") == 0) {
         int trackId = std::stoi(action.substr(14));
         libvlc_video_set_spu(media_player_, trackId);
+        track_cache_.Invalidate();
     }
 
     // Dynamic audio track selection
     else if (action.find("audioTrack_") == 0) {
         int trackId = std::stoi(action.substr(11));
         libvlc_audio_set_track(media_player_, trackId);
+        track_cache_.Invalidate();
     }
 
     // Dynamic video actions - Aspect Ratio
@@ -74,6 +75,7 @@ void VlcPlayer::ExecuteMenuAction(const std::string& action) {
         std::string mode = action.substr(12);
         if (mode == "Off") {
             libvlc_video_set_deinterlace(media_player_, nullptr);
+            deinterlace_mode_.clear();
         } else {
             // Convert mode name to lowercase for libvlc
             std::string vlcMode = mode;
@@ -85,11 +87,11 @@ void VlcPlayer::ExecuteMenuAction(const std::string& action) {
             }
 
             libvlc_video_set_deinterlace(media_player_, vlcMode.c_str());
+            deinterlace_mode_ = vlcMode;
         }
     }
 
     else {
-        printf("[VLC] Unknown menu action: %s\n", action.c_str());
-        fflush(stdout);
+        Log("Unknown menu action: %s", action.c_str());
     }
 }
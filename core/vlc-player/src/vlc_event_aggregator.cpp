@@ -0,0 +1,285 @@
+#include "vlc_event_aggregator.h"
+#include <chrono>
+#include <cstring>
+
+static int64_t NowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+EventAggregator::EventAggregator()
+    : dirty_(0),
+      flush_scheduled_(false),
+      last_flush_us_(0),
+      interval_us_(DEFAULT_INTERVAL_US),
+      deferred_at_us_(0),
+      deferred_running_(false)
+{
+}
+
+EventAggregator::~EventAggregator()
+{
+    StopDeferredFlush();
+}
+
+void EventAggregator::SetInterval(int64_t interval_us)
+{
+    interval_us_.store(interval_us > 0 ? interval_us : 0);
+}
+
+int64_t EventAggregator::GetInterval() const
+{
+    return interval_us_.load();
+}
+
+// =================================================================================================
+// Recorders
+// =================================================================================================
+
+bool EventAggregator::MarkLocked(uint32_t field, bool changed, bool urgent)
+{
+    stats_.recorded++;
+
+    // A value that went back to what JS already has needs no flush
+    if (changed)
+    {
+        dirty_ |= field;
+    }
+    else
+    {
+        dirty_ &= ~field;
+        stats_.dropped++;
+    }
+
+    if (dirty_ == 0 || flush_scheduled_)
+        return false;
+
+    int64_t interval = interval_us_.load(std::memory_order_relaxed);
+    if (!urgent && NowMicros() - last_flush_us_ < interval)
+    {
+        // Nothing may follow this value, arm the trailing flush
+        if (deferred_running_ && deferred_at_us_ == 0)
+        {
+            deferred_at_us_ = last_flush_us_ + interval;
+            deferred_cv_.notify_one();
+        }
+        return false;
+    }
+
+    flush_scheduled_ = true;
+    return true;
+}
+
+bool EventAggregator::UpdateTime(int64_t time)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.time = time;
+    return MarkLocked(EVENT_FIELD_TIME, time != sent_.time, false);
+}
+
+bool EventAggregator::UpdatePosition(float position)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.position = position;
+    return MarkLocked(EVENT_FIELD_POSITION, position != sent_.position, false);
+}
+
+bool EventAggregator::UpdateBuffering(float buffering)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.buffering = buffering;
+    // The end of buffering is what the UI waits for, do not hold it back
+    return MarkLocked(EVENT_FIELD_BUFFERING, buffering != sent_.buffering, buffering >= 100.0f);
+}
+
+bool EventAggregator::UpdateState(const std::string &state)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.state = state;
+    return MarkLocked(EVENT_FIELD_STATE, state != sent_.state, true);
+}
+
+bool EventAggregator::UpdateError(const std::string &error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.error = error;
+    return MarkLocked(EVENT_FIELD_ERROR, true, true);
+}
+
+bool EventAggregator::UpdateEndReached()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.end_reached = true;
+    pending_.state = "ended";
+    MarkLocked(EVENT_FIELD_STATE, pending_.state != sent_.state, true);
+    return MarkLocked(EVENT_FIELD_END_REACHED, true, true);
+}
+
+bool EventAggregator::UpdateVolume(int volume)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.volume = volume;
+    return MarkLocked(EVENT_FIELD_VOLUME, volume != sent_.volume, true);
+}
+
+bool EventAggregator::UpdateMuted(bool muted)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.muted = muted ? 1 : 0;
+    return MarkLocked(EVENT_FIELD_MUTED, pending_.muted != sent_.muted, true);
+}
+
+bool EventAggregator::UpdateRate(float rate)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.rate = rate;
+    return MarkLocked(EVENT_FIELD_RATE, rate != sent_.rate, true);
+}
+
+// =================================================================================================
+// Flush
+// =================================================================================================
+
+uint32_t EventAggregator::Take(PlaybackEventState *out)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t fields = dirty_;
+    *out = pending_;
+
+    // error / endReached are one-shot notifications, everything else is a level
+    sent_ = pending_;
+    pending_.error.clear();
+    pending_.end_reached = false;
+
+    dirty_ = 0;
+    flush_scheduled_ = false;
+    deferred_at_us_ = 0;
+    last_flush_us_ = NowMicros();
+    if (fields)
+        stats_.flushes++;
+
+    return fields;
+}
+
+void EventAggregator::CancelFlush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_scheduled_ = false;
+}
+
+void EventAggregator::ResetCurrentVideo()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    PlaybackEventState fresh;
+    sent_.time = fresh.time;
+    sent_.position = fresh.position;
+    sent_.buffering = fresh.buffering;
+    sent_.state = fresh.state;
+    dirty_ &= ~EVENT_FIELDS_CURRENT_VIDEO;
+    pending_.error.clear();
+    pending_.end_reached = false;
+}
+
+EventAggregatorStats EventAggregator::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// =================================================================================================
+// Deferred Flush
+// =================================================================================================
+
+void EventAggregator::StartDeferredFlush(std::function<void()> schedule)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (deferred_running_)
+        return;
+
+    deferred_schedule_ = std::move(schedule);
+    deferred_at_us_ = 0;
+    deferred_running_ = true;
+    deferred_thread_ = std::thread(&EventAggregator::DeferredFlushLoop, this);
+}
+
+void EventAggregator::StopDeferredFlush()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        deferred_running_ = false;
+        deferred_cv_.notify_one();
+    }
+
+    if (deferred_thread_.joinable())
+        deferred_thread_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    deferred_schedule_ = nullptr;
+    deferred_at_us_ = 0;
+}
+
+void EventAggregator::DeferredFlushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (deferred_running_)
+    {
+        if (deferred_at_us_ == 0)
+        {
+            deferred_cv_.wait(lock);
+            continue;
+        }
+
+        int64_t wait_us = deferred_at_us_ - NowMicros();
+        if (wait_us > 0)
+        {
+            deferred_cv_.wait_for(lock, std::chrono::microseconds(wait_us));
+            continue;
+        }
+
+        deferred_at_us_ = 0;
+
+        // A recorder or Take() got there first
+        if (dirty_ == 0 || flush_scheduled_)
+            continue;
+
+        flush_scheduled_ = true;
+        lock.unlock();
+        deferred_schedule_();
+        lock.lock();
+    }
+}
+
+// =================================================================================================
+// Compact Playback Record
+// =================================================================================================
+
+template <typename T>
+static void PutLE(uint8_t *out, T value)
+{
+    // Byte-wise so the record is little-endian regardless of the host
+    uint8_t bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    const uint16_t probe = 1;
+    bool little = *reinterpret_cast<const uint8_t *>(&probe) == 1;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        out[i] = little ? bytes[i] : bytes[sizeof(T) - 1 - i];
+    }
+}
+
+void EncodePlaybackRecord(const PlaybackEventState &state, uint32_t fields, uint32_t sequence, uint8_t *out)
+{
+    memset(out, 0, PLAYBACK_RECORD_SIZE);
+
+    out[0] = PLAYBACK_RECORD_VERSION;
+    PutLE<uint16_t>(out + 2, static_cast<uint16_t>(fields & EVENT_FIELDS_RECORD));
+    PutLE<uint32_t>(out + 4, sequence);
+    PutLE<double>(out + 8, static_cast<double>(state.time));
+    PutLE<float>(out + 16, state.position);
+    PutLE<float>(out + 20, state.buffering);
+}
@@ -0,0 +1,152 @@
+#ifndef VLC_EVENT_AGGREGATOR_H
+#define VLC_EVENT_AGGREGATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <string>
+#include <thread>
+
+// =================================================================================================
+// EventAggregator - Playback state merged on the VLC threads, flushed to JS in one payload
+// =================================================================================================
+// libVLC event handlers only record values here. A flush is requested when the interval has
+// elapsed (or right away for urgent changes like state, end of stream and errors), and at most
+// one flush is queued on the ThreadSafeFunction at a time. Fields equal to what JS last received
+// are dropped, so a flush only carries what actually changed since the previous one.
+//
+// A value recorded inside the interval is not lost when nothing follows it: the deferred flush
+// thread schedules a trailing flush once the interval since the last one has elapsed.
+
+struct PlaybackEventState
+{
+    // currentVideo
+    int64_t time = -1;
+    float position = -1.0f;
+    float buffering = -1.0f;
+    std::string state;
+    std::string error;
+    bool end_reached = false;
+
+    // playerInfo
+    int volume = -1;
+    int muted = -1; // -1 unknown, 0/1
+    float rate = 0.0f;
+};
+
+enum EventField : uint32_t
+{
+    EVENT_FIELD_TIME = 1u << 0,
+    EVENT_FIELD_POSITION = 1u << 1,
+    EVENT_FIELD_BUFFERING = 1u << 2,
+    EVENT_FIELD_STATE = 1u << 3,
+    EVENT_FIELD_ERROR = 1u << 4,
+    EVENT_FIELD_END_REACHED = 1u << 5,
+    EVENT_FIELD_VOLUME = 1u << 6,
+    EVENT_FIELD_MUTED = 1u << 7,
+    EVENT_FIELD_RATE = 1u << 8,
+
+    EVENT_FIELDS_CURRENT_VIDEO = EVENT_FIELD_TIME | EVENT_FIELD_POSITION | EVENT_FIELD_BUFFERING |
+                                 EVENT_FIELD_STATE | EVENT_FIELD_ERROR | EVENT_FIELD_END_REACHED,
+    EVENT_FIELDS_PLAYER_INFO = EVENT_FIELD_VOLUME | EVENT_FIELD_MUTED | EVENT_FIELD_RATE,
+
+    // Fields carried by the compact binary record instead of currentVideo
+    EVENT_FIELDS_RECORD = EVENT_FIELD_TIME | EVENT_FIELD_POSITION | EVENT_FIELD_BUFFERING
+};
+
+// =================================================================================================
+// Compact playback record (setEventCallback(cb, { compact: true }))
+// =================================================================================================
+// Fixed 24-byte little-endian layout, only the fields flagged in `fields` are meaningful:
+//
+//   offset  type     name
+//   0       uint8    version (PLAYBACK_RECORD_VERSION)
+//   1       uint8    reserved (0)
+//   2       uint16   fields (EVENT_FIELD_TIME | EVENT_FIELD_POSITION | EVENT_FIELD_BUFFERING)
+//   4       uint32   sequence (per player, wraps)
+//   8       float64  time (ms)
+//   16      float32  position (0.0 - 1.0)
+//   20      float32  buffering (0 - 100)
+
+static constexpr size_t PLAYBACK_RECORD_SIZE = 24;
+static constexpr uint8_t PLAYBACK_RECORD_VERSION = 1;
+
+void EncodePlaybackRecord(const PlaybackEventState &state, uint32_t fields, uint32_t sequence, uint8_t *out);
+
+struct EventAggregatorStats
+{
+    uint64_t recorded = 0; // Values handed to the aggregator
+    uint64_t dropped = 0;  // Values equal to the last flushed one
+    uint64_t flushes = 0;  // Payloads delivered to JS
+};
+
+class EventAggregator
+{
+public:
+    static constexpr int64_t DEFAULT_INTERVAL_US = 100000; // 10 flushes per second
+
+    EventAggregator();
+    ~EventAggregator();
+
+    /**
+     * Run schedule for trailing flushes, from the deferred flush thread (same contract as a
+     * recorder returning true). Stopped before the owner's flush target goes away.
+     */
+    void StartDeferredFlush(std::function<void()> schedule);
+    void StopDeferredFlush();
+
+    void SetInterval(int64_t interval_us);
+    int64_t GetInterval() const;
+
+    // Recorders (any thread). Return true when the caller has to schedule a flush.
+    bool UpdateTime(int64_t time);
+    bool UpdatePosition(float position);
+    bool UpdateBuffering(float buffering);
+    bool UpdateState(const std::string &state);
+    bool UpdateError(const std::string &error);
+    bool UpdateEndReached();
+    bool UpdateVolume(int volume);
+    bool UpdateMuted(bool muted);
+    bool UpdateRate(float rate);
+
+    /**
+     * Move the changed fields into out and mark them as sent (JS thread, inside the flush).
+     * Returns the EventField mask of the fields set in out, 0 if nothing changed meanwhile.
+     */
+    uint32_t Take(PlaybackEventState *out);
+
+    // The scheduled flush could not be queued, allow the next recorder to retry
+    void CancelFlush();
+
+    // New media: forget the last flushed currentVideo values so they are all sent again
+    void ResetCurrentVideo();
+
+    EventAggregatorStats GetStats();
+
+private:
+    // Caller holds mutex_
+    bool MarkLocked(uint32_t field, bool changed, bool urgent);
+
+    void DeferredFlushLoop();
+
+    std::mutex mutex_;
+    PlaybackEventState pending_; // Latest recorded values
+    PlaybackEventState sent_;    // Values JS has last seen
+    uint32_t dirty_;
+    bool flush_scheduled_;
+    int64_t last_flush_us_;
+    EventAggregatorStats stats_;
+    std::atomic<int64_t> interval_us_;
+
+    // Trailing flush, guarded by mutex_
+    int64_t deferred_at_us_; // 0 = none armed
+    bool deferred_running_;
+    std::function<void()> deferred_schedule_;
+    std::condition_variable deferred_cv_;
+    std::thread deferred_thread_;
+};
+
+#endif // VLC_EVENT_AGGREGATOR_H
@@ -0,0 +1,51 @@
+#ifndef VLC_FRAME_BUFFERS_H
+#define VLC_FRAME_BUFFERS_H
+
+#include <napi.h>
+#include <cstring>
+#include <memory>
+#include "vlc_frame_ring.h"
+
+// =================================================================================================
+// Frame Buffers - ArrayBuffers over FrameStorage memory for the zero-copy getters
+// =================================================================================================
+// The ArrayBuffer is an external view that keeps storage alive until it is collected. Hosts
+// running V8 with the memory cage (Electron 21 and later) refuse external buffers with
+// napi_no_external_buffers_allowed. There the bytes are copied into a V8-owned ArrayBuffer
+// and *external is set to false: the buffer is a snapshot, fetch it again for newer frames.
+//
+// Returns an empty ArrayBuffer with a JS exception pending on any other failure.
+
+inline Napi::ArrayBuffer NewFrameArrayBuffer(Napi::Env env, const std::shared_ptr<FrameStorage> &storage,
+                                             uint8_t *data, size_t size, bool *external)
+{
+    auto *hint = new std::shared_ptr<FrameStorage>(storage);
+    napi_value value = nullptr;
+    napi_status status = napi_create_external_arraybuffer(
+        env, data, size,
+        [](napi_env, void *, void *ref)
+        {
+            delete static_cast<std::shared_ptr<FrameStorage> *>(ref);
+        },
+        hint, &value);
+
+    if (status == napi_ok)
+    {
+        *external = true;
+        return Napi::ArrayBuffer(env, value);
+    }
+    delete hint;
+
+    if (status != napi_no_external_buffers_allowed)
+    {
+        Napi::Error::New(env, "Failed to create frame ArrayBuffer").ThrowAsJavaScriptException();
+        return Napi::ArrayBuffer();
+    }
+
+    *external = false;
+    Napi::ArrayBuffer copy = Napi::ArrayBuffer::New(env, size);
+    memcpy(copy.Data(), data, size);
+    return copy;
+}
+
+#endif // VLC_FRAME_BUFFERS_H
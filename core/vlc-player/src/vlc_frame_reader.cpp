@@ -0,0 +1,209 @@
+#include "vlc_frame_reader.h"
+#include "vlc_frame_buffers.h"
+#include <algorithm>
+
+Napi::Object VlcFrameReader::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "FrameReader", {
+        InstanceMethod("read", &VlcFrameReader::Read),
+        InstanceMethod("getFrameBuffers", &VlcFrameReader::GetFrameBuffers),
+        InstanceMethod("getVideoFormat", &VlcFrameReader::GetVideoFormat),
+        InstanceMethod("wait", &VlcFrameReader::Wait),
+        InstanceMethod("close", &VlcFrameReader::Close),
+    });
+
+    exports.Set("FrameReader", func);
+    return exports;
+}
+
+VlcFrameReader::VlcFrameReader(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<VlcFrameReader>(info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Shared frame ring name expected").ThrowAsJavaScriptException();
+        return;
+    }
+
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    reader_ = SharedFrameReader::Open(name);
+    if (!reader_) {
+        Napi::Error::New(env, "No shared frame ring named '" + name + "'").ThrowAsJavaScriptException();
+        return;
+    }
+}
+
+VlcFrameReader::~VlcFrameReader() {
+    if (reader_) {
+        reader_->ReleaseHeld();
+    }
+}
+
+/**
+ * read()                   -> Buffer copy of the latest frame (or null)
+ * read({ zeroCopy: true }) -> { slot, sequence, generation } (or null)
+ */
+Napi::Value VlcFrameReader::Read(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!reader_) return env.Null();
+
+    bool zero_copy = false;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("zeroCopy")) {
+            zero_copy = options.Get("zeroCopy").ToBoolean().Value();
+        }
+    }
+
+    FrameSlotInfo latest;
+    std::shared_ptr<FrameStorage> storage = reader_->HoldLatest(&latest);
+    if (!storage) {
+        return env.Null();
+    }
+
+    if (zero_copy) {
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("slot", Napi::Number::New(env, latest.slot));
+        result.Set("sequence", Napi::Number::New(env, static_cast<double>(latest.sequence)));
+        result.Set("generation", Napi::Number::New(env, latest.generation));
+        return result;
+    }
+
+    return Napi::Buffer<uint8_t>::Copy(env, storage->Slot(latest.slot), storage->FrameSize());
+}
+
+/**
+ * getFrameBuffers() -> { generation, frameSize, external, buffers: ArrayBuffer[] } (or null)
+ *
+ * external: true - views straight into the shared mapping, which stays mapped until every
+ * ArrayBuffer of that generation is collected.
+ * external: false - the Electron main process (V8 memory cage) refuses external buffers, the
+ * ArrayBuffers are copies taken now, call read() for each new frame instead.
+ */
+Napi::Value VlcFrameReader::GetFrameBuffers(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!reader_) return env.Null();
+
+    uint32_t generation = 0;
+    std::shared_ptr<FrameStorage> storage = reader_->GetStorage(&generation, nullptr);
+    if (!storage) {
+        return env.Null();
+    }
+
+    bool external = true;
+    Napi::Array buffers = Napi::Array::New(env, storage->SlotCount());
+    for (size_t i = 0; i < storage->SlotCount(); i++) {
+        Napi::ArrayBuffer buffer = NewFrameArrayBuffer(env, storage, storage->Slot(i), storage->FrameSize(), &external);
+        if (buffer.IsEmpty()) {
+            return env.Undefined();
+        }
+        buffers.Set(static_cast<uint32_t>(i), buffer);
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("generation", Napi::Number::New(env, generation));
+    result.Set("frameSize", Napi::Number::New(env, static_cast<double>(storage->FrameSize())));
+    result.Set("external", Napi::Boolean::New(env, external));
+    result.Set("buffers", buffers);
+
+    return result;
+}
+
+Napi::Value VlcFrameReader::GetVideoFormat(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!reader_) return env.Null();
+
+    uint32_t generation = 0;
+    std::shared_ptr<FrameStorage> storage = reader_->GetStorage(&generation, nullptr);
+    if (!storage) {
+        return env.Null();
+    }
+
+    FrameFormat current = reader_->GetFormat();
+
+    Napi::Object format = Napi::Object::New(env);
+    format.Set("width", Napi::Number::New(env, current.width));
+    format.Set("height", Napi::Number::New(env, current.height));
+    format.Set("pitch", Napi::Number::New(env, current.pitch));
+    format.Set("chroma", Napi::String::New(env, current.chroma));
+    format.Set("frameSize", Napi::Number::New(env, static_cast<double>(current.frame_size)));
+    format.Set("slots", Napi::Number::New(env, static_cast<double>(storage->SlotCount())));
+    format.Set("generation", Napi::Number::New(env, generation));
+
+    Napi::Array planes = Napi::Array::New(env, current.plane_count);
+    for (int i = 0; i < current.plane_count; i++) {
+        Napi::Object plane = Napi::Object::New(env);
+        plane.Set("offset", Napi::Number::New(env, static_cast<double>(current.planes[i].offset)));
+        plane.Set("pitch", Napi::Number::New(env, current.planes[i].pitch));
+        plane.Set("lines", Napi::Number::New(env, current.planes[i].lines));
+        planes.Set(static_cast<uint32_t>(i), plane);
+    }
+    format.Set("planes", planes);
+    format.Set("decodedFrames", Napi::Number::New(env, static_cast<double>(reader_->GetPublished())));
+    format.Set("droppedFrames", Napi::Number::New(env, static_cast<double>(reader_->GetDropped())));
+
+    return format;
+}
+
+// Blocks on the shared signal word off the JS thread
+class FrameWaitWorker : public Napi::AsyncWorker {
+public:
+    FrameWaitWorker(Napi::Env env, Napi::Promise::Deferred deferred,
+                    std::shared_ptr<SharedFrameReader> reader, int timeout_ms)
+        : Napi::AsyncWorker(env, "VlcFrameWait"),
+          deferred_(deferred),
+          reader_(std::move(reader)),
+          timeout_ms_(timeout_ms),
+          signaled_(false) {
+    }
+
+protected:
+    void Execute() override {
+        signaled_ = reader_->Wait(timeout_ms_);
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Napi::Boolean::New(Env(), signaled_));
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    std::shared_ptr<SharedFrameReader> reader_;
+    int timeout_ms_;
+    bool signaled_;
+};
+
+/**
+ * wait(timeoutMs = 1000) -> Promise<boolean>
+ * Resolves true once something was published since the last read()/wait(), false on timeout.
+ */
+Napi::Value VlcFrameReader::Wait(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    if (!reader_) {
+        deferred.Resolve(Napi::Boolean::New(env, false));
+        return deferred.Promise();
+    }
+
+    // Bounded so a worker thread is never parked forever on a writer that went away
+    int timeout_ms = 1000;
+    if (info.Length() > 0 && info[0].IsNumber()) {
+        timeout_ms = std::clamp(info[0].As<Napi::Number>().Int32Value(), 0, 10000);
+    }
+
+    FrameWaitWorker* worker = new FrameWaitWorker(env, deferred, reader_, timeout_ms);
+    worker->Queue();
+
+    return deferred.Promise();
+}
+
+Napi::Value VlcFrameReader::Close(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // Pending wait() workers keep their own reference until they time out
+    if (reader_) {
+        reader_->ReleaseHeld();
+        reader_.reset();
+    }
+    return env.Undefined();
+}
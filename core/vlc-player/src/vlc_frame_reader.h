@@ -0,0 +1,31 @@
+#ifndef VLC_FRAME_READER_H
+#define VLC_FRAME_READER_H
+
+#include <napi.h>
+#include <memory>
+#include "vlc_shared_frames.h"
+
+// =================================================================================================
+// FrameReader - JS access to frames published by video({ sharedFrames }) in another process
+// =================================================================================================
+// new FrameReader(name) attaches to the shared ring, read()/getFrameBuffers()/getVideoFormat()
+// mirror the VlcPlayer methods of the same purpose and wait(timeoutMs) resolves once a new
+// frame (or format change) was published. No libVLC calls are made on this side.
+
+class VlcFrameReader : public Napi::ObjectWrap<VlcFrameReader> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    VlcFrameReader(const Napi::CallbackInfo& info);
+    ~VlcFrameReader();
+
+private:
+    Napi::Value Read(const Napi::CallbackInfo& info);
+    Napi::Value GetFrameBuffers(const Napi::CallbackInfo& info);
+    Napi::Value GetVideoFormat(const Napi::CallbackInfo& info);
+    Napi::Value Wait(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+
+    std::shared_ptr<SharedFrameReader> reader_;
+};
+
+#endif // VLC_FRAME_READER_H
@@ -0,0 +1,482 @@
+#include "vlc_frame_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// =================================================================================================
+// Frame Format
+// =================================================================================================
+
+static inline size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static inline int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool ParseFrameChroma(const std::string &name, FrameChroma *chroma)
+{
+    if (name == "RV32")
+        *chroma = FrameChroma::RV32;
+    else if (name == "I420")
+        *chroma = FrameChroma::I420;
+    else if (name == "NV12")
+        *chroma = FrameChroma::NV12;
+    else
+        return false;
+    return true;
+}
+
+const char *FrameChromaName(FrameChroma chroma)
+{
+    switch (chroma)
+    {
+    case FrameChroma::I420:
+        return "I420";
+    case FrameChroma::NV12:
+        return "NV12";
+    case FrameChroma::RV32:
+    default:
+        return "RV32";
+    }
+}
+
+FrameFormat MakeFrameFormat(FrameChroma chroma, unsigned width, unsigned height)
+{
+    FrameFormat format;
+    memcpy(format.chroma, FrameChromaName(chroma), 4);
+    format.width = width;
+    format.height = height;
+
+    // Luma pitch aligned to 32 so the half-width chroma planes stay 16-byte aligned
+    unsigned luma_pitch = static_cast<unsigned>(AlignUp(width, 32));
+    unsigned chroma_lines = (height + 1) / 2;
+
+    switch (chroma)
+    {
+    case FrameChroma::I420:
+        format.plane_count = 3;
+        format.planes[0].pitch = luma_pitch;
+        format.planes[0].lines = height;
+        format.planes[1].pitch = luma_pitch / 2;
+        format.planes[1].lines = chroma_lines;
+        format.planes[2].pitch = luma_pitch / 2;
+        format.planes[2].lines = chroma_lines;
+        break;
+    case FrameChroma::NV12:
+        format.plane_count = 2;
+        format.planes[0].pitch = luma_pitch;
+        format.planes[0].lines = height;
+        format.planes[1].pitch = luma_pitch;
+        format.planes[1].lines = chroma_lines;
+        break;
+    case FrameChroma::RV32:
+    default:
+        format.plane_count = 1;
+        format.planes[0].pitch = width * 4; // 4 bytes per pixel (RGBA)
+        format.planes[0].lines = height;
+        break;
+    }
+
+    size_t offset = 0;
+    for (int i = 0; i < format.plane_count; i++)
+    {
+        format.planes[i].offset = offset;
+        offset = AlignUp(offset + static_cast<size_t>(format.planes[i].pitch) * format.planes[i].lines,
+                         FrameStorage::ALIGNMENT);
+    }
+
+    format.pitch = format.planes[0].pitch;
+    format.frame_size = offset;
+    return format;
+}
+
+void FitFrameSize(unsigned src_width, unsigned src_height, unsigned box_width, unsigned box_height,
+                  unsigned *width, unsigned *height)
+{
+    *width = src_width;
+    *height = src_height;
+
+    if (src_width == 0 || src_height == 0 || (box_width == 0 && box_height == 0))
+        return;
+
+    double scale = 1.0;
+    if (box_width > 0)
+        scale = std::min(scale, static_cast<double>(box_width) / src_width);
+    if (box_height > 0)
+        scale = std::min(scale, static_cast<double>(box_height) / src_height);
+
+    if (scale >= 1.0)
+        return;
+
+    // Even sizes keep 4:2:0 chroma planes exact
+    *width = std::max(2u, static_cast<unsigned>(src_width * scale + 0.5) & ~1u);
+    *height = std::max(2u, static_cast<unsigned>(src_height * scale + 0.5) & ~1u);
+}
+
+// =================================================================================================
+// FrameStorage
+// =================================================================================================
+
+void FrameSlotTable::Initialize()
+{
+    for (size_t i = 0; i <= MAX_SLOTS; i++)
+    {
+        states[i].store(static_cast<uint32_t>(FrameSlotState::FREE));
+        sequences[i].store(0);
+    }
+    ready_slot.store(-1);
+}
+
+size_t FrameStorage::SlotStride(size_t frame_size)
+{
+    // Round every slot up to the alignment so each plane base stays SIMD friendly
+    return AlignUp(frame_size, ALIGNMENT);
+}
+
+FrameStorage::FrameStorage(size_t slot_count, size_t frame_size)
+    : table_(nullptr),
+      base_(nullptr),
+      slot_count_(std::min(slot_count, FrameSlotTable::MAX_SLOTS)),
+      frame_size_(frame_size),
+      slot_stride_(SlotStride(frame_size)),
+      next_write_(0)
+{
+    // slot_count_ real slots + one scratch slot for dropped frames
+    data_.resize(slot_stride_ * (slot_count_ + 1) + ALIGNMENT);
+    uintptr_t raw = reinterpret_cast<uintptr_t>(data_.data());
+    uintptr_t aligned = (raw + ALIGNMENT - 1) & ~(static_cast<uintptr_t>(ALIGNMENT) - 1);
+    base_ = reinterpret_cast<uint8_t *>(aligned);
+
+    owned_table_.reset(new FrameSlotTable());
+    table_ = owned_table_.get();
+    table_->Initialize();
+}
+
+FrameStorage::FrameStorage(size_t slot_count, size_t frame_size, FrameSlotTable *table, uint8_t *base,
+                           std::shared_ptr<void> backing, bool initialize)
+    : backing_(std::move(backing)),
+      table_(table),
+      base_(base),
+      slot_count_(std::min(slot_count, FrameSlotTable::MAX_SLOTS)),
+      frame_size_(frame_size),
+      slot_stride_(SlotStride(frame_size)),
+      next_write_(0)
+{
+    if (initialize)
+        table_->Initialize();
+}
+
+bool FrameStorage::TransitionState(int slot, FrameSlotState from, FrameSlotState to)
+{
+    uint32_t expected = static_cast<uint32_t>(from);
+    return table_->states[slot].compare_exchange_strong(expected, static_cast<uint32_t>(to));
+}
+
+int FrameStorage::AcquireWrite()
+{
+    int count = static_cast<int>(slot_count_);
+
+    for (int i = 0; i < count; i++)
+    {
+        int candidate = (next_write_ + i) % count;
+        if (TransitionState(candidate, FrameSlotState::FREE, FrameSlotState::DECODING))
+        {
+            next_write_ = (candidate + 1) % count;
+            return candidate;
+        }
+    }
+
+    // Everything is READY/IN_USE/DECODING: decode into scratch, the frame will be dropped
+    return DropSlot();
+}
+
+bool FrameStorage::Publish(int slot, uint64_t sequence, bool *superseded)
+{
+    if (slot < 0 || slot >= static_cast<int>(slot_count_))
+        return false;
+
+    table_->sequences[slot].store(sequence, std::memory_order_release);
+    table_->states[slot].store(static_cast<uint32_t>(FrameSlotState::READY));
+
+    // The superseded frame goes back to the pool unless the reader grabbed it meanwhile
+    int previous = table_->ready_slot.exchange(slot);
+    bool freed = false;
+    if (previous >= 0 && previous != slot)
+    {
+        freed = TransitionState(previous, FrameSlotState::READY, FrameSlotState::FREE);
+    }
+    if (superseded)
+        *superseded = freed;
+    return true;
+}
+
+int FrameStorage::AcquireRead()
+{
+    // The ready slot can only move forward, a few retries are enough to catch up with the decoder
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        int slot = table_->ready_slot.load();
+        if (slot < 0)
+            return -1;
+
+        if (TransitionState(slot, FrameSlotState::READY, FrameSlotState::IN_USE))
+            return slot;
+    }
+    return -1;
+}
+
+void FrameStorage::ReleaseRead(int slot)
+{
+    if (slot < 0 || slot >= static_cast<int>(slot_count_))
+        return;
+
+    // Still the newest frame: keep it readable. Otherwise hand it back to the decoder.
+    // Publish() does exchange-then-CAS, we do store-then-load, so one side always frees it.
+    if (!TransitionState(slot, FrameSlotState::IN_USE, FrameSlotState::READY))
+        return;
+
+    if (table_->ready_slot.load() != slot)
+    {
+        TransitionState(slot, FrameSlotState::READY, FrameSlotState::FREE);
+    }
+}
+
+// =================================================================================================
+// FrameLatency
+// =================================================================================================
+
+void FrameLatency::Add(int64_t us)
+{
+    uint64_t value = us > 0 ? static_cast<uint64_t>(us) : 0;
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_us_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = max_us_.load(std::memory_order_relaxed);
+    while (value > max && !max_us_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+FrameLatencyStats FrameLatency::Snapshot() const
+{
+    FrameLatencyStats stats;
+    stats.count = count_.load(std::memory_order_relaxed);
+    stats.total_us = total_us_.load(std::memory_order_relaxed);
+    stats.max_us = max_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FrameLatency::Reset()
+{
+    count_.store(0, std::memory_order_relaxed);
+    total_us_.store(0, std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+}
+
+// =================================================================================================
+// FrameRing
+// =================================================================================================
+
+FrameRing::FrameRing()
+    : slot_count_(DEFAULT_SLOTS),
+      generation_(0),
+      sequence_(0),
+      dropped_frames_(0),
+      producer_storage_(nullptr),
+      held_generation_(0),
+      held_slot_(-1)
+{
+}
+
+void FrameRing::SetSlotCount(size_t count)
+{
+    slot_count_ = std::clamp(count, MIN_SLOTS, MAX_SLOTS);
+}
+
+void FrameRing::SetProvider(std::shared_ptr<FrameStorageProvider> provider)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    provider_ = std::move(provider);
+}
+
+std::shared_ptr<FrameStorageProvider> FrameRing::GetProvider()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return provider_;
+}
+
+void FrameRing::Configure(const FrameFormat &format)
+{
+    std::shared_ptr<FrameStorageProvider> provider = GetProvider();
+
+    // Finish with the previous provider before storage moves to a different one
+    if (producer_provider_ && producer_provider_ != provider)
+        producer_provider_->OnReset();
+
+    std::shared_ptr<FrameStorage> storage;
+    if (provider)
+        storage = provider->CreateStorage(format, slot_count_.load());
+
+    // Fall back to the heap if the provider could not allocate
+    if (!storage)
+    {
+        provider.reset();
+        storage = std::make_shared<FrameStorage>(slot_count_.load(), format.frame_size);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    format_ = format;
+    storage_ = storage;
+    producer_storage_ = storage_.get();
+    producer_provider_ = provider;
+    producer_format_ = format;
+    generation_++;
+}
+
+void FrameRing::Reset()
+{
+    if (producer_provider_)
+        producer_provider_->OnReset();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    format_ = FrameFormat();
+    storage_.reset();
+    producer_storage_ = nullptr;
+    producer_provider_.reset();
+    producer_format_ = FrameFormat();
+    generation_++;
+}
+
+FrameFormat FrameRing::GetFormat()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return format_;
+}
+
+std::shared_ptr<FrameStorage> FrameRing::GetStorage(uint32_t *generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation)
+        *generation = generation_;
+    return storage_;
+}
+
+uint8_t *FrameRing::AcquireWriteSlot(int *slot)
+{
+    if (!producer_storage_)
+        return nullptr;
+
+    *slot = producer_storage_->AcquireWrite();
+    lock_us_[*slot] = NowUs();
+    return producer_storage_->Slot(*slot);
+}
+
+void FrameRing::Publish(int slot)
+{
+    if (!producer_storage_)
+        return;
+
+    int64_t now = NowUs();
+    lock_to_display_.Add(now - lock_us_[slot]);
+
+    if (slot == producer_storage_->DropSlot())
+    {
+        dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+        if (producer_provider_)
+            producer_provider_->OnDrop();
+        return;
+    }
+
+    uint64_t sequence = sequence_.fetch_add(1, std::memory_order_relaxed) + 1;
+    publish_us_[slot].store(now, std::memory_order_relaxed);
+
+    bool superseded = false;
+    producer_storage_->Publish(slot, sequence, &superseded);
+    if (superseded)
+        overwritten_frames_.fetch_add(1, std::memory_order_relaxed);
+
+    if (producer_provider_)
+        producer_provider_->OnPublish(sequence);
+}
+
+std::shared_ptr<FrameStorage> FrameRing::HoldLatest(FrameSlotInfo *info)
+{
+    uint32_t generation = 0;
+    std::shared_ptr<FrameStorage> storage = GetStorage(&generation);
+    if (!storage)
+    {
+        ReleaseHeld();
+        return nullptr;
+    }
+
+    bool same_storage = held_storage_ == storage && held_slot_ >= 0;
+
+    // No newer frame than the one already held
+    if (same_storage && storage->ReadySlot() == held_slot_)
+    {
+        info->slot = held_slot_;
+        info->sequence = storage->SlotSequence(held_slot_);
+        info->generation = held_generation_;
+        return storage;
+    }
+
+    int slot = storage->AcquireRead();
+    if (slot < 0)
+    {
+        if (!same_storage)
+            return nullptr;
+
+        // Decoder is racing ahead, keep serving the frame we already own
+        info->slot = held_slot_;
+        info->sequence = storage->SlotSequence(held_slot_);
+        info->generation = held_generation_;
+        return storage;
+    }
+
+    ReleaseHeld();
+    held_storage_ = storage;
+    held_generation_ = generation;
+    held_slot_ = slot;
+
+    read_frames_.fetch_add(1, std::memory_order_relaxed);
+    read_latency_.Add(NowUs() - publish_us_[slot].load(std::memory_order_relaxed));
+
+    info->slot = slot;
+    info->sequence = storage->SlotSequence(slot);
+    info->generation = generation;
+    return storage;
+}
+
+void FrameRing::ReleaseHeld()
+{
+    if (held_storage_ && held_slot_ >= 0)
+    {
+        held_storage_->ReleaseRead(held_slot_);
+    }
+    held_storage_.reset();
+    held_slot_ = -1;
+}
+
+FrameRingStats FrameRing::GetStats() const
+{
+    FrameRingStats stats;
+    stats.decoded = sequence_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_frames_.load(std::memory_order_relaxed);
+    stats.overwritten = overwritten_frames_.load(std::memory_order_relaxed);
+    stats.read = read_frames_.load(std::memory_order_relaxed);
+    stats.lock_to_display = lock_to_display_.Snapshot();
+    stats.read_latency = read_latency_.Snapshot();
+    return stats;
+}
+
+void FrameRing::ResetStats()
+{
+    lock_to_display_.Reset();
+    read_latency_.Reset();
+}
@@ -0,0 +1,302 @@
+#ifndef VLC_FRAME_RING_H
+#define VLC_FRAME_RING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+
+// =================================================================================================
+// Frame Format (negotiated in the vmem format callback)
+// =================================================================================================
+
+enum class FrameChroma
+{
+    RV32, // Packed 32-bit RGB, 1 plane
+    I420, // Planar YUV 4:2:0, 3 planes (Y, U, V)
+    NV12  // Semi-planar YUV 4:2:0, 2 planes (Y, interleaved UV)
+};
+
+struct FramePlane
+{
+    size_t offset = 0; // From the start of the slot, always ALIGNMENT aligned
+    unsigned pitch = 0;
+    unsigned lines = 0;
+};
+
+struct FrameFormat
+{
+    static constexpr int MAX_PLANES = 3;
+
+    char chroma[5] = {0};
+    unsigned width = 0;
+    unsigned height = 0;
+    unsigned pitch = 0;    // Pitch of the first plane
+    size_t frame_size = 0; // Bytes needed for one complete picture
+    int plane_count = 0;
+    FramePlane planes[MAX_PLANES];
+};
+
+bool ParseFrameChroma(const std::string &name, FrameChroma *chroma);
+const char *FrameChromaName(FrameChroma chroma);
+
+/**
+ * Compute pitches/lines/offsets of every plane for the given chroma and size
+ */
+FrameFormat MakeFrameFormat(FrameChroma chroma, unsigned width, unsigned height);
+
+/**
+ * Fit the source size into a bounding box keeping the aspect ratio (never upscales).
+ * A 0 box dimension leaves that axis unconstrained. Results are rounded to even sizes.
+ */
+void FitFrameSize(unsigned src_width, unsigned src_height, unsigned box_width, unsigned box_height,
+                  unsigned *width, unsigned *height);
+
+// =================================================================================================
+// FrameStorage - One contiguous, aligned allocation holding every slot of the ring
+// =================================================================================================
+// Shared via std::shared_ptr so JS-side external ArrayBuffers can keep the memory alive
+// after the ring has been reconfigured for a new format.
+//
+// Every slot carries an atomic state, which is the only synchronisation between the decoder
+// and the JS reader:
+//
+//   FREE -> DECODING (lock) -> READY (display) -> IN_USE (JS reader) -> FREE
+//
+// A READY slot that gets superseded by a newer frame before JS picks it up goes back to FREE.
+// One extra scratch slot (DropSlot) absorbs decoding when every real slot is busy, so the
+// decoder never waits and never writes into a frame that is being read.
+
+enum class FrameSlotState : uint32_t
+{
+    FREE,
+    DECODING,
+    READY,
+    IN_USE
+};
+
+// Slot bookkeeping. Plain lock-free atomics only, so the table also works when it lives in
+// memory shared with another process (vlc_shared_frames.h).
+struct FrameSlotTable
+{
+    static constexpr size_t MAX_SLOTS = 16;
+
+    std::atomic<uint32_t> states[MAX_SLOTS + 1]; // + scratch slot
+    std::atomic<uint64_t> sequences[MAX_SLOTS + 1];
+    std::atomic<int32_t> ready_slot;
+
+    void Initialize();
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "FrameSlotTable needs lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "FrameSlotTable needs lock-free 64-bit atomics");
+
+class FrameStorage
+{
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+     * Bytes one slot occupies (frame size rounded up to ALIGNMENT)
+     */
+    static size_t SlotStride(size_t frame_size);
+
+    // Heap backed
+    FrameStorage(size_t slot_count, size_t frame_size);
+
+    /**
+     * Externally backed (shared memory): base must be ALIGNMENT aligned and hold
+     * (slot_count + 1) * SlotStride(frame_size) bytes. backing keeps the mapping alive.
+     * Pass initialize = false when attaching to a table another process owns.
+     */
+    FrameStorage(size_t slot_count, size_t frame_size, FrameSlotTable *table, uint8_t *base,
+                 std::shared_ptr<void> backing, bool initialize);
+
+    uint8_t *Slot(size_t index) { return base_ + index * slot_stride_; }
+    size_t SlotCount() const { return slot_count_; }
+    size_t FrameSize() const { return frame_size_; }
+    int DropSlot() const { return static_cast<int>(slot_count_); }
+
+    // Producer side (VLC vout thread)
+    int AcquireWrite();
+    // superseded (optional) reports whether the previous frame went back unread
+    bool Publish(int slot, uint64_t sequence, bool *superseded = nullptr);
+
+    // Consumer side (JS thread)
+    int ReadySlot() const { return table_->ready_slot.load(); }
+    int AcquireRead();
+    void ReleaseRead(int slot);
+    uint64_t SlotSequence(int slot) const { return table_->sequences[slot].load(std::memory_order_acquire); }
+
+private:
+    bool TransitionState(int slot, FrameSlotState from, FrameSlotState to);
+
+    std::vector<uint8_t> data_;
+    std::unique_ptr<FrameSlotTable> owned_table_;
+    std::shared_ptr<void> backing_;
+    FrameSlotTable *table_;
+    uint8_t *base_;
+    size_t slot_count_;
+    size_t frame_size_;
+    size_t slot_stride_;
+    int next_write_; // Producer only, round-robin start point
+};
+
+// =================================================================================================
+// FrameStorageProvider - Alternative backing for the ring (e.g. shared memory)
+// =================================================================================================
+// All calls come from the vout thread that runs the vmem callbacks.
+
+class FrameStorageProvider
+{
+public:
+    virtual ~FrameStorageProvider() = default;
+
+    virtual std::shared_ptr<FrameStorage> CreateStorage(const FrameFormat &format, size_t slot_count) = 0;
+    virtual void OnPublish(uint64_t sequence) = 0;
+    virtual void OnDrop() = 0;
+    virtual void OnReset() = 0;
+};
+
+// =================================================================================================
+// Frame Timing - Lock-free latency accumulators for the vmem path
+// =================================================================================================
+
+struct FrameLatencyStats
+{
+    uint64_t count = 0;
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+};
+
+class FrameLatency
+{
+public:
+    void Add(int64_t us);
+    FrameLatencyStats Snapshot() const;
+    void Reset();
+
+private:
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> total_us_{0};
+    std::atomic<uint64_t> max_us_{0};
+};
+
+struct FrameRingStats
+{
+    uint64_t decoded = 0;     // Published frames
+    uint64_t dropped = 0;     // Decoded into the scratch slot, every slot was busy
+    uint64_t overwritten = 0; // Superseded by a newer frame before JS read them
+    uint64_t read = 0;        // Frames JS picked up (getFrame)
+    FrameLatencyStats lock_to_display; // Buffer lock (decode start) to display (presentation time)
+    FrameLatencyStats read_latency;    // Display to the JS read
+};
+
+// =================================================================================================
+// FrameRing - Pool of pre-allocated frame slots shared between the vmem callbacks and JS
+// =================================================================================================
+// The decoder writes into a FREE slot, publishes it on display and JS picks it up by index +
+// sequence number. The mutex only guards reconfiguration and storage snapshots, the per-frame
+// path is lock-free on both sides.
+
+struct FrameSlotInfo
+{
+    int slot;
+    uint64_t sequence;
+    uint32_t generation;
+};
+
+class FrameRing
+{
+public:
+    static constexpr size_t DEFAULT_SLOTS = 3;
+    static constexpr size_t MIN_SLOTS = 2;
+    static constexpr size_t MAX_SLOTS = FrameSlotTable::MAX_SLOTS;
+
+    FrameRing();
+
+    /**
+     * Set number of slots used by the next Configure() call
+     */
+    void SetSlotCount(size_t count);
+    size_t GetSlotCount() const { return slot_count_.load(); }
+
+    /**
+     * Allocate slots through provider (nullptr = heap) from the next Configure() call on
+     */
+    void SetProvider(std::shared_ptr<FrameStorageProvider> provider);
+    std::shared_ptr<FrameStorageProvider> GetProvider();
+
+    /**
+     * (Re)allocate all slots for a new format. Called from the vmem format/cleanup callbacks.
+     * Bumps the generation so JS knows previously handed out buffers are stale.
+     */
+    void Configure(const FrameFormat &format);
+    void Reset();
+
+    FrameFormat GetFormat();
+    const FrameFormat &GetProducerFormat() const { return producer_format_; }
+    uint32_t GetGeneration() const { return generation_.load(); }
+    std::shared_ptr<FrameStorage> GetStorage(uint32_t *generation = nullptr);
+
+    uint64_t GetDroppedFrames() const { return dropped_frames_.load(std::memory_order_relaxed); }
+    uint64_t GetDecodedFrames() const { return sequence_.load(std::memory_order_relaxed); }
+
+    /**
+     * Counter snapshot, relaxed atomic loads only (safe from any thread, values may be skewed by a frame)
+     */
+    FrameRingStats GetStats() const;
+    void ResetStats(); // Latencies only, the frame counters keep counting
+
+    // Producer side (VLC vout thread)
+    uint8_t *AcquireWriteSlot(int *slot);
+    void Publish(int slot);
+
+    // Pixels of a slot from AcquireWriteSlot(), nullptr for the drop slot (not published to readers)
+    uint8_t *ProducerPixels(int slot) const
+    {
+        if (!producer_storage_ || slot < 0 || slot == producer_storage_->DropSlot())
+            return nullptr;
+        return producer_storage_->Slot(slot);
+    }
+
+    // Consumer side (JS thread)
+    /**
+     * Take the newest READY frame and keep it IN_USE until the next call (or ReleaseHeld).
+     * Returns the storage the slot belongs to, nullptr if no frame is available.
+     */
+    std::shared_ptr<FrameStorage> HoldLatest(FrameSlotInfo *info);
+    void ReleaseHeld();
+
+private:
+    std::mutex mutex_;
+    std::shared_ptr<FrameStorage> storage_;
+    std::shared_ptr<FrameStorageProvider> provider_;
+    FrameFormat format_;
+    std::atomic<size_t> slot_count_;
+    std::atomic<uint32_t> generation_;
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> dropped_frames_;
+    std::atomic<uint64_t> overwritten_frames_{0};
+    std::atomic<uint64_t> read_frames_{0};
+
+    FrameLatency lock_to_display_;
+    FrameLatency read_latency_;
+    int64_t lock_us_[MAX_SLOTS + 1] = {};     // Producer only, per slot (+ scratch)
+    std::atomic<int64_t> publish_us_[MAX_SLOTS + 1] = {}; // Written on publish, read by the consumer
+
+    // Producer only (vout thread also runs the format/cleanup callbacks that swap storage_)
+    FrameStorage *producer_storage_;
+    std::shared_ptr<FrameStorageProvider> producer_provider_; // Provider producer_storage_ came from
+    FrameFormat producer_format_;
+
+    // Consumer only (JS thread)
+    std::shared_ptr<FrameStorage> held_storage_;
+    uint32_t held_generation_;
+    int held_slot_;
+};
+
+#endif // VLC_FRAME_RING_H
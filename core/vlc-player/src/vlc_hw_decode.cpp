@@ -0,0 +1,425 @@
+#include "vlc_hw_decode.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <d3d11.h>
+#include <d3d9.h>
+#elif defined(__linux__)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <X11/Xlib.h>
+#endif
+
+// =================================================================================================
+// Names
+// =================================================================================================
+
+bool ParseHwDecoder(const std::string &name, HwDecoder *decoder)
+{
+    if (name == "auto")
+        *decoder = HwDecoder::AUTO;
+    else if (name == "none")
+        *decoder = HwDecoder::NONE;
+    else if (name == "vaapi")
+        *decoder = HwDecoder::VAAPI;
+    else if (name == "vdpau")
+        *decoder = HwDecoder::VDPAU;
+    else if (name == "d3d11va")
+        *decoder = HwDecoder::D3D11VA;
+    else if (name == "dxva2")
+        *decoder = HwDecoder::DXVA2;
+    else
+        return false;
+    return true;
+}
+
+const char *HwDecoderName(HwDecoder decoder)
+{
+    switch (decoder)
+    {
+    case HwDecoder::NONE:
+        return "none";
+    case HwDecoder::VAAPI:
+        return "vaapi";
+    case HwDecoder::VDPAU:
+        return "vdpau";
+    case HwDecoder::D3D11VA:
+        return "d3d11va";
+    case HwDecoder::DXVA2:
+        return "dxva2";
+    case HwDecoder::AUTO:
+    default:
+        return "auto";
+    }
+}
+
+std::string HwDecoderOptionValue(HwDecoder decoder)
+{
+    if (decoder != HwDecoder::AUTO)
+        return HwDecoderName(decoder);
+
+    // Skip the module search (and its failed driver opens) on every media when nothing works
+    if (const std::vector<HwDecoderCaps> *caps = ProbedHwDecoders())
+    {
+        bool any = false;
+        for (const HwDecoderCaps &cap : *caps)
+            any = any || cap.available;
+        if (!caps->empty() && !any)
+            return "none";
+    }
+    return "any";
+}
+
+// =================================================================================================
+// Platform Probes
+// =================================================================================================
+
+#ifdef _WIN32
+
+struct DecoderProfile
+{
+    GUID guid;
+    const char *codec;
+};
+
+// DXVA decoder profile GUIDs, shared by D3D11 video and DXVA2
+static const DecoderProfile DECODER_PROFILES[] = {
+    {{0x1b81be68, 0xa0c7, 0x11d3, {0xb9, 0x84, 0x00, 0xc0, 0x4f, 0x2e, 0x73, 0xc5}}, "h264"},
+    {{0x5b11d51b, 0x2f4c, 0x4452, {0xbc, 0xc3, 0x09, 0xf2, 0xa1, 0x16, 0x0c, 0xc0}}, "hevc"},
+    {{0x107af0e0, 0xef1a, 0x4d19, {0xab, 0xa8, 0x67, 0xa1, 0x63, 0x07, 0x3d, 0x13}}, "hevc10"},
+    {{0x463707f8, 0xa1d0, 0x4585, {0x87, 0x6d, 0x83, 0xaa, 0x6d, 0x60, 0xb8, 0x9e}}, "vp9"},
+    {{0xa4c749ef, 0x6ecf, 0x48aa, {0x84, 0x48, 0x50, 0xa7, 0xa1, 0x16, 0x5f, 0xf7}}, "vp9-10"},
+    {{0xb8be4ccb, 0xcf53, 0x46ba, {0x8d, 0x59, 0xd6, 0xb8, 0xa6, 0xda, 0x5d, 0x2a}}, "av1"},
+    {{0xee27417f, 0x5e28, 0x4e65, {0xbe, 0xea, 0x1d, 0x26, 0xb5, 0x08, 0xad, 0xc9}}, "mpeg2"},
+};
+
+static void AddCodec(std::vector<std::string> *codecs, const char *codec)
+{
+    for (const std::string &known : *codecs)
+    {
+        if (known == codec)
+            return;
+    }
+    codecs->push_back(codec);
+}
+
+static HwDecoderCaps ProbeD3D11VA()
+{
+    HwDecoderCaps caps;
+    caps.decoder = HwDecoder::D3D11VA;
+
+    HMODULE module = LoadLibraryW(L"d3d11.dll");
+    if (!module)
+    {
+        caps.detail = "d3d11.dll not found";
+        return caps;
+    }
+
+    auto create_device = reinterpret_cast<PFN_D3D11_CREATE_DEVICE>(GetProcAddress(module, "D3D11CreateDevice"));
+    ID3D11Device *device = nullptr;
+    HRESULT hr = create_device ? create_device(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr,
+                                               D3D11_CREATE_DEVICE_VIDEO_SUPPORT, nullptr, 0,
+                                               D3D11_SDK_VERSION, &device, nullptr, nullptr)
+                               : E_FAIL;
+    if (FAILED(hr) || !device)
+    {
+        caps.detail = "no hardware device with video support";
+        FreeLibrary(module);
+        return caps;
+    }
+
+    ID3D11VideoDevice *video = nullptr;
+    if (SUCCEEDED(device->QueryInterface(__uuidof(ID3D11VideoDevice), reinterpret_cast<void **>(&video))))
+    {
+        UINT count = video->GetVideoDecoderProfileCount();
+        for (UINT i = 0; i < count; i++)
+        {
+            GUID profile;
+            if (FAILED(video->GetVideoDecoderProfile(i, &profile)))
+                continue;
+            for (const DecoderProfile &known : DECODER_PROFILES)
+            {
+                if (IsEqualGUID(profile, known.guid))
+                    AddCodec(&caps.codecs, known.codec);
+            }
+        }
+        video->Release();
+    }
+
+    IDXGIDevice *dxgi = nullptr;
+    if (SUCCEEDED(device->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void **>(&dxgi))))
+    {
+        IDXGIAdapter *adapter = nullptr;
+        DXGI_ADAPTER_DESC desc;
+        if (SUCCEEDED(dxgi->GetAdapter(&adapter)) && SUCCEEDED(adapter->GetDesc(&desc)))
+        {
+            char name[256];
+            WideCharToMultiByte(CP_UTF8, 0, desc.Description, -1, name, sizeof(name), nullptr, nullptr);
+            caps.detail = name;
+        }
+        if (adapter)
+            adapter->Release();
+        dxgi->Release();
+    }
+
+    caps.available = !caps.codecs.empty();
+    if (!caps.available)
+        caps.detail = "no decoder profiles";
+
+    device->Release();
+    FreeLibrary(module);
+    return caps;
+}
+
+static HwDecoderCaps ProbeDXVA2(const HwDecoderCaps &d3d11)
+{
+    HwDecoderCaps caps;
+    caps.decoder = HwDecoder::DXVA2;
+
+    HMODULE dxva2 = LoadLibraryW(L"dxva2.dll");
+    HMODULE d3d9 = LoadLibraryW(L"d3d9.dll");
+    if (!dxva2 || !d3d9)
+    {
+        caps.detail = "dxva2.dll or d3d9.dll not found";
+    }
+    else
+    {
+        using Direct3DCreate9Fn = IDirect3D9 *(WINAPI *)(UINT);
+        auto create = reinterpret_cast<Direct3DCreate9Fn>(GetProcAddress(d3d9, "Direct3DCreate9"));
+        IDirect3D9 *d3d = create ? create(D3D_SDK_VERSION) : nullptr;
+        D3DADAPTER_IDENTIFIER9 identifier;
+        if (d3d && d3d->GetAdapterCount() > 0 && SUCCEEDED(d3d->GetAdapterIdentifier(D3DADAPTER_DEFAULT, 0, &identifier)))
+        {
+            caps.available = true;
+            caps.detail = identifier.Description;
+            // Same driver, same decoder profiles (enumerating them needs a D3D9 device and a window)
+            caps.codecs = d3d11.codecs;
+        }
+        else
+        {
+            caps.detail = "no Direct3D 9 adapter";
+        }
+        if (d3d)
+            d3d->Release();
+    }
+
+    if (d3d9)
+        FreeLibrary(d3d9);
+    if (dxva2)
+        FreeLibrary(dxva2);
+    return caps;
+}
+
+static std::vector<HwDecoderCaps> RunProbe()
+{
+    std::vector<HwDecoderCaps> result;
+    result.push_back(ProbeD3D11VA());
+    result.push_back(ProbeDXVA2(result.front()));
+    return result;
+}
+
+#elif defined(__linux__)
+
+// Only the few libva/libvdpau entry points the probe needs, so no development headers are required
+using VADisplay = void *;
+using VAStatus = int;
+using VAGetDisplayDRMFn = VADisplay (*)(int fd);
+using VAInitializeFn = VAStatus (*)(VADisplay display, int *major, int *minor);
+using VATerminateFn = VAStatus (*)(VADisplay display);
+using VAMaxNumProfilesFn = int (*)(VADisplay display);
+using VAQueryConfigProfilesFn = VAStatus (*)(VADisplay display, int *profiles, int *count);
+using VAQueryVendorStringFn = const char *(*)(VADisplay display);
+
+struct VAProfileName
+{
+    int profile; // VAProfile
+    const char *codec;
+};
+
+static const VAProfileName VA_PROFILES[] = {
+    {1, "mpeg2"},   // VAProfileMPEG2Main
+    {6, "h264"},    // VAProfileH264Main
+    {7, "h264"},    // VAProfileH264High
+    {17, "hevc"},   // VAProfileHEVCMain
+    {18, "hevc10"}, // VAProfileHEVCMain10
+    {19, "vp9"},    // VAProfileVP9Profile0
+    {21, "vp9-10"}, // VAProfileVP9Profile2
+    {32, "av1"},    // VAProfileAV1Profile0
+};
+
+static void AddCodec(std::vector<std::string> *codecs, const char *codec)
+{
+    for (const std::string &known : *codecs)
+    {
+        if (known == codec)
+            return;
+    }
+    codecs->push_back(codec);
+}
+
+static HwDecoderCaps ProbeVAAPI()
+{
+    HwDecoderCaps caps;
+    caps.decoder = HwDecoder::VAAPI;
+
+    void *va = dlopen("libva.so.2", RTLD_NOW | RTLD_LOCAL);
+    void *va_drm = va ? dlopen("libva-drm.so.2", RTLD_NOW | RTLD_LOCAL) : nullptr;
+    if (!va || !va_drm)
+    {
+        caps.detail = "libva not installed";
+        if (va)
+            dlclose(va);
+        return caps;
+    }
+
+    auto get_display = reinterpret_cast<VAGetDisplayDRMFn>(dlsym(va_drm, "vaGetDisplayDRM"));
+    auto initialize = reinterpret_cast<VAInitializeFn>(dlsym(va, "vaInitialize"));
+    auto terminate = reinterpret_cast<VATerminateFn>(dlsym(va, "vaTerminate"));
+    auto max_profiles = reinterpret_cast<VAMaxNumProfilesFn>(dlsym(va, "vaMaxNumProfiles"));
+    auto query_profiles = reinterpret_cast<VAQueryConfigProfilesFn>(dlsym(va, "vaQueryConfigProfiles"));
+    auto vendor = reinterpret_cast<VAQueryVendorStringFn>(dlsym(va, "vaQueryVendorString"));
+
+    caps.detail = "no DRM render node";
+    if (get_display && initialize && terminate && max_profiles && query_profiles)
+    {
+        // First render node whose driver initialises
+        for (int node = 128; node < 136 && !caps.available; node++)
+        {
+            std::string path = "/dev/dri/renderD" + std::to_string(node);
+            int fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0)
+                continue;
+
+            VADisplay display = get_display(fd);
+            int major = 0, minor = 0;
+            if (display && initialize(display, &major, &minor) == 0)
+            {
+                std::vector<int> profiles(static_cast<size_t>(std::max(max_profiles(display), 0)));
+                int count = 0;
+                if (!profiles.empty() && query_profiles(display, profiles.data(), &count) == 0)
+                {
+                    for (int i = 0; i < count; i++)
+                    {
+                        for (const VAProfileName &known : VA_PROFILES)
+                        {
+                            if (profiles[i] == known.profile)
+                                AddCodec(&caps.codecs, known.codec);
+                        }
+                    }
+                }
+
+                caps.available = !caps.codecs.empty();
+                const char *name = vendor ? vendor(display) : nullptr;
+                caps.detail = caps.available ? (name ? name : path) : "no decoder profiles on " + path;
+                terminate(display);
+            }
+            else if (display)
+            {
+                terminate(display);
+                caps.detail = "driver failed to initialise on " + path;
+            }
+            close(fd);
+        }
+    }
+
+    dlclose(va_drm);
+    dlclose(va);
+    return caps;
+}
+
+// VdpFuncId of VdpDeviceDestroy
+static constexpr uint32_t VDP_FUNC_ID_DEVICE_DESTROY = 5;
+
+using VdpGetProcAddressFn = uint32_t (*)(uint32_t device, uint32_t function_id, void **function);
+using VdpDeviceCreateX11Fn = uint32_t (*)(Display *display, int screen, uint32_t *device,
+                                          VdpGetProcAddressFn *get_proc_address);
+using VdpDeviceDestroyFn = uint32_t (*)(uint32_t device);
+
+static HwDecoderCaps ProbeVDPAU()
+{
+    HwDecoderCaps caps;
+    caps.decoder = HwDecoder::VDPAU;
+
+    void *vdpau = dlopen("libvdpau.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!vdpau)
+    {
+        caps.detail = "libvdpau not installed";
+        return caps;
+    }
+
+    auto create = reinterpret_cast<VdpDeviceCreateX11Fn>(dlsym(vdpau, "vdp_device_create_x11"));
+    Display *display = create ? XOpenDisplay(nullptr) : nullptr;
+    if (!display)
+    {
+        caps.detail = "no X11 display";
+    }
+    else
+    {
+        uint32_t device = 0;
+        VdpGetProcAddressFn get_proc_address = nullptr;
+        if (create(display, DefaultScreen(display), &device, &get_proc_address) == 0 && get_proc_address)
+        {
+            // The driver loaded and created a device, VLC queries the per-codec limits itself
+            caps.available = true;
+            caps.detail = "device created";
+
+            void *destroy = nullptr;
+            if (get_proc_address(device, VDP_FUNC_ID_DEVICE_DESTROY, &destroy) == 0 && destroy)
+                reinterpret_cast<VdpDeviceDestroyFn>(destroy)(device);
+        }
+        else
+        {
+            caps.detail = "no VDPAU driver for this display";
+        }
+        XCloseDisplay(display);
+    }
+
+    dlclose(vdpau);
+    return caps;
+}
+
+static std::vector<HwDecoderCaps> RunProbe()
+{
+    std::vector<HwDecoderCaps> result;
+    result.push_back(ProbeVAAPI());
+    result.push_back(ProbeVDPAU());
+    return result;
+}
+
+#else
+
+// VideoToolbox is always present on supported macOS versions, "auto" selects it
+static std::vector<HwDecoderCaps> RunProbe()
+{
+    return {};
+}
+
+#endif
+
+// =================================================================================================
+// Probe Cache
+// =================================================================================================
+
+static std::once_flag probe_once;
+static std::vector<HwDecoderCaps> probe_result;
+static std::atomic<bool> probe_done{false};
+
+const std::vector<HwDecoderCaps> &ProbeHwDecoders()
+{
+    std::call_once(probe_once, []()
+                   {
+                       probe_result = RunProbe();
+                       probe_done = true;
+                   });
+    return probe_result;
+}
+
+const std::vector<HwDecoderCaps> *ProbedHwDecoders()
+{
+    return probe_done ? &probe_result : nullptr;
+}
@@ -0,0 +1,58 @@
+#ifndef VLC_HW_DECODE_H
+#define VLC_HW_DECODE_H
+
+#include <string>
+#include <vector>
+
+// =================================================================================================
+// Hardware Decoding - Decoder selection and capability probing
+// =================================================================================================
+// libVLC picks a hardware decoder per media through :avcodec-hw and silently falls back to
+// software when it fails, which is how 4K HEVC ends up decoded on the CPU. The probe opens each
+// platform API once (VA-API over a DRM render node, VDPAU over X11, D3D11 video device, D3D9)
+// through the system libraries loaded at run time, and lists the codec profiles the driver
+// can decode, so the app can choose before the first open instead of guessing from dropped frames.
+//
+// With the native window the video output consumes the decoder's GPU surfaces directly. With
+// memory rendering libVLC 3 has to copy surfaces back for vmem, so the frames pass through host
+// memory once. Asking for NV12 then makes that copy a plain plane copy with no conversion.
+
+enum class HwDecoder
+{
+    AUTO = 0, // :avcodec-hw=any, libVLC tries every hardware decoder in priority order
+    NONE,
+    VAAPI,
+    VDPAU,
+    D3D11VA,
+    DXVA2
+};
+
+struct HwDecoderCaps
+{
+    HwDecoder decoder;
+    bool available = false;
+    std::string detail;              // Driver/vendor string or why the probe failed
+    std::vector<std::string> codecs; // Decodable profiles: h264, hevc, hevc10, vp9, vp9-10, av1, ...
+};
+
+bool ParseHwDecoder(const std::string &name, HwDecoder *decoder);
+const char *HwDecoderName(HwDecoder decoder);
+
+/**
+ * Value for the :avcodec-hw media option
+ * AUTO resolves to none once the probe has found no working decoder on this machine
+ */
+std::string HwDecoderOptionValue(HwDecoder decoder);
+
+/**
+ * Probe the hardware decoders of this platform, runs once and may take tens of milliseconds
+ * (driver initialisation), call it off the JS thread. Thread-safe.
+ */
+const std::vector<HwDecoderCaps> &ProbeHwDecoders();
+
+/**
+ * Result of a probe that already ran, nullptr before that (never blocks)
+ */
+const std::vector<HwDecoderCaps> *ProbedHwDecoders();
+
+#endif // VLC_HW_DECODE_H
@@ -1,4 +1,5 @@
 #include "vlc_player.h"
+#include <algorithm>
 
 // =================================================================================================
 // Media & Player Info API
@@ -6,11 +7,11 @@
 
 Napi::Value VlcPlayer::GetMediaInfo(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    std::lock_guard<std::mutex> lock(mutex_);
+    PlayerLock lock(player_mutex_);
     return GetMediaInfoObject(env);
 }
 
-Napi::Object VlcPlayer::GetMediaInfoObject(Napi::Env env) {
+Napi::Object VlcPlayer::GetMediaInfoObject(Napi::Env env, uint64_t* track_version) {
     Napi::Object result = Napi::Object::New(env);
 
     if (!media_player_) return result;
@@ -21,56 +22,229 @@ Napi::Object VlcPlayer::GetMediaInfoObject(Napi::Env env) {
     Napi::Object meta = Napi::Object::New(env);
     result.Set("meta", meta);
 
-    // Audio Tracks
-    Napi::Array audioTracks = Napi::Array::New(env);
-    libvlc_track_description_t* a_tracks = libvlc_audio_get_track_description(media_player_);
-    if (a_tracks) {
-        libvlc_track_description_t* t = a_tracks;
-        int i = 0;
-        while(t) {
-            Napi::Object track = Napi::Object::New(env);
-            track.Set("id", t->i_id);
-            track.Set("name", t->psz_name ? t->psz_name : "");
-            audioTracks.Set(i++, track);
-            t = t->p_next;
+    TrackLists tracks = track_cache_.Get(media_player_, track_version);
+    result.Set("audioTracks", TracksToArray(env, tracks.audio));
+    result.Set("subtitleTracks", TracksToArray(env, tracks.subtitle));
+    result.Set("videoTracks", TracksToArray(env, tracks.video));
+
+    result.Set("latency", LatencyStatsToObject(env, latency_.GetStats()));
+
+    return result;
+}
+
+// =================================================================================================
+// Pre-parse Snapshot (worker thread -> JS)
+// =================================================================================================
+
+static std::string TrackName(const libvlc_media_track_t* track) {
+    std::string name;
+    if (track->psz_description && *track->psz_description) {
+        name = track->psz_description;
+    }
+    if (track->psz_language && *track->psz_language) {
+        name = name.empty() ? track->psz_language : name + " [" + track->psz_language + "]";
+    }
+    if (name.empty()) {
+        name = "Track " + std::to_string(track->i_id);
+    }
+    return name;
+}
+
+void VlcPlayer::SnapshotMediaInfo(libvlc_media_t* media, MediaInfoSnapshot* snapshot) {
+    if (!media) return;
+
+    libvlc_media_parsed_status_t status = libvlc_media_get_parsed_status(media);
+    switch (status) {
+        case libvlc_media_parsed_status_done: snapshot->parse_status = "done"; break;
+        case libvlc_media_parsed_status_failed: snapshot->parse_status = "failed"; break;
+        case libvlc_media_parsed_status_timeout: snapshot->parse_status = "timeout"; break;
+        case libvlc_media_parsed_status_skipped: snapshot->parse_status = "skipped"; break;
+        default: snapshot->parse_status = "none"; break;
+    }
+    snapshot->parsed = status == libvlc_media_parsed_status_done;
+
+    snapshot->duration = libvlc_media_get_duration(media);
+
+    static const struct { libvlc_meta_t key; const char* name; } meta_keys[] = {
+        { libvlc_meta_Title, "title" },
+        { libvlc_meta_Artist, "artist" },
+        { libvlc_meta_Genre, "genre" },
+        { libvlc_meta_Description, "description" },
+        { libvlc_meta_NowPlaying, "nowPlaying" },
+    };
+    for (const auto& key : meta_keys) {
+        char* value = libvlc_media_get_meta(media, key.key);
+        if (value) {
+            snapshot->meta[key.name] = value;
+            libvlc_free(value);
+        }
+    }
+
+    libvlc_media_track_t** tracks = nullptr;
+    unsigned count = libvlc_media_tracks_get(media, &tracks);
+    for (unsigned i = 0; i < count; i++) {
+        MediaTrackSnapshot track{ tracks[i]->i_id, TrackName(tracks[i]) };
+        switch (tracks[i]->i_type) {
+            case libvlc_track_audio: snapshot->audio_tracks.push_back(track); break;
+            case libvlc_track_video: snapshot->video_tracks.push_back(track); break;
+            case libvlc_track_text: snapshot->subtitle_tracks.push_back(track); break;
+            default: break;
         }
-        libvlc_track_description_list_release(a_tracks);
     }
-    result.Set("audioTracks", audioTracks);
-
-    // Subtitle Tracks
-    Napi::Array subTracks = Napi::Array::New(env);
-    libvlc_track_description_t* s_tracks = libvlc_video_get_spu_description(media_player_);
-    if (s_tracks) {
-        libvlc_track_description_t* t = s_tracks;
-        int i = 0;
-        while(t) {
-            Napi::Object track = Napi::Object::New(env);
-            track.Set("id", t->i_id);
-            track.Set("name", t->psz_name ? t->psz_name : "");
-            subTracks.Set(i++, track);
-            t = t->p_next;
+    if (tracks) {
+        libvlc_media_tracks_release(tracks, count);
+    }
+}
+
+Napi::Object VlcPlayer::MediaInfoSnapshotToObject(Napi::Env env, const MediaInfoSnapshot& snapshot) {
+    Napi::Object result = Napi::Object::New(env);
+
+    result.Set("duration", Napi::Number::New(env, static_cast<double>(snapshot.duration)));
+    // Seekability is only known once the input is running
+    result.Set("isSeekable", Napi::Boolean::New(env, false));
+    result.Set("parsed", Napi::Boolean::New(env, snapshot.parsed));
+    result.Set("parseStatus", Napi::String::New(env, snapshot.parse_status));
+
+    Napi::Object meta = Napi::Object::New(env);
+    for (const auto& entry : snapshot.meta) {
+        meta.Set(entry.first, Napi::String::New(env, entry.second));
+    }
+    result.Set("meta", meta);
+
+    result.Set("audioTracks", TracksToArray(env, snapshot.audio_tracks));
+    result.Set("subtitleTracks", TracksToArray(env, snapshot.subtitle_tracks));
+    result.Set("videoTracks", TracksToArray(env, snapshot.video_tracks));
+
+    return result;
+}
+
+Napi::Array VlcPlayer::TracksToArray(Napi::Env env, const std::vector<MediaTrackSnapshot>& tracks) {
+    Napi::Array array = Napi::Array::New(env, tracks.size());
+    for (size_t i = 0; i < tracks.size(); i++) {
+        Napi::Object track = Napi::Object::New(env);
+        track.Set("id", tracks[i].id);
+        track.Set("name", tracks[i].name);
+        array.Set(static_cast<uint32_t>(i), track);
+    }
+    return array;
+}
+
+// =================================================================================================
+// Playback Statistics
+// =================================================================================================
+
+/**
+ * getStats({ interval?, reset? }) -> { media, input, demux, video, audio, vmem, latency, events, tracks }
+ *
+ * interval (ms) also emits the same object as a "stats" event while playing, 0 turns it off.
+ * reset clears the vmem latency accumulators after the snapshot.
+ * Bitrates are kbit/s, latencies microseconds.
+ */
+Napi::Value VlcPlayer::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    bool reset = false;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("interval")) {
+            int64_t interval = options.Get("interval").As<Napi::Number>().Int64Value();
+            stats_interval_ms_ = std::max<int64_t>(0, interval);
+            next_stats_event_ms_ = 0;
         }
-        libvlc_track_description_list_release(s_tracks);
+        if (options.Has("reset")) {
+            reset = options.Get("reset").ToBoolean().Value();
+        }
+    }
+
+    PlaybackStatsSnapshot snapshot;
+    SnapshotStats(&snapshot);
+    if (reset) {
+        frame_ring_.ResetStats();
     }
-    result.Set("subtitleTracks", subTracks);
-
-    // Video Tracks
-    Napi::Array videoTracks = Napi::Array::New(env);
-    libvlc_track_description_t* v_tracks = libvlc_video_get_track_description(media_player_);
-    if (v_tracks) {
-        libvlc_track_description_t* t = v_tracks;
-        int i = 0;
-        while(t) {
-            Napi::Object track = Napi::Object::New(env);
-            track.Set("id", t->i_id);
-            track.Set("name", t->psz_name ? t->psz_name : "");
-            videoTracks.Set(i++, track);
-            t = t->p_next;
+    return StatsSnapshotToObject(env, snapshot);
+}
+
+void VlcPlayer::SnapshotStats(PlaybackStatsSnapshot* snapshot) {
+    {
+        PlayerLock lock(player_mutex_);
+        if (media_player_) {
+            if (libvlc_media_t* media = libvlc_media_player_get_media(media_player_)) {
+                snapshot->has_media = libvlc_media_get_stats(media, &snapshot->media) != 0;
+                libvlc_media_release(media);
+            }
         }
-        libvlc_track_description_list_release(v_tracks);
     }
-    result.Set("videoTracks", videoTracks);
+
+    snapshot->buffering = buffering_progress_.load();
+    snapshot->vmem = frame_ring_.GetStats();
+    snapshot->events = event_aggregator_.GetStats();
+    snapshot->latency = latency_.GetStats();
+    snapshot->tracks = track_cache_.GetStats();
+}
+
+static Napi::Object FrameLatencyToObject(Napi::Env env, const FrameLatencyStats& latency) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("count", Napi::Number::New(env, static_cast<double>(latency.count)));
+    result.Set("avg", Napi::Number::New(env, latency.count ? static_cast<double>(latency.total_us) / latency.count : 0.0));
+    result.Set("max", Napi::Number::New(env, static_cast<double>(latency.max_us)));
+    return result;
+}
+
+Napi::Object VlcPlayer::StatsSnapshotToObject(Napi::Env env, const PlaybackStatsSnapshot& snapshot) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hasMedia", Napi::Boolean::New(env, snapshot.has_media));
+    result.Set("buffering", Napi::Number::New(env, snapshot.buffering));
+
+    // libVLC reports rates in bytes per microsecond
+    const libvlc_media_stats_t& media = snapshot.media;
+
+    Napi::Object input = Napi::Object::New(env);
+    input.Set("readBytes", Napi::Number::New(env, media.i_read_bytes));
+    input.Set("bitrate", Napi::Number::New(env, media.f_input_bitrate * 8000.0));
+    result.Set("input", input);
+
+    Napi::Object demux = Napi::Object::New(env);
+    demux.Set("readBytes", Napi::Number::New(env, media.i_demux_read_bytes));
+    demux.Set("bitrate", Napi::Number::New(env, media.f_demux_bitrate * 8000.0));
+    demux.Set("corrupted", Napi::Number::New(env, media.i_demux_corrupted));
+    demux.Set("discontinuity", Napi::Number::New(env, media.i_demux_discontinuity));
+    result.Set("demux", demux);
+
+    Napi::Object video = Napi::Object::New(env);
+    video.Set("decoded", Napi::Number::New(env, media.i_decoded_video));
+    video.Set("displayed", Napi::Number::New(env, media.i_displayed_pictures));
+    video.Set("lost", Napi::Number::New(env, media.i_lost_pictures));
+    result.Set("video", video);
+
+    Napi::Object audio = Napi::Object::New(env);
+    audio.Set("decoded", Napi::Number::New(env, media.i_decoded_audio));
+    audio.Set("played", Napi::Number::New(env, media.i_played_abuffers));
+    audio.Set("lost", Napi::Number::New(env, media.i_lost_abuffers));
+    result.Set("audio", audio);
+
+    // Memory rendering path (all zero with the native window)
+    Napi::Object vmem = Napi::Object::New(env);
+    vmem.Set("decoded", Napi::Number::New(env, static_cast<double>(snapshot.vmem.decoded)));
+    vmem.Set("dropped", Napi::Number::New(env, static_cast<double>(snapshot.vmem.dropped)));
+    vmem.Set("overwritten", Napi::Number::New(env, static_cast<double>(snapshot.vmem.overwritten)));
+    vmem.Set("read", Napi::Number::New(env, static_cast<double>(snapshot.vmem.read)));
+    vmem.Set("lockToDisplay", FrameLatencyToObject(env, snapshot.vmem.lock_to_display));
+    vmem.Set("readLatency", FrameLatencyToObject(env, snapshot.vmem.read_latency));
+    result.Set("vmem", vmem);
+
+    result.Set("latency", LatencyStatsToObject(env, snapshot.latency));
+
+    Napi::Object events = Napi::Object::New(env);
+    events.Set("recorded", Napi::Number::New(env, static_cast<double>(snapshot.events.recorded)));
+    events.Set("dropped", Napi::Number::New(env, static_cast<double>(snapshot.events.dropped)));
+    events.Set("flushes", Napi::Number::New(env, static_cast<double>(snapshot.events.flushes)));
+    result.Set("events", events);
+
+    Napi::Object tracks = Napi::Object::New(env);
+    tracks.Set("hits", Napi::Number::New(env, static_cast<double>(snapshot.tracks.hits)));
+    tracks.Set("refreshes", Napi::Number::New(env, static_cast<double>(snapshot.tracks.refreshes)));
+    tracks.Set("invalidations", Napi::Number::New(env, static_cast<double>(snapshot.tracks.invalidations)));
+    result.Set("tracks", tracks);
 
     return result;
 }
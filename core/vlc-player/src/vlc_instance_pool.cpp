@@ -0,0 +1,284 @@
+#include "vlc_instance_pool.h"
+#include "vlc_player.h"
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+
+// =================================================================================================
+// Singleton
+// =================================================================================================
+
+VlcInstancePool &VlcInstancePool::Get()
+{
+    static VlcInstancePool pool;
+    return pool;
+}
+
+VlcInstancePool::VlcInstancePool()
+    : instance_(nullptr),
+      instance_refs_(0),
+      pinned_(false),
+      plugin_cache_(PluginCacheMode::REUSE),
+      borrowed_players_(0),
+      warm_target_(DEFAULT_WARM_PLAYERS),
+      max_idle_(DEFAULT_MAX_IDLE)
+{
+}
+
+// =================================================================================================
+// Instance Lifecycle
+// =================================================================================================
+
+libvlc_instance_t *VlcInstancePool::CreateInstance()
+{
+    // Initialize VLC with platform-specific parameters
+    std::vector<const char *> args;
+#ifdef _WIN32
+    // Windows: VLC plugins must be in the same directory as the .node file
+    // This is handled by binding.gyp copying plugins to build directory
+    args.push_back("--no-video-title-show");
+    args.push_back("--intf=dummy");
+#elif defined(__linux__)
+    const char *plugin_path = getenv("VLC_PLUGIN_PATH");
+    if (!plugin_path)
+    {
+        const char *default_plugin_path = "/usr/lib/x86_64-linux-gnu/vlc/plugins";
+        setenv("VLC_PLUGIN_PATH", default_plugin_path, 1);
+    }
+
+    args.push_back("--vout=xcb_x11");
+    args.push_back("--osd");
+#elif defined(__APPLE__)
+    args.push_back("--no-video-title-show");
+    args.push_back("--intf=dummy");
+#else
+    args.push_back("-vv");
+    args.push_back("--no-video-title-show");
+    args.push_back("--intf=dummy");
+#endif
+
+    // Plugin cache: reusing plugins.dat skips the full plugin scan on every start
+    switch (plugin_cache_)
+    {
+    case PluginCacheMode::REBUILD:
+        args.push_back("--reset-plugins-cache");
+        break;
+    case PluginCacheMode::OFF:
+        args.push_back("--no-plugins-cache");
+        break;
+    case PluginCacheMode::REUSE:
+    default:
+        args.push_back("--plugins-cache");
+        break;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    VlcPlayer::Log("CALL: libvlc_new(argc=%zu, args=[...])", args.size());
+    libvlc_instance_t *instance = libvlc_new(static_cast<int>(args.size()), args.data());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+    VlcPlayer::Log("RETURN: vlc_instance=%p (%lld ms)", (void *)instance, (long long)elapsed.count());
+
+    return instance;
+}
+
+libvlc_instance_t *VlcInstancePool::AcquireInstance()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!instance_)
+    {
+        instance_ = CreateInstance();
+        if (!instance_)
+            return nullptr;
+
+        PrewarmLocked();
+    }
+
+    instance_refs_++;
+    return instance_;
+}
+
+bool VlcInstancePool::Warmup()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!instance_)
+    {
+        instance_ = CreateInstance();
+        if (!instance_)
+            return false;
+    }
+
+    // The pinned reference keeps the instance (and its loaded plugins) across player churn
+    if (!pinned_)
+    {
+        pinned_ = true;
+        instance_refs_++;
+    }
+
+    PrewarmLocked();
+    return true;
+}
+
+bool VlcInstancePool::SetPluginCacheMode(PluginCacheMode mode)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (instance_)
+        return plugin_cache_ == mode;
+
+    plugin_cache_ = mode;
+    return true;
+}
+
+void VlcInstancePool::ReleaseInstance()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (instance_refs_ <= 0)
+        return;
+
+    if (--instance_refs_ > 0)
+        return;
+
+    // Last player gone: drop the parked players and the instance itself
+    VlcPlayer::Log("Releasing shared libVLC instance (%zu idle players)", idle_players_.size());
+    for (libvlc_media_player_t *player : idle_players_)
+    {
+        libvlc_media_player_release(player);
+    }
+    idle_players_.clear();
+
+    libvlc_release(instance_);
+    instance_ = nullptr;
+}
+
+// =================================================================================================
+// Player Pool
+// =================================================================================================
+
+libvlc_media_player_t *VlcInstancePool::AcquirePlayer()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!instance_)
+        return nullptr;
+
+    libvlc_media_player_t *player = nullptr;
+    if (!idle_players_.empty())
+    {
+        player = idle_players_.back();
+        idle_players_.pop_back();
+        VlcPlayer::Log("Borrowed pooled media player %p (%zu idle left)", (void *)player, idle_players_.size());
+    }
+    else
+    {
+        player = libvlc_media_player_new(instance_);
+        VlcPlayer::Log("Created media player %p (pool empty)", (void *)player);
+    }
+
+    if (player)
+        borrowed_players_++;
+
+    return player;
+}
+
+void VlcInstancePool::ReturnPlayer(libvlc_media_player_t *player)
+{
+    if (!player)
+        return;
+
+    // Stop outside the lock, it joins the decoder/vout threads
+    ResetPlayer(player);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (borrowed_players_ > 0)
+        borrowed_players_--;
+
+    if (instance_ && idle_players_.size() < max_idle_)
+    {
+        idle_players_.push_back(player);
+        return;
+    }
+
+    libvlc_media_player_release(player);
+}
+
+void VlcInstancePool::ResetPlayer(libvlc_media_player_t *player)
+{
+    libvlc_media_player_stop(player);
+    libvlc_media_player_set_media(player, nullptr);
+
+    // Re-setting the drawable resets the "vout" variable, discarding any vmem callbacks
+#ifdef _WIN32
+    libvlc_media_player_set_hwnd(player, nullptr);
+#elif defined(__linux__)
+    libvlc_media_player_set_xwindow(player, 0);
+#elif defined(__APPLE__)
+    libvlc_media_player_set_nsobject(player, nullptr);
+#endif
+
+    libvlc_video_set_scale(player, 0);
+    libvlc_video_set_aspect_ratio(player, nullptr);
+    libvlc_video_set_crop_geometry(player, nullptr);
+    libvlc_video_set_deinterlace(player, nullptr);
+    libvlc_media_player_set_rate(player, 1.0f);
+
+    // The aout (and its volume / mute) lives in the input resource and survives stop()
+    libvlc_audio_set_mute(player, 0);
+    libvlc_audio_set_volume(player, 100);
+}
+
+// =================================================================================================
+// Configuration
+// =================================================================================================
+
+void VlcInstancePool::Configure(size_t warm, size_t max_idle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    max_idle_ = max_idle;
+    warm_target_ = std::min(warm, max_idle_);
+
+    while (idle_players_.size() > max_idle_)
+    {
+        libvlc_media_player_release(idle_players_.back());
+        idle_players_.pop_back();
+    }
+}
+
+void VlcInstancePool::Prewarm()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    PrewarmLocked();
+}
+
+void VlcInstancePool::PrewarmLocked()
+{
+    if (!instance_)
+        return;
+
+    while (idle_players_.size() < warm_target_)
+    {
+        libvlc_media_player_t *player = libvlc_media_player_new(instance_);
+        if (!player)
+            break;
+        idle_players_.push_back(player);
+    }
+}
+
+VlcPoolStats VlcInstancePool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    VlcPoolStats stats;
+    stats.instance_refs = instance_refs_;
+    stats.idle_players = idle_players_.size();
+    stats.borrowed_players = borrowed_players_;
+    stats.warm_target = warm_target_;
+    stats.max_idle = max_idle_;
+    stats.instance_ready = instance_ != nullptr;
+    stats.plugin_cache = plugin_cache_;
+    return stats;
+}
@@ -0,0 +1,105 @@
+#ifndef VLC_INSTANCE_POOL_H
+#define VLC_INSTANCE_POOL_H
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <vlc/vlc.h>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// =================================================================================================
+// VlcInstancePool - Process-wide libVLC instance shared by every VlcPlayer
+// =================================================================================================
+// libvlc_new() loads and scans the plugins, which dominates player creation time and RSS.
+// The pool creates one refcounted instance on first use and keeps a few idle, pre-created
+// media players around so opening a second or third stream is near-instant.
+
+enum class PluginCacheMode
+{
+    REUSE,   // Read plugins.dat when present (fast start)
+    REBUILD, // Rescan plugins and rewrite the cache (--reset-plugins-cache)
+    OFF      // Always scan, never touch the cache (--no-plugins-cache)
+};
+
+struct VlcPoolStats
+{
+    int instance_refs;
+    size_t idle_players;
+    size_t borrowed_players;
+    size_t warm_target;
+    size_t max_idle;
+    bool instance_ready;
+    PluginCacheMode plugin_cache;
+};
+
+class VlcInstancePool
+{
+public:
+    static constexpr size_t DEFAULT_WARM_PLAYERS = 1;
+    static constexpr size_t DEFAULT_MAX_IDLE = 4;
+
+    static VlcInstancePool &Get();
+
+    /**
+     * Returns the shared instance (created on first call), nullptr if libVLC failed to start.
+     * Every successful call must be balanced with ReleaseInstance().
+     */
+    libvlc_instance_t *AcquireInstance();
+    void ReleaseInstance();
+
+    /**
+     * Create the instance ahead of the first player and keep it alive for the process lifetime.
+     * Safe to call from a worker thread, returns false if libVLC failed to start.
+     */
+    bool Warmup();
+
+    /**
+     * Only effective before the instance is created, returns false otherwise
+     */
+    bool SetPluginCacheMode(PluginCacheMode mode);
+
+    /**
+     * Borrow a media player bound to the shared instance. Caller must hold an instance ref.
+     */
+    libvlc_media_player_t *AcquirePlayer();
+
+    /**
+     * Stop, reset and park the player for reuse (released if the idle list is full)
+     */
+    void ReturnPlayer(libvlc_media_player_t *player);
+
+    /**
+     * warm: idle players created up front (instance creation, Warmup(), Prewarm()), max_idle:
+     * upper bound of parked players. Borrows do not replenish, returned players refill the pool.
+     */
+    void Configure(size_t warm, size_t max_idle);
+    void Prewarm();
+
+    VlcPoolStats GetStats();
+
+private:
+    VlcInstancePool();
+    VlcInstancePool(const VlcInstancePool &) = delete;
+    VlcInstancePool &operator=(const VlcInstancePool &) = delete;
+
+    libvlc_instance_t *CreateInstance();
+    void PrewarmLocked();
+    void ResetPlayer(libvlc_media_player_t *player);
+
+    std::mutex mutex_;
+    libvlc_instance_t *instance_;
+    int instance_refs_;
+    bool pinned_;
+    PluginCacheMode plugin_cache_;
+    std::vector<libvlc_media_player_t *> idle_players_;
+    size_t borrowed_players_;
+    size_t warm_target_;
+    size_t max_idle_;
+};
+
+#endif // VLC_INSTANCE_POOL_H
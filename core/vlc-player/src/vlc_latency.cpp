@@ -0,0 +1,247 @@
+#include "vlc_latency.h"
+#include <algorithm>
+
+// =================================================================================================
+// Profiles
+// =================================================================================================
+
+LatencyProfile LatencyController::Profile(LatencyMode mode)
+{
+    switch (mode)
+    {
+    case LatencyMode::LOW_LATENCY:
+        // No clock jitter tolerance and no clock synchro: late pictures are dropped, never waited for
+        return {300, 150, 1000, 0, 0};
+    case LatencyMode::BALANCED:
+        return {1000, 500, 3000, 5000, -1};
+    case LatencyMode::RESILIENT:
+        return {3000, 2000, 10000, 5000, -1};
+    case LatencyMode::NONE:
+    default:
+        return {0, 0, 0, 0, -1};
+    }
+}
+
+bool LatencyController::ParseLatencyMode(const std::string &name, LatencyMode *mode)
+{
+    if (name == "lowLatency")
+        *mode = LatencyMode::LOW_LATENCY;
+    else if (name == "balanced")
+        *mode = LatencyMode::BALANCED;
+    else if (name == "resilient")
+        *mode = LatencyMode::RESILIENT;
+    else if (name == "none" || name == "default")
+        *mode = LatencyMode::NONE;
+    else
+        return false;
+    return true;
+}
+
+const char *LatencyController::LatencyModeName(LatencyMode mode)
+{
+    switch (mode)
+    {
+    case LatencyMode::LOW_LATENCY:
+        return "lowLatency";
+    case LatencyMode::BALANCED:
+        return "balanced";
+    case LatencyMode::RESILIENT:
+        return "resilient";
+    case LatencyMode::NONE:
+    default:
+        return "none";
+    }
+}
+
+// =================================================================================================
+// LatencyController
+// =================================================================================================
+
+void LatencyController::SetMode(LatencyMode mode, bool adaptive)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool changed = mode != mode_;
+    mode_ = mode;
+    adaptive_ = adaptive && mode != LatencyMode::NONE;
+
+    // Re-selecting the same mode keeps what adaptation has learned about the network
+    if (changed)
+    {
+        caching_ms_ = Profile(mode).caching_ms;
+        stats_.total_stalls = 0;
+        stats_.adjustments = 0;
+    }
+}
+
+LatencyMode LatencyController::GetMode()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mode_;
+}
+
+void LatencyController::AppendOptions(std::map<std::string, std::string> *options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (mode_ == LatencyMode::NONE)
+        return;
+
+    LatencyProfile profile = Profile(mode_);
+    std::string caching = std::to_string(caching_ms_);
+
+    (*options)[":network-caching"] = caching;
+    (*options)[":live-caching"] = caching;
+    (*options)[":file-caching"] = caching;
+    (*options)[":clock-jitter"] = std::to_string(profile.clock_jitter_ms);
+    if (profile.clock_synchro >= 0)
+        (*options)[":clock-synchro"] = std::to_string(profile.clock_synchro);
+}
+
+void LatencyController::OnMediaChanged()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Clock::time_point now = Clock::now();
+    primed_ = false;
+    stalled_ = false;
+    starved_samples_ = 0;
+    stable_since_ = now;
+    next_sample_ = now;
+
+    stats_.stalls = 0;
+    stats_.stall_ms = 0;
+    stats_.last_stall_ms = 0;
+    stats_.input_kbps = 0.0;
+    stats_.demux_kbps = 0.0;
+}
+
+void LatencyController::OnSeek()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Clock::time_point now = Clock::now();
+    if (stalled_)
+    {
+        int64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - stall_started_).count();
+        stats_.stall_ms += duration;
+        stats_.last_stall_ms = duration;
+    }
+
+    primed_ = false;
+    stalled_ = false;
+    starved_samples_ = 0;
+    stable_since_ = now;
+}
+
+void LatencyController::OnBuffering(float cache)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Clock::time_point now = Clock::now();
+
+    if (cache >= 100.0f)
+    {
+        if (stalled_)
+        {
+            int64_t duration =
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - stall_started_).count();
+            stats_.stall_ms += duration;
+            stats_.last_stall_ms = duration;
+            stalled_ = false;
+        }
+        if (!primed_)
+            stable_since_ = now;
+        primed_ = true;
+        return;
+    }
+
+    // The initial fill is not a stall
+    if (!primed_ || stalled_)
+        return;
+
+    stalled_ = true;
+    stall_started_ = now;
+    stable_since_ = now;
+    stats_.stalls++;
+    stats_.total_stalls++;
+
+    if (adaptive_)
+        GrowLocked(caching_ms_ * 3 / 2 + 100);
+}
+
+bool LatencyController::WantsBitrateSample()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (mode_ == LatencyMode::NONE)
+        return false;
+
+    Clock::time_point now = Clock::now();
+    if (now < next_sample_)
+        return false;
+    next_sample_ = now + std::chrono::milliseconds(BITRATE_SAMPLE_MS);
+    return true;
+}
+
+void LatencyController::OnBitrate(float input_kbps, float demux_kbps)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    stats_.input_kbps = input_kbps;
+    stats_.demux_kbps = demux_kbps;
+
+    if (!adaptive_ || !primed_ || stalled_)
+        return;
+
+    Clock::time_point now = Clock::now();
+
+    // Input slower than the demuxer consumes it: the cache drains towards a stall
+    if (demux_kbps > 0.0f && input_kbps < demux_kbps * 0.95f)
+    {
+        if (++starved_samples_ >= STARVATION_SAMPLES &&
+            now - last_growth_ >= std::chrono::milliseconds(STARVATION_GROW_MS))
+        {
+            starved_samples_ = 0;
+            stable_since_ = now;
+            GrowLocked(caching_ms_ * 5 / 4);
+        }
+        return;
+    }
+    starved_samples_ = 0;
+
+    // Shrink back towards the live edge after a minute without trouble
+    LatencyProfile profile = Profile(mode_);
+    if (caching_ms_ > profile.min_caching_ms &&
+        now - stable_since_ >= std::chrono::milliseconds(STABLE_DECAY_MS))
+    {
+        caching_ms_ = std::max(profile.min_caching_ms, caching_ms_ * 9 / 10);
+        stable_since_ = now;
+        stats_.adjustments++;
+    }
+}
+
+void LatencyController::GrowLocked(int caching_ms)
+{
+    LatencyProfile profile = Profile(mode_);
+    int grown = std::min(caching_ms, profile.max_caching_ms);
+    if (grown <= caching_ms_)
+        return;
+
+    caching_ms_ = grown;
+    last_growth_ = Clock::now();
+    stats_.adjustments++;
+}
+
+LatencyStats LatencyController::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    LatencyStats stats = stats_;
+    stats.mode = mode_;
+    stats.adaptive = adaptive_;
+    stats.caching_ms = caching_ms_;
+    if (stalled_)
+        stats.stall_ms += std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - stall_started_).count();
+    return stats;
+}
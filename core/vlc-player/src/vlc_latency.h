@@ -0,0 +1,113 @@
+#ifndef VLC_LATENCY_H
+#define VLC_LATENCY_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// =================================================================================================
+// Latency Modes - Caching profiles and stall-driven adaptation for network streams
+// =================================================================================================
+// The caching and clock options only make sense together: a small network cache with the
+// default clock jitter tolerance just trades latency for stutter. Each mode is a coherent option
+// set applied to every media at open time. In adaptive modes buffering stalls and input rate
+// starvation grow the cache, and long stretches of clean playback shrink it back towards the
+// mode's floor, so live channels sit as close to the live edge as the network allows.
+//
+// libVLC 3 reads the caching options when the input starts, an adjusted value therefore
+// applies from the next open (a zap or a reconnect), never to the media already playing.
+
+enum class LatencyMode
+{
+    NONE = 0, // No options added, libVLC defaults
+    LOW_LATENCY,
+    BALANCED,
+    RESILIENT
+};
+
+struct LatencyProfile
+{
+    int caching_ms;     // Initial network/live/file caching
+    int min_caching_ms; // Adaptive range
+    int max_caching_ms;
+    int clock_jitter_ms;
+    int clock_synchro;  // -1 keeps the libVLC default
+};
+
+struct LatencyStats
+{
+    LatencyMode mode = LatencyMode::NONE;
+    bool adaptive = false;
+    int caching_ms = 0; // Applied at the next open
+    uint32_t stalls = 0;         // Current media
+    int64_t stall_ms = 0;        // Current media, including a stall in progress
+    int64_t last_stall_ms = 0;
+    uint32_t total_stalls = 0;   // Since the mode was set
+    uint32_t adjustments = 0;
+    double input_kbps = 0.0;
+    double demux_kbps = 0.0;
+};
+
+class LatencyController
+{
+public:
+    static constexpr int64_t BITRATE_SAMPLE_MS = 2000;
+
+    void SetMode(LatencyMode mode, bool adaptive);
+    LatencyMode GetMode();
+
+    /**
+     * Add the option set of the current mode (nothing for NONE)
+     */
+    void AppendOptions(std::map<std::string, std::string> *options);
+
+    /**
+     * New media: stall counters restart, the adapted caching is kept
+     */
+    void OnMediaChanged();
+
+    /**
+     * Seek or input restart: libVLC refills the cache from 0, which is not a stall. A stall in
+     * progress ends here, the counters of the media are kept.
+     */
+    void OnSeek();
+
+    // Event thread
+    void OnBuffering(float cache);
+    bool WantsBitrateSample(); // True at most once per BITRATE_SAMPLE_MS
+    void OnBitrate(float input_kbps, float demux_kbps);
+
+    LatencyStats GetStats();
+
+    static bool ParseLatencyMode(const std::string &name, LatencyMode *mode);
+    static const char *LatencyModeName(LatencyMode mode);
+    static LatencyProfile Profile(LatencyMode mode);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int64_t STABLE_DECAY_MS = 60000;     // Clean playback before shrinking
+    static constexpr int64_t STARVATION_GROW_MS = 30000;  // Minimum spacing of rate-based growth
+    static constexpr int STARVATION_SAMPLES = 3;          // Consecutive starved samples
+
+    void GrowLocked(int caching_ms);
+
+    std::mutex mutex_;
+    LatencyMode mode_ = LatencyMode::NONE;
+    bool adaptive_ = false;
+    int caching_ms_ = 0;
+
+    bool primed_ = false;   // Reached 100% once for this media
+    bool stalled_ = false;
+    Clock::time_point stall_started_;
+    Clock::time_point stable_since_;
+    Clock::time_point last_growth_;
+    Clock::time_point next_sample_;
+    int starved_samples_ = 0;
+
+    LatencyStats stats_;
+};
+
+#endif // VLC_LATENCY_H
@@ -0,0 +1,523 @@
+#include "vlc_m3u_catalog.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+// =================================================================================================
+// Helpers
+// =================================================================================================
+
+static inline char FoldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static std::string_view Trim(std::string_view text)
+{
+    while (!text.empty() && IsSpace(text.front()))
+        text.remove_prefix(1);
+    while (!text.empty() && IsSpace(text.back()))
+        text.remove_suffix(1);
+    return text;
+}
+
+static bool StartsWith(std::string_view text, std::string_view prefix)
+{
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Byte order after ASCII case folding, UTF-8 sequences compare by code point
+static int CompareFolded(std::string_view a, std::string_view b)
+{
+    size_t length = std::min(a.size(), b.size());
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char ca = static_cast<unsigned char>(FoldAscii(a[i]));
+        unsigned char cb = static_cast<unsigned char>(FoldAscii(b[i]));
+        if (ca != cb)
+            return ca < cb ? -1 : 1;
+    }
+    if (a.size() == b.size())
+        return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
+static bool EqualsFolded(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() && CompareFolded(a, b) == 0;
+}
+
+// core/parser's rule: no extension in the last path segment means a live stream
+static bool IsLiveUrl(std::string_view url)
+{
+    size_t slash = url.rfind('/');
+    if (slash == std::string_view::npos)
+        return false;
+
+    std::string_view file = url.substr(slash + 1);
+    size_t query = file.find('?');
+    if (query != std::string_view::npos)
+        file = file.substr(0, query);
+    return file.find('.') == std::string_view::npos;
+}
+
+// S<digits> followed somewhere later by E<digits>, as core/parser's episode scan
+static bool HasEpisodeMarker(std::string_view name)
+{
+    bool season = false;
+    for (size_t i = 0; i + 1 < name.size(); i++)
+    {
+        char c = FoldAscii(name[i]);
+        if (!season && c == 's' && IsDigit(name[i + 1]))
+            season = true;
+        else if (season && c == 'e' && IsDigit(name[i + 1]))
+            return true;
+    }
+    return false;
+}
+
+// =================================================================================================
+// StringArena / StringTable
+// =================================================================================================
+
+std::string_view StringArena::Store(std::string_view text)
+{
+    if (text.empty())
+        return {};
+
+    if (text.size() > BLOCK_SIZE / 4)
+    {
+        blocks_.emplace_back(new char[text.size()]);
+        reserved_ += text.size();
+        memcpy(blocks_.back().get(), text.data(), text.size());
+        return std::string_view(blocks_.back().get(), text.size());
+    }
+
+    if (block_used_ + text.size() > BLOCK_SIZE)
+    {
+        blocks_.emplace_back(new char[BLOCK_SIZE]);
+        reserved_ += BLOCK_SIZE;
+        block_ = blocks_.back().get();
+        block_used_ = 0;
+    }
+
+    char *target = block_ + block_used_;
+    memcpy(target, text.data(), text.size());
+    block_used_ += text.size();
+    return std::string_view(target, text.size());
+}
+
+StringTable::StringTable()
+{
+    strings_.emplace_back();
+    interned_.emplace(std::string_view(), 0);
+}
+
+M3UStringId StringTable::Intern(std::string_view text)
+{
+    if (text.empty())
+        return 0;
+
+    auto it = interned_.find(text);
+    if (it != interned_.end())
+        return it->second;
+
+    M3UStringId id = Add(text);
+    interned_.emplace(strings_[id], id); // Keyed by the arena copy, text may be a parse buffer
+    return id;
+}
+
+M3UStringId StringTable::Add(std::string_view text)
+{
+    if (text.empty())
+        return 0;
+
+    strings_.push_back(arena_.Store(text));
+    return static_cast<M3UStringId>(strings_.size() - 1);
+}
+
+bool StringTable::Find(std::string_view text, M3UStringId *id) const
+{
+    auto it = interned_.find(text);
+    if (it == interned_.end())
+        return false;
+    *id = it->second;
+    return true;
+}
+
+size_t StringTable::Bytes() const
+{
+    // Hash nodes are estimated, the rest is exact
+    const size_t node_bytes = sizeof(std::string_view) + sizeof(M3UStringId) + 2 * sizeof(void *);
+    return arena_.Bytes() + strings_.capacity() * sizeof(std::string_view) +
+           interned_.size() * node_bytes + interned_.bucket_count() * sizeof(void *);
+}
+
+// =================================================================================================
+// M3UCatalog
+// =================================================================================================
+
+const char *M3UCatalog::CategoryName(M3UCategory category)
+{
+    switch (category)
+    {
+    case M3UCategory::LIVE:
+        return "live";
+    case M3UCategory::SERIES:
+        return "series";
+    default:
+        return "movie";
+    }
+}
+
+int M3UCatalog::ParseCategory(const std::string &name)
+{
+    if (name == "live")
+        return static_cast<int>(M3UCategory::LIVE);
+    if (name == "movie")
+        return static_cast<int>(M3UCategory::MOVIE);
+    if (name == "series")
+        return static_cast<int>(M3UCategory::SERIES);
+    return -1;
+}
+
+void M3UCatalog::AddEntry(M3UEntry entry, std::string_view group)
+{
+    M3UStringId group_name = strings_.Intern(group);
+    auto it = group_lookup_.find(group_name);
+    if (it == group_lookup_.end())
+    {
+        it = group_lookup_.emplace(group_name, static_cast<uint32_t>(groups_.size())).first;
+        groups_.emplace_back();
+        groups_.back().name = group_name;
+    }
+
+    uint32_t index = static_cast<uint32_t>(entries_.size());
+    entry.group = it->second;
+
+    GroupSlot &slot = groups_[entry.group];
+    slot.entries.push_back(index);
+    slot.by_category[static_cast<size_t>(entry.category)]++;
+    categories_[static_cast<size_t>(entry.category)].push_back(index);
+
+    entries_.push_back(entry);
+}
+
+void M3UCatalog::BuildIndexes()
+{
+    by_name_.resize(entries_.size());
+    std::iota(by_name_.begin(), by_name_.end(), 0u);
+    std::stable_sort(by_name_.begin(), by_name_.end(), [this](uint32_t a, uint32_t b)
+                     { return CompareFolded(String(entries_[a].name), String(entries_[b].name)) < 0; });
+}
+
+M3UGroupInfo M3UCatalog::Group(size_t group) const
+{
+    const GroupSlot &slot = groups_[group];
+    return {String(slot.name), static_cast<uint32_t>(slot.entries.size()), slot.by_category};
+}
+
+std::string_view M3UCatalog::GroupName(uint32_t group) const
+{
+    return group < groups_.size() ? String(groups_[group].name) : std::string_view();
+}
+
+size_t M3UCatalog::Select(const M3UQuery &query, size_t offset, size_t limit, std::vector<uint32_t> *indices) const
+{
+    indices->clear();
+
+    const uint32_t no_group = UINT32_MAX;
+    uint32_t group = no_group;
+    if (!query.group.empty())
+    {
+        M3UStringId name = 0;
+        if (!strings_.Find(query.group, &name))
+            return 0;
+        auto it = group_lookup_.find(name);
+        if (it == group_lookup_.end())
+            return 0;
+        group = it->second;
+    }
+
+    bool by_category = query.category >= 0 && query.category < static_cast<int>(M3UCategory::COUNT);
+
+    // Walk the narrowest index that already satisfies one condition, test the others per entry
+    const uint32_t *base = nullptr;
+    size_t base_size = entries_.size(); // nullptr base: every entry in playlist order
+    bool check_group = false;
+    bool check_category = false;
+
+    if (!query.prefix.empty())
+    {
+        std::string_view prefix = query.prefix;
+        auto lower = std::lower_bound(by_name_.begin(), by_name_.end(), prefix,
+                                      [this](uint32_t index, std::string_view value)
+                                      { return CompareFolded(String(entries_[index].name), value) < 0; });
+        auto upper = std::upper_bound(lower, by_name_.end(), prefix,
+                                      [this](std::string_view value, uint32_t index)
+                                      {
+                                          std::string_view name = String(entries_[index].name);
+                                          return CompareFolded(value, name.substr(0, value.size())) < 0;
+                                      });
+        base = by_name_.data() + (lower - by_name_.begin());
+        base_size = static_cast<size_t>(upper - lower);
+        check_group = group != no_group;
+        check_category = by_category;
+    }
+    else if (group != no_group)
+    {
+        base = groups_[group].entries.data();
+        base_size = groups_[group].entries.size();
+        check_category = by_category;
+    }
+    else if (by_category)
+    {
+        const auto &list = categories_[static_cast<size_t>(query.category)];
+        base = list.data();
+        base_size = list.size();
+    }
+
+    auto at = [base](size_t i) { return base ? base[i] : static_cast<uint32_t>(i); };
+
+    // One condition: the index is the answer, copy the page
+    if (!check_group && !check_category)
+    {
+        for (size_t i = offset; i < base_size && indices->size() < limit; i++)
+            indices->push_back(at(i));
+        return base_size;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < base_size; i++)
+    {
+        uint32_t index = at(i);
+        const M3UEntry &entry = entries_[index];
+        if (check_group && entry.group != group)
+            continue;
+        if (check_category && static_cast<int>(entry.category) != query.category)
+            continue;
+
+        if (total >= offset && indices->size() < limit)
+            indices->push_back(index);
+        total++;
+    }
+    return total;
+}
+
+uint64_t M3UCatalog::Bytes() const
+{
+    uint64_t bytes = strings_.Bytes();
+    bytes += entries_.capacity() * sizeof(M3UEntry);
+    bytes += by_name_.capacity() * sizeof(uint32_t);
+    for (const auto &list : categories_)
+        bytes += list.capacity() * sizeof(uint32_t);
+    for (const auto &slot : groups_)
+        bytes += sizeof(GroupSlot) + slot.entries.capacity() * sizeof(uint32_t);
+    return bytes;
+}
+
+// =================================================================================================
+// M3UParser
+// =================================================================================================
+
+M3UParser::M3UParser(M3UCatalog *catalog)
+    : catalog_(catalog)
+{
+}
+
+void M3UParser::Feed(const char *data, size_t size)
+{
+    const char *end = data + size;
+    while (data < end)
+    {
+        const char *newline = static_cast<const char *>(memchr(data, '\n', static_cast<size_t>(end - data)));
+        if (!newline)
+        {
+            carry_.append(data, static_cast<size_t>(end - data));
+            return;
+        }
+
+        // Whole lines are parsed straight from the chunk, only a split one is copied
+        if (carry_.empty())
+        {
+            ParseLine(std::string_view(data, static_cast<size_t>(newline - data)));
+        }
+        else
+        {
+            carry_.append(data, static_cast<size_t>(newline - data));
+            ParseLine(carry_);
+            carry_.clear();
+        }
+        data = newline + 1;
+    }
+}
+
+void M3UParser::Finish()
+{
+    if (!carry_.empty())
+    {
+        ParseLine(carry_);
+        carry_.clear();
+    }
+    catalog_->BuildIndexes();
+}
+
+void M3UParser::ParseLine(std::string_view line)
+{
+    if (first_line_ && StartsWith(line, "\xEF\xBB\xBF"))
+        line.remove_prefix(3); // UTF-8 BOM
+    first_line_ = false;
+
+    line = Trim(line);
+    if (line.empty())
+        return;
+
+    if (line[0] != '#')
+    {
+        Commit(line);
+        return;
+    }
+
+    if (StartsWith(line, "#EXTINF:"))
+        ParseExtInf(line.substr(8));
+    else if (StartsWith(line, "#EXTGRP:"))
+        extgrp_.assign(Trim(line.substr(8)));
+    else if (StartsWith(line, "#EXTM3U"))
+        saw_header_ = true;
+    // Other directives (#EXTVLCOPT, #KODIPROP, comments) are not catalogued
+}
+
+/**
+ * #EXTINF:<duration> key="value" key=value ...,<title>
+ * The title starts at the first comma outside quotes, so commas inside attribute values and
+ * in the title itself are both kept.
+ */
+void M3UParser::ParseExtInf(std::string_view info)
+{
+    has_info_ = true;
+    duration_ = -1;
+    name_.clear();
+    tvg_id_.clear();
+    tvg_name_.clear();
+    logo_.clear();
+    group_.clear();
+
+    size_t pos = 0;
+    size_t size = info.size();
+
+    // Duration, the fraction of "12.5" is dropped
+    bool negative = pos < size && info[pos] == '-';
+    if (negative)
+        pos++;
+    if (pos < size && IsDigit(info[pos]))
+    {
+        int64_t value = 0;
+        while (pos < size && IsDigit(info[pos]))
+        {
+            value = std::min<int64_t>(value * 10 + (info[pos] - '0'), INT32_MAX);
+            pos++;
+        }
+        duration_ = static_cast<int32_t>(negative ? -value : value);
+    }
+    while (pos < size && !IsSpace(info[pos]) && info[pos] != ',')
+        pos++;
+
+    while (pos < size)
+    {
+        char c = info[pos];
+        if (c == ',')
+        {
+            name_.assign(Trim(info.substr(pos + 1)));
+            break;
+        }
+        if (IsSpace(c))
+        {
+            pos++;
+            continue;
+        }
+
+        size_t key_start = pos;
+        while (pos < size && info[pos] != '=' && info[pos] != ',' && !IsSpace(info[pos]))
+            pos++;
+        std::string_view key = info.substr(key_start, pos - key_start);
+        if (pos >= size || info[pos] != '=')
+            continue; // Bare word
+
+        pos++;
+        std::string_view value;
+        if (pos < size && info[pos] == '"')
+        {
+            size_t close = info.find('"', pos + 1);
+            if (close == std::string_view::npos)
+                close = size;
+            value = info.substr(pos + 1, close - pos - 1);
+            pos = std::min(close + 1, size);
+        }
+        else
+        {
+            size_t value_start = pos;
+            while (pos < size && info[pos] != ',' && !IsSpace(info[pos]))
+                pos++;
+            value = info.substr(value_start, pos - value_start);
+        }
+
+        value = Trim(value);
+        if (EqualsFolded(key, "group-title"))
+            group_.assign(value);
+        else if (EqualsFolded(key, "tvg-id"))
+            tvg_id_.assign(value);
+        else if (EqualsFolded(key, "tvg-name"))
+            tvg_name_.assign(value);
+        else if (EqualsFolded(key, "tvg-logo"))
+            logo_.assign(value);
+    }
+
+    if (name_.empty())
+        name_ = tvg_name_;
+}
+
+void M3UParser::Commit(std::string_view url)
+{
+    StringTable &strings = catalog_->strings_;
+
+    M3UEntry entry{};
+    entry.url = strings.Add(url);
+    entry.duration = -1;
+
+    if (has_info_)
+    {
+        entry.name = strings.Add(name_);
+        entry.tvg_id = strings.Intern(tvg_id_);
+        entry.tvg_name = tvg_name_ == name_ ? entry.name : strings.Add(tvg_name_);
+        entry.logo = strings.Intern(logo_);
+        entry.duration = duration_;
+    }
+    else
+    {
+        // Plain playlists list bare URLs, the URL doubles as the name
+        entry.name = entry.url;
+    }
+
+    if (IsLiveUrl(url))
+        entry.category = M3UCategory::LIVE;
+    else if (HasEpisodeMarker(strings.Get(entry.name)))
+        entry.category = M3UCategory::SERIES;
+    else
+        entry.category = M3UCategory::MOVIE;
+
+    catalog_->AddEntry(entry, !group_.empty() ? std::string_view(group_) : std::string_view(extgrp_));
+
+    has_info_ = false;
+    group_.clear();
+    extgrp_.clear();
+}
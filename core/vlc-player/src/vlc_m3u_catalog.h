@@ -0,0 +1,180 @@
+#ifndef VLC_M3U_CATALOG_H
+#define VLC_M3U_CATALOG_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// =================================================================================================
+// M3U Catalogue - Streaming playlist parser and indexed channel store
+// =================================================================================================
+// Provider playlists run to 100k+ entries but only a few hundred distinct groups, logos and
+// attribute values. An entry is a fixed-size record of string ids, and every string lives
+// once in an arena of large blocks, so a catalogue costs a few allocations per megabyte instead
+// of several per entry. Groups, categories and a name-sorted order are indexed once after the
+// parse, and JS only ever materialises the page it asks for.
+
+enum class M3UCategory : uint8_t
+{
+    LIVE = 0,   // No file extension in the URL (same rule as core/parser)
+    MOVIE = 1,
+    SERIES = 2, // SxxEyy in the name
+    COUNT = 3
+};
+
+using M3UStringId = uint32_t; // 0 is the empty string
+
+/**
+ * Append-only block allocator for string bytes, views into it stay valid for its lifetime
+ */
+class StringArena
+{
+public:
+    std::string_view Store(std::string_view text);
+    size_t Bytes() const { return reserved_; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *block_ = nullptr;          // Block being filled, strings over a quarter block get their own
+    size_t block_used_ = BLOCK_SIZE; // Full until the first Store()
+    size_t reserved_ = 0;
+};
+
+class StringTable
+{
+public:
+    StringTable();
+
+    // Deduplicated, for values that repeat (groups, logos, tvg ids)
+    M3UStringId Intern(std::string_view text);
+    // Stored as is, for values that are unique anyway (URLs, names)
+    M3UStringId Add(std::string_view text);
+
+    bool Find(std::string_view text, M3UStringId *id) const; // Interned strings only
+
+    std::string_view Get(M3UStringId id) const { return id < strings_.size() ? strings_[id] : std::string_view(); }
+    size_t Count() const { return strings_.size(); }
+    size_t Bytes() const;
+
+private:
+    StringArena arena_;
+    std::vector<std::string_view> strings_;
+    std::unordered_map<std::string_view, M3UStringId> interned_;
+};
+
+struct M3UEntry
+{
+    M3UStringId name;
+    M3UStringId url;
+    M3UStringId tvg_id;
+    M3UStringId tvg_name;
+    M3UStringId logo;
+    uint32_t group;      // Index into the catalogue's groups
+    int32_t duration;    // #EXTINF seconds, -1 for live
+    M3UCategory category;
+};
+
+struct M3UQuery
+{
+    std::string group;  // Exact group-title, empty matches every group
+    int category = -1;  // M3UCategory, -1 matches every category
+    std::string prefix; // Name prefix, case-insensitive for ASCII; results come in name order
+};
+
+struct M3UGroupInfo
+{
+    std::string_view name;
+    uint32_t count;
+    std::array<uint32_t, static_cast<size_t>(M3UCategory::COUNT)> by_category;
+};
+
+class M3UCatalog
+{
+public:
+    size_t Size() const { return entries_.size(); }
+    const M3UEntry &At(size_t index) const { return entries_[index]; }
+    std::string_view String(M3UStringId id) const { return strings_.Get(id); }
+
+    size_t GroupCount() const { return groups_.size(); }
+    M3UGroupInfo Group(size_t group) const;
+    std::string_view GroupName(uint32_t group) const;
+
+    /**
+     * Page through the matching entries
+     * @param offset, limit Range of the match list to copy into indices
+     * @return Total number of matches
+     */
+    size_t Select(const M3UQuery &query, size_t offset, size_t limit, std::vector<uint32_t> *indices) const;
+
+    uint64_t Bytes() const;
+
+    static const char *CategoryName(M3UCategory category);
+    static int ParseCategory(const std::string &name); // -1 if unknown
+
+private:
+    friend class M3UParser;
+
+    void AddEntry(M3UEntry entry, std::string_view group);
+    void BuildIndexes();
+
+    StringTable strings_;
+    std::vector<M3UEntry> entries_;
+
+    struct GroupSlot
+    {
+        M3UStringId name;
+        std::vector<uint32_t> entries; // Playlist order
+        std::array<uint32_t, static_cast<size_t>(M3UCategory::COUNT)> by_category{};
+    };
+    std::vector<GroupSlot> groups_;                          // First-seen order
+    std::unordered_map<M3UStringId, uint32_t> group_lookup_; // Interned name -> slot
+
+    std::array<std::vector<uint32_t>, static_cast<size_t>(M3UCategory::COUNT)> categories_;
+    std::vector<uint32_t> by_name_; // Entry indices sorted by case-folded name
+};
+
+// =================================================================================================
+// M3UParser - Feeds arbitrary chunks of a playlist into a catalogue
+// =================================================================================================
+
+class M3UParser
+{
+public:
+    explicit M3UParser(M3UCatalog *catalog);
+
+    // Lines may be split across chunks anywhere, including inside UTF-8 sequences
+    void Feed(const char *data, size_t size);
+    // Parse a trailing line without newline and build the catalogue indexes
+    void Finish();
+
+    bool SawHeader() const { return saw_header_; }
+
+private:
+    void ParseLine(std::string_view line);
+    void ParseExtInf(std::string_view info);
+    void Commit(std::string_view url);
+
+    M3UCatalog *catalog_;
+    std::string carry_; // Incomplete line from the previous chunk
+    bool first_line_ = true;
+    bool saw_header_ = false;
+
+    // #EXTINF (and #EXTGRP) waiting for its URL line, buffers reused from entry to entry
+    bool has_info_ = false;
+    int32_t duration_ = -1;
+    std::string name_;
+    std::string tvg_id_;
+    std::string tvg_name_;
+    std::string logo_;
+    std::string group_;
+    std::string extgrp_;
+};
+
+#endif // VLC_M3U_CATALOG_H
@@ -0,0 +1,723 @@
+#include "vlc_mosaic.h"
+#include "vlc_frame_buffers.h"
+#include "vlc_player.h"
+#include "vlc_instance_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+static constexpr uint32_t MOSAIC_BLACK = 0xff000000; // Opaque black, BGRA in memory
+
+static inline int AlignDown(int value, int alignment) {
+    return value - value % alignment;
+}
+
+// =================================================================================================
+// MosaicOpenWorker - set_media() stops the tile's previous stream, which joins its threads
+// =================================================================================================
+
+class MosaicOpenWorker : public Napi::AsyncWorker {
+public:
+    MosaicOpenWorker(Napi::Env env, VlcMosaic* mosaic, VlcMosaic::Tile* tile, Napi::Promise::Deferred deferred,
+                     const std::string& url, uint64_t generation)
+        : Napi::AsyncWorker(env, "VlcMosaicOpen"),
+          mosaic_(mosaic),
+          mosaic_ref_(Napi::Persistent(mosaic->Value())),
+          tile_(tile),
+          deferred_(deferred),
+          url_(url),
+          generation_(generation) {
+    }
+
+protected:
+    void Execute() override {
+        TRACE_SCOPE("mosaic.open");
+        std::lock_guard<std::mutex> lock(tile_->open_mutex);
+
+        // Zapping the same tile faster than streams open: only the latest open() runs
+        if (mosaic_->disposed_ || tile_->open_generation.load() != generation_) {
+            superseded_ = true;
+            return;
+        }
+
+        bool is_url = url_.find("://") != std::string::npos;
+        libvlc_media_t* media = is_url ? libvlc_media_new_location(mosaic_->instance_, url_.c_str())
+                                       : libvlc_media_new_path(mosaic_->instance_, url_.c_str());
+        if (!media) {
+            SetError("Failed to create media");
+            return;
+        }
+
+        libvlc_media_player_set_media(tile_->player, media);
+        libvlc_media_release(media);
+
+        if (libvlc_media_player_play(tile_->player) != 0) {
+            SetError("Failed to start playback");
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (superseded_) {
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("superseded", Napi::Boolean::New(env, true));
+            deferred_.Resolve(result);
+            return;
+        }
+        deferred_.Resolve(mosaic_->TileToObject(env, *tile_));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    VlcMosaic* mosaic_;
+    Napi::ObjectReference mosaic_ref_;
+    VlcMosaic::Tile* tile_;
+    Napi::Promise::Deferred deferred_;
+    std::string url_;
+    uint64_t generation_;
+    bool superseded_ = false;
+};
+
+// =================================================================================================
+// MosaicStopWorker - stop() joins the tile's threads too, and must not race an open in flight
+// =================================================================================================
+
+class MosaicStopWorker : public Napi::AsyncWorker {
+public:
+    MosaicStopWorker(Napi::Env env, VlcMosaic* mosaic, VlcMosaic::Tile* tile, Napi::Promise::Deferred deferred,
+                     uint64_t generation)
+        : Napi::AsyncWorker(env, "VlcMosaicStop"),
+          mosaic_(mosaic),
+          mosaic_ref_(Napi::Persistent(mosaic->Value())),
+          tile_(tile),
+          deferred_(deferred),
+          generation_(generation) {
+    }
+
+protected:
+    void Execute() override {
+        TRACE_SCOPE("mosaic.stop");
+        std::lock_guard<std::mutex> lock(tile_->open_mutex);
+
+        // An open() issued after this stop() owns the tile now
+        if (mosaic_->disposed_ || tile_->open_generation.load() != generation_) return;
+
+        libvlc_media_player_stop(tile_->player);
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Env().Undefined());
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    VlcMosaic* mosaic_;
+    Napi::ObjectReference mosaic_ref_;
+    VlcMosaic::Tile* tile_;
+    Napi::Promise::Deferred deferred_;
+    uint64_t generation_;
+};
+
+// =================================================================================================
+// Construction
+// =================================================================================================
+
+Napi::Object VlcMosaic::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "Mosaic", {
+        InstanceMethod("open", &VlcMosaic::Open),
+        InstanceMethod("stop", &VlcMosaic::Stop),
+        InstanceMethod("focus", &VlcMosaic::Focus),
+        InstanceMethod("getLayout", &VlcMosaic::GetLayout),
+        InstanceMethod("getFrame", &VlcMosaic::GetFrame),
+        InstanceMethod("getFrameBuffer", &VlcMosaic::GetFrameBuffer),
+        InstanceMethod("setEventCallback", &VlcMosaic::SetEventCallback),
+        InstanceMethod("dispose", &VlcMosaic::Dispose),
+    });
+
+    exports.Set("Mosaic", func);
+    return exports;
+}
+
+/**
+ * new Mosaic({ width, height, columns, rows, gap }) or new Mosaic({ width, height, tiles: [{ x, y,
+ * width, height }] }). Tile x positions are rounded down to TILE_ALIGNMENT pixels.
+ */
+bool VlcMosaic::ParseLayout(Napi::Env env, const Napi::Object& options, int width, int height,
+                            std::vector<MosaicTileRect>* rects) {
+    if (options.Has("tiles") && options.Get("tiles").IsArray()) {
+        Napi::Array tiles = options.Get("tiles").As<Napi::Array>();
+        for (uint32_t i = 0; i < tiles.Length(); i++) {
+            Napi::Value value = tiles.Get(i);
+            if (!value.IsObject()) {
+                Napi::TypeError::New(env, "tiles must be { x, y, width, height } objects").ThrowAsJavaScriptException();
+                return false;
+            }
+            Napi::Object tile = value.As<Napi::Object>();
+            MosaicTileRect rect;
+            rect.x = AlignDown(std::max(0, tile.Get("x").ToNumber().Int32Value()), TILE_ALIGNMENT);
+            rect.y = std::max(0, tile.Get("y").ToNumber().Int32Value());
+            rect.width = std::min(tile.Get("width").ToNumber().Int32Value(), width - rect.x);
+            rect.height = std::min(tile.Get("height").ToNumber().Int32Value(), height - rect.y);
+            rects->push_back(rect);
+        }
+    } else {
+        int columns = options.Has("columns") ? options.Get("columns").ToNumber().Int32Value() : 2;
+        int rows = options.Has("rows") ? options.Get("rows").ToNumber().Int32Value() : 2;
+        int gap = options.Has("gap") ? std::max(0, options.Get("gap").ToNumber().Int32Value()) : 0;
+        if (columns < 1 || rows < 1) {
+            Napi::RangeError::New(env, "columns and rows must be at least 1").ThrowAsJavaScriptException();
+            return false;
+        }
+
+        int cell_width = (width - gap * (columns - 1)) / columns;
+        int cell_height = (height - gap * (rows - 1)) / rows;
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < columns; column++) {
+                MosaicTileRect rect;
+                rect.x = AlignDown(column * (cell_width + gap), TILE_ALIGNMENT);
+                rect.y = row * (cell_height + gap);
+                int right = column == columns - 1 ? width
+                                                  : AlignDown((column + 1) * (cell_width + gap), TILE_ALIGNMENT) - gap;
+                rect.width = right - rect.x;
+                rect.height = cell_height;
+                rects->push_back(rect);
+            }
+        }
+    }
+
+    if (rects->empty() || rects->size() > MAX_TILES) {
+        Napi::RangeError::New(env, "A mosaic holds 1 to " + std::to_string(MAX_TILES) + " tiles")
+            .ThrowAsJavaScriptException();
+        return false;
+    }
+    for (const MosaicTileRect& rect : *rects) {
+        if (rect.width < MIN_TILE_SIZE || rect.height < MIN_TILE_SIZE) {
+            Napi::RangeError::New(env, "Every tile must fit the surface and be at least " +
+                                           std::to_string(MIN_TILE_SIZE) + " pixels wide and high")
+                .ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    return true;
+}
+
+VlcMosaic::VlcMosaic(const Napi::CallbackInfo& info) : Napi::ObjectWrap<VlcMosaic>(info) {
+    Napi::Env env = info.Env();
+
+    Napi::Object options = info.Length() > 0 && info[0].IsObject() ? info[0].As<Napi::Object>()
+                                                                    : Napi::Object::New(env);
+    width_ = options.Has("width") ? options.Get("width").ToNumber().Int32Value() : 1920;
+    height_ = options.Has("height") ? options.Get("height").ToNumber().Int32Value() : 1080;
+    if (width_ < MIN_TILE_SIZE || height_ < MIN_TILE_SIZE || width_ > 7680 || height_ > 4320) {
+        Napi::RangeError::New(env, "Mosaic size must be within 32x32 - 7680x4320").ThrowAsJavaScriptException();
+        return;
+    }
+
+    std::vector<MosaicTileRect> rects;
+    if (!ParseLayout(env, options, width_, height_, &rects)) {
+        return;
+    }
+
+    pitch_ = static_cast<unsigned>(width_ * 4 + FrameStorage::ALIGNMENT - 1) &
+             ~static_cast<unsigned>(FrameStorage::ALIGNMENT - 1);
+    surface_ = std::make_shared<FrameStorage>(1, static_cast<size_t>(pitch_) * height_);
+    pixels_ = surface_->Slot(0);
+
+    VlcInstancePool& pool = VlcInstancePool::Get();
+    instance_ = pool.AcquireInstance();
+    if (!instance_) {
+        disposed_ = true;
+        Napi::Error::New(env, "Failed to initialize libVLC").ThrowAsJavaScriptException();
+        return;
+    }
+
+    for (size_t i = 0; i < rects.size(); i++) {
+        auto tile = std::make_unique<Tile>();
+        tile->owner = this;
+        tile->index = static_cast<int>(i);
+        tile->rect = rects[i];
+        tile->player = pool.AcquirePlayer();
+        if (!tile->player) {
+            tiles_.push_back(std::move(tile));
+            Release();
+            Napi::Error::New(env, "Failed to create media player").ThrowAsJavaScriptException();
+            return;
+        }
+
+        libvlc_video_set_format_callbacks(tile->player, FormatCallback, CleanupCallback);
+        libvlc_video_set_callbacks(tile->player, LockCallback, UnlockCallback, DisplayCallback, tile.get());
+        AttachEvents(tile.get());
+        FillTile(tile.get(), MOSAIC_BLACK);
+        tiles_.push_back(std::move(tile));
+    }
+
+    VlcPlayer::Log("Mosaic %dx%d created with %zu tiles", width_, height_, tiles_.size());
+}
+
+VlcMosaic::~VlcMosaic() {
+    Release();
+}
+
+void VlcMosaic::Release() {
+    if (disposed_.exchange(true)) return;
+
+    VlcInstancePool& pool = VlcInstancePool::Get();
+    for (auto& tile : tiles_) {
+        if (!tile->player) continue;
+
+        // An open() in flight finishes first, the ones queued behind it see disposed_
+        std::lock_guard<std::mutex> lock(tile->open_mutex);
+        DetachEvents(tile.get());
+        // Stops the vout, no vmem callback runs into the surface after this
+        pool.ReturnPlayer(tile->player);
+        tile->player = nullptr;
+    }
+
+    if (tsfn_events_) {
+        tsfn_events_.Release();
+    }
+
+    if (instance_) {
+        pool.ReleaseInstance();
+        instance_ = nullptr;
+    }
+}
+
+// =================================================================================================
+// vmem Callbacks - libVLC renders straight into the tile
+// =================================================================================================
+
+void VlcMosaic::FillTile(Tile* tile, uint32_t color) {
+    const MosaicTileRect& rect = tile->rect;
+
+    tile->sequence.fetch_add(1, std::memory_order_acq_rel);
+    for (int y = 0; y < rect.height; y++) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(pixels_ + static_cast<size_t>(rect.y + y) * pitch_) + rect.x;
+        std::fill(row, row + rect.width, color);
+    }
+    tile->sequence.fetch_add(1, std::memory_order_release);
+}
+
+unsigned VlcMosaic::FormatCallback(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                                   unsigned* pitches, unsigned* lines) {
+    TRACE_SCOPE("mosaic.format");
+    Tile* tile = static_cast<Tile*>(*opaque);
+    const MosaicTileRect& rect = tile->rect;
+
+    // Fit the picture into the tile keeping its aspect ratio, libVLC scales to whatever is asked
+    int fit_width = rect.width;
+    int fit_height = rect.height;
+    if (*width > 0 && *height > 0) {
+        if (static_cast<uint64_t>(*width) * rect.height > static_cast<uint64_t>(*height) * rect.width) {
+            fit_height = static_cast<int>(static_cast<uint64_t>(rect.width) * *height / *width);
+        } else {
+            fit_width = static_cast<int>(static_cast<uint64_t>(rect.height) * *width / *height);
+        }
+    }
+    fit_width = std::max(2, fit_width & ~1);
+    fit_height = std::max(2, fit_height & ~1);
+
+    tile->picture_x = AlignDown((rect.width - fit_width) / 2, TILE_ALIGNMENT);
+    tile->picture_y = (rect.height - fit_height) / 2;
+    tile->picture_width = fit_width;
+    tile->picture_height = fit_height;
+
+    // Letterbox bars stay black, the picture area is overwritten by every frame
+    tile->owner->FillTile(tile, MOSAIC_BLACK);
+
+    memcpy(chroma, "RV32", 4);
+    *width = static_cast<unsigned>(fit_width);
+    *height = static_cast<unsigned>(fit_height);
+    pitches[0] = tile->owner->pitch_; // Rows of the surface, not of the picture
+    lines[0] = static_cast<unsigned>(fit_height);
+
+    VlcPlayer::Log("Mosaic tile %d: %ux%u picture at +%d+%d", tile->index, *width, *height,
+                   tile->picture_x.load(), tile->picture_y.load());
+    return 1;
+}
+
+void VlcMosaic::CleanupCallback(void* opaque) {
+    Tile* tile = static_cast<Tile*>(opaque);
+    tile->owner->FillTile(tile, MOSAIC_BLACK);
+    tile->picture_width = 0;
+    tile->picture_height = 0;
+}
+
+void* VlcMosaic::LockCallback(void* opaque, void** planes) {
+    TRACE_SCOPE("mosaic.lock");
+    Tile* tile = static_cast<Tile*>(opaque);
+    VlcMosaic* mosaic = tile->owner;
+
+    size_t x = static_cast<size_t>(tile->rect.x + tile->picture_x.load(std::memory_order_relaxed));
+    size_t y = static_cast<size_t>(tile->rect.y + tile->picture_y.load(std::memory_order_relaxed));
+    planes[0] = mosaic->pixels_ + y * mosaic->pitch_ + x * 4;
+
+    tile->sequence.fetch_add(1, std::memory_order_acq_rel);
+    return nullptr;
+}
+
+void VlcMosaic::UnlockCallback(void* opaque, void* picture, void* const* planes) {
+    Tile* tile = static_cast<Tile*>(opaque);
+    tile->sequence.fetch_add(1, std::memory_order_release);
+}
+
+void VlcMosaic::DisplayCallback(void* opaque, void* picture) {
+    TRACE_SCOPE("mosaic.display");
+    Tile* tile = static_cast<Tile*>(opaque);
+    tile->frames.fetch_add(1, std::memory_order_relaxed);
+    tile->owner->EmitFrame();
+}
+
+// =================================================================================================
+// Events
+// =================================================================================================
+
+void VlcMosaic::AttachEvents(Tile* tile) {
+    libvlc_event_manager_t* events = libvlc_media_player_event_manager(tile->player);
+    libvlc_event_attach(events, libvlc_MediaPlayerOpening, HandleEvent, tile);
+    libvlc_event_attach(events, libvlc_MediaPlayerPlaying, HandleEvent, tile);
+    libvlc_event_attach(events, libvlc_MediaPlayerPaused, HandleEvent, tile);
+    libvlc_event_attach(events, libvlc_MediaPlayerStopped, HandleEvent, tile);
+    libvlc_event_attach(events, libvlc_MediaPlayerEndReached, HandleEvent, tile);
+    libvlc_event_attach(events, libvlc_MediaPlayerEncounteredError, HandleEvent, tile);
+}
+
+void VlcMosaic::DetachEvents(Tile* tile) {
+    libvlc_event_manager_t* events = libvlc_media_player_event_manager(tile->player);
+    libvlc_event_detach(events, libvlc_MediaPlayerOpening, HandleEvent, tile);
+    libvlc_event_detach(events, libvlc_MediaPlayerPlaying, HandleEvent, tile);
+    libvlc_event_detach(events, libvlc_MediaPlayerPaused, HandleEvent, tile);
+    libvlc_event_detach(events, libvlc_MediaPlayerStopped, HandleEvent, tile);
+    libvlc_event_detach(events, libvlc_MediaPlayerEndReached, HandleEvent, tile);
+    libvlc_event_detach(events, libvlc_MediaPlayerEncounteredError, HandleEvent, tile);
+}
+
+void VlcMosaic::HandleEvent(const libvlc_event_t* event, void* data) {
+    TRACE_SCOPE("mosaic.event");
+    Tile* tile = static_cast<Tile*>(data);
+
+    const char* state = nullptr;
+    switch (event->type) {
+    case libvlc_MediaPlayerOpening:
+        state = "opening";
+        break;
+    case libvlc_MediaPlayerPlaying:
+        state = "playing";
+        // libVLC drops a mute set before the audio output exists, apply it once playing
+        tile->owner->ApplyAudioFocus(tile);
+        break;
+    case libvlc_MediaPlayerPaused:
+        state = "paused";
+        break;
+    case libvlc_MediaPlayerStopped:
+        state = "stopped";
+        break;
+    case libvlc_MediaPlayerEndReached:
+        state = "ended";
+        break;
+    case libvlc_MediaPlayerEncounteredError:
+        state = "error";
+        break;
+    default:
+        return;
+    }
+
+    tile->state = state;
+    tile->owner->EmitState(tile, state);
+}
+
+void VlcMosaic::EmitState(Tile* tile, const char* state) {
+    if (!tsfn_events_ || disposed_) return;
+
+    int index = tile->index;
+    tsfn_events_.NonBlockingCall([this, index, state](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.mosaicTile");
+        if (disposed_) return;
+
+        Napi::Object payload = Napi::Object::New(env);
+        Napi::Object tile = Napi::Object::New(env);
+        tile.Set("index", Napi::Number::New(env, index));
+        tile.Set("state", Napi::String::New(env, state));
+        payload.Set("tile", tile);
+        callback.Call({payload});
+    });
+}
+
+void VlcMosaic::EmitFrame() {
+    if (!tsfn_events_ || disposed_) return;
+
+    // Every tile's vout thread ends up here, at most one event is in flight for all of them
+    int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int64_t interval = frame_event_interval_us_.load(std::memory_order_relaxed);
+    if (interval > 0 && now - last_frame_event_us_.load(std::memory_order_relaxed) < interval) {
+        frame_events_coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (frame_event_pending_.exchange(true)) {
+        frame_events_coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    last_frame_event_us_ = now;
+
+    napi_status status = tsfn_events_.NonBlockingCall([this](Napi::Env env, Napi::Function callback) {
+        TRACE_SCOPE("tsfn.mosaicFrame");
+        frame_event_pending_ = false;
+        if (disposed_) return;
+
+        Napi::Array sequences = Napi::Array::New(env, tiles_.size());
+        for (size_t i = 0; i < tiles_.size(); i++) {
+            sequences.Set(static_cast<uint32_t>(i),
+                          Napi::Number::New(env, static_cast<double>(tiles_[i]->sequence.load(std::memory_order_acquire))));
+        }
+
+        Napi::Object payload = Napi::Object::New(env);
+        Napi::Object frame = Napi::Object::New(env);
+        frame.Set("sequences", sequences);
+        frame.Set("coalesced", Napi::Number::New(env, static_cast<double>(frame_events_coalesced_.exchange(0))));
+        payload.Set("frame", frame);
+        callback.Call({payload});
+    });
+
+    if (status != napi_ok) {
+        frame_event_pending_ = false;
+    }
+}
+
+/**
+ * setEventCallback(cb, { frameRate }) - { tile: { index, state } } and coalesced
+ * { frame: { sequences, coalesced } } events, frameRate caps the latter
+ */
+Napi::Value VlcMosaic::SetEventCallback(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsFunction()) {
+        Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (disposed_) {
+        Napi::Error::New(env, "Mosaic is disposed").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    if (tsfn_events_) {
+        tsfn_events_.Release();
+    }
+    tsfn_events_ = Napi::ThreadSafeFunction::New(env, info[0].As<Napi::Function>(), "VlcMosaicEvents", 0, 1);
+
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        if (options.Has("frameRate")) {
+            double fps = options.Get("frameRate").ToNumber().DoubleValue();
+            frame_event_interval_us_ = fps > 0 ? static_cast<int64_t>(1000000.0 / fps) : 0;
+        }
+    }
+
+    return env.Undefined();
+}
+
+// =================================================================================================
+// Tiles
+// =================================================================================================
+
+VlcMosaic::Tile* VlcMosaic::TileArgument(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (disposed_) {
+        Napi::Error::New(env, "Mosaic is disposed").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Tile index expected").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+
+    int index = info[0].As<Napi::Number>().Int32Value();
+    if (index < 0 || index >= static_cast<int>(tiles_.size())) {
+        Napi::RangeError::New(env, "Tile index out of range").ThrowAsJavaScriptException();
+        return nullptr;
+    }
+    return tiles_[index].get();
+}
+
+Napi::Object VlcMosaic::TileToObject(Napi::Env env, const Tile& tile) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("index", Napi::Number::New(env, tile.index));
+    result.Set("x", Napi::Number::New(env, tile.rect.x));
+    result.Set("y", Napi::Number::New(env, tile.rect.y));
+    result.Set("width", Napi::Number::New(env, tile.rect.width));
+    result.Set("height", Napi::Number::New(env, tile.rect.height));
+
+    Napi::Object picture = Napi::Object::New(env);
+    picture.Set("x", Napi::Number::New(env, tile.rect.x + tile.picture_x.load()));
+    picture.Set("y", Napi::Number::New(env, tile.rect.y + tile.picture_y.load()));
+    picture.Set("width", Napi::Number::New(env, tile.picture_width.load()));
+    picture.Set("height", Napi::Number::New(env, tile.picture_height.load()));
+    result.Set("picture", picture);
+
+    result.Set("state", Napi::String::New(env, tile.state.load()));
+    result.Set("url", Napi::String::New(env, tile.url));
+    result.Set("focused", Napi::Boolean::New(env, focus_ == tile.index));
+    result.Set("sequence", Napi::Number::New(env, static_cast<double>(tile.sequence.load(std::memory_order_acquire))));
+    result.Set("frames", Napi::Number::New(env, static_cast<double>(tile.frames.load())));
+    return result;
+}
+
+/**
+ * open(index, { file }) -> Promise<tile> (or { superseded: true } when a newer open() on the
+ * same tile took over)
+ */
+Napi::Value VlcMosaic::Open(const Napi::CallbackInfo& info) {
+    TRACE_SCOPE("mosaic.openCall");
+    Napi::Env env = info.Env();
+    Tile* tile = TileArgument(info);
+    if (!tile) {
+        return env.Undefined();
+    }
+
+    if (info.Length() < 2 || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Options object expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    Napi::Object options = info[1].As<Napi::Object>();
+    if (!options.Has("file") || !options.Get("file").IsString()) {
+        Napi::Error::New(env, "File path/url is required").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    std::string url = options.Get("file").As<Napi::String>().Utf8Value();
+    if (url.empty() || url.size() > VlcPlayer::MAX_URL_LENGTH) {
+        Napi::Error::New(env, "Invalid URL provided").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    tile->url = url;
+    uint64_t generation = ++tile->open_generation;
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    MosaicOpenWorker* worker = new MosaicOpenWorker(env, this, tile, deferred, url, generation);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value VlcMosaic::Stop(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Tile* tile = TileArgument(info);
+    if (!tile) {
+        return env.Undefined();
+    }
+
+    // Queued opens of this tile become no-ops, the one in flight finishes before the stop
+    uint64_t generation = ++tile->open_generation;
+    tile->url.clear();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    MosaicStopWorker* worker = new MosaicStopWorker(env, this, tile, deferred, generation);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+/**
+ * focus(index) moves the audio to that tile and mutes the others, focus(-1) mutes every tile.
+ * Returns the focused index.
+ */
+Napi::Value VlcMosaic::Focus(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() > 0) {
+        if (info[0].IsNumber() && info[0].As<Napi::Number>().Int32Value() == -1) {
+            focus_ = -1;
+        } else {
+            Tile* tile = TileArgument(info);
+            if (!tile) {
+                return env.Undefined();
+            }
+            focus_ = tile->index;
+        }
+
+        for (auto& tile : tiles_) {
+            ApplyAudioFocus(tile.get());
+        }
+    }
+
+    return Napi::Number::New(env, focus_);
+}
+
+void VlcMosaic::ApplyAudioFocus(Tile* tile) {
+    if (!tile->player || disposed_) return;
+    libvlc_audio_set_mute(tile->player, focus_ != tile->index);
+}
+
+// =================================================================================================
+// Surface
+// =================================================================================================
+
+Napi::Value VlcMosaic::GetLayout(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    Napi::Array tiles = Napi::Array::New(env, tiles_.size());
+    for (size_t i = 0; i < tiles_.size(); i++) {
+        tiles.Set(static_cast<uint32_t>(i), TileToObject(env, *tiles_[i]));
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("width", Napi::Number::New(env, width_));
+    result.Set("height", Napi::Number::New(env, height_));
+    result.Set("pitch", Napi::Number::New(env, pitch_));
+    result.Set("chroma", Napi::String::New(env, "RV32"));
+    result.Set("focus", Napi::Number::New(env, focus_));
+    result.Set("tiles", tiles);
+    return result;
+}
+
+// Copy of the whole surface, tiles being written meanwhile may tear (see the tile sequences)
+Napi::Value VlcMosaic::GetFrame(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!surface_) {
+        return env.Null();
+    }
+    return Napi::Buffer<uint8_t>::Copy(env, pixels_, static_cast<size_t>(pitch_) * height_);
+}
+
+/**
+ * getFrameBuffer() -> { buffer: ArrayBuffer, external, width, height, pitch }
+ *
+ * external: true - the surface itself, wrap it once. It stays valid after dispose() until the
+ * ArrayBuffer is collected.
+ * external: false - the host refuses external buffers (Electron's V8 memory cage), buffer is a
+ * copy of the surface taken now, like getFrame().
+ */
+Napi::Value VlcMosaic::GetFrameBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!surface_) {
+        return env.Null();
+    }
+
+    bool external = true;
+    Napi::ArrayBuffer buffer = NewFrameArrayBuffer(env, surface_, pixels_, static_cast<size_t>(pitch_) * height_,
+                                                   &external);
+    if (buffer.IsEmpty()) {
+        return env.Undefined();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("buffer", buffer);
+    result.Set("external", Napi::Boolean::New(env, external));
+    result.Set("width", Napi::Number::New(env, width_));
+    result.Set("height", Napi::Number::New(env, height_));
+    result.Set("pitch", Napi::Number::New(env, pitch_));
+    return result;
+}
+
+Napi::Value VlcMosaic::Dispose(const Napi::CallbackInfo& info) {
+    Release();
+    return info.Env().Undefined();
+}
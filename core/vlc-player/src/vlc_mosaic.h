@@ -0,0 +1,131 @@
+#ifndef VLC_MOSAIC_H
+#define VLC_MOSAIC_H
+
+#include <napi.h>
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <vlc/vlc.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "vlc_frame_ring.h"
+
+// =================================================================================================
+// Mosaic - Several streams decoded into the tiles of one memory-rendered surface
+// =================================================================================================
+// One object owns M media players borrowed from the shared pool, without windows, OSD threads
+// or message loops. Each player's vmem callbacks hand libVLC a pointer into its own tile of a
+// single RV32 surface, with the surface pitch, so the vout scales and converts the picture
+// straight into place and nothing is copied afterwards. getFrameBuffer() exposes the surface
+// as an external ArrayBuffer, so JS reads the same memory too.
+//
+// Tiles update independently. Every tile carries a sequence number that is odd while libVLC
+// writes into it (seqlock style): a reader that sees the same even value before and after
+// reading a tile got a complete picture.
+//
+// Audio follows the focused tile, every other tile is muted.
+
+struct MosaicTileRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+class MosaicOpenWorker;
+class MosaicStopWorker;
+
+class VlcMosaic : public Napi::ObjectWrap<VlcMosaic> {
+public:
+    static constexpr size_t MAX_TILES = 16;
+    static constexpr int MIN_TILE_SIZE = 32;
+    static constexpr int TILE_ALIGNMENT = 16; // Pixels, keeps every tile and picture 64-byte aligned
+
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    VlcMosaic(const Napi::CallbackInfo& info);
+    ~VlcMosaic();
+
+private:
+    friend class MosaicOpenWorker;
+    friend class MosaicStopWorker;
+
+    struct Tile {
+        VlcMosaic* owner = nullptr;
+        int index = 0;
+        MosaicTileRect rect;
+        libvlc_media_player_t* player = nullptr;
+        std::string url; // JS thread only
+
+        std::mutex open_mutex; // One open/stop at a time, Release() waits for it
+        std::atomic<uint64_t> open_generation{0};
+
+        // Where the current picture sits inside rect (letterboxed), set by the format callback
+        std::atomic<int> picture_x{0};
+        std::atomic<int> picture_y{0};
+        std::atomic<int> picture_width{0};
+        std::atomic<int> picture_height{0};
+
+        std::atomic<uint64_t> sequence{0}; // Odd while the vout writes into the tile
+        std::atomic<uint64_t> frames{0};
+        std::atomic<const char*> state{"idle"};
+    };
+
+    Napi::Value Open(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+    Napi::Value Focus(const Napi::CallbackInfo& info);
+    Napi::Value GetLayout(const Napi::CallbackInfo& info);
+    Napi::Value GetFrame(const Napi::CallbackInfo& info);
+    Napi::Value GetFrameBuffer(const Napi::CallbackInfo& info);
+    Napi::Value SetEventCallback(const Napi::CallbackInfo& info);
+    Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+    // vmem callbacks, opaque is the Tile
+    static unsigned FormatCallback(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                                   unsigned* pitches, unsigned* lines);
+    static void CleanupCallback(void* opaque);
+    static void* LockCallback(void* opaque, void** planes);
+    static void UnlockCallback(void* opaque, void* picture, void* const* planes);
+    static void DisplayCallback(void* opaque, void* picture);
+
+    static void HandleEvent(const libvlc_event_t* event, void* data);
+
+    static bool ParseLayout(Napi::Env env, const Napi::Object& options, int width, int height,
+                            std::vector<MosaicTileRect>* rects);
+
+    Tile* TileArgument(const Napi::CallbackInfo& info);
+    Napi::Object TileToObject(Napi::Env env, const Tile& tile);
+    void AttachEvents(Tile* tile);
+    void DetachEvents(Tile* tile);
+    void ApplyAudioFocus(Tile* tile);
+    void FillTile(Tile* tile, uint32_t color);
+    void EmitState(Tile* tile, const char* state);
+    void EmitFrame();
+    void Release();
+
+    int width_ = 0;
+    int height_ = 0;
+    unsigned pitch_ = 0;
+    uint8_t* pixels_ = nullptr;             // Slot 0 of surface_
+    std::shared_ptr<FrameStorage> surface_; // The scratch slot behind it absorbs the last rows' pitch overrun
+    std::vector<std::unique_ptr<Tile>> tiles_;
+    libvlc_instance_t* instance_ = nullptr;
+
+    std::atomic<int> focus_{-1}; // -1 = every tile muted
+    std::atomic<bool> disposed_{false};
+
+    Napi::ThreadSafeFunction tsfn_events_;
+    std::atomic<bool> frame_event_pending_{false};
+    std::atomic<uint64_t> frame_events_coalesced_{0};
+    std::atomic<int64_t> frame_event_interval_us_{0};
+    std::atomic<int64_t> last_frame_event_us_{0};
+};
+
+#endif // VLC_MOSAIC_H
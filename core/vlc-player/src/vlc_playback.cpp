@@ -1,11 +1,267 @@
 #include "vlc_player.h"
+#include "vlc_instance_pool.h"
+#include <algorithm>
+#include <condition_variable>
 
 // =================================================================================================
 // Playback Control API
 // =================================================================================================
 
+// =================================================================================================
+// OpenWorker - media creation, option application and optional pre-parse off the JS thread
+// =================================================================================================
+
+class OpenWorker : public Napi::AsyncWorker
+{
+public:
+    OpenWorker(Napi::Env env, VlcPlayer *player, Napi::Promise::Deferred deferred, const std::string &url,
+               const std::map<std::string, std::string> &media_options, bool parse, bool parse_network,
+               int parse_timeout_ms, uint64_t generation, libvlc_media_player_t *retired_player,
+               std::shared_ptr<TimeshiftSession> timeshift)
+        : Napi::AsyncWorker(env, "VlcOpen"),
+          player_(player),
+          player_ref_(Napi::Persistent(player->Value())),
+          deferred_(deferred),
+          url_(url),
+          media_options_(media_options),
+          parse_(parse),
+          parse_network_(parse_network),
+          parse_timeout_ms_(parse_timeout_ms),
+          generation_(generation),
+          retired_player_(retired_player),
+          timeshift_(std::move(timeshift)),
+          superseded_(false)
+    {
+    }
+
+protected:
+    void Execute() override
+    {
+        TRACE_SCOPE("open.worker");
+
+        // Standby player was swapped in on the JS thread, only the old player is left to stop
+        if (retired_player_)
+        {
+            // Its input may be blocked reading a timeshift ring, stopping waits for the read
+            std::shared_ptr<TimeshiftSession> retired_timeshift = player_->DetachTimeshift();
+            VlcInstancePool::Get().ReturnPlayer(retired_player_);
+            if (retired_timeshift)
+                retired_timeshift->Stop();
+            return;
+        }
+
+        // One open at a time per player, a newer open() makes any queued older one a no-op
+        std::lock_guard<std::mutex> open_lock(player_->open_mutex_);
+
+        if (player_->disposed_ || IsSuperseded())
+        {
+            superseded_ = true;
+            return;
+        }
+
+        libvlc_media_t *media = timeshift_ ? CreateTimeshiftMedia() : CreateMedia();
+        if (!media)
+            return;
+
+        // A callback media is parsed by reading it, which would wait for the recorder
+        if (parse_ && !timeshift_)
+        {
+            ParseMedia(media);
+        }
+        VlcPlayer::SnapshotMediaInfo(media, &snapshot_);
+
+        // Channel switched again while we were parsing
+        if (player_->disposed_ || IsSuperseded())
+        {
+            libvlc_media_release(media);
+            superseded_ = true;
+            if (timeshift_)
+                timeshift_->Stop();
+            return;
+        }
+
+        // set_media() stops the previous media and joins its threads, controls only share the lock
+        std::shared_ptr<TimeshiftSession> previous;
+        {
+            VlcPlayer::PlayerLock lock(player_->player_mutex_);
+            if (IsSuperseded())
+            {
+                superseded_ = true;
+            }
+            else if (player_->media_player_)
+            {
+                previous = player_->DetachTimeshift();
+                libvlc_media_player_set_media(player_->media_player_, media);
+                player_->track_cache_.Invalidate();
+
+                std::lock_guard<std::mutex> timeshift_lock(player_->timeshift_mutex_);
+                player_->timeshift_ = timeshift_;
+            }
+        }
+        libvlc_media_release(media);
+
+        if (previous)
+            previous->Stop();
+        if (superseded_ && timeshift_)
+            timeshift_->Stop();
+    }
+
+    void OnOK() override
+    {
+        Napi::Env env = Env();
+
+        if (superseded_)
+        {
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("superseded", Napi::Boolean::New(env, true));
+            deferred_.Resolve(result);
+            return;
+        }
+
+        if (snapshot_.parsed)
+        {
+            deferred_.Resolve(VlcPlayer::MediaInfoSnapshotToObject(env, snapshot_));
+            return;
+        }
+
+        VlcPlayer::PlayerLock lock(player_->player_mutex_);
+        deferred_.Resolve(player_->GetMediaInfoObject(env));
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    bool IsSuperseded() const
+    {
+        return player_->open_generation_.load() != generation_;
+    }
+
+    void AddMediaOptions(libvlc_media_t *media)
+    {
+        for (const auto &opt : media_options_)
+        {
+            std::string option_str = opt.first + "=" + opt.second;
+            libvlc_media_add_option(media, option_str.c_str());
+        }
+    }
+
+    libvlc_media_t *CreateMedia()
+    {
+        bool is_url = url_.find("://") != std::string::npos;
+        VlcPlayer::Log("Creating media (is_url=%d)...", is_url);
+        libvlc_media_t *media = is_url ? libvlc_media_new_location(player_->vlc_instance_, url_.c_str())
+                                       : libvlc_media_new_path(player_->vlc_instance_, url_.c_str());
+
+        if (!media)
+        {
+            VlcPlayer::Log("ERROR: Failed to create media");
+            SetError("Failed to create media");
+            return nullptr;
+        }
+        VlcPlayer::Log("Media created successfully");
+
+        AddMediaOptions(media);
+        return media;
+    }
+
+    // The recorder opens url, the player reads the ring from its first byte
+    libvlc_media_t *CreateTimeshiftMedia()
+    {
+        std::string error;
+        if (!timeshift_->Start(player_->vlc_instance_, media_options_, &error))
+        {
+            VlcPlayer::Log("ERROR: Timeshift start failed: %s", error.c_str());
+            timeshift_->Stop();
+            SetError(error);
+            return nullptr;
+        }
+        VlcPlayer::Log("Timeshift recording %s into %s", url_.c_str(), timeshift_->Directory().c_str());
+
+        libvlc_media_t *media = timeshift_->CreateMedia(player_->vlc_instance_, 0);
+        if (!media)
+        {
+            timeshift_->Stop();
+            SetError("Failed to create media");
+            return nullptr;
+        }
+
+        AddMediaOptions(media);
+        return media;
+    }
+
+    // libvlc_media_parse_with_options() is asynchronous, wait for MediaParsedChanged
+    void ParseMedia(libvlc_media_t *media)
+    {
+        struct ParseWait
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool done = false;
+        } wait;
+
+        libvlc_event_manager_t *events = libvlc_media_event_manager(media);
+        auto on_parsed = [](const libvlc_event_t *, void *data)
+        {
+            ParseWait *w = static_cast<ParseWait *>(data);
+            std::lock_guard<std::mutex> lock(w->mutex);
+            w->done = true;
+            w->cv.notify_all();
+        };
+        libvlc_event_attach(events, libvlc_MediaParsedChanged, on_parsed, &wait);
+
+        int flags = libvlc_media_parse_local | libvlc_media_fetch_local;
+        if (parse_network_)
+            flags |= libvlc_media_parse_network;
+
+        VlcPlayer::Log("Pre-parsing media (network=%d, timeout=%d ms)", parse_network_, parse_timeout_ms_);
+        if (libvlc_media_parse_with_options(media, static_cast<libvlc_media_parse_flag_t>(flags), parse_timeout_ms_) == 0)
+        {
+            // libVLC enforces the timeout itself, the extra margin only guards against a lost event
+            std::unique_lock<std::mutex> lock(wait.mutex);
+            if (!wait.cv.wait_for(lock, std::chrono::milliseconds(parse_timeout_ms_ + 500), [&wait]
+                                  { return wait.done; }))
+            {
+                lock.unlock();
+                libvlc_media_parse_stop(media);
+            }
+        }
+
+        libvlc_event_detach(events, libvlc_MediaParsedChanged, on_parsed, &wait);
+    }
+
+    VlcPlayer *player_;
+    Napi::ObjectReference player_ref_; // Keeps the JS object (and player_) alive while queued
+    Napi::Promise::Deferred deferred_;
+    std::string url_;
+    std::map<std::string, std::string> media_options_;
+    bool parse_;
+    bool parse_network_;
+    int parse_timeout_ms_;
+    uint64_t generation_;
+    libvlc_media_player_t *retired_player_;
+    std::shared_ptr<TimeshiftSession> timeshift_; // Not started yet, owned by the player once its media is set
+    bool superseded_;
+    MediaInfoSnapshot snapshot_;
+};
+
+/**
+ * open({ file, window?, parse?: boolean | { network?, timeout? },
+ *        latency?: 'lowLatency' | 'balanced' | 'resilient' | 'none' | { mode, adaptive? },
+ *        timeshift?: boolean | { minutes?, maxBytes?, directory? } }) -> Promise<mediaInfo>
+ *
+ * The latency mode sticks to the player, later opens without the option keep using it.
+ * With timeshift the channel is recorded into a local ring and played from there, see timeshift().
+ * If the file was preloaded with preload(), the standby player is swapped in instead and
+ * the following play() resumes it.
+ * Resolves with the parsed media info when pre-parse succeeded, otherwise with the current
+ * player info. Resolves with { superseded: true } when a newer open() replaced this one.
+ */
 Napi::Value VlcPlayer::Open(const Napi::CallbackInfo &info)
 {
+    TRACE_SCOPE("open");
     Log("Open() called");
     Napi::Env env = info.Env();
 
@@ -30,6 +286,24 @@ Napi::Value VlcPlayer::Open(const Napi::CallbackInfo &info)
 
     media_options_.clear();
 
+    if (options.Has("latency") && !ApplyLatencyOption(env, options.Get("latency")))
+    {
+        return env.Undefined();
+    }
+    AppendMediaOptions(&media_options_);
+
+    bool timeshift = false;
+    TimeshiftOptions timeshift_options;
+    if (options.Has("timeshift"))
+    {
+        Napi::Value value = options.Get("timeshift");
+        timeshift = value.IsObject() || value.ToBoolean().Value();
+        if (timeshift && !ParseTimeshiftOption(env, value, &timeshift_options))
+        {
+            return env.Undefined();
+        }
+    }
+
     int window_width = 1280;
     int window_height = 720;
 
@@ -46,54 +320,136 @@ Napi::Value VlcPlayer::Open(const Napi::CallbackInfo &info)
         }
     }
 
+    bool parse = false;
+    bool parse_network = true;
+    int parse_timeout_ms = 5000;
+
+    if (options.Has("parse"))
+    {
+        Napi::Value parseOpt = options.Get("parse");
+        if (parseOpt.IsObject())
+        {
+            Napi::Object parseObj = parseOpt.As<Napi::Object>();
+            parse = true;
+            if (parseObj.Has("network"))
+                parse_network = parseObj.Get("network").As<Napi::Boolean>().Value();
+            if (parseObj.Has("timeout"))
+                parse_timeout_ms = std::max(0, parseObj.Get("timeout").As<Napi::Number>().Int32Value());
+        }
+        else
+        {
+            parse = parseOpt.ToBoolean().Value();
+        }
+    }
+
     if (url.empty())
     {
         Napi::Error::New(env, "Empty URL provided").ThrowAsJavaScriptException();
         return env.Undefined();
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    Log("Creating child window (width=%d, height=%d)...", window_width, window_height);
-    osd_window_->Create(window_width, window_height);
-    Log("Child window creation call completed, osd_window_=%p", (void *)osd_window_);
-
-    if (current_media_)
+    if (!vlc_instance_)
     {
-        Log("Releasing previous media...");
-        libvlc_media_release(current_media_);
+        Napi::Error::New(env, "libVLC is not initialized").ThrowAsJavaScriptException();
+        return env.Undefined();
     }
 
-    bool is_url = url.find("://") != std::string::npos;
-    Log("Creating media (is_url=%d)...", is_url);
-    if (is_url)
-    {
-        current_media_ = libvlc_media_new_location(vlc_instance_, url.c_str());
-    }
-    else
-    {
-        current_media_ = libvlc_media_new_path(vlc_instance_, url.c_str());
-    }
+    // Zapping fast path: the preloaded standby player already has this media set up
+    libvlc_media_player_t *standby = timeshift ? nullptr : TakeStandby(url);
+    libvlc_media_player_t *retired = nullptr;
+    uint64_t generation = ++open_generation_;
+    event_aggregator_.ResetCurrentVideo();
+    latency_.OnMediaChanged();
+    track_cache_.Invalidate();
+    length_ms_ = -1;
+
+    // A drag over the previous media must not seek the new one
+    if (scrub_)
+        scrub_->Cancel();
 
-    if (!current_media_)
+    // The only place besides dispose() that replaces media_player_
+    if (standby)
     {
-        Log("ERROR: Failed to create media");
-        Napi::Error::New(env, "Failed to create media").ThrowAsJavaScriptException();
-        return env.Undefined();
+        std::unique_lock<std::shared_mutex> lock(player_mutex_);
+        Log("Swapping in standby player %p for %s", (void *)standby, url.c_str());
+        DetachPlayerEvents();
+        retired = media_player_;
+        media_player_ = standby;
+        CopyPlayerSettings(retired, standby);
+        SetupEventCallbacks();
+
+        // JS keeps the values it was sent, report whatever the standby could not take over
+        bool flush = false;
+        int volume = libvlc_audio_get_volume(standby);
+        if (volume >= 0)
+            flush |= event_aggregator_.UpdateVolume(volume);
+        int mute = libvlc_audio_get_mute(standby);
+        if (mute >= 0)
+            flush |= event_aggregator_.UpdateMuted(mute != 0);
+        flush |= event_aggregator_.UpdateRate(libvlc_media_player_get_rate(standby));
+        if (flush)
+            ScheduleEventFlush();
+
+        // Its LengthChanged fired while nobody listened
+        length_ms_ = libvlc_media_player_get_length(standby);
+
+        if (memory_render_)
+        {
+            SetupVideoCallbacks();
+        }
+        vout_restart_pending_ = true;
     }
-    Log("Media created successfully");
 
-    for (const auto &opt : media_options_)
+    // Native windows stay on the JS thread (Win32 window affinity), the rest runs in the worker
     {
-        std::string option_str = opt.first + "=" + opt.second;
-        libvlc_media_add_option(current_media_, option_str.c_str());
+        std::lock_guard<std::mutex> lock(window_mutex_);
+        if (memory_render_)
+        {
+            Log("Memory rendering enabled, skipping child window creation");
+        }
+        else
+        {
+            Log("Creating child window (width=%d, height=%d)...", window_width, window_height);
+            osd_window_->Create(window_width, window_height);
+            Log("Child window creation call completed, osd_window_=%p", (void *)osd_window_);
+        }
     }
 
-    libvlc_media_player_set_media(media_player_, current_media_);
-    libvlc_media_release(current_media_);
-    current_media_ = nullptr;
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    std::shared_ptr<TimeshiftSession> session;
+    if (timeshift)
+        session = std::make_shared<TimeshiftSession>(url, timeshift_options);
 
-    return env.Undefined();
+    OpenWorker *worker = new OpenWorker(env, this, deferred, url, media_options_, parse, parse_network,
+                                        parse_timeout_ms, generation, retired, session);
+    worker->Queue();
+
+    return deferred.Promise();
+}
+
+// Volume and mute need an audio output, unknown values leave the standby's own
+void VlcPlayer::CopyPlayerSettings(libvlc_media_player_t *from, libvlc_media_player_t *to)
+{
+    int volume = libvlc_audio_get_volume(from);
+    if (volume >= 0)
+        libvlc_audio_set_volume(to, volume);
+
+    int mute = libvlc_audio_get_mute(from);
+    if (mute >= 0)
+        libvlc_audio_set_mute(to, mute);
+
+    libvlc_media_player_set_rate(to, libvlc_media_player_get_rate(from));
+    libvlc_video_set_scale(to, libvlc_video_get_scale(from));
+
+    char *aspect = libvlc_video_get_aspect_ratio(from);
+    libvlc_video_set_aspect_ratio(to, aspect);
+    libvlc_free(aspect);
+
+    char *crop = libvlc_video_get_crop_geometry(from);
+    libvlc_video_set_crop_geometry(to, crop);
+    libvlc_free(crop);
+
+    libvlc_video_set_deinterlace(to, deinterlace_mode_.empty() ? nullptr : deinterlace_mode_.c_str());
 }
 
 Napi::Value VlcPlayer::Playback(const Napi::CallbackInfo &info)
@@ -106,7 +462,7 @@ Napi::Value VlcPlayer::Playback(const Napi::CallbackInfo &info)
     }
 
     Napi::Object options = info[0].As<Napi::Object>();
-    std::lock_guard<std::mutex> lock(mutex_);
+    PlayerLock lock(player_mutex_);
 
     if (!media_player_)
     {
@@ -120,8 +476,24 @@ Napi::Value VlcPlayer::Playback(const Napi::CallbackInfo &info)
         if (action == "play")
         {
             Log("Playback action: play");
-            if (osd_window_)
+
+            // Swapped-in standby: its input keeps the discard vout, and libVLC reuses a vout for
+            // an unchanged format. Restart the input so the output follows Bind() / the vmem callbacks.
+            if (vout_restart_pending_)
+            {
+                vout_restart_pending_ = false;
+                libvlc_media_player_stop(media_player_);
+                latency_.OnSeek();
+            }
+
+            if (memory_render_)
+            {
+                // Binding a window would reset the vout and drop the vmem callbacks
+                Log("Memory rendering enabled, skipping Bind()");
+            }
+            else if (osd_window_)
             {
+                std::lock_guard<std::mutex> window_lock(window_mutex_);
                 osd_window_->Bind(media_player_);
             }
             else
@@ -140,40 +512,235 @@ Napi::Value VlcPlayer::Playback(const Napi::CallbackInfo &info)
         }
         else if (action == "stop")
         {
+            // Lets a callback input blocked on the live edge return, the recorder keeps running
+            if (std::shared_ptr<TimeshiftSession> timeshift = GetTimeshift())
+                timeshift->Interrupt();
             libvlc_media_player_stop(media_player_);
+            latency_.OnSeek(); // The next play() fills from 0
+
+            std::lock_guard<std::mutex> window_lock(window_mutex_);
             osd_window_->Destroy();
         }
     }
 
+    // scrub: true | { interval, preview } enters scrub mode before the seek below,
+    // scrub: false leaves it after it
+    bool end_scrub = false;
+    if (options.Has("scrub"))
+    {
+        Napi::Value scrub = options.Get("scrub");
+        if (scrub.IsObject() || scrub.ToBoolean().Value())
+            ApplyScrubOption(scrub);
+        else
+            end_scrub = true;
+    }
+    bool scrubbing = scrub_ && scrub_->IsActive();
+
     if (options.Has("time"))
     {
         int64_t time = options.Get("time").As<Napi::Number>().Int64Value();
-        libvlc_media_player_set_time(media_player_, time);
+        if (scrubbing)
+        {
+            ScrubTo(time);
+        }
+        else
+        {
+            latency_.OnSeek();
+            libvlc_media_player_set_time(media_player_, time);
+        }
 
         // Show Seek OSD (formatting happens inside)
-        int64_t duration = libvlc_media_player_get_length(media_player_);
-        osd_window_->ShowSeekOSD(time, duration);
+        osd_window_->ShowSeekOSD(time, length_ms_);
     }
 
     if (options.Has("position"))
     {
         float pos = options.Get("position").As<Napi::Number>().FloatValue();
-        libvlc_media_player_set_position(media_player_, pos);
 
         // Show Seek OSD (formatting happens inside)
-        int64_t duration = libvlc_media_player_get_length(media_player_);
+        int64_t duration = length_ms_;
         int64_t time = static_cast<int64_t>(pos * duration);
+
+        // Scrub targets are times, without a length there is nothing to convert with
+        if (scrubbing && duration > 0)
+        {
+            ScrubTo(time);
+        }
+        else
+        {
+            latency_.OnSeek();
+            libvlc_media_player_set_position(media_player_, pos);
+        }
+
         osd_window_->ShowSeekOSD(time, duration);
     }
 
+    if (end_scrub && scrub_)
+    {
+        scrub_->End();
+    }
+
     if (options.Has("rate"))
     {
         float rate = options.Get("rate").As<Napi::Number>().FloatValue();
         libvlc_media_player_set_rate(media_player_, rate);
 
-        EmitPlayerInfo([rate](Napi::Env env, Napi::Object &playerInfo)
-                       { playerInfo.Set("rate", Napi::Number::New(env, rate)); });
+        if (event_aggregator_.UpdateRate(rate))
+            ScheduleEventFlush();
     }
 
     return env.Undefined();
 }
+
+// =================================================================================================
+// Seek-Bar Scrubbing
+// =================================================================================================
+
+ScrubController *VlcPlayer::GetScrub()
+{
+    if (!scrub_)
+    {
+        scrub_ = std::make_unique<ScrubController>(
+            [this](int64_t time)
+            {
+                PlayerLock lock(player_mutex_);
+                if (disposed_ || !media_player_)
+                    return;
+                latency_.OnSeek();
+                libvlc_media_player_set_time(media_player_, time);
+            },
+            [this](std::shared_ptr<const OSDImage> image)
+            {
+                osd_window_->SetSeekPreview(std::move(image));
+            });
+    }
+    return scrub_.get();
+}
+
+void VlcPlayer::ApplyScrubOption(const Napi::Value &value)
+{
+    ScrubController *scrub = GetScrub();
+
+    if (value.IsObject())
+    {
+        Napi::Object scrubObj = value.As<Napi::Object>();
+        ScrubOptions scrub_options = scrub->GetOptions();
+
+        if (scrubObj.Has("interval"))
+            scrub_options.interval_ms = scrubObj.Get("interval").As<Napi::Number>().Int32Value();
+        if (scrubObj.Has("preview"))
+        {
+            Napi::Value previewOpt = scrubObj.Get("preview");
+            if (previewOpt.IsObject())
+            {
+                Napi::Object previewObj = previewOpt.As<Napi::Object>();
+                scrub_options.preview = true;
+                if (previewObj.Has("width"))
+                    scrub_options.preview_width = previewObj.Get("width").As<Napi::Number>().Uint32Value();
+                if (previewObj.Has("height"))
+                    scrub_options.preview_height = previewObj.Get("height").As<Napi::Number>().Uint32Value();
+            }
+            else
+            {
+                scrub_options.preview = previewOpt.ToBoolean().Value();
+            }
+        }
+
+        scrub->Configure(scrub_options);
+    }
+
+    scrub->Begin();
+}
+
+void VlcPlayer::ScrubTo(int64_t time)
+{
+    // The preview decoder opens the MRL the player is actually playing
+    std::string mrl;
+    if (libvlc_media_t *media = libvlc_media_player_get_media(media_player_))
+    {
+        if (char *location = libvlc_media_get_mrl(media))
+        {
+            mrl = location;
+            libvlc_free(location);
+        }
+        libvlc_media_release(media);
+    }
+
+    GetScrub()->Request(mrl, time);
+}
+
+void VlcPlayer::StopScrub()
+{
+    if (scrub_)
+    {
+        scrub_->Stop();
+        scrub_.reset();
+    }
+}
+
+// =================================================================================================
+// Per-Media Options
+// =================================================================================================
+
+void VlcPlayer::AppendMediaOptions(std::map<std::string, std::string> *options)
+{
+    latency_.AppendOptions(options);
+
+    if (hw_decode_set_)
+        (*options)[":avcodec-hw"] = HwDecoderOptionValue(hw_decode_);
+}
+
+// =================================================================================================
+// Latency Modes
+// =================================================================================================
+
+bool VlcPlayer::ApplyLatencyOption(Napi::Env env, const Napi::Value &value)
+{
+    std::string name;
+    bool adaptive = true;
+
+    if (value.IsString())
+    {
+        name = value.As<Napi::String>().Utf8Value();
+    }
+    else if (value.IsObject())
+    {
+        Napi::Object latencyObj = value.As<Napi::Object>();
+        if (latencyObj.Has("mode") && latencyObj.Get("mode").IsString())
+            name = latencyObj.Get("mode").As<Napi::String>().Utf8Value();
+        if (latencyObj.Has("adaptive"))
+            adaptive = latencyObj.Get("adaptive").ToBoolean().Value();
+    }
+    else if (value.IsNull() || value.IsUndefined() || value.IsBoolean())
+    {
+        name = value.ToBoolean().Value() ? "balanced" : "none";
+    }
+
+    LatencyMode mode;
+    if (!LatencyController::ParseLatencyMode(name, &mode))
+    {
+        Napi::TypeError::New(env, "latency must be 'lowLatency', 'balanced', 'resilient' or 'none'")
+            .ThrowAsJavaScriptException();
+        return false;
+    }
+
+    latency_.SetMode(mode, adaptive);
+    Log("Latency mode: %s (adaptive=%d)", LatencyController::LatencyModeName(mode), adaptive);
+    return true;
+}
+
+Napi::Object VlcPlayer::LatencyStatsToObject(Napi::Env env, const LatencyStats &stats)
+{
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("mode", Napi::String::New(env, LatencyController::LatencyModeName(stats.mode)));
+    result.Set("adaptive", Napi::Boolean::New(env, stats.adaptive));
+    result.Set("caching", Napi::Number::New(env, stats.caching_ms));
+    result.Set("stalls", Napi::Number::New(env, stats.stalls));
+    result.Set("stallTime", Napi::Number::New(env, static_cast<double>(stats.stall_ms)));
+    result.Set("lastStallTime", Napi::Number::New(env, static_cast<double>(stats.last_stall_ms)));
+    result.Set("totalStalls", Napi::Number::New(env, stats.total_stalls));
+    result.Set("adjustments", Napi::Number::New(env, stats.adjustments));
+    result.Set("inputBitrate", Napi::Number::New(env, stats.input_kbps));
+    result.Set("demuxBitrate", Napi::Number::New(env, stats.demux_kbps));
+    return result;
+}
@@ -1,4 +1,14 @@
 #include "vlc_player.h"
+#include "vlc_instance_pool.h"
+#include "vlc_frame_reader.h"
+#include "vlc_thumbnailer.h"
+#include "vlc_catalog.h"
+#include "vlc_mosaic.h"
+#include <algorithm>
+
+#ifdef VLC_BENCH
+#include "vlc_bench.h"
+#endif
 
 #ifdef _WIN32
 #include "os/win32/window.h"
@@ -8,6 +18,8 @@
 
 Napi::Object VlcPlayer::Init(Napi::Env env, Napi::Object exports)
 {
+    Trace::SetThreadName("js");
+
     Napi::Function func = DefineClass(
         env, "VlcPlayer",
         {
@@ -17,19 +29,29 @@ Napi::Object VlcPlayer::Init(Napi::Env env, Napi::Object exports)
             InstanceMethod("audio", &VlcPlayer::Audio),
             InstanceMethod("video", &VlcPlayer::Video),
             InstanceMethod("subtitle", &VlcPlayer::Subtitle),
+            InstanceMethod("preload", &VlcPlayer::Preload),
+            InstanceMethod("timeshift", &VlcPlayer::Timeshift),
             InstanceMethod("window", &VlcPlayer::Window),
             InstanceMethod("shortcut", &VlcPlayer::Shortcut),
             InstanceMethod("getMediaInfo", &VlcPlayer::GetMediaInfo),
+            InstanceMethod("getStats", &VlcPlayer::GetStats),
 
             // Events
             InstanceMethod("setEventCallback", &VlcPlayer::SetEventCallback),
 
             // Frame retrieval (memory rendering mode)
             InstanceMethod("getFrame", &VlcPlayer::GetFrame),
+            InstanceMethod("getFrameBuffers", &VlcPlayer::GetFrameBuffers),
             InstanceMethod("getVideoFormat", &VlcPlayer::GetVideoFormat),
 
             // Cleanup
             InstanceMethod("dispose", &VlcPlayer::Dispose),
+
+            // Shared libVLC instance / media player pool
+            StaticMethod("pool", &VlcPlayer::Pool),
+            StaticMethod("warmup", &VlcPlayer::Warmup),
+            StaticMethod("hwDecoders", &VlcPlayer::HwDecoders),
+            StaticMethod("trace", &VlcPlayer::TraceControl),
         });
 
     Napi::FunctionReference *constructor = new Napi::FunctionReference();
@@ -46,12 +68,7 @@ VlcPlayer::VlcPlayer(const Napi::CallbackInfo &info)
       media_player_(nullptr),
       current_media_(nullptr),
       osd_window_(nullptr),
-
-
-      video_width_(0),
-      video_height_(0),
-      video_pitch_(0),
-      frame_ready_(false),
+      last_frame_event_us_(0),
       tsfn_events_(),
       event_manager_(nullptr)
 {
@@ -59,63 +76,19 @@ VlcPlayer::VlcPlayer(const Napi::CallbackInfo &info)
 
     Napi::Env env = info.Env();
 
-    // Initialize VLC with platform-specific parameters
 #ifdef _WIN32
-    // Windows: VLC plugins must be in the same directory as the .node file
-    // This is handled by binding.gyp copying plugins to build directory
-    const char *args[] = {
-        "--no-video-title-show",
-        "--intf=dummy",
-        "--no-plugins-cache"};
-
-    Log("CALL: libvlc_new(argc=%zu, args=[...])\n", sizeof(args) / sizeof(args[0]));
-    vlc_instance_ = libvlc_new(sizeof(args) / sizeof(args[0]), args);
-    Log("RETURN: vlc_instance=%p\n", (void *)vlc_instance_);
-
     Log("Creating Win32Window instance in constructor...");
     osd_window_ = new Win32Window(this);
     osd_window_->Initialize();
-
 #elif defined(__linux__)
     Log("Creating LinuxWindow instance in constructor...");
     osd_window_ = new LinuxWindow(this);
     osd_window_->Initialize();
-
-    const char *plugin_path = getenv("VLC_PLUGIN_PATH");
-    if (!plugin_path)
-    {
-        const char *default_plugin_path = "/usr/lib/x86_64-linux-gnu/vlc/plugins";
-        setenv("VLC_PLUGIN_PATH", default_plugin_path, 1);
-    }
-
-    const char *args[] = {
-        "--vout=xcb_x11",
-        "--osd",
-        "--no-plugins-cache"};
-
-    printf("[VLC Core] CALL: libvlc_new(argc=%zu, args=[...])\n", sizeof(args) / sizeof(args[0]));
-    vlc_instance_ = libvlc_new(sizeof(args) / sizeof(args[0]), args);
-#elif defined(__APPLE__)
-    const char *args[] = {
-        "--no-video-title-show",
-        "--intf=dummy",
-        "--no-plugins-cache"};
-
-    printf("[VLC Core] CALL: libvlc_new(argc=%zu, args=[...])\n", sizeof(args) / sizeof(args[0]));
-    vlc_instance_ = libvlc_new(sizeof(args) / sizeof(args[0]), args);
-#else
-    const char *args[] = {
-        "-vv",
-        "--no-video-title-show",
-        "--intf=dummy",
-        "--no-plugins-cache"};
-
-    printf("[VLC Core] CALL: libvlc_new(argc=%zu, args=[...])\n", sizeof(args) / sizeof(args[0]));
-    vlc_instance_ = libvlc_new(sizeof(args) / sizeof(args[0]), args);
 #endif
 
-    printf("[VLC Core] RETURN: vlc_instance=%p\n", (void *)vlc_instance_);
-    fflush(stdout);
+    // Shared libVLC instance: plugins are only loaded by the first player of the process
+    VlcInstancePool &pool = VlcInstancePool::Get();
+    vlc_instance_ = pool.AcquireInstance();
 
     if (!vlc_instance_)
     {
@@ -123,17 +96,14 @@ VlcPlayer::VlcPlayer(const Napi::CallbackInfo &info)
         Napi::Error::New(env, "Failed to initialize libVLC").ThrowAsJavaScriptException();
         return;
     }
-    Log("libVLC instance created successfully");
+    Log("libVLC instance acquired successfully (%p)", (void *)vlc_instance_);
 
-    printf("[VLC Core] CALL: libvlc_media_player_new(vlc_instance=%p)\n", (void *)vlc_instance_);
-    media_player_ = libvlc_media_player_new(vlc_instance_);
-    printf("[VLC Core] RETURN: media_player=%p\n", (void *)media_player_);
-    fflush(stdout);
+    media_player_ = pool.AcquirePlayer();
 
     if (!media_player_)
     {
         Log("ERROR: Failed to create media player");
-        libvlc_release(vlc_instance_);
+        pool.ReleaseInstance();
         vlc_instance_ = nullptr;
         Napi::Error::New(env, "Failed to create media player").ThrowAsJavaScriptException();
         return;
@@ -146,6 +116,8 @@ VlcPlayer::VlcPlayer(const Napi::CallbackInfo &info)
 
     Log("Setting up event callbacks...");
     SetupEventCallbacks();
+    event_aggregator_.StartDeferredFlush([this]()
+                                         { ScheduleEventFlush(); });
 
     Log("Constructor completed successfully");
 }
@@ -153,18 +125,23 @@ VlcPlayer::VlcPlayer(const Napi::CallbackInfo &info)
 VlcPlayer::~VlcPlayer()
 {
     Log("Destructor started (disposed_=%d)", (int)disposed_);
+    StopScrub();
     if (!disposed_)
     {
         osd_window_->Destroy();
 
         CleanupEventCallbacks();
 
+        std::shared_ptr<TimeshiftSession> timeshift = DetachTimeshift();
         if (media_player_)
         {
-            libvlc_media_player_stop(media_player_);
-            libvlc_media_player_release(media_player_);
+            VlcInstancePool::Get().ReturnPlayer(media_player_);
             media_player_ = nullptr;
         }
+        if (timeshift)
+            timeshift->Stop();
+
+        VlcInstancePool::Get().ReturnPlayer(DetachStandby());
 
         if (current_media_)
         {
@@ -174,7 +151,7 @@ VlcPlayer::~VlcPlayer()
 
         if (vlc_instance_)
         {
-            libvlc_release(vlc_instance_);
+            VlcInstancePool::Get().ReleaseInstance();
             vlc_instance_ = nullptr;
         }
     }
@@ -197,10 +174,27 @@ void VlcPlayer::SetupEventCallbacks()
         libvlc_event_attach(event_manager_, libvlc_MediaPlayerEncounteredError, HandleError, this);
         libvlc_event_attach(event_manager_, libvlc_MediaPlayerLengthChanged, HandleLengthChanged, this);
         libvlc_event_attach(event_manager_, libvlc_MediaPlayerBuffering, HandleBuffering, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerPositionChanged, HandlePositionChanged, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerAudioVolume, HandleAudioVolume, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerMuted, HandleAudioVolume, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerUnmuted, HandleAudioVolume, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerESAdded, HandleTracksChanged, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerESDeleted, HandleTracksChanged, this);
+        libvlc_event_attach(event_manager_, libvlc_MediaPlayerESSelected, HandleTracksChanged, this);
     }
 }
 
 void VlcPlayer::CleanupEventCallbacks()
+{
+    DetachPlayerEvents();
+    event_aggregator_.StopDeferredFlush();
+
+    // Release thread-safe function
+    if (tsfn_events_)
+        tsfn_events_.Release();
+}
+
+void VlcPlayer::DetachPlayerEvents()
 {
     if (event_manager_)
     {
@@ -212,12 +206,15 @@ void VlcPlayer::CleanupEventCallbacks()
         libvlc_event_detach(event_manager_, libvlc_MediaPlayerEncounteredError, HandleError, this);
         libvlc_event_detach(event_manager_, libvlc_MediaPlayerLengthChanged, HandleLengthChanged, this);
         libvlc_event_detach(event_manager_, libvlc_MediaPlayerBuffering, HandleBuffering, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerPositionChanged, HandlePositionChanged, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerAudioVolume, HandleAudioVolume, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerMuted, HandleAudioVolume, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerUnmuted, HandleAudioVolume, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerESAdded, HandleTracksChanged, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerESDeleted, HandleTracksChanged, this);
+        libvlc_event_detach(event_manager_, libvlc_MediaPlayerESSelected, HandleTracksChanged, this);
         event_manager_ = nullptr;
     }
-
-    // Release thread-safe function
-    if (tsfn_events_)
-        tsfn_events_.Release();
 }
 
 // Unified Event Registration
@@ -244,39 +241,69 @@ Napi::Value VlcPlayer::SetEventCallback(const Napi::CallbackInfo &info)
         0,
         1);
 
+    // Optional flush rate for merged playback events: { interval: ms } (0 = every change)
+    // { compact: true } sends time/position/buffering as a fixed-layout "playback" Buffer
+    if (info.Length() > 1 && info[1].IsObject())
+    {
+        Napi::Object options = info[1].As<Napi::Object>();
+        if (options.Has("interval") && options.Get("interval").IsNumber())
+        {
+            double interval = options.Get("interval").As<Napi::Number>().DoubleValue();
+            event_aggregator_.SetInterval(static_cast<int64_t>(interval * 1000.0));
+        }
+        if (options.Has("compact"))
+        {
+            compact_events_ = options.Get("compact").ToBoolean().Value();
+        }
+    }
+
     return env.Undefined();
 }
 
 // Static event handlers
+// Playback events only feed event_aggregator_, which decides when a merged payload goes to JS
 void VlcPlayer::HandleTimeChanged(const libvlc_event_t *event, void *data)
 {
+    TRACE_SCOPE("vlc.timeChanged");
     VlcPlayer *player = static_cast<VlcPlayer *>(data);
-    if (player->disposed_ || !player->media_player_)
+    if (player->disposed_)
         return;
 
-    int64_t time = event->u.media_player_time_changed.new_time;
+    if (player->event_aggregator_.UpdateTime(event->u.media_player_time_changed.new_time))
+        player->ScheduleEventFlush();
 
-    player->EmitCurrentVideo([player, time](Napi::Env env, Napi::Object &currentVideo)
-                             {
-        if (player->disposed_ || !player->media_player_) return;
+    // Input/demux rates for the latency controller, sampled from the player that sent the event
+    if (player->latency_.WantsBitrateSample())
+    {
+        libvlc_media_player_t *mp = static_cast<libvlc_media_player_t *>(event->p_obj);
+        if (libvlc_media_t *media = libvlc_media_player_get_media(mp))
+        {
+            libvlc_media_stats_t stats;
+            // Rates are in bytes per microsecond
+            if (libvlc_media_get_stats(media, &stats))
+                player->latency_.OnBitrate(stats.f_input_bitrate * 8000.0f, stats.f_demux_bitrate * 8000.0f);
+            libvlc_media_release(media);
+        }
+    }
 
-        // Time
-        currentVideo.Set("time", Napi::Number::New(env, static_cast<double>(time)));
+    player->EmitStats();
+}
 
-        // Position (normalized 0.0 - 1.0)
-        float position = libvlc_media_player_get_position(player->media_player_);
-        currentVideo.Set("position", Napi::Number::New(env, position));
+void VlcPlayer::HandlePositionChanged(const libvlc_event_t *event, void *data)
+{
+    TRACE_SCOPE("vlc.positionChanged");
+    VlcPlayer *player = static_cast<VlcPlayer *>(data);
+    if (player->disposed_)
+        return;
 
-        // Buffering progress (only if currently buffering)
-        libvlc_state_t state = libvlc_media_player_get_state(player->media_player_);
-        if (state == libvlc_Buffering) {
-            float bufferingProgress = player->buffering_progress_.load();
-            currentVideo.Set("buffering", Napi::Number::New(env, bufferingProgress));
-        } });
+    // Position (normalized 0.0 - 1.0)
+    if (player->event_aggregator_.UpdatePosition(event->u.media_player_position_changed.new_position))
+        player->ScheduleEventFlush();
 }
 
 void VlcPlayer::HandleStateChanged(const libvlc_event_t *event, void *data)
 {
+    TRACE_SCOPE("vlc.stateChanged");
     VlcPlayer *player = static_cast<VlcPlayer *>(data);
     if (player->disposed_)
         return;
@@ -305,8 +332,8 @@ void VlcPlayer::HandleStateChanged(const libvlc_event_t *event, void *data)
         player->osd_window_->ShowPlaybackOSD(state);
     }
 
-    player->EmitCurrentVideo([state](Napi::Env env, Napi::Object &currentVideo)
-                             { currentVideo.Set("state", Napi::String::New(env, state)); });
+    if (player->event_aggregator_.UpdateState(state))
+        player->ScheduleEventFlush();
 }
 
 void VlcPlayer::HandleEndReached(const libvlc_event_t *event, void *data)
@@ -315,10 +342,8 @@ void VlcPlayer::HandleEndReached(const libvlc_event_t *event, void *data)
     if (player->disposed_)
         return;
 
-    player->EmitCurrentVideo([](Napi::Env env, Napi::Object &currentVideo)
-                             {
-        currentVideo.Set("endReached", Napi::Boolean::New(env, true));
-        currentVideo.Set("state", Napi::String::New(env, "ended")); });
+    if (player->event_aggregator_.UpdateEndReached())
+        player->ScheduleEventFlush();
 }
 
 void VlcPlayer::HandleError(const libvlc_event_t *event, void *data)
@@ -327,13 +352,14 @@ void VlcPlayer::HandleError(const libvlc_event_t *event, void *data)
     if (player->disposed_)
         return;
 
-    player->EmitCurrentVideo([](Napi::Env env, Napi::Object &currentVideo)
-                             { currentVideo.Set("error", Napi::String::New(env, "Playback error occurred")); });
+    if (player->event_aggregator_.UpdateError("Playback error occurred"))
+        player->ScheduleEventFlush();
 }
 
 void VlcPlayer::HandleLengthChanged(const libvlc_event_t *event, void *data)
 {
     VlcPlayer *player = static_cast<VlcPlayer *>(data);
+    player->length_ms_ = event->u.media_player_length_changed.new_length;
     if (player->disposed_ || !player->tsfn_events_)
         return;
 
@@ -344,7 +370,7 @@ void VlcPlayer::HandleLengthChanged(const libvlc_event_t *event, void *data)
         Napi::Object payload = Napi::Object::New(env);
 
         // Media Info (tracks, duration, etc.)
-        Napi::Object mediaInfo = player->GetMediaInfoObject(env);
+        Napi::Object mediaInfo = player->GetMediaInfoObject(env, &player->emitted_track_version_);
         payload.Set("mediaInfo", mediaInfo);
 
         // Player Settings (persistent across videos)
@@ -407,6 +433,7 @@ void VlcPlayer::HandleLengthChanged(const libvlc_event_t *event, void *data)
 
 void VlcPlayer::HandleBuffering(const libvlc_event_t *event, void *data)
 {
+    TRACE_SCOPE("vlc.buffering");
     VlcPlayer *player = static_cast<VlcPlayer *>(data);
     if (player->disposed_)
         return;
@@ -414,9 +441,50 @@ void VlcPlayer::HandleBuffering(const libvlc_event_t *event, void *data)
     // Store buffering progress
     float cache = event->u.media_player_buffering.new_cache;
     player->buffering_progress_.store(cache);
+    player->latency_.OnBuffering(cache);
 
-    // Note: We don't emit buffering here separately
-    // It will be sent with the next TimeChanged event if state is buffering
+    if (player->event_aggregator_.UpdateBuffering(cache))
+        player->ScheduleEventFlush();
+}
+
+void VlcPlayer::HandleAudioVolume(const libvlc_event_t *event, void *data)
+{
+    VlcPlayer *player = static_cast<VlcPlayer *>(data);
+    if (player->disposed_)
+        return;
+
+    // Volume changes made by the audio output itself (e.g. restored on aout creation).
+    // Values already reported by audio() are dropped by the aggregator.
+    bool flush = false;
+    switch (event->type)
+    {
+    case libvlc_MediaPlayerAudioVolume:
+        flush = player->event_aggregator_.UpdateVolume(
+            static_cast<int>(event->u.media_player_audio_volume.volume * 100.0f + 0.5f));
+        break;
+    case libvlc_MediaPlayerMuted:
+        flush = player->event_aggregator_.UpdateMuted(true);
+        break;
+    case libvlc_MediaPlayerUnmuted:
+        flush = player->event_aggregator_.UpdateMuted(false);
+        break;
+    default:
+        break;
+    }
+
+    if (flush)
+        player->ScheduleEventFlush();
+}
+
+// ESAdded / ESDeleted / ESSelected: an open fires one per stream, EmitMediaInfo() coalesces them
+void VlcPlayer::HandleTracksChanged(const libvlc_event_t *event, void *data)
+{
+    VlcPlayer *player = static_cast<VlcPlayer *>(data);
+    player->track_cache_.Invalidate();
+    if (player->disposed_)
+        return;
+
+    player->EmitMediaInfo();
 }
 
 // Cleanup
@@ -424,26 +492,37 @@ Napi::Value VlcPlayer::Dispose(const Napi::CallbackInfo &info)
 {
     Napi::Env env = info.Env();
 
-    // Set disposed flag under mutex protection to prevent race conditions
+    // Waits for libVLC calls already in flight on other threads, later ones see the flag
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::shared_mutex> lock(player_mutex_);
         disposed_ = true;
     }
 
     // Cleanup event callbacks after setting disposed flag
     CleanupEventCallbacks();
 
+    // Joins the scrub thread, which seeks under player_mutex_
+    StopScrub();
 
+    std::unique_lock<std::shared_mutex> lock(player_mutex_);
 
-    // Acquire mutex for cleanup operations
-    std::lock_guard<std::mutex> lock(mutex_);
-
+    std::shared_ptr<TimeshiftSession> timeshift = DetachTimeshift();
     if (media_player_)
     {
-        libvlc_media_player_stop(media_player_);
-        libvlc_media_player_release(media_player_);
+        VlcInstancePool::Get().ReturnPlayer(media_player_);
         media_player_ = nullptr;
     }
+    if (timeshift)
+        timeshift->Stop();
+
+    VlcInstancePool::Get().ReturnPlayer(DetachStandby());
+
+    // The vout is gone, so is the producer side of any shared ring
+    {
+        std::lock_guard<std::mutex> vmem_lock(vmem_mutex_);
+        frame_ring_.SetProvider(nullptr);
+        shared_frames_.reset();
+    }
 
     if (current_media_)
     {
@@ -453,13 +532,218 @@ Napi::Value VlcPlayer::Dispose(const Napi::CallbackInfo &info)
 
     if (vlc_instance_)
     {
-        libvlc_release(vlc_instance_);
+        VlcInstancePool::Get().ReleaseInstance();
         vlc_instance_ = nullptr;
     }
 
     return env.Undefined();
 }
 
+// ================================================================================================
+// Shared Instance Pool
+// ================================================================================================
+
+static bool ParsePluginCacheMode(const std::string &name, PluginCacheMode *mode)
+{
+    if (name == "reuse")
+        *mode = PluginCacheMode::REUSE;
+    else if (name == "rebuild")
+        *mode = PluginCacheMode::REBUILD;
+    else if (name == "off")
+        *mode = PluginCacheMode::OFF;
+    else
+        return false;
+    return true;
+}
+
+static const char *PluginCacheModeName(PluginCacheMode mode)
+{
+    switch (mode)
+    {
+    case PluginCacheMode::REBUILD:
+        return "rebuild";
+    case PluginCacheMode::OFF:
+        return "off";
+    case PluginCacheMode::REUSE:
+    default:
+        return "reuse";
+    }
+}
+
+static Napi::Object PoolStatsToObject(Napi::Env env, const VlcPoolStats &stats)
+{
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("ready", Napi::Boolean::New(env, stats.instance_ready));
+    result.Set("pluginCache", Napi::String::New(env, PluginCacheModeName(stats.plugin_cache)));
+    result.Set("instanceRefs", Napi::Number::New(env, stats.instance_refs));
+    result.Set("idlePlayers", Napi::Number::New(env, static_cast<double>(stats.idle_players)));
+    result.Set("borrowedPlayers", Napi::Number::New(env, static_cast<double>(stats.borrowed_players)));
+    result.Set("warm", Napi::Number::New(env, static_cast<double>(stats.warm_target)));
+    result.Set("maxIdle", Napi::Number::New(env, static_cast<double>(stats.max_idle)));
+    return result;
+}
+
+// Applies { warm, maxIdle, pluginCache }, returns false (with a pending exception) on bad input
+static bool ApplyPoolOptions(Napi::Env env, const Napi::Object &options)
+{
+    VlcInstancePool &pool = VlcInstancePool::Get();
+
+    if (options.Has("pluginCache"))
+    {
+        PluginCacheMode mode;
+        std::string name = options.Get("pluginCache").As<Napi::String>().Utf8Value();
+        if (!ParsePluginCacheMode(name, &mode))
+        {
+            Napi::TypeError::New(env, "pluginCache must be one of reuse, rebuild, off").ThrowAsJavaScriptException();
+            return false;
+        }
+        if (!pool.SetPluginCacheMode(mode))
+        {
+            VlcPlayer::Log("WARNING: pluginCache=%s ignored, libVLC instance already running", name.c_str());
+        }
+    }
+
+    if (options.Has("warm") || options.Has("maxIdle"))
+    {
+        VlcPoolStats current = pool.GetStats();
+        size_t warm = current.warm_target;
+        size_t max_idle = current.max_idle;
+        if (options.Has("warm"))
+            warm = static_cast<size_t>(std::max(0, options.Get("warm").As<Napi::Number>().Int32Value()));
+        if (options.Has("maxIdle"))
+            max_idle = static_cast<size_t>(std::max(0, options.Get("maxIdle").As<Napi::Number>().Int32Value()));
+
+        pool.Configure(warm, max_idle);
+    }
+
+    return true;
+}
+
+// Shared pool configuration: VlcPlayer.pool({ warm, maxIdle, pluginCache }) -> stats
+Napi::Value VlcPlayer::Pool(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    VlcInstancePool &pool = VlcInstancePool::Get();
+
+    if (info.Length() > 0 && info[0].IsObject())
+    {
+        if (!ApplyPoolOptions(env, info[0].As<Napi::Object>()))
+            return env.Undefined();
+
+        pool.Prewarm();
+    }
+
+    return PoolStatsToObject(env, pool.GetStats());
+}
+
+// Runs libvlc_new() (plugin loading) and player pre-creation off the JS thread
+class WarmupWorker : public Napi::AsyncWorker
+{
+public:
+    WarmupWorker(Napi::Env env, Napi::Promise::Deferred deferred)
+        : Napi::AsyncWorker(env, "VlcWarmup"),
+          deferred_(deferred),
+          elapsed_ms_(0)
+    {
+    }
+
+protected:
+    void Execute() override
+    {
+        auto started = std::chrono::steady_clock::now();
+        if (!VlcInstancePool::Get().Warmup())
+        {
+            SetError("Failed to initialize libVLC");
+            return;
+        }
+        // Startup probe, so video({ hwDecode: 'auto' }) knows whether any decoder works
+        ProbeHwDecoders();
+        elapsed_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - started)
+                          .count();
+    }
+
+    void OnOK() override
+    {
+        Napi::Env env = Env();
+        Napi::Object result = PoolStatsToObject(env, VlcInstancePool::Get().GetStats());
+        result.Set("elapsedMs", Napi::Number::New(env, static_cast<double>(elapsed_ms_)));
+        result.Set("hwDecoders", VlcPlayer::HwDecoderCapsToArray(env, ProbeHwDecoders()));
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    int64_t elapsed_ms_;
+};
+
+// VlcPlayer.warmup({ pluginCache, warm }) -> Promise<stats & { elapsedMs, hwDecoders }>
+Napi::Value VlcPlayer::Warmup(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    if (info.Length() > 0 && info[0].IsObject())
+    {
+        if (!ApplyPoolOptions(env, info[0].As<Napi::Object>()))
+            return env.Undefined();
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    WarmupWorker *worker = new WarmupWorker(env, deferred);
+    worker->Queue();
+
+    return deferred.Promise();
+}
+
+// ================================================================================================
+// Tracing
+// ================================================================================================
+
+/**
+ * VlcPlayer.trace({ enabled?, syncLog?, clear?, dump? }) -> { enabled, syncLog, events, threads, droppedLogs, json? }
+ *
+ * dump adds the recorded events as Chrome trace JSON (chrome://tracing, ui.perfetto.dev),
+ * clear forgets them afterwards. syncLog prints log lines in place instead of on the log thread.
+ */
+Napi::Value VlcPlayer::TraceControl(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+
+    bool dump = false;
+    bool clear = false;
+    if (info.Length() > 0 && info[0].IsObject())
+    {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("enabled"))
+            Trace::SetEnabled(options.Get("enabled").ToBoolean().Value());
+        if (options.Has("syncLog"))
+            LogSink::Get().SetSynchronous(options.Get("syncLog").ToBoolean().Value());
+        if (options.Has("dump"))
+            dump = options.Get("dump").ToBoolean().Value();
+        if (options.Has("clear"))
+            clear = options.Get("clear").ToBoolean().Value();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, Trace::Enabled()));
+    result.Set("syncLog", Napi::Boolean::New(env, LogSink::Get().IsSynchronous()));
+    result.Set("events", Napi::Number::New(env, static_cast<double>(Trace::EventCount())));
+    result.Set("threads", Napi::Number::New(env, static_cast<double>(Trace::ThreadCount())));
+    result.Set("droppedLogs", Napi::Number::New(env, static_cast<double>(LogSink::Get().Dropped())));
+
+    if (dump)
+        result.Set("json", Napi::String::New(env, Trace::DumpJson()));
+    if (clear)
+        Trace::Clear();
+
+    return result;
+}
+
 // ================================================================================================
 // Helper Methods
 // ================================================================================================
@@ -494,7 +778,15 @@ std::string VlcPlayer::FormatTime(int64_t time_ms)
 // Module initialization
 Napi::Object Init(Napi::Env env, Napi::Object exports)
 {
+    VlcFrameReader::Init(env, exports);
+    VlcThumbnailer::Init(env, exports);
+    VlcCatalog::Init(env, exports);
+    VlcMosaic::Init(env, exports);
+#ifdef VLC_BENCH
+    VlcBench::Init(env, exports);
+#endif
     return VlcPlayer::Init(env, exports);
 }
 
-NODE_API_MODULE(vlc_player, Init)
+// vlc_player, or vlc_bench for the benchmark build of the same sources
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
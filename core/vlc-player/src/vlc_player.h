@@ -15,13 +15,25 @@ typedef SSIZE_T ssize_t;
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <array>
 #include <mutex>
+#include <shared_mutex>
 #include <atomic>
 #include <memory>
 #include <chrono>
 #include <thread>
 #include "os/common.h"
 #include "os/window_base.h"
+#include "vlc_frame_ring.h"
+#include "vlc_event_aggregator.h"
+#include "vlc_shared_frames.h"
+#include "vlc_scrub.h"
+#include "vlc_latency.h"
+#include "vlc_hw_decode.h"
+#include "vlc_track_cache.h"
+#include "vlc_timeshift_buffer.h"
+#include "vlc_trace.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -31,6 +43,34 @@ typedef SSIZE_T ssize_t;
 #include <objc/objc.h>
 #endif
 
+// Media info captured off the JS thread (pre-parse), converted to JS on completion
+struct MediaInfoSnapshot
+{
+    bool parsed = false;
+    std::string parse_status; // "done", "failed", "timeout", "skipped", "none"
+    int64_t duration = -1;
+    std::map<std::string, std::string> meta;
+    std::vector<MediaTrackSnapshot> audio_tracks;
+    std::vector<MediaTrackSnapshot> subtitle_tracks;
+    std::vector<MediaTrackSnapshot> video_tracks;
+};
+
+// getStats() / "stats" events: plain copies taken under the player lock, converted on the JS thread
+struct PlaybackStatsSnapshot
+{
+    bool has_media = false;
+    libvlc_media_stats_t media = {};
+    float buffering = 0.0f;
+    FrameRingStats vmem;
+    EventAggregatorStats events;
+    LatencyStats latency;
+    TrackCacheStats tracks;
+};
+
+class OpenWorker;
+class PreloadWorker;
+class TimeshiftSeekWorker;
+
 class VlcPlayer : public Napi::ObjectWrap<VlcPlayer>
 {
 public:
@@ -38,16 +78,13 @@ public:
     static constexpr int MIN_WINDOW_SIZE = 1;
     static constexpr size_t MAX_URL_LENGTH = 8192;
 
-    // Debug logging helper
+    // Debug logging helper, printed by the LogSink thread so callers never wait for stdout
     static void Log(const char *format, ...)
     {
-        printf("[VLC Node] ");
         va_list args;
         va_start(args, format);
-        vprintf(format, args);
+        LogSink::Get().Write("[VLC Node] ", format, args);
         va_end(args);
-        printf("\n");
-        fflush(stdout);
     }
 
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
@@ -59,26 +96,69 @@ public:
     friend LRESULT CALLBACK VlcWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
     friend class Win32Window;
 #endif
+    friend class OpenWorker;
+    friend class PreloadWorker;
+    friend class TimeshiftSeekWorker;
+    friend class WarmupWorker;
+    friend class HwProbeWorker;
+    friend class VlcBench; // vlc_bench target only
 
     // Internal members accessible by split files
     libvlc_instance_t *vlc_instance_;
     libvlc_media_player_t *media_player_;
     libvlc_media_t *current_media_;
-    std::mutex mutex_;
+
+    // Locking domains, always nested in this order:
+    //   player_mutex_ - lifetime of media_player_ / current_media_. Held shared around libVLC calls,
+    //                   unique only to swap in a standby player or to release them in dispose()
+    //   window_mutex_ - osd_window_ create / bind / destroy and the window() options
+    //   vmem_mutex_   - shared_frames_ and the render size
+    // timeshift_mutex_ (only timeshift_) is taken after player_mutex_ and never around libVLC calls.
+    // State read on hot paths without any of them is atomic.
+    std::shared_mutex player_mutex_;
+    std::mutex window_mutex_;
+    std::mutex vmem_mutex_;
+    using PlayerLock = std::shared_lock<std::shared_mutex>;
+
+    // Window-thread entry points skip their action instead of waiting (owns_lock() false): the
+    // JS thread may be stopping the player, which can wait on that very thread
+    PlayerLock TryLockPlayer() { return PlayerLock(player_mutex_, std::try_to_lock); }
+
     std::atomic<bool> disposed_{false};
     OSWindow *osd_window_;
 
 
     // Video memory (vmem) callback support
-    unsigned int video_width_;
-    unsigned int video_height_;
-    unsigned int video_pitch_;
-    std::vector<uint8_t> frame_buffer_;
-    std::mutex frame_mutex_;
-    bool frame_ready_;
+    // When memory_render_ is set VLC decodes into frame_ring_ instead of the native window
+    std::atomic<bool> memory_render_{false};
+    FrameRing frame_ring_;
+    std::atomic<FrameChroma> video_chroma_{FrameChroma::RV32};
+    std::shared_ptr<SharedFrameWriter> shared_frames_; // video({ sharedFrames }), guarded by vmem_mutex_
+
+    // Downscaled render target (0 = source size), source size as last reported by the decoder
+    std::atomic<unsigned> render_width_{0};
+    std::atomic<unsigned> render_height_{0};
+    std::atomic<unsigned> source_width_{0};
+    std::atomic<unsigned> source_height_{0};
+    bool render_size_follow_window_ = false;
+
+    // Push-based "frame" events (coalesced: at most one in flight, optional FPS cap)
+    std::atomic<bool> frame_events_enabled_{false};
+    std::atomic<bool> frame_event_pending_{false};
+    std::atomic<int64_t> frame_event_interval_us_{0};
+    std::atomic<uint64_t> frame_events_coalesced_{0};
+    int64_t last_frame_event_us_; // vout thread only
     std::atomic<float> buffering_progress_{0.0f};
+    std::atomic<int64_t> length_ms_{-1}; // From LengthChanged, seek OSDs read it without asking libVLC
 
-    void ProcessKeyPress(const std::string &key_code);
+    // Modifier mask for ProcessKeyPress(), also the "Ctrl+" / "Shift+" / "Alt+" / "Meta+" key prefixes
+    static constexpr unsigned SHORTCUT_CTRL = 1 << 0;
+    static constexpr unsigned SHORTCUT_SHIFT = 1 << 1;
+    static constexpr unsigned SHORTCUT_ALT = 1 << 2;
+    static constexpr unsigned SHORTCUT_META = 1 << 3;
+    static constexpr unsigned SHORTCUT_MODIFIER_COMBOS = 16;
+
+    void ProcessKeyPress(const std::string &key_code, unsigned modifiers = 0);
 
     std::vector<MenuItem> BuildContextMenu();
 
@@ -91,15 +171,38 @@ private:
     Napi::Value Audio(const Napi::CallbackInfo &info);
     Napi::Value Video(const Napi::CallbackInfo &info);
     Napi::Value Subtitle(const Napi::CallbackInfo &info);
+    Napi::Value Preload(const Napi::CallbackInfo &info);
+    /**
+     * Live channel opened with open({ timeshift }): status, seeks inside the ring and exports
+     * timeshift() -> status | null, timeshift({ seek | live | rewind | forward | export }) -> Promise
+     */
+    Napi::Value Timeshift(const Napi::CallbackInfo &info);
     /**
      * Get comprehensive media information (tracks, duration, seekability)
-     * Returns: { duration, isSeekable, audioTracks, subtitleTracks, videoTracks }
+     * Returns: { duration, isSeekable, audioTracks, subtitleTracks, videoTracks, latency }
      */
     Napi::Value GetMediaInfo(const Napi::CallbackInfo &info);
+    /**
+     * Playback-quality counters: libVLC input/demux/decoder stats, vmem timing, buffering
+     * getStats({ interval }) also sets the period of "stats" events (0 = off)
+     */
+    Napi::Value GetStats(const Napi::CallbackInfo &info);
 
     // Internal storage for media options (applied on Open)
     std::map<std::string, std::string> media_options_;
 
+    // open({ latency }): caching profile added to media_options_, adapted from stalls and bitrate
+    LatencyController latency_;
+    bool ApplyLatencyOption(Napi::Env env, const Napi::Value &value);
+    static Napi::Object LatencyStatsToObject(Napi::Env env, const LatencyStats &stats);
+
+    // video({ hwDecode }): :avcodec-hw for the next open, libVLC's own choice until set
+    std::atomic<bool> hw_decode_set_{false};
+    std::atomic<HwDecoder> hw_decode_{HwDecoder::AUTO};
+
+    // Per-media options every open()/preload() adds (latency profile, hardware decoder)
+    void AppendMediaOptions(std::map<std::string, std::string> *options);
+
     // Unified Window API (declared before internal methods to avoid X11 Window typedef conflict)
     Napi::Value Window(const Napi::CallbackInfo &info);
 
@@ -112,13 +215,37 @@ private:
     // Cleanup
     Napi::Value Dispose(const Napi::CallbackInfo &info);
 
+    // Shared instance pool (static)
+    static Napi::Value Pool(const Napi::CallbackInfo &info);
+    static Napi::Value Warmup(const Napi::CallbackInfo &info);
+    static Napi::Value HwDecoders(const Napi::CallbackInfo &info);
+    static Napi::Value TraceControl(const Napi::CallbackInfo &info);
+    static Napi::Array HwDecoderCapsToArray(Napi::Env env, const std::vector<HwDecoderCaps> &caps);
+
     // Event handling
     Napi::ThreadSafeFunction tsfn_events_;
 
+    // High-rate playback events (time, position, buffering, state) are merged here
+    EventAggregator event_aggregator_;
+    bool compact_events_ = false;     // time/position/buffering as a binary "playback" record
+    uint32_t playback_record_seq_ = 0; // JS thread only
+
     // Keyboard shortcut mapping (action -> keys[])
     // New format: { "playPause": ["Space", "KeyK"], "volumeUp": ["ArrowUp", "Equal"] }
     std::map<std::string, std::vector<std::string>> action_to_keys_;
 
+    // action_to_keys_ inverted for input events: key name -> action index per modifier mask (-1 = none).
+    // Rebuilt by the JS thread on every mapping change and swapped in whole, the window thread
+    // only takes a reference under the mutex.
+    struct ShortcutTable
+    {
+        std::vector<std::string> actions;
+        std::unordered_map<std::string, std::array<int16_t, SHORTCUT_MODIFIER_COMBOS>> keys;
+    };
+    std::mutex shortcut_mutex_;
+    std::shared_ptr<const ShortcutTable> shortcut_table_;
+    void RebuildShortcutTable();
+
     void ExecuteMenuAction(const std::string &action);
 
     // Helper methods for OSD (delegates to osd_window_)
@@ -129,6 +256,7 @@ private:
 
     void SetupEventCallbacks();
     void CleanupEventCallbacks();
+    void DetachPlayerEvents();
 
     // Static event handlers
     static void HandleTimeChanged(const libvlc_event_t *event, void *data);
@@ -137,6 +265,9 @@ private:
     static void HandleError(const libvlc_event_t *event, void *data);
     static void HandleLengthChanged(const libvlc_event_t *event, void *data);
     static void HandleBuffering(const libvlc_event_t *event, void *data);
+    static void HandlePositionChanged(const libvlc_event_t *event, void *data);
+    static void HandleAudioVolume(const libvlc_event_t *event, void *data);
+    static void HandleTracksChanged(const libvlc_event_t *event, void *data);
 
     // Shortcut management
     void InitializeDefaultShortcuts();
@@ -144,22 +275,80 @@ private:
     bool HasKeyForAction(const std::string &action);
     bool IsKnownAction(const std::string &action);
 
+    // Track lists, re-read only after ES events or a media change (own lock, after player_mutex_)
+    TrackCache track_cache_;
+    std::atomic<bool> media_info_event_pending_{false};
+    uint64_t emitted_track_version_ = 0; // JS thread only
+
     // Helpers
-    Napi::Object GetMediaInfoObject(Napi::Env env);
+    Napi::Object GetMediaInfoObject(Napi::Env env, uint64_t *track_version = nullptr);
+    static Napi::Array TracksToArray(Napi::Env env, const std::vector<MediaTrackSnapshot> &tracks);
+    static void SnapshotMediaInfo(libvlc_media_t *media, MediaInfoSnapshot *snapshot);
+    static Napi::Object MediaInfoSnapshotToObject(Napi::Env env, const MediaInfoSnapshot &snapshot);
+    void SnapshotStats(PlaybackStatsSnapshot *snapshot); // Takes player_mutex_ (shared)
+    static Napi::Object StatsSnapshotToObject(Napi::Env env, const PlaybackStatsSnapshot &snapshot);
+
+    // Periodic "stats" events, driven by time changes so they only run while playing
+    std::atomic<int64_t> stats_interval_ms_{0};
+    std::atomic<int64_t> next_stats_event_ms_{0};
+    std::atomic<bool> stats_event_pending_{false};
+
+    // Async open(): serialises media creation/parsing, newer open() calls supersede older ones
+    std::mutex open_mutex_;
+    std::atomic<uint64_t> open_generation_{0};
+
+    // Zapping fast path: standby player opened start-paused with discarded video
+    std::mutex standby_mutex_;
+    libvlc_media_player_t *standby_player_ = nullptr;
+    std::string standby_url_;
+    bool standby_ready_ = false;        // Media set and playing (guarded by standby_mutex_)
+    bool vout_restart_pending_ = false; // Swapped-in player still renders into the discard vout, play() restarts it
+    libvlc_media_player_t *TakeStandby(const std::string &url);
+    libvlc_media_player_t *DetachStandby();
+
+    // Player-level audio/video settings outlive the media, the standby has to inherit them
+    std::string deinterlace_mode_; // Last mode set, "" = off (libVLC has no getter)
+    void CopyPlayerSettings(libvlc_media_player_t *from, libvlc_media_player_t *to);
+
+    // Timeshift: session whose ring the current media reads, set by the open worker with the media
+    std::mutex timeshift_mutex_;
+    std::shared_ptr<TimeshiftSession> timeshift_;
+    bool ParseTimeshiftOption(Napi::Env env, const Napi::Value &value, TimeshiftOptions *options);
+    std::shared_ptr<TimeshiftSession> GetTimeshift();
+    std::shared_ptr<TimeshiftSession> DetachTimeshift(); // Interrupted, stop the player before releasing it
+    static Napi::Object TimeshiftStatsToObject(Napi::Env env, const TimeshiftSession &session,
+                                               const TimeshiftStats &stats);
+
+    // Seek-bar scrubbing: coalesced seeks and preview pictures, created on first use (JS thread)
+    std::unique_ptr<ScrubController> scrub_;
+    ScrubController *GetScrub();
+    void ApplyScrubOption(const Napi::Value &value);
+    void ScrubTo(int64_t time); // Caller holds player_mutex_
+    void StopScrub();           // Caller must not hold player_mutex_ (the scrub thread seeks under it)
 
     // Event emission helpers
     void EmitCurrentVideo(std::function<void(Napi::Env, Napi::Object &)> builder);
     void EmitPlayerInfo(std::function<void(Napi::Env, Napi::Object &)> builder);
     void EmitMediaInfo();
+    void EmitFrame();
+    void EmitStats();
+    void ScheduleEventFlush();
 
     // Video memory callbacks
     void SetupVideoCallbacks();
+    static unsigned VideoFormatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                        unsigned *pitches, unsigned *lines);
+    static void VideoCleanupCallback(void *opaque);
     static void *VideoLockCallback(void *opaque, void **planes);
     static void VideoUnlockCallback(void *opaque, void *picture, void *const *planes);
     static void VideoDisplayCallback(void *opaque, void *picture);
 
+    // Render size for the next format negotiation (caller holds player_mutex_ shared and vmem_mutex_)
+    void SetRenderSize(unsigned width, unsigned height);
+
     // Frame retrieval
     Napi::Value GetFrame(const Napi::CallbackInfo &info);
+    Napi::Value GetFrameBuffers(const Napi::CallbackInfo &info);
     Napi::Value GetVideoFormat(const Napi::CallbackInfo &info);
 };
 
@@ -0,0 +1,364 @@
+#include "vlc_png.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+// =================================================================================================
+// Checksums
+// =================================================================================================
+
+static const std::array<uint32_t, 256> &Crc32Table()
+{
+    static const std::array<uint32_t, 256> table = []()
+    {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            result[n] = c;
+        }
+        return result;
+    }();
+    return table;
+}
+
+static uint32_t Crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+{
+    const auto &table = Crc32Table();
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t Adler32(const uint8_t *data, size_t size)
+{
+    // 5552 bytes is the longest run that cannot overflow before the modulo
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0)
+    {
+        size_t run = size < 5552 ? size : 5552;
+        size -= run;
+        while (run--)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+static void PutBigEndian(std::vector<uint8_t> *out, uint32_t value)
+{
+    out->push_back(static_cast<uint8_t>(value >> 24));
+    out->push_back(static_cast<uint8_t>(value >> 16));
+    out->push_back(static_cast<uint8_t>(value >> 8));
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+// =================================================================================================
+// Deflate (LZ77 with hash chains, one fixed-Huffman block)
+// =================================================================================================
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t> *out) : out_(out) {}
+
+    // Deflate packs bits LSB first
+    void Write(uint32_t bits, int count)
+    {
+        buffer_ |= bits << count_;
+        count_ += count;
+        while (count_ >= 8)
+        {
+            out_->push_back(static_cast<uint8_t>(buffer_));
+            buffer_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    // ...except Huffman codes, which are stored MSB first
+    void WriteCode(uint32_t code, int length)
+    {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++)
+            reversed |= ((code >> i) & 1) << (length - 1 - i);
+        Write(reversed, length);
+    }
+
+    void Flush()
+    {
+        if (count_ > 0)
+            out_->push_back(static_cast<uint8_t>(buffer_));
+        buffer_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::vector<uint8_t> *out_;
+    uint32_t buffer_ = 0;
+    int count_ = 0;
+};
+
+static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                         35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                         3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                           193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+                                           4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                           6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static void WriteSymbol(BitWriter &writer, int symbol)
+{
+    // Fixed literal/length code of RFC 1951 3.2.6
+    if (symbol < 144)
+        writer.WriteCode(0x30 + symbol, 8);
+    else if (symbol < 256)
+        writer.WriteCode(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        writer.WriteCode(symbol - 256, 7);
+    else
+        writer.WriteCode(0xC0 + symbol - 280, 8);
+}
+
+static void WriteMatch(BitWriter &writer, int length, int distance)
+{
+    int l = 28;
+    while (LENGTH_BASE[l] > length)
+        l--;
+    WriteSymbol(writer, 257 + l);
+    writer.Write(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+    int d = 29;
+    while (DISTANCE_BASE[d] > distance)
+        d--;
+    writer.WriteCode(d, 5);
+    writer.Write(distance - DISTANCE_BASE[d], DISTANCE_EXTRA[d]);
+}
+
+static void Deflate(const uint8_t *data, size_t size, std::vector<uint8_t> *out)
+{
+    const int WINDOW = 32768;
+    const int MIN_MATCH = 3;
+    const int MAX_MATCH = 258;
+    const int HASH_BITS = 15;
+    const int MAX_CHAIN = 32; // Probes per position, trades ratio for speed
+
+    std::vector<int32_t> head(1 << HASH_BITS, -1);
+    std::vector<int32_t> prev(size, -1);
+
+    auto hash = [data](size_t pos)
+    {
+        uint32_t value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16);
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    };
+    auto insert = [&](size_t pos)
+    {
+        if (pos + MIN_MATCH > size)
+            return;
+        uint32_t h = hash(pos);
+        prev[pos] = head[h];
+        head[h] = static_cast<int32_t>(pos);
+    };
+
+    BitWriter writer(out);
+    writer.Write(1, 1); // BFINAL
+    writer.Write(1, 2); // BTYPE = fixed Huffman
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        int best_length = 0;
+        int best_distance = 0;
+
+        if (pos + MIN_MATCH <= size)
+        {
+            int limit = static_cast<int>(std::min<size_t>(MAX_MATCH, size - pos));
+            int32_t candidate = head[hash(pos)];
+            for (int chain = 0; candidate >= 0 && chain < MAX_CHAIN; chain++)
+            {
+                int distance = static_cast<int>(pos - candidate);
+                if (distance > WINDOW)
+                    break;
+
+                int length = 0;
+                while (length < limit && data[candidate + length] == data[pos + length])
+                    length++;
+
+                if (length > best_length)
+                {
+                    best_length = length;
+                    best_distance = distance;
+                    if (length == limit)
+                        break;
+                }
+                candidate = prev[candidate];
+            }
+        }
+
+        if (best_length >= MIN_MATCH)
+        {
+            WriteMatch(writer, best_length, best_distance);
+            for (int i = 0; i < best_length; i++)
+                insert(pos + i);
+            pos += best_length;
+        }
+        else
+        {
+            WriteSymbol(writer, data[pos]);
+            insert(pos);
+            pos++;
+        }
+    }
+
+    WriteSymbol(writer, 256); // End of block
+    writer.Flush();
+}
+
+// =================================================================================================
+// Scanline Filters
+// =================================================================================================
+
+static inline uint8_t Paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return static_cast<uint8_t>(a);
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+/**
+ * Append the best filtered version of row (filter byte + bytes), picked by the usual
+ * minimum sum of absolute differences heuristic
+ */
+static void FilterRow(const uint8_t *row, const uint8_t *above, size_t length, int bpp,
+                      std::vector<uint8_t> *candidates, std::vector<uint8_t> *out)
+{
+    const int FILTERS = 5;
+    candidates->resize(length * FILTERS);
+
+    long best_score = -1;
+    int best_filter = 0;
+    for (int filter = 0; filter < FILTERS; filter++)
+    {
+        uint8_t *target = candidates->data() + length * filter;
+        long score = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            int left = i >= static_cast<size_t>(bpp) ? row[i - bpp] : 0;
+            int up = above ? above[i] : 0;
+            int up_left = (above && i >= static_cast<size_t>(bpp)) ? above[i - bpp] : 0;
+
+            uint8_t predicted = 0;
+            switch (filter)
+            {
+            case 1:
+                predicted = static_cast<uint8_t>(left);
+                break;
+            case 2:
+                predicted = static_cast<uint8_t>(up);
+                break;
+            case 3:
+                predicted = static_cast<uint8_t>((left + up) / 2);
+                break;
+            case 4:
+                predicted = Paeth(left, up, up_left);
+                break;
+            default:
+                break;
+            }
+
+            target[i] = static_cast<uint8_t>(row[i] - predicted);
+            score += std::abs(static_cast<int8_t>(target[i]));
+        }
+
+        if (best_score < 0 || score < best_score)
+        {
+            best_score = score;
+            best_filter = filter;
+        }
+    }
+
+    out->push_back(static_cast<uint8_t>(best_filter));
+    const uint8_t *best = candidates->data() + length * best_filter;
+    out->insert(out->end(), best, best + length);
+}
+
+// =================================================================================================
+// PNG Container
+// =================================================================================================
+
+static void WriteChunk(std::vector<uint8_t> *png, const char type[4], const std::vector<uint8_t> &data)
+{
+    PutBigEndian(png, static_cast<uint32_t>(data.size()));
+
+    size_t type_offset = png->size();
+    png->insert(png->end(), type, type + 4);
+    png->insert(png->end(), data.begin(), data.end());
+
+    PutBigEndian(png, Crc32(png->data() + type_offset, data.size() + 4));
+}
+
+bool EncodePNG(const uint8_t *bgrx, unsigned width, unsigned height, unsigned pitch,
+               std::vector<uint8_t> *png)
+{
+    if (!bgrx || width == 0 || height == 0)
+        return false;
+
+    // RV32 alpha is undefined, drop it and store RGB
+    const int bpp = 3;
+    size_t row_length = static_cast<size_t>(width) * bpp;
+
+    std::vector<uint8_t> filtered;
+    filtered.reserve((row_length + 1) * height);
+
+    std::vector<uint8_t> row(row_length);
+    std::vector<uint8_t> above(row_length);
+    std::vector<uint8_t> candidates;
+    for (unsigned y = 0; y < height; y++)
+    {
+        const uint8_t *source = bgrx + static_cast<size_t>(y) * pitch;
+        for (unsigned x = 0; x < width; x++)
+        {
+            row[x * 3 + 0] = source[x * 4 + 2];
+            row[x * 3 + 1] = source[x * 4 + 1];
+            row[x * 3 + 2] = source[x * 4 + 0];
+        }
+
+        FilterRow(row.data(), y > 0 ? above.data() : nullptr, row_length, bpp, &candidates, &filtered);
+        row.swap(above);
+    }
+
+    // zlib wrapper: deflate, 32K window, no dictionary
+    std::vector<uint8_t> idat = {0x78, 0x01};
+    Deflate(filtered.data(), filtered.size(), &idat);
+    PutBigEndian(&idat, Adler32(filtered.data(), filtered.size()));
+
+    std::vector<uint8_t> ihdr;
+    PutBigEndian(&ihdr, width);
+    PutBigEndian(&ihdr, height);
+    ihdr.push_back(8); // Bit depth
+    ihdr.push_back(2); // Color type: truecolor
+    ihdr.push_back(0); // Compression: deflate
+    ihdr.push_back(0); // Filter method: adaptive
+    ihdr.push_back(0); // No interlace
+
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png->assign(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    WriteChunk(png, "IHDR", ihdr);
+    WriteChunk(png, "IDAT", idat);
+    WriteChunk(png, "IEND", {});
+    return true;
+}
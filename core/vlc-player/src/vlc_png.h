@@ -0,0 +1,22 @@
+#ifndef VLC_PNG_H
+#define VLC_PNG_H
+
+#include <cstdint>
+#include <vector>
+
+// =================================================================================================
+// PNG Encoder - Self-contained writer for decoded RV32 thumbnails
+// =================================================================================================
+// No image library ships with the addon (and Electron's zlib is not reliably exported), so
+// thumbnails are written with a small built-in encoder: adaptive per-row filters, then
+// LZ77 + fixed-Huffman deflate. It is slower than zlib at its best level but needs nothing
+// extra, and thumbnail-sized pictures encode in a few milliseconds.
+
+/**
+ * Encode a BGRX frame (libVLC RV32, alpha ignored) as an 8-bit RGB PNG
+ * @return false if the size is 0
+ */
+bool EncodePNG(const uint8_t *bgrx, unsigned width, unsigned height, unsigned pitch,
+               std::vector<uint8_t> *png);
+
+#endif // VLC_PNG_H
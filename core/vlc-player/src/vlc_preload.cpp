@@ -0,0 +1,213 @@
+#include "vlc_player.h"
+#include "vlc_instance_pool.h"
+#include <cstring>
+
+// =================================================================================================
+// Standby Player (zapping fast path)
+// =================================================================================================
+// preload({ file }) borrows a second media player from the pool and opens the media with
+// :start-paused, without producing audio. Video goes to a tiny discard vmem target. open() with
+// the same file swaps the standby player in without creating or parsing media.
+//
+// libVLC 3 keeps a vout for the lifetime of the input and reuses it while the format does not
+// change, so the discard target cannot be swapped for the real one in place: play() stops the
+// standby once and starts it again on the window / vmem output. Access and demux are opened a
+// second time then, the preload only warms what the OS and network caches keep.
+
+static constexpr unsigned STANDBY_WIDTH = 64;
+static constexpr unsigned STANDBY_HEIGHT = 36;
+
+static unsigned StandbyFormatCallback(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                                      unsigned* pitches, unsigned* lines) {
+    (void)opaque;
+    memcpy(chroma, "RV32", 4);
+    *width = STANDBY_WIDTH;
+    *height = STANDBY_HEIGHT;
+    *pitches = STANDBY_WIDTH * 4;
+    *lines = STANDBY_HEIGHT;
+    return 1;
+}
+
+static void* StandbyLockCallback(void* opaque, void** planes) {
+    (void)opaque;
+    // One scratch picture per vout thread, the content is never read
+    static thread_local uint8_t scratch[STANDBY_WIDTH * STANDBY_HEIGHT * 4];
+    *planes = scratch;
+    return nullptr;
+}
+
+static void StandbyUnlockCallback(void* opaque, void* picture, void* const* planes) {
+    (void)opaque;
+    (void)picture;
+    (void)planes;
+}
+
+static void StandbyDisplayCallback(void* opaque, void* picture) {
+    (void)opaque;
+    (void)picture;
+}
+
+// Retires the previous standby player and starts the new one off the JS thread
+class PreloadWorker : public Napi::AsyncWorker {
+public:
+    PreloadWorker(Napi::Env env, VlcPlayer* player, Napi::Promise::Deferred deferred,
+                  libvlc_media_player_t* standby, libvlc_media_player_t* retired, const std::string& url,
+                  const std::map<std::string, std::string>& media_options)
+        : Napi::AsyncWorker(env, "VlcPreload"),
+          player_(player),
+          player_ref_(Napi::Persistent(player->Value())),
+          deferred_(deferred),
+          standby_(standby),
+          retired_(retired),
+          url_(url),
+          media_options_(media_options) {
+    }
+
+protected:
+    void Execute() override {
+        TRACE_SCOPE("preload.worker");
+
+        if (retired_) {
+            VlcInstancePool::Get().ReturnPlayer(retired_);
+        }
+
+        if (!standby_) return;
+
+        std::lock_guard<std::mutex> lock(player_->standby_mutex_);
+
+        // Replaced or swapped in before we got here
+        if (player_->standby_player_ != standby_) return;
+
+        bool is_url = url_.find("://") != std::string::npos;
+        libvlc_media_t* media = is_url ? libvlc_media_new_location(player_->vlc_instance_, url_.c_str())
+                                       : libvlc_media_new_path(player_->vlc_instance_, url_.c_str());
+        if (!media) {
+            SetError("Failed to create media");
+            return;
+        }
+
+        libvlc_media_add_option(media, ":start-paused");
+        for (const auto& opt : media_options_) {
+            std::string option_str = opt.first + "=" + opt.second;
+            libvlc_media_add_option(media, option_str.c_str());
+        }
+
+        libvlc_video_set_format_callbacks(standby_, StandbyFormatCallback, nullptr);
+        libvlc_video_set_callbacks(standby_, StandbyLockCallback, StandbyUnlockCallback,
+                                   StandbyDisplayCallback, nullptr);
+
+        libvlc_media_player_set_media(standby_, media);
+        libvlc_media_release(media);
+
+        if (libvlc_media_player_play(standby_) != 0) {
+            SetError("Failed to start standby player");
+            return;
+        }
+
+        player_->standby_ready_ = true;
+        VlcPlayer::Log("Standby player %p preloading: %s", (void*)standby_, url_.c_str());
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("preloaded", standby_ ? Napi::Value(Napi::String::New(env, url_)) : env.Null());
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    VlcPlayer* player_;
+    Napi::ObjectReference player_ref_;
+    Napi::Promise::Deferred deferred_;
+    libvlc_media_player_t* standby_;
+    libvlc_media_player_t* retired_;
+    std::string url_;
+    std::map<std::string, std::string> media_options_;
+};
+
+/**
+ * preload({ file }) -> Promise<{ preloaded }>
+ * preload(null)     -> drops the standby player
+ */
+Napi::Value VlcPlayer::Preload(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    std::string url;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("file") && options.Get("file").IsString()) {
+            url = options.Get("file").As<Napi::String>().Utf8Value();
+        }
+    }
+
+    if (!vlc_instance_ || disposed_) {
+        Napi::Error::New(env, "Player not initialized").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    libvlc_media_player_t* standby = nullptr;
+    libvlc_media_player_t* retired = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(standby_mutex_);
+
+        if (!url.empty() && url == standby_url_ && standby_player_) {
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("preloaded", Napi::String::New(env, url));
+            deferred.Resolve(result);
+            return deferred.Promise();
+        }
+
+        retired = standby_player_;
+        standby_player_ = nullptr;
+        standby_url_.clear();
+        standby_ready_ = false;
+
+        if (!url.empty()) {
+            standby = VlcInstancePool::Get().AcquirePlayer();
+            if (!standby) {
+                Log("ERROR: Failed to borrow standby player");
+            }
+            standby_player_ = standby;
+            standby_url_ = url;
+        }
+    }
+
+    // Same options as open() would add, so swapping the standby in changes nothing
+    std::map<std::string, std::string> media_options;
+    AppendMediaOptions(&media_options);
+
+    PreloadWorker* worker = new PreloadWorker(env, this, deferred, standby, retired, url, media_options);
+    worker->Queue();
+
+    return deferred.Promise();
+}
+
+libvlc_media_player_t* VlcPlayer::TakeStandby(const std::string& url) {
+    std::lock_guard<std::mutex> lock(standby_mutex_);
+
+    if (!standby_player_ || !standby_ready_ || url != standby_url_) {
+        return nullptr;
+    }
+
+    libvlc_media_player_t* player = standby_player_;
+    standby_player_ = nullptr;
+    standby_url_.clear();
+    standby_ready_ = false;
+    return player;
+}
+
+libvlc_media_player_t* VlcPlayer::DetachStandby() {
+    std::lock_guard<std::mutex> lock(standby_mutex_);
+
+    libvlc_media_player_t* player = standby_player_;
+    standby_player_ = nullptr;
+    standby_url_.clear();
+    standby_ready_ = false;
+    return player;
+}
@@ -0,0 +1,391 @@
+#include "vlc_scrub.h"
+#include "vlc_instance_pool.h"
+#include "vlc_frame_ring.h"
+#include "vlc_player.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// =================================================================================================
+// ScrubController
+// =================================================================================================
+
+ScrubController::ScrubController(SeekCallback seek, PreviewCallback preview)
+    : seek_(std::move(seek)), preview_(std::move(preview))
+{
+}
+
+ScrubController::~ScrubController()
+{
+    Stop();
+}
+
+void ScrubController::Configure(const ScrubOptions &options)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ScrubOptions clamped = options;
+    clamped.interval_ms = std::clamp(clamped.interval_ms, 16, 2000);
+    clamped.preview_width = std::clamp(clamped.preview_width, 32u, 480u);
+    clamped.preview_height = std::clamp(clamped.preview_height, 18u, 270u);
+
+    if (clamped.preview_width != options_.preview_width || clamped.preview_height != options_.preview_height)
+        reopen_preview_ = true;
+    if (!clamped.preview && options_.preview)
+        clear_preview_ = true;
+
+    options_ = clamped;
+    cv_.notify_all();
+}
+
+ScrubOptions ScrubController::GetOptions()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+void ScrubController::Begin()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnsureThreadLocked();
+    active_ = true;
+}
+
+void ScrubController::Request(const std::string &mrl, int64_t time)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    EnsureThreadLocked();
+
+    mrl_ = mrl;
+
+    active_ = true;
+    final_seek_ = false;
+    target_ = std::max<int64_t>(0, time);
+    seek_pending_ = true;
+    if (options_.preview && !mrl_.empty())
+        preview_wanted_ = target_;
+    cv_.notify_all();
+}
+
+void ScrubController::End()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_)
+        return;
+
+    active_ = false;
+    preview_wanted_ = -1;
+    clear_preview_ = true;
+
+    // Land exactly where the pointer was released, unless the last interval seek already did
+    if (target_ >= 0 && (seek_pending_ || applied_ != target_))
+    {
+        seek_pending_ = true;
+        final_seek_ = true;
+        next_seek_at_ = std::chrono::steady_clock::now();
+    }
+    cv_.notify_all();
+}
+
+void ScrubController::Cancel()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_ && !seek_pending_)
+        return;
+
+    active_ = false;
+    seek_pending_ = false;
+    final_seek_ = false;
+    target_ = -1;
+    applied_ = -1;
+    preview_wanted_ = -1;
+    clear_preview_ = true;
+    cv_.notify_all();
+}
+
+bool ScrubController::IsActive()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+}
+
+void ScrubController::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        cv_.notify_all();
+    }
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void ScrubController::EnsureThreadLocked()
+{
+    if (!thread_.joinable() && !stopping_)
+        thread_ = std::thread(&ScrubController::Loop, this);
+}
+
+/**
+ * libVLC is only ever called with mutex_ released: the preview decoder's vout thread takes it
+ * in the display callback, and stopping a player waits for that thread.
+ */
+void ScrubController::Loop()
+{
+    using clock = std::chrono::steady_clock;
+    Trace::SetThreadName("scrub");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_)
+    {
+        auto now = clock::now();
+
+        // Main player: the newest target, at most once per interval
+        if (seek_pending_ && now >= next_seek_at_)
+        {
+            int64_t time = target_;
+            seek_pending_ = false;
+            final_seek_ = false;
+            next_seek_at_ = now + std::chrono::milliseconds(options_.interval_ms);
+
+            lock.unlock();
+            seek_(time);
+            lock.lock();
+
+            applied_ = time;
+            continue;
+        }
+
+        // Preview done, or given up on
+        if (preview_pending_ >= 0 && (captured_ || now >= preview_deadline_))
+        {
+            std::shared_ptr<OSDImage> image = std::move(captured_);
+            captured_.reset();
+            int64_t target = preview_pending_;
+            preview_pending_ = -1;
+            preview_armed_ = false;
+            preview_idle_since_ = now;
+            bool show = active_ && options_.preview;
+
+            lock.unlock();
+            libvlc_media_player_set_pause(preview_player_, 1);
+            if (image)
+            {
+                // A picture far from the target predates the seek
+                int64_t landed = libvlc_media_player_get_time(preview_player_);
+                bool fresh = landed >= 0 && std::llabs(landed - target) <= PREVIEW_WINDOW_MS;
+                if (fresh && show)
+                    preview_(image);
+            }
+            else
+            {
+                VlcPlayer::Log("Scrub preview at %lld ms timed out", (long long)target);
+            }
+            lock.lock();
+            continue;
+        }
+
+        // Next preview: the newest target, once the decoder is free
+        if (active_ && options_.preview && preview_pending_ < 0 && preview_wanted_ >= 0)
+        {
+            int64_t time = preview_wanted_;
+            preview_wanted_ = -1;
+            std::string mrl = mrl_;
+            bool reopen = reopen_preview_ || !preview_player_ || preview_mrl_ != mrl;
+            reopen_preview_ = false;
+
+            lock.unlock();
+            bool ready = true;
+            if (reopen)
+            {
+                ready = OpenPreviewer(mrl, time);
+            }
+            else
+            {
+                libvlc_media_player_set_time(preview_player_, time);
+                libvlc_media_player_set_pause(preview_player_, 0);
+            }
+            lock.lock();
+
+            if (ready)
+            {
+                preview_pending_ = time;
+                preview_armed_ = true;
+                captured_.reset();
+                preview_deadline_ = clock::now() +
+                                    std::chrono::milliseconds(reopen ? PREVIEW_OPEN_TIMEOUT_MS : PREVIEW_TIMEOUT_MS);
+            }
+            continue;
+        }
+
+        if (clear_preview_)
+        {
+            clear_preview_ = false;
+            lock.unlock();
+            preview_(nullptr);
+            lock.lock();
+            continue;
+        }
+
+        // Between scrubs the decoder stays open for a while, then goes back to the pool
+        auto idle_close_at = preview_idle_since_ + std::chrono::milliseconds(PREVIEW_IDLE_CLOSE_MS);
+        bool idle = !active_ && preview_player_ && preview_pending_ < 0;
+        if (idle && now >= idle_close_at)
+        {
+            lock.unlock();
+            ClosePreviewer();
+            lock.lock();
+            continue;
+        }
+
+        // Sleep until the next deadline or request
+        auto wake = clock::time_point::max();
+        if (seek_pending_)
+            wake = std::min(wake, next_seek_at_);
+        if (preview_pending_ >= 0)
+            wake = std::min(wake, preview_deadline_);
+        if (idle)
+            wake = std::min(wake, idle_close_at);
+
+        if (wake == clock::time_point::max())
+            cv_.wait(lock);
+        else
+            cv_.wait_until(lock, wake);
+    }
+
+    lock.unlock();
+    ClosePreviewer();
+}
+
+// =================================================================================================
+// Preview Decoder
+// =================================================================================================
+
+bool ScrubController::OpenPreviewer(const std::string &mrl, int64_t start_time)
+{
+    ClosePreviewer();
+
+    preview_instance_ = VlcInstancePool::Get().AcquireInstance();
+    if (!preview_instance_)
+        return false;
+
+    libvlc_media_t *media = libvlc_media_new_location(preview_instance_, mrl.c_str());
+    if (!media)
+    {
+        VlcInstancePool::Get().ReleaseInstance();
+        preview_instance_ = nullptr;
+        return false;
+    }
+
+    // Pictures only, software decoded so the main player keeps the hardware decoder, and fast
+    // seeks so a preview never decodes up to the exact target
+    libvlc_media_add_option(media, ":no-audio");
+    libvlc_media_add_option(media, ":no-spu");
+    libvlc_media_add_option(media, ":no-sub-autodetect-file");
+    libvlc_media_add_option(media, ":no-video-title-show");
+    libvlc_media_add_option(media, ":avcodec-hw=none");
+    libvlc_media_add_option(media, ":avcodec-skiploopfilter=4");
+    libvlc_media_add_option(media, ":input-fast-seek");
+    if (start_time > 0)
+    {
+        char option[64];
+        snprintf(option, sizeof(option), ":start-time=%.3f", start_time / 1000.0);
+        libvlc_media_add_option(media, option);
+    }
+
+    preview_player_ = VlcInstancePool::Get().AcquirePlayer();
+    if (!preview_player_)
+    {
+        libvlc_media_release(media);
+        VlcInstancePool::Get().ReleaseInstance();
+        preview_instance_ = nullptr;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        box_width_ = options_.preview_width;
+        box_height_ = options_.preview_height;
+    }
+
+    libvlc_video_set_format_callbacks(preview_player_, PreviewFormatCallback, nullptr);
+    libvlc_video_set_callbacks(preview_player_, PreviewLockCallback, nullptr, PreviewDisplayCallback, this);
+    libvlc_media_player_set_media(preview_player_, media);
+    libvlc_media_release(media);
+
+    if (libvlc_media_player_play(preview_player_) != 0)
+    {
+        VlcPlayer::Log("Scrub preview decoder failed to start for %s", mrl.c_str());
+        ClosePreviewer();
+        return false;
+    }
+
+    preview_mrl_ = mrl;
+    VlcPlayer::Log("Scrub preview decoder opened (%ux%u box)", box_width_, box_height_);
+    return true;
+}
+
+void ScrubController::ClosePreviewer()
+{
+    if (preview_player_)
+    {
+        VlcInstancePool::Get().ReturnPlayer(preview_player_);
+        preview_player_ = nullptr;
+    }
+
+    if (preview_instance_)
+    {
+        VlcInstancePool::Get().ReleaseInstance();
+        preview_instance_ = nullptr;
+    }
+    preview_mrl_.clear();
+}
+
+unsigned ScrubController::PreviewFormatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                                unsigned *pitches, unsigned *lines)
+{
+    ScrubController *self = static_cast<ScrubController *>(*opaque);
+    std::lock_guard<std::mutex> lock(self->mutex_);
+
+    // VLC scales into the preview box, the OSD blits the picture as is
+    FitFrameSize(*width, *height, self->box_width_, self->box_height_, width, height);
+    memcpy(chroma, "RV32", 4);
+    *pitches = *width * 4;
+    *lines = *height;
+
+    self->decode_width_ = *width;
+    self->decode_height_ = *height;
+    self->decode_.assign(static_cast<size_t>(*pitches) * *lines, 0);
+    return 1;
+}
+
+void *ScrubController::PreviewLockCallback(void *opaque, void **planes)
+{
+    ScrubController *self = static_cast<ScrubController *>(opaque);
+    *planes = self->decode_.data();
+    return nullptr;
+}
+
+void ScrubController::PreviewDisplayCallback(void *opaque, void *picture)
+{
+    (void)picture;
+    ScrubController *self = static_cast<ScrubController *>(opaque);
+    std::lock_guard<std::mutex> lock(self->mutex_);
+
+    if (!self->preview_armed_ || self->decode_.empty())
+        return;
+
+    auto image = std::make_shared<OSDImage>();
+    image->width = static_cast<int>(self->decode_width_);
+    image->height = static_cast<int>(self->decode_height_);
+    image->pixels = self->decode_;
+
+    // RV32 leaves the padding byte undefined, the OSD blends it as alpha
+    for (size_t i = 3; i < image->pixels.size(); i += 4)
+        image->pixels[i] = 255;
+
+    self->captured_ = std::move(image);
+    self->preview_armed_ = false;
+    self->cv_.notify_all();
+}
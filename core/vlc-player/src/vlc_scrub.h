@@ -0,0 +1,150 @@
+#ifndef VLC_SCRUB_H
+#define VLC_SCRUB_H
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <vlc/vlc.h>
+#include "os/common.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =================================================================================================
+// Scrubbing - Coalesced seeks and preview pictures while the seek bar is dragged
+// =================================================================================================
+// A dragged seek bar produces far more positions than a demuxer can seek to. In scrub mode only
+// the newest target is kept and the main player is seeked at most once per interval. A second,
+// small decoder (a pool player rendering into vmem with audio, subtitles and hardware decoding
+// off) decodes the picture under the pointer for the seek OSD, one request at a time, always
+// jumping to the newest target when it gets free.
+//
+// Main player seeks always go to the requested time. libVLC has no keyframe API, and the time a
+// fast-seeking preview reports after pausing is not known to be a keyframe, so nothing is
+// snapped to it.
+
+struct ScrubOptions
+{
+    int interval_ms = 100;         // Minimum spacing of main player seeks
+    bool preview = true;
+    unsigned preview_width = 160;  // Bounding box, the aspect ratio is kept and never upscaled
+    unsigned preview_height = 90;
+};
+
+// =================================================================================================
+// ScrubController - Scrub thread, rate-limited seeks and the preview decoder
+// =================================================================================================
+
+class ScrubController
+{
+public:
+    // Applies a seek to the main player, called on the scrub thread
+    using SeekCallback = std::function<void(int64_t time)>;
+    // Shows (or with nullptr removes) the preview, called on the scrub thread
+    using PreviewCallback = std::function<void(std::shared_ptr<const OSDImage> image)>;
+
+    ScrubController(SeekCallback seek, PreviewCallback preview);
+    ~ScrubController();
+
+    void Configure(const ScrubOptions &options);
+    ScrubOptions GetOptions();
+
+    /**
+     * Enter scrub mode (also implied by Request)
+     */
+    void Begin();
+
+    /**
+     * Move the scrub target, the newest one replaces anything not applied yet
+     * @param mrl Media the target belongs to, the preview decoder reopens for a different one
+     */
+    void Request(const std::string &mrl, int64_t time);
+
+    /**
+     * Leave scrub mode with one immediate seek to the last target
+     */
+    void End();
+
+    /**
+     * Leave scrub mode without applying anything (new media opened)
+     */
+    void Cancel();
+
+    bool IsActive();
+
+    /**
+     * Join the scrub thread and close the preview decoder, no callback runs afterwards
+     */
+    void Stop();
+
+private:
+    static constexpr int PREVIEW_TIMEOUT_MS = 1000;       // Seek to picture in an open decoder
+    static constexpr int PREVIEW_OPEN_TIMEOUT_MS = 5000;  // First picture after opening
+    static constexpr int PREVIEW_IDLE_CLOSE_MS = 10000;   // Decoder kept open between scrubs
+    static constexpr int64_t PREVIEW_WINDOW_MS = 10000;   // Farther landings are stale pictures
+
+    void EnsureThreadLocked();
+    void Loop();
+
+    // Preview decoder, scrub thread only
+    bool OpenPreviewer(const std::string &mrl, int64_t start_time);
+    void ClosePreviewer();
+
+    // vmem callbacks of the preview decoder
+    static unsigned PreviewFormatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                          unsigned *pitches, unsigned *lines);
+    static void *PreviewLockCallback(void *opaque, void **planes);
+    static void PreviewDisplayCallback(void *opaque, void *picture);
+
+    SeekCallback seek_;
+    PreviewCallback preview_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stopping_ = false;
+
+    ScrubOptions options_;
+    bool active_ = false;
+    std::string mrl_;
+
+    // Main player seeks
+    bool seek_pending_ = false;
+    bool final_seek_ = false;      // End(): immediate
+    int64_t target_ = -1;          // Newest scrub target
+    int64_t applied_ = -1;         // Last time handed to seek_
+    std::chrono::steady_clock::time_point next_seek_at_;
+
+    // Preview requests (guarded by mutex_)
+    int64_t preview_wanted_ = -1;  // Newest target without a picture yet
+    int64_t preview_pending_ = -1; // Target being decoded
+    bool preview_armed_ = false;   // Keep the next displayed picture
+    bool reopen_preview_ = false;  // Preview size changed
+    bool clear_preview_ = false;
+    std::shared_ptr<OSDImage> captured_;
+    std::chrono::steady_clock::time_point preview_deadline_;
+    std::chrono::steady_clock::time_point preview_idle_since_;
+
+    // Decoder output (guarded by mutex_, the lock callback only reads the pointer)
+    unsigned box_width_ = 0;
+    unsigned box_height_ = 0;
+    unsigned decode_width_ = 0;
+    unsigned decode_height_ = 0;
+    std::vector<uint8_t> decode_;
+
+    // Preview decoder (scrub thread only)
+    libvlc_instance_t *preview_instance_ = nullptr;
+    libvlc_media_player_t *preview_player_ = nullptr;
+    std::string preview_mrl_;
+};
+
+#endif // VLC_SCRUB_H
@@ -0,0 +1,518 @@
+#include "vlc_shared_frames.h"
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <new>
+#include <thread>
+#include <chrono>
+
+#ifdef _WIN32
+// windows.h already included by the header
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>
+#endif
+
+static inline size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static std::string RegionName(const std::string &name, uint32_t index)
+{
+    return name + "." + std::to_string(index);
+}
+
+#ifdef _WIN32
+static std::string NativeName(const std::string &name)
+{
+    return "Local\\" + name;
+}
+#else
+static std::string NativeName(const std::string &name)
+{
+    return "/" + name;
+}
+#endif
+
+// =================================================================================================
+// SharedMemory
+// =================================================================================================
+
+SharedMemory::~SharedMemory()
+{
+#ifdef _WIN32
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(mapping_);
+#else
+    if (data_)
+        munmap(data_, size_);
+    if (owner_)
+        Unlink();
+#endif
+}
+
+std::shared_ptr<SharedMemory> SharedMemory::Create(const std::string &name, size_t size)
+{
+    std::shared_ptr<SharedMemory> memory(new SharedMemory());
+    memory->name_ = NativeName(name);
+    memory->size_ = size;
+    memory->owner_ = true;
+
+#ifdef _WIN32
+    uint64_t size64 = static_cast<uint64_t>(size);
+    memory->mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                          static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF),
+                                          memory->name_.c_str());
+    if (!memory->mapping_)
+        return nullptr;
+
+    memory->data_ = static_cast<uint8_t *>(MapViewOfFile(memory->mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (!memory->data_)
+        return nullptr;
+#else
+    // A leftover from a crashed writer with the same name is replaced
+    shm_unlink(memory->name_.c_str());
+
+    int fd = shm_open(memory->name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        return nullptr;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        shm_unlink(memory->name_.c_str());
+        return nullptr;
+    }
+
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(memory->name_.c_str());
+        return nullptr;
+    }
+    memory->data_ = static_cast<uint8_t *>(data);
+#endif
+
+    // Fresh mappings are zero filled on both platforms
+    return memory;
+}
+
+std::shared_ptr<SharedMemory> SharedMemory::Open(const std::string &name)
+{
+    std::shared_ptr<SharedMemory> memory(new SharedMemory());
+    memory->name_ = NativeName(name);
+
+#ifdef _WIN32
+    memory->mapping_ = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, memory->name_.c_str());
+    if (!memory->mapping_)
+        return nullptr;
+
+    memory->data_ = static_cast<uint8_t *>(MapViewOfFile(memory->mapping_, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (!memory->data_)
+        return nullptr;
+
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(memory->data_, &info, sizeof(info)) == 0)
+        return nullptr;
+    memory->size_ = info.RegionSize;
+#else
+    int fd = shm_open(memory->name_.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+    memory->size_ = static_cast<size_t>(st.st_size);
+
+    void *data = mmap(nullptr, memory->size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+    memory->data_ = static_cast<uint8_t *>(data);
+#endif
+
+    return memory;
+}
+
+void SharedMemory::Unlink()
+{
+#ifndef _WIN32
+    if (!name_.empty())
+        shm_unlink(name_.c_str());
+#endif
+    owner_ = false;
+}
+
+// =================================================================================================
+// SharedFrameSignal
+// =================================================================================================
+
+SharedFrameSignal::~SharedFrameSignal()
+{
+#ifdef _WIN32
+    if (event_)
+        CloseHandle(event_);
+#endif
+}
+
+bool SharedFrameSignal::Create(const std::string &name)
+{
+#ifdef _WIN32
+    // Auto-reset: one wakeup per Notify(), intended for a single reader
+    event_ = CreateEventA(nullptr, FALSE, FALSE, NativeName(name + ".signal").c_str());
+    return event_ != nullptr;
+#else
+    (void)name;
+    return true;
+#endif
+}
+
+bool SharedFrameSignal::Open(const std::string &name)
+{
+#ifdef _WIN32
+    event_ = OpenEventA(SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, NativeName(name + ".signal").c_str());
+    return event_ != nullptr;
+#else
+    (void)name;
+    return true;
+#endif
+}
+
+void SharedFrameSignal::Notify(SharedFrameControl *control)
+{
+    // Sequentially consistent on both sides (signal/waiters), so either the waiter sees the
+    // new signal value or we see the waiter
+    control->signal.fetch_add(1);
+
+    // Nobody is blocked: skip the syscall, the usual case when the reader polls
+    if (control->waiters.load() == 0)
+        return;
+
+#ifdef _WIN32
+    SetEvent(event_);
+#elif defined(__linux__)
+    // Not FUTEX_PRIVATE: the word lives in memory shared with another process
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&control->signal), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+bool SharedFrameSignal::Wait(SharedFrameControl *control, uint32_t seen, int timeout_ms)
+{
+    if (control->signal.load(std::memory_order_acquire) != seen)
+        return true;
+
+    control->waiters.fetch_add(1);
+
+    // Re-check after announcing ourselves, a Notify() in between would otherwise be lost
+    if (control->signal.load() == seen)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(event_, timeout_ms < 0 ? INFINITE : static_cast<DWORD>(timeout_ms));
+#elif defined(__linux__)
+        struct timespec timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&control->signal), FUTEX_WAIT, seen,
+                timeout_ms < 0 ? nullptr : &timeout, nullptr, 0);
+#else
+        // No cross-process futex: poll in short steps
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (control->signal.load(std::memory_order_acquire) == seen &&
+               (timeout_ms < 0 || std::chrono::steady_clock::now() < deadline))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+#endif
+    }
+
+    control->waiters.fetch_sub(1);
+    return control->signal.load(std::memory_order_acquire) != seen;
+}
+
+// =================================================================================================
+// SharedFrameWriter
+// =================================================================================================
+
+bool SharedFrameWriter::IsValidName(const std::string &name)
+{
+    if (name.empty() || name.size() > 64)
+        return false;
+
+    for (char c : name)
+    {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+std::shared_ptr<SharedFrameWriter> SharedFrameWriter::Create(const std::string &name)
+{
+    if (!IsValidName(name))
+        return nullptr;
+
+    std::shared_ptr<SharedFrameWriter> writer(new SharedFrameWriter());
+    writer->name_ = name;
+
+    writer->control_memory_ = SharedMemory::Create(name, SHARED_FRAMES_PAGE);
+    if (!writer->control_memory_ || !writer->signal_.Create(name))
+        return nullptr;
+
+    // Zero-filled mapping, atomics start at 0
+    writer->control_ = new (writer->control_memory_->Data()) SharedFrameControl();
+    writer->control_->magic = SHARED_FRAMES_MAGIC;
+    writer->control_->version = SHARED_FRAMES_VERSION;
+#ifdef _WIN32
+    writer->control_->writer_pid = static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    writer->control_->writer_pid = static_cast<uint32_t>(getpid());
+#endif
+
+    return writer;
+}
+
+SharedFrameWriter::~SharedFrameWriter()
+{
+    if (control_)
+    {
+        control_->region.store(0);
+        signal_.Notify(control_);
+    }
+}
+
+std::shared_ptr<FrameStorage> SharedFrameWriter::CreateStorage(const FrameFormat &format, size_t slot_count)
+{
+    slot_count = std::min(slot_count, FrameSlotTable::MAX_SLOTS);
+
+    size_t data_offset = AlignUp(sizeof(SharedFrameHeader), SHARED_FRAMES_PAGE);
+    size_t slot_stride = FrameStorage::SlotStride(format.frame_size);
+    size_t size = data_offset + slot_stride * (slot_count + 1);
+
+    uint32_t index = region_index_ + 1;
+    std::shared_ptr<SharedMemory> memory = SharedMemory::Create(RegionName(name_, index), size);
+    if (!memory)
+        return nullptr;
+
+    SharedFrameHeader *header = new (memory->Data()) SharedFrameHeader();
+    header->magic = SHARED_FRAMES_MAGIC;
+    header->version = SHARED_FRAMES_VERSION;
+    memcpy(header->chroma, format.chroma, 4);
+    header->width = format.width;
+    header->height = format.height;
+    header->plane_count = static_cast<uint32_t>(format.plane_count);
+    header->slot_count = static_cast<uint32_t>(slot_count);
+    header->frame_size = format.frame_size;
+    header->slot_stride = slot_stride;
+    header->data_offset = data_offset;
+    for (int i = 0; i < format.plane_count; i++)
+    {
+        header->planes[i].offset = format.planes[i].offset;
+        header->planes[i].pitch = format.planes[i].pitch;
+        header->planes[i].lines = format.planes[i].lines;
+    }
+
+    auto storage = std::make_shared<FrameStorage>(slot_count, format.frame_size, &header->table,
+                                                  memory->Data() + data_offset, memory, true);
+
+    // Readers attach by name, so the previous region can lose its name right away
+    if (region_memory_)
+        region_memory_->Unlink();
+    region_memory_ = memory;
+    region_index_ = index;
+
+    control_->region.store(index);
+    signal_.Notify(control_);
+    return storage;
+}
+
+void SharedFrameWriter::OnPublish(uint64_t sequence)
+{
+    control_->published.store(sequence, std::memory_order_relaxed);
+    signal_.Notify(control_);
+}
+
+void SharedFrameWriter::OnDrop()
+{
+    control_->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedFrameWriter::OnReset()
+{
+    if (region_memory_)
+        region_memory_->Unlink();
+    region_memory_.reset();
+
+    control_->region.store(0);
+    signal_.Notify(control_);
+}
+
+// =================================================================================================
+// SharedFrameReader
+// =================================================================================================
+
+std::shared_ptr<SharedFrameReader> SharedFrameReader::Open(const std::string &name)
+{
+    if (!SharedFrameWriter::IsValidName(name))
+        return nullptr;
+
+    std::shared_ptr<SharedFrameReader> reader(new SharedFrameReader());
+    reader->name_ = name;
+
+    reader->control_memory_ = SharedMemory::Open(name);
+    if (!reader->control_memory_ || reader->control_memory_->Size() < sizeof(SharedFrameControl))
+        return nullptr;
+
+    reader->control_ = reinterpret_cast<SharedFrameControl *>(reader->control_memory_->Data());
+    if (reader->control_->magic != SHARED_FRAMES_MAGIC || reader->control_->version != SHARED_FRAMES_VERSION)
+        return nullptr;
+
+    if (!reader->signal_.Open(name))
+        return nullptr;
+
+    return reader;
+}
+
+std::shared_ptr<FrameStorage> SharedFrameReader::GetStorage(uint32_t *generation, const SharedFrameHeader **header)
+{
+    uint32_t index = control_->region.load();
+
+    if (index != region_index_)
+    {
+        storage_.reset();
+        region_memory_.reset();
+        region_index_ = index;
+
+        if (index != 0)
+        {
+            std::shared_ptr<SharedMemory> memory = SharedMemory::Open(RegionName(name_, index));
+            const SharedFrameHeader *candidate =
+                memory && memory->Size() >= sizeof(SharedFrameHeader)
+                    ? reinterpret_cast<const SharedFrameHeader *>(memory->Data())
+                    : nullptr;
+
+            // The header comes from another process: the table only has MAX_SLOTS entries, and the
+            // size check uses the stride FrameStorage will index with, not the one written there
+            size_t slot_count = candidate ? std::min<size_t>(candidate->slot_count, FrameSlotTable::MAX_SLOTS) : 0;
+            size_t slot_stride = candidate ? FrameStorage::SlotStride(candidate->frame_size) : 0;
+
+            if (candidate && candidate->magic == SHARED_FRAMES_MAGIC && slot_count > 0 &&
+                candidate->data_offset <= memory->Size() &&
+                (memory->Size() - candidate->data_offset) / (slot_count + 1) >= slot_stride)
+            {
+                auto *table = reinterpret_cast<FrameSlotTable *>(memory->Data() + offsetof(SharedFrameHeader, table));
+                storage_ = std::make_shared<FrameStorage>(slot_count, candidate->frame_size, table,
+                                                          memory->Data() + candidate->data_offset, memory, false);
+                region_memory_ = memory;
+            }
+        }
+    }
+
+    if (generation)
+        *generation = region_index_;
+    if (header)
+        *header = region_memory_ ? reinterpret_cast<const SharedFrameHeader *>(region_memory_->Data()) : nullptr;
+    return storage_;
+}
+
+std::shared_ptr<FrameStorage> SharedFrameReader::HoldLatest(FrameSlotInfo *info)
+{
+    // Anything published after this point wakes the next Wait()
+    last_signal_ = control_->signal.load(std::memory_order_acquire);
+
+    uint32_t generation = 0;
+    std::shared_ptr<FrameStorage> storage = GetStorage(&generation, nullptr);
+    if (!storage)
+    {
+        ReleaseHeld();
+        return nullptr;
+    }
+
+    bool same_storage = held_storage_ == storage && held_slot_ >= 0;
+
+    if (same_storage && storage->ReadySlot() == held_slot_)
+    {
+        info->slot = held_slot_;
+        info->sequence = storage->SlotSequence(held_slot_);
+        info->generation = held_generation_;
+        return storage;
+    }
+
+    int slot = storage->AcquireRead();
+    if (slot < 0)
+    {
+        if (!same_storage)
+            return nullptr;
+
+        info->slot = held_slot_;
+        info->sequence = storage->SlotSequence(held_slot_);
+        info->generation = held_generation_;
+        return storage;
+    }
+
+    ReleaseHeld();
+    held_storage_ = storage;
+    held_generation_ = generation;
+    held_slot_ = slot;
+
+    info->slot = slot;
+    info->sequence = storage->SlotSequence(slot);
+    info->generation = generation;
+    return storage;
+}
+
+void SharedFrameReader::ReleaseHeld()
+{
+    if (held_storage_ && held_slot_ >= 0)
+    {
+        held_storage_->ReleaseRead(held_slot_);
+    }
+    held_storage_.reset();
+    held_slot_ = -1;
+}
+
+bool SharedFrameReader::Wait(int timeout_ms)
+{
+    uint32_t seen = last_signal_.load();
+    bool moved = signal_.Wait(control_, seen, timeout_ms);
+    last_signal_ = control_->signal.load(std::memory_order_acquire);
+    return moved;
+}
+
+FrameFormat SharedFrameReader::GetFormat()
+{
+    FrameFormat format;
+    const SharedFrameHeader *header = nullptr;
+    if (!GetStorage(nullptr, &header) || !header)
+        return format;
+
+    memcpy(format.chroma, header->chroma, 4);
+    format.width = header->width;
+    format.height = header->height;
+    format.frame_size = static_cast<size_t>(header->frame_size);
+    format.plane_count = static_cast<int>(std::min<uint32_t>(header->plane_count, FrameFormat::MAX_PLANES));
+    for (int i = 0; i < format.plane_count; i++)
+    {
+        format.planes[i].offset = static_cast<size_t>(header->planes[i].offset);
+        format.planes[i].pitch = header->planes[i].pitch;
+        format.planes[i].lines = header->planes[i].lines;
+    }
+    format.pitch = format.planes[0].pitch;
+    return format;
+}
@@ -0,0 +1,207 @@
+#ifndef VLC_SHARED_FRAMES_H
+#define VLC_SHARED_FRAMES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <memory>
+#include <atomic>
+#include "vlc_frame_ring.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// =================================================================================================
+// Shared Frame Transport (POSIX shm / Win32 file mapping)
+// =================================================================================================
+// Lets another process (the Electron main process) read memory-rendered frames without any
+// serialization. The vmem callbacks decode straight into FrameStorage slots living in shared
+// memory and the reader follows the same FREE/DECODING/READY/IN_USE protocol on the slot table.
+//
+//   "<name>"           SharedFrameControl, fixed size, lives as long as the writer
+//   "<name>.<region>"  SharedFrameHeader + slots, one per negotiated format
+//
+// A format change creates a new data region and publishes its index in the control block, so
+// readers keep a valid mapping of the old one until they re-attach. Every publish bumps the
+// control signal word; readers block on it (futex on Linux, named event on Windows).
+
+static constexpr uint32_t SHARED_FRAMES_MAGIC = 0x5A564652; // "ZVFR"
+static constexpr uint32_t SHARED_FRAMES_VERSION = 1;
+static constexpr size_t SHARED_FRAMES_PAGE = 4096;
+
+struct SharedFrameControl
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t writer_pid;
+    std::atomic<uint32_t> region;  // Index of the live data region, 0 = no video
+    std::atomic<uint32_t> signal;  // Bumped on every publish and region change (futex word)
+    std::atomic<uint32_t> waiters; // Readers blocked in Wait(), wakeups are skipped when 0
+    std::atomic<uint64_t> published;
+    std::atomic<uint64_t> dropped;
+};
+
+struct SharedFramePlane
+{
+    uint64_t offset;
+    uint32_t pitch;
+    uint32_t lines;
+};
+
+struct SharedFrameHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    char chroma[8];
+    uint32_t width;
+    uint32_t height;
+    uint32_t plane_count;
+    uint32_t slot_count;
+    uint64_t frame_size;
+    uint64_t slot_stride;
+    uint64_t data_offset; // From the start of the region, page aligned
+    SharedFramePlane planes[FrameFormat::MAX_PLANES];
+    FrameSlotTable table;
+};
+
+// =================================================================================================
+// SharedMemory - Named mapping
+// =================================================================================================
+
+class SharedMemory
+{
+public:
+    ~SharedMemory();
+
+    static std::shared_ptr<SharedMemory> Create(const std::string &name, size_t size);
+    static std::shared_ptr<SharedMemory> Open(const std::string &name);
+
+    uint8_t *Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+    // Remove the name, existing mappings stay valid (no-op on Windows, names die with handles)
+    void Unlink();
+
+private:
+    SharedMemory() = default;
+
+    std::string name_;
+    uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+#ifdef _WIN32
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+// =================================================================================================
+// SharedFrameSignal - Cross-process wakeup on the control signal word
+// =================================================================================================
+
+class SharedFrameSignal
+{
+public:
+    ~SharedFrameSignal();
+
+    bool Create(const std::string &name);
+    bool Open(const std::string &name);
+
+    void Notify(SharedFrameControl *control);
+
+    /**
+     * Block until control->signal differs from seen or timeout_ms elapsed.
+     * Returns true if the signal moved.
+     */
+    bool Wait(SharedFrameControl *control, uint32_t seen, int timeout_ms);
+
+private:
+#ifdef _WIN32
+    HANDLE event_ = nullptr;
+#endif
+};
+
+// =================================================================================================
+// SharedFrameWriter - FrameRing storage provider (producer process)
+// =================================================================================================
+
+class SharedFrameWriter : public FrameStorageProvider
+{
+public:
+    ~SharedFrameWriter() override;
+
+    /**
+     * Create the control block for name ([A-Za-z0-9_-], no path separators).
+     * Returns nullptr if the name is invalid or the mapping could not be created.
+     */
+    static std::shared_ptr<SharedFrameWriter> Create(const std::string &name);
+
+    static bool IsValidName(const std::string &name);
+
+    const std::string &Name() const { return name_; }
+
+    // FrameStorageProvider (vout thread)
+    std::shared_ptr<FrameStorage> CreateStorage(const FrameFormat &format, size_t slot_count) override;
+    void OnPublish(uint64_t sequence) override;
+    void OnDrop() override;
+    void OnReset() override;
+
+private:
+    SharedFrameWriter() = default;
+
+    std::string name_;
+    std::shared_ptr<SharedMemory> control_memory_;
+    SharedFrameControl *control_ = nullptr;
+    SharedFrameSignal signal_;
+    std::shared_ptr<SharedMemory> region_memory_;
+    uint32_t region_index_ = 0;
+};
+
+// =================================================================================================
+// SharedFrameReader - Consumer process side
+// =================================================================================================
+
+class SharedFrameReader
+{
+public:
+    /**
+     * Attach to the control block of a writer. Returns nullptr if it does not exist.
+     */
+    static std::shared_ptr<SharedFrameReader> Open(const std::string &name);
+
+    /**
+     * Current storage, re-attached when the writer moved to a new region.
+     * generation is the region index, header is only valid while storage is held.
+     */
+    std::shared_ptr<FrameStorage> GetStorage(uint32_t *generation, const SharedFrameHeader **header);
+
+    // Same semantics as FrameRing::HoldLatest / ReleaseHeld
+    std::shared_ptr<FrameStorage> HoldLatest(FrameSlotInfo *info);
+    void ReleaseHeld();
+
+    bool Wait(int timeout_ms);
+    uint32_t GetSignal() const { return control_->signal.load(); }
+
+    FrameFormat GetFormat();
+    uint64_t GetPublished() const { return control_->published.load(); }
+    uint64_t GetDropped() const { return control_->dropped.load(); }
+
+private:
+    SharedFrameReader() = default;
+
+    std::string name_;
+    std::shared_ptr<SharedMemory> control_memory_;
+    SharedFrameControl *control_ = nullptr;
+    SharedFrameSignal signal_;
+    std::atomic<uint32_t> last_signal_{0}; // Signal value as of the last HoldLatest()/Wait()
+
+    std::shared_ptr<SharedMemory> region_memory_;
+    std::shared_ptr<FrameStorage> storage_;
+    uint32_t region_index_ = 0;
+
+    std::shared_ptr<FrameStorage> held_storage_;
+    uint32_t held_generation_ = 0;
+    int held_slot_ = -1;
+};
+
+#endif // VLC_SHARED_FRAMES_H
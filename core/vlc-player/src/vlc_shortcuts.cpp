@@ -1,5 +1,4 @@
 #include "vlc_player.h"
-#include <algorithm>
 
 // =================================================================================================
 // Keyboard Shortcut API
@@ -30,6 +29,60 @@ void VlcPlayer::InitializeDefaultShortcuts() {
     action_to_keys_["subtitleDelayPlus"] = {};
     action_to_keys_["subtitleDelayMinus"] = {};
     action_to_keys_["subtitleDisable"] = {};
+
+    RebuildShortcutTable();
+}
+
+// "Ctrl+Shift+KeyS" -> ("KeyS", CTRL | SHIFT), a key without prefixes has no modifiers
+static std::string ParseShortcutKey(const std::string& key, unsigned* modifiers) {
+    *modifiers = 0;
+    size_t start = 0;
+    size_t plus;
+    while ((plus = key.find('+', start)) != std::string::npos && plus + 1 < key.size()) {
+        std::string prefix = key.substr(start, plus - start);
+        if (prefix == "Ctrl" || prefix == "Control") {
+            *modifiers |= VlcPlayer::SHORTCUT_CTRL;
+        } else if (prefix == "Shift") {
+            *modifiers |= VlcPlayer::SHORTCUT_SHIFT;
+        } else if (prefix == "Alt") {
+            *modifiers |= VlcPlayer::SHORTCUT_ALT;
+        } else if (prefix == "Meta" || prefix == "Cmd") {
+            *modifiers |= VlcPlayer::SHORTCUT_META;
+        } else {
+            break; // Not a modifier, the rest is the key name
+        }
+        start = plus + 1;
+    }
+    return key.substr(start);
+}
+
+void VlcPlayer::RebuildShortcutTable() {
+    auto table = std::make_shared<ShortcutTable>();
+
+    // Same precedence as the mapping order: the first action listing a key keeps it
+    for (const auto& [action, keys] : action_to_keys_) {
+        int16_t index = static_cast<int16_t>(table->actions.size());
+        table->actions.push_back(action);
+
+        for (const std::string& key : keys) {
+            unsigned modifiers;
+            std::string name = ParseShortcutKey(key, &modifiers);
+            if (name.empty()) continue;
+
+            auto it = table->keys.find(name);
+            if (it == table->keys.end()) {
+                std::array<int16_t, SHORTCUT_MODIFIER_COMBOS> slots;
+                slots.fill(-1);
+                it = table->keys.emplace(name, slots).first;
+            }
+            if (it->second[modifiers] < 0) {
+                it->second[modifiers] = index;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(shortcut_mutex_);
+    shortcut_table_ = std::move(table);
 }
 
 std::string VlcPlayer::GetFirstKeyForAction(const std::string& action) {
@@ -93,14 +146,29 @@ Napi::Value VlcPlayer::Shortcut(const Napi::CallbackInfo& info) {
         action_to_keys_[action] = keys;
     }
 
+    RebuildShortcutTable();
+
     return env.Undefined();
 }
 
-void VlcPlayer::ProcessKeyPress(const std::string& key_code) {
-    for (const auto& [action, keys] : action_to_keys_) {
-        if (std::find(keys.begin(), keys.end(), key_code) != keys.end()) {
-            EmitShortcut(action);
-            return;
-        }
+// Window thread, on every key press and autorepeat: one hash lookup, no string built
+void VlcPlayer::ProcessKeyPress(const std::string& key_code, unsigned modifiers) {
+    std::shared_ptr<const ShortcutTable> table;
+    {
+        std::lock_guard<std::mutex> lock(shortcut_mutex_);
+        table = shortcut_table_;
+    }
+    if (!table) return;
+
+    auto it = table->keys.find(key_code);
+    if (it == table->keys.end()) return;
+
+    // An exact modifier binding wins, otherwise the plain key fires with any modifiers held
+    int16_t index = it->second[modifiers & (SHORTCUT_MODIFIER_COMBOS - 1)];
+    if (index < 0) {
+        index = it->second[0];
+    }
+    if (index >= 0) {
+        EmitShortcut(table->actions[index]);
     }
 }
@@ -11,7 +11,7 @@ Napi::Value VlcPlayer::Subtitle(const Napi::CallbackInfo &info)
         return env.Undefined();
 
     Napi::Object options = info[0].As<Napi::Object>();
-    std::lock_guard<std::mutex> lock(mutex_);
+    PlayerLock lock(player_mutex_);
 
     if (!media_player_)
         return env.Undefined();
@@ -20,6 +20,7 @@ Napi::Value VlcPlayer::Subtitle(const Napi::CallbackInfo &info)
     {
         int track = options.Get("track").As<Napi::Number>().Int32Value();
         libvlc_video_set_spu(media_player_, track);
+        track_cache_.Invalidate();
 
         // Show Subtitle Track OSD
         std::string text = (track == -1) ? "Subtitle: Disabled" : ("Subtitle Track: " + std::to_string(track));
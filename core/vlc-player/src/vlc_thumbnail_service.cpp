@@ -0,0 +1,681 @@
+#include "vlc_thumbnail_service.h"
+#include "vlc_instance_pool.h"
+#include "vlc_frame_ring.h"
+#include "vlc_player.h"
+#include "vlc_png.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// =================================================================================================
+// Request Keys
+// =================================================================================================
+
+static uint64_t Fnv1a64(const std::string &text)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string ThumbnailRequest::CacheKey() const
+{
+    // Everything that changes the output bytes, the timeout does not
+    char spec[96];
+    snprintf(spec, sizeof(spec), "|%lld|%.4f|%ux%u|%d", (long long)time, position, width, height,
+             static_cast<int>(format));
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.%s", (unsigned long long)Fnv1a64(url + spec),
+             format == ThumbnailFormat::PNG ? "png" : "bgra");
+    return name;
+}
+
+// =================================================================================================
+// ThumbnailCache
+// =================================================================================================
+
+// RAW entries: "ZTHB", width, height (little-endian uint32), then width * height * 4 bytes
+static const char RAW_MAGIC[4] = {'Z', 'T', 'H', 'B'};
+static constexpr size_t RAW_HEADER_SIZE = 12;
+
+static void PutLittleEndian(uint8_t *out, uint32_t value)
+{
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+static uint32_t GetLittleEndian(const uint8_t *in)
+{
+    return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+static uint32_t GetBigEndian(const uint8_t *in)
+{
+    return (static_cast<uint32_t>(in[0]) << 24) | (in[1] << 16) | (in[2] << 8) | in[3];
+}
+
+bool ThumbnailCache::Open(const std::string &directory, uint64_t max_bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // JS strings arrive as UTF-8, which std::string paths would misread on Windows
+    fs::path root = fs::u8path(directory);
+    std::error_code ec;
+    fs::create_directories(root, ec);
+    if (!fs::is_directory(root, ec))
+    {
+        VlcPlayer::Log("Thumbnail cache disabled, '%s' is not a directory", directory.c_str());
+        return false;
+    }
+
+    directory_ = directory;
+    max_bytes_ = max_bytes > 0 ? max_bytes : DEFAULT_MAX_BYTES;
+    entries_.clear();
+    bytes_ = 0;
+
+    for (const auto &item : fs::directory_iterator(root, ec))
+    {
+        if (!item.is_regular_file(ec))
+            continue;
+
+        std::string name = item.path().filename().string();
+        if (name.find(".tmp") != std::string::npos)
+        {
+            // Left over by a process that died mid-write
+            fs::remove(item.path(), ec);
+            continue;
+        }
+
+        Entry entry;
+        entry.size = item.file_size(ec);
+        entry.last_used = item.last_write_time(ec).time_since_epoch().count();
+        entries_[name] = entry;
+        bytes_ += entry.size;
+    }
+
+    EvictLocked();
+    VlcPlayer::Log("Thumbnail cache: %zu entries, %llu bytes in %s", entries_.size(),
+                   (unsigned long long)bytes_, directory_.c_str());
+    return true;
+}
+
+bool ThumbnailCache::IsOpen()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !directory_.empty();
+}
+
+fs::path ThumbnailCache::PathFor(const std::string &key) const
+{
+    return fs::u8path(directory_) / key;
+}
+
+bool ThumbnailCache::Load(const std::string &key, ThumbnailResult *result)
+{
+    fs::path path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (directory_.empty() || entries_.find(key) == entries_.end())
+            return false;
+        path = PathFor(key);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!file.good() && !file.eof())
+        data.clear();
+
+    bool is_png = key.size() > 4 && key.compare(key.size() - 4, 4, ".png") == 0;
+    bool valid = false;
+    if (is_png)
+    {
+        // Signature (8) + IHDR length and type (8) + width and height
+        if (data.size() >= 24)
+        {
+            result->width = GetBigEndian(data.data() + 16);
+            result->height = GetBigEndian(data.data() + 20);
+            result->data = std::move(data);
+            valid = true;
+        }
+    }
+    else if (data.size() >= RAW_HEADER_SIZE && memcmp(data.data(), RAW_MAGIC, 4) == 0)
+    {
+        result->width = GetLittleEndian(data.data() + 4);
+        result->height = GetLittleEndian(data.data() + 8);
+        if (data.size() == RAW_HEADER_SIZE + static_cast<size_t>(result->width) * result->height * 4)
+        {
+            result->data.assign(data.begin() + RAW_HEADER_SIZE, data.end());
+            valid = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    std::error_code ec;
+    if (!valid)
+    {
+        // Truncated or foreign file, forget it
+        if (it != entries_.end())
+        {
+            bytes_ -= std::min(bytes_, it->second.size);
+            entries_.erase(it);
+        }
+        fs::remove(path, ec);
+        return false;
+    }
+
+    result->ok = true;
+    result->cached = true;
+    result->format = is_png ? ThumbnailFormat::PNG : ThumbnailFormat::RAW;
+
+    // Touch for the next process, it rebuilds the LRU order from the file times
+    auto now = fs::file_time_type::clock::now();
+    fs::last_write_time(path, now, ec);
+    if (it != entries_.end())
+        it->second.last_used = now.time_since_epoch().count();
+    return true;
+}
+
+void ThumbnailCache::Store(const std::string &key, const ThumbnailResult &result)
+{
+    std::vector<uint8_t> header;
+    if (result.format == ThumbnailFormat::RAW)
+    {
+        header.resize(RAW_HEADER_SIZE);
+        memcpy(header.data(), RAW_MAGIC, 4);
+        PutLittleEndian(header.data() + 4, result.width);
+        PutLittleEndian(header.data() + 8, result.height);
+    }
+
+    fs::path path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (directory_.empty())
+            return;
+        path = PathFor(key);
+    }
+
+    // Unique per thread, renamed over the final name once complete
+    fs::path temp = path;
+    temp += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(header.data()), header.size());
+        file.write(reinterpret_cast<const char *>(result.data.data()), result.data.size());
+        if (!file.good())
+        {
+            file.close();
+            std::error_code ec;
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(temp, path, ec);
+    if (ec)
+    {
+        fs::remove(temp, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+    bytes_ -= std::min(bytes_, entry.size);
+    entry.size = header.size() + result.data.size();
+    entry.last_used = fs::file_time_type::clock::now().time_since_epoch().count();
+    bytes_ += entry.size;
+    EvictLocked();
+}
+
+void ThumbnailCache::EvictLocked()
+{
+    while (bytes_ > max_bytes_ && !entries_.empty())
+    {
+        auto oldest = entries_.begin();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->second.last_used < oldest->second.last_used)
+                oldest = it;
+        }
+
+        std::error_code ec;
+        fs::remove(PathFor(oldest->first), ec);
+        bytes_ -= std::min(bytes_, oldest->second.size);
+        entries_.erase(oldest);
+    }
+}
+
+void ThumbnailCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::error_code ec;
+    for (const auto &pair : entries_)
+        fs::remove(PathFor(pair.first), ec);
+
+    entries_.clear();
+    bytes_ = 0;
+}
+
+size_t ThumbnailCache::Count()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t ThumbnailCache::Bytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+// =================================================================================================
+// Frame Grab (vmem target of one worker)
+// =================================================================================================
+
+namespace
+{
+struct GrabContext
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    unsigned box_width = 0;
+    unsigned box_height = 0;
+    unsigned width = 0;
+    unsigned height = 0;
+    std::vector<uint8_t> decode; // VLC renders here
+    std::vector<uint8_t> frame;  // Copy of the kept picture
+
+    bool armed = false;    // Keep the next displayed picture
+    int64_t arm_at_ms = -1; // Position seek: arm once playback reports this time
+    bool captured = false;
+    bool failed = false;   // Error or end of stream before a picture
+};
+} // namespace
+
+static unsigned GrabFormatCallback(void **opaque, char *chroma, unsigned *width, unsigned *height,
+                                   unsigned *pitches, unsigned *lines)
+{
+    GrabContext *ctx = static_cast<GrabContext *>(*opaque);
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+
+    // VLC scales into the box so nothing bigger than the thumbnail is ever copied
+    FitFrameSize(*width, *height, ctx->box_width, ctx->box_height, width, height);
+    memcpy(chroma, "RV32", 4);
+    *pitches = *width * 4;
+    *lines = *height;
+
+    ctx->width = *width;
+    ctx->height = *height;
+    ctx->decode.assign(static_cast<size_t>(*pitches) * *lines, 0);
+    return 1;
+}
+
+static void *GrabLockCallback(void *opaque, void **planes)
+{
+    GrabContext *ctx = static_cast<GrabContext *>(opaque);
+    *planes = ctx->decode.data();
+    return nullptr;
+}
+
+static void GrabUnlockCallback(void *opaque, void *picture, void *const *planes)
+{
+    (void)opaque;
+    (void)picture;
+    (void)planes;
+}
+
+static void GrabDisplayCallback(void *opaque, void *picture)
+{
+    (void)picture;
+    GrabContext *ctx = static_cast<GrabContext *>(opaque);
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+
+    if (!ctx->armed || ctx->captured)
+        return;
+
+    ctx->frame = ctx->decode;
+    ctx->captured = true;
+    ctx->cv.notify_all();
+}
+
+// Pictures decoded before the seek are still displayed for a while, only later ones count
+static void GrabTimeCallback(const libvlc_event_t *event, void *opaque)
+{
+    GrabContext *ctx = static_cast<GrabContext *>(opaque);
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    if (!ctx->armed && ctx->arm_at_ms >= 0 && event->u.media_player_time_changed.new_time >= ctx->arm_at_ms)
+        ctx->armed = true;
+}
+
+static void GrabEventCallback(const libvlc_event_t *event, void *opaque)
+{
+    (void)event;
+    GrabContext *ctx = static_cast<GrabContext *>(opaque);
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    ctx->failed = true;
+    ctx->cv.notify_all();
+}
+
+// =================================================================================================
+// ThumbnailService
+// =================================================================================================
+
+ThumbnailService::ThumbnailService(std::shared_ptr<ThumbnailCache> cache)
+    : cache_(std::move(cache))
+{
+}
+
+ThumbnailService::~ThumbnailService()
+{
+    Stop();
+}
+
+bool ThumbnailService::Start(size_t workers)
+{
+    instance_ = VlcInstancePool::Get().AcquireInstance();
+    if (!instance_)
+        return false;
+
+    workers = std::clamp<size_t>(workers, 1, MAX_WORKERS);
+    for (size_t i = 0; i < workers; i++)
+        workers_.emplace_back(&ThumbnailService::WorkerLoop, this);
+
+    VlcPlayer::Log("Thumbnail service started with %zu workers", workers);
+    return true;
+}
+
+void ThumbnailService::Stop()
+{
+    std::deque<std::shared_ptr<Job>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_)
+            return;
+        stopping_ = true;
+        dropped.swap(queue_);
+    }
+    cv_.notify_all();
+
+    ThumbnailResult closed;
+    closed.error = "Thumbnailer closed";
+    for (auto &job : dropped)
+        Finish(job, closed);
+
+    for (auto &worker : workers_)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers_.clear();
+
+    if (instance_)
+    {
+        VlcInstancePool::Get().ReleaseInstance();
+        instance_ = nullptr;
+    }
+}
+
+void ThumbnailService::Submit(const ThumbnailRequest &request, Callback callback)
+{
+    std::string key = request.CacheKey();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_)
+        {
+            // Same thumbnail already queued or being grabbed: wait for that one
+            auto it = jobs_.find(key);
+            if (it != jobs_.end())
+            {
+                it->second->callbacks.push_back(std::move(callback));
+                return;
+            }
+
+            auto job = std::make_shared<Job>();
+            job->request = request;
+            job->key = key;
+            job->callbacks.push_back(std::move(callback));
+            jobs_[key] = job;
+            queue_.push_back(job);
+            cv_.notify_one();
+            return;
+        }
+    }
+
+    ThumbnailResult closed;
+    closed.error = "Thumbnailer closed";
+    callback(closed);
+}
+
+void ThumbnailService::Finish(const std::shared_ptr<Job> &job, const ThumbnailResult &result)
+{
+    std::vector<Callback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks.swap(job->callbacks);
+
+        auto it = jobs_.find(job->key);
+        if (it != jobs_.end() && it->second == job)
+            jobs_.erase(it);
+    }
+
+    for (auto &callback : callbacks)
+        callback(result);
+}
+
+ThumbnailStats ThumbnailService::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ThumbnailStats stats;
+    stats.workers = workers_.size();
+    stats.queued = queue_.size();
+    stats.in_flight = jobs_.size() - queue_.size();
+    stats.grabbed = grabbed_;
+    stats.cache_hits = cache_hits_;
+    stats.failed = failed_;
+    return stats;
+}
+
+void ThumbnailService::WorkerLoop()
+{
+    // Borrowed on the first miss, most grid renders are served from the cache alone
+    libvlc_media_player_t *player = nullptr;
+
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]()
+                     { return stopping_ || !queue_.empty(); });
+            if (stopping_)
+                break;
+
+            job = queue_.front();
+            queue_.pop_front();
+        }
+
+        ThumbnailResult result;
+        if (job->request.use_cache && cache_ && cache_->Load(job->key, &result))
+        {
+            cache_hits_++;
+            Finish(job, result);
+            continue;
+        }
+
+        if (!player)
+            player = VlcInstancePool::Get().AcquirePlayer();
+
+        result = player ? Grab(player, job->request) : ThumbnailResult();
+        if (!player)
+            result.error = "Failed to create media player";
+
+        if (result.ok)
+        {
+            grabbed_++;
+            if (cache_)
+                cache_->Store(job->key, result);
+        }
+        else
+        {
+            failed_++;
+        }
+
+        Finish(job, result);
+    }
+
+    if (player)
+        VlcInstancePool::Get().ReturnPlayer(player);
+}
+
+ThumbnailResult ThumbnailService::Grab(libvlc_media_player_t *player, const ThumbnailRequest &request)
+{
+    ThumbnailResult result;
+    result.format = request.format;
+
+    bool is_url = request.url.find("://") != std::string::npos;
+    libvlc_media_t *media = is_url ? libvlc_media_new_location(instance_, request.url.c_str())
+                                   : libvlc_media_new_path(instance_, request.url.c_str());
+    if (!media)
+    {
+        result.error = "Failed to create media";
+        return result;
+    }
+
+    // Only the picture matters: no audio output, no subtitles or title overlay, and software
+    // decoding so a handful of workers never compete for hardware decoder sessions
+    libvlc_media_add_option(media, ":no-audio");
+    libvlc_media_add_option(media, ":no-spu");
+    libvlc_media_add_option(media, ":no-sub-autodetect-file");
+    libvlc_media_add_option(media, ":no-video-title-show");
+    libvlc_media_add_option(media, ":avcodec-hw=none");
+
+    // A fast seek lands on the keyframe before the target, a position thumbnail would then wait
+    // for playback to reach it in real time
+    bool seek_by_position = request.time < 0 && request.position > 0.0f;
+    if (!seek_by_position)
+        libvlc_media_add_option(media, ":input-fast-seek");
+    if (request.time > 0)
+    {
+        char option[64];
+        snprintf(option, sizeof(option), ":start-time=%.3f", request.time / 1000.0);
+        libvlc_media_add_option(media, option);
+    }
+
+    GrabContext ctx;
+    ctx.box_width = request.width;
+    ctx.box_height = request.height;
+    ctx.armed = !seek_by_position;
+
+    libvlc_video_set_format_callbacks(player, GrabFormatCallback, nullptr);
+    libvlc_video_set_callbacks(player, GrabLockCallback, GrabUnlockCallback, GrabDisplayCallback, &ctx);
+    libvlc_media_player_set_media(player, media);
+    libvlc_media_release(media);
+
+    libvlc_event_manager_t *events = libvlc_media_player_event_manager(player);
+    libvlc_event_attach(events, libvlc_MediaPlayerEncounteredError, GrabEventCallback, &ctx);
+    libvlc_event_attach(events, libvlc_MediaPlayerEndReached, GrabEventCallback, &ctx);
+    libvlc_event_attach(events, libvlc_MediaPlayerTimeChanged, GrabTimeCallback, &ctx);
+
+    bool seek_requested = false;
+    bool timed_out = false;
+    if (libvlc_media_player_play(player) != 0)
+    {
+        result.error = "Failed to start playback";
+    }
+    else
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(request.timeout_ms);
+        std::unique_lock<std::mutex> lock(ctx.mutex);
+        while (!ctx.captured && !ctx.failed && !stopping_)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                timed_out = true;
+                break;
+            }
+
+            // Sliced so Stop() and the position seek are noticed
+            ctx.cv.wait_for(lock, std::chrono::milliseconds(20));
+
+            if (seek_by_position && !seek_requested)
+            {
+                lock.unlock();
+                int64_t length = libvlc_media_player_get_length(player);
+                bool seekable = length > 0 && libvlc_media_player_is_seekable(player);
+                float position = std::min(request.position, 1.0f);
+                if (seekable)
+                    libvlc_media_player_set_position(player, position);
+                lock.lock();
+
+                if (length > 0)
+                {
+                    seek_requested = true;
+                    // Time events stop short of the length, position 1.0 still arms in the last second
+                    if (seekable)
+                        ctx.arm_at_ms = std::min(static_cast<int64_t>(position * length),
+                                                 std::max<int64_t>(0, length - 1000));
+                    else
+                        ctx.armed = true; // Nothing to seek in, the first picture will do
+                }
+            }
+        }
+    }
+
+    // Stop joins the vout thread, no callback touches ctx after this
+    libvlc_media_player_stop(player);
+    libvlc_event_detach(events, libvlc_MediaPlayerEncounteredError, GrabEventCallback, &ctx);
+    libvlc_event_detach(events, libvlc_MediaPlayerEndReached, GrabEventCallback, &ctx);
+    libvlc_event_detach(events, libvlc_MediaPlayerTimeChanged, GrabTimeCallback, &ctx);
+    libvlc_media_player_set_media(player, nullptr);
+
+    if (!ctx.captured)
+    {
+        if (result.error.empty())
+        {
+            if (stopping_)
+                result.error = "Thumbnailer closed";
+            else if (timed_out)
+                result.error = "Timed out waiting for a picture";
+            else
+                result.error = "Playback failed before a picture was decoded";
+        }
+        return result;
+    }
+
+    result.width = ctx.width;
+    result.height = ctx.height;
+    if (request.format == ThumbnailFormat::PNG)
+    {
+        if (!EncodePNG(ctx.frame.data(), ctx.width, ctx.height, ctx.width * 4, &result.data))
+        {
+            result.error = "Failed to encode PNG";
+            return result;
+        }
+    }
+    else
+    {
+        result.data = std::move(ctx.frame);
+        for (size_t i = 3; i < result.data.size(); i += 4)
+            result.data[i] = 0xFF;
+    }
+
+    result.ok = true;
+    return result;
+}
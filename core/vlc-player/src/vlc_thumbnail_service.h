@@ -0,0 +1,174 @@
+#ifndef VLC_THUMBNAIL_SERVICE_H
+#define VLC_THUMBNAIL_SERVICE_H
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <vlc/vlc.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =================================================================================================
+// Thumbnails - Headless frame grabs for channel / VOD grids
+// =================================================================================================
+// A few worker threads each own a media player borrowed from VlcInstancePool, rendering into
+// vmem at the requested size with audio, subtitles and hardware decoding off. A job opens the
+// media (at :start-time for a time, or seeking once the length is known for a position),
+// keeps the first picture the decoder hands over, and encodes it. Finished thumbnails land in
+// an on-disk LRU keyed by the request, so re-rendering a grid never opens a stream twice.
+
+enum class ThumbnailFormat
+{
+    PNG, // RGB PNG (built-in encoder, see vlc_png.h)
+    RAW  // Tightly packed BGRA, alpha forced opaque
+};
+
+struct ThumbnailRequest
+{
+    std::string url;
+    int64_t time = -1;      // ms from the start, -1 = first picture
+    float position = -1.0f; // 0..1 of the length, used when time is -1
+    unsigned width = 320;   // Bounding box, the aspect ratio is kept and never upscaled
+    unsigned height = 180;
+    ThumbnailFormat format = ThumbnailFormat::PNG;
+    int timeout_ms = 10000;
+    bool use_cache = true;
+
+    std::string CacheKey() const;
+};
+
+struct ThumbnailResult
+{
+    bool ok = false;
+    std::string error;
+    bool cached = false;
+    ThumbnailFormat format = ThumbnailFormat::PNG;
+    unsigned width = 0;
+    unsigned height = 0;
+    std::vector<uint8_t> data;
+};
+
+// =================================================================================================
+// ThumbnailCache - On-disk LRU of encoded thumbnails
+// =================================================================================================
+// One file per key in a flat directory. The last-use order lives in the file times, so it
+// survives restarts; writes go through a temporary file and a rename, so concurrent workers
+// or processes never see half a thumbnail.
+
+class ThumbnailCache
+{
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 256ull * 1024 * 1024;
+
+    /**
+     * Create the directory if needed and index what is already there
+     * @return false if the directory is unusable (the cache then stays disabled)
+     */
+    bool Open(const std::string &directory, uint64_t max_bytes);
+
+    bool IsOpen();
+    bool Load(const std::string &key, ThumbnailResult *result);
+    void Store(const std::string &key, const ThumbnailResult &result);
+    void Clear();
+
+    size_t Count();
+    uint64_t Bytes();
+
+private:
+    struct Entry
+    {
+        uint64_t size = 0;
+        int64_t last_used = 0; // File time ticks, refreshed on every hit
+    };
+
+    std::filesystem::path PathFor(const std::string &key) const;
+    void EvictLocked();
+
+    std::mutex mutex_;
+    std::string directory_; // UTF-8
+    uint64_t max_bytes_ = DEFAULT_MAX_BYTES;
+    uint64_t bytes_ = 0;
+    std::map<std::string, Entry> entries_; // File name -> entry
+};
+
+// =================================================================================================
+// ThumbnailService - Worker pool, identical requests in flight share one grab
+// =================================================================================================
+
+struct ThumbnailStats
+{
+    size_t workers;
+    size_t queued;
+    size_t in_flight;
+    uint64_t grabbed;
+    uint64_t cache_hits;
+    uint64_t failed;
+};
+
+class ThumbnailService
+{
+public:
+    static constexpr size_t DEFAULT_WORKERS = 2;
+    static constexpr size_t MAX_WORKERS = 8;
+
+    // Invoked on a worker thread
+    using Callback = std::function<void(const ThumbnailResult &result)>;
+
+    explicit ThumbnailService(std::shared_ptr<ThumbnailCache> cache);
+    ~ThumbnailService();
+
+    /**
+     * Take a libVLC instance reference and spawn the workers
+     * @return false if libVLC could not be started
+     */
+    bool Start(size_t workers);
+
+    /**
+     * Fail everything queued with "closed", let running grabs abort and join the workers
+     */
+    void Stop();
+
+    void Submit(const ThumbnailRequest &request, Callback callback);
+    ThumbnailStats GetStats();
+
+private:
+    struct Job
+    {
+        ThumbnailRequest request;
+        std::string key;
+        std::vector<Callback> callbacks;
+    };
+
+    void WorkerLoop();
+    void Finish(const std::shared_ptr<Job> &job, const ThumbnailResult &result);
+    ThumbnailResult Grab(libvlc_media_player_t *player, const ThumbnailRequest &request);
+
+    std::shared_ptr<ThumbnailCache> cache_;
+    libvlc_instance_t *instance_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::map<std::string, std::shared_ptr<Job>> jobs_; // Queued or running, by cache key
+    std::vector<std::thread> workers_;
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<uint64_t> grabbed_{0};
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> failed_{0};
+};
+
+#endif // VLC_THUMBNAIL_SERVICE_H
@@ -0,0 +1,205 @@
+#include "vlc_thumbnailer.h"
+#include <algorithm>
+
+Napi::Object VlcThumbnailer::Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function func = DefineClass(env, "Thumbnailer", {
+        InstanceMethod("get", &VlcThumbnailer::Get),
+        InstanceMethod("getStats", &VlcThumbnailer::GetStats),
+        InstanceMethod("clearCache", &VlcThumbnailer::ClearCache),
+        InstanceMethod("close", &VlcThumbnailer::Close),
+    });
+
+    exports.Set("Thumbnailer", func);
+    return exports;
+}
+
+/**
+ * new Thumbnailer({ workers = 2, cacheDir, maxCacheBytes = 256 MiB })
+ * Without cacheDir nothing is written to disk, identical in-flight requests are still shared.
+ */
+VlcThumbnailer::VlcThumbnailer(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<VlcThumbnailer>(info) {
+    Napi::Env env = info.Env();
+
+    size_t workers = ThumbnailService::DEFAULT_WORKERS;
+    std::string cache_dir;
+    uint64_t max_cache_bytes = ThumbnailCache::DEFAULT_MAX_BYTES;
+
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("workers")) {
+            workers = static_cast<size_t>(std::max(options.Get("workers").As<Napi::Number>().Int32Value(), 1));
+        }
+        if (options.Has("cacheDir") && options.Get("cacheDir").IsString()) {
+            cache_dir = options.Get("cacheDir").As<Napi::String>().Utf8Value();
+        }
+        if (options.Has("maxCacheBytes")) {
+            max_cache_bytes = static_cast<uint64_t>(std::max(options.Get("maxCacheBytes").As<Napi::Number>().Int64Value(), int64_t(0)));
+        }
+    }
+
+    if (!cache_dir.empty()) {
+        cache_ = std::make_shared<ThumbnailCache>();
+        if (!cache_->Open(cache_dir, max_cache_bytes)) {
+            cache_.reset();
+        }
+    }
+
+    service_ = std::make_unique<ThumbnailService>(cache_);
+    if (!service_->Start(workers)) {
+        service_.reset();
+        Napi::Error::New(env, "Failed to initialize libVLC").ThrowAsJavaScriptException();
+        return;
+    }
+
+    // Holds the event loop open only while get() promises are pending
+    tsfn_results_ = Napi::ThreadSafeFunction::New(
+        env,
+        Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+        "VlcThumbnails",
+        0,
+        1);
+    tsfn_results_.Unref(env);
+}
+
+VlcThumbnailer::~VlcThumbnailer() {
+    Shutdown();
+}
+
+void VlcThumbnailer::Shutdown() {
+    // Workers are joined first, so no result is queued on the released function
+    if (service_) {
+        service_->Stop();
+        service_.reset();
+    }
+
+    if (tsfn_results_) {
+        tsfn_results_.Release();
+        tsfn_results_ = Napi::ThreadSafeFunction();
+    }
+}
+
+/**
+ * get({ url, time?, position?, width = 320, height = 180, format = "png", timeout = 10000, cache = true })
+ *   -> Promise<{ data: Buffer, width, height, format, cached }>
+ *
+ * time is in ms, position (0..1) is used when time is not given, neither means the first
+ * picture. format "raw" is tightly packed BGRA.
+ */
+Napi::Value VlcThumbnailer::Get(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Options object expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (!options.Has("url") || !options.Get("url").IsString()) {
+        Napi::TypeError::New(env, "url is required").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    ThumbnailRequest request;
+    request.url = options.Get("url").As<Napi::String>().Utf8Value();
+
+    if (options.Has("time")) {
+        request.time = std::max(options.Get("time").As<Napi::Number>().Int64Value(), int64_t(-1));
+    }
+    if (options.Has("position")) {
+        request.position = std::clamp(options.Get("position").As<Napi::Number>().FloatValue(), 0.0f, 1.0f);
+    }
+    if (options.Has("width")) {
+        request.width = static_cast<unsigned>(std::max(options.Get("width").As<Napi::Number>().Int32Value(), 1));
+    }
+    if (options.Has("height")) {
+        request.height = static_cast<unsigned>(std::max(options.Get("height").As<Napi::Number>().Int32Value(), 1));
+    }
+    if (options.Has("timeout")) {
+        request.timeout_ms = std::clamp(options.Get("timeout").As<Napi::Number>().Int32Value(), 100, 120000);
+    }
+    if (options.Has("cache")) {
+        request.use_cache = options.Get("cache").ToBoolean().Value();
+    }
+    if (options.Has("format")) {
+        std::string format = options.Get("format").As<Napi::String>().Utf8Value();
+        if (format == "png") {
+            request.format = ThumbnailFormat::PNG;
+        } else if (format == "raw") {
+            request.format = ThumbnailFormat::RAW;
+        } else {
+            Napi::TypeError::New(env, "format must be one of png, raw").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    if (!service_ || !tsfn_results_) {
+        deferred.Reject(Napi::Error::New(env, "Thumbnailer closed").Value());
+        return deferred.Promise();
+    }
+
+    // A script that only awaits get() must not exit before the result arrives
+    if ((*pending_)++ == 0) {
+        tsfn_results_.Ref(env);
+    }
+
+    Napi::ThreadSafeFunction tsfn = tsfn_results_;
+    std::shared_ptr<size_t> pending = pending_;
+    service_->Submit(request, [tsfn, deferred, pending](const ThumbnailResult& result) {
+        // Shared requests all get the same result, each promise gets its own copy
+        auto settled = std::make_shared<ThumbnailResult>(result);
+        tsfn.NonBlockingCall([tsfn, deferred, settled, pending](Napi::Env env, Napi::Function) {
+            if (--(*pending) == 0) {
+                tsfn.Unref(env);
+            }
+
+            if (!settled->ok) {
+                deferred.Reject(Napi::Error::New(env, settled->error).Value());
+                return;
+            }
+
+            Napi::Object thumbnail = Napi::Object::New(env);
+            thumbnail.Set("data", Napi::Buffer<uint8_t>::Copy(env, settled->data.data(), settled->data.size()));
+            thumbnail.Set("width", Napi::Number::New(env, settled->width));
+            thumbnail.Set("height", Napi::Number::New(env, settled->height));
+            thumbnail.Set("format", Napi::String::New(env, settled->format == ThumbnailFormat::PNG ? "png" : "raw"));
+            thumbnail.Set("cached", Napi::Boolean::New(env, settled->cached));
+            deferred.Resolve(thumbnail);
+        });
+    });
+
+    return deferred.Promise();
+}
+
+Napi::Value VlcThumbnailer::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (!service_) return env.Null();
+
+    ThumbnailStats stats = service_->GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("workers", Napi::Number::New(env, static_cast<double>(stats.workers)));
+    result.Set("queued", Napi::Number::New(env, static_cast<double>(stats.queued)));
+    result.Set("inFlight", Napi::Number::New(env, static_cast<double>(stats.in_flight)));
+    result.Set("grabbed", Napi::Number::New(env, static_cast<double>(stats.grabbed)));
+    result.Set("cacheHits", Napi::Number::New(env, static_cast<double>(stats.cache_hits)));
+    result.Set("failed", Napi::Number::New(env, static_cast<double>(stats.failed)));
+    result.Set("cacheEntries", Napi::Number::New(env, cache_ ? static_cast<double>(cache_->Count()) : 0));
+    result.Set("cacheBytes", Napi::Number::New(env, cache_ ? static_cast<double>(cache_->Bytes()) : 0));
+
+    return result;
+}
+
+Napi::Value VlcThumbnailer::ClearCache(const Napi::CallbackInfo& info) {
+    if (cache_) {
+        cache_->Clear();
+    }
+    return info.Env().Undefined();
+}
+
+Napi::Value VlcThumbnailer::Close(const Napi::CallbackInfo& info) {
+    // Pending get() promises reject with "Thumbnailer closed"
+    Shutdown();
+    return info.Env().Undefined();
+}
@@ -0,0 +1,38 @@
+#ifndef VLC_THUMBNAILER_H
+#define VLC_THUMBNAILER_H
+
+#include <napi.h>
+#include <memory>
+#include "vlc_thumbnail_service.h"
+
+// =================================================================================================
+// Thumbnailer - JS front of ThumbnailService
+// =================================================================================================
+// new Thumbnailer({ workers, cacheDir, maxCacheBytes }) starts the worker pool, get({ url, ... })
+// resolves with the encoded thumbnail. Independent of any VlcPlayer, it only shares the
+// process-wide libVLC instance.
+
+class VlcThumbnailer : public Napi::ObjectWrap<VlcThumbnailer> {
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    VlcThumbnailer(const Napi::CallbackInfo& info);
+    ~VlcThumbnailer();
+
+private:
+    Napi::Value Get(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value ClearCache(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+
+    void Shutdown();
+
+    std::shared_ptr<ThumbnailCache> cache_;
+    std::unique_ptr<ThumbnailService> service_;
+    Napi::ThreadSafeFunction tsfn_results_; // Settles get() promises on the JS thread
+
+    // get() promises not settled yet (JS thread only), tsfn_results_ is ref'ed while non-zero.
+    // Shared with the result callbacks, which may run after this object is gone.
+    std::shared_ptr<size_t> pending_ = std::make_shared<size_t>(0);
+};
+
+#endif // VLC_THUMBNAILER_H
@@ -0,0 +1,397 @@
+#include "vlc_player.h"
+#include <algorithm>
+
+// =================================================================================================
+// Timeshift API
+// =================================================================================================
+// open({ file, timeshift: true }) records the channel into a TimeshiftSession ring and plays the
+// ring instead of the network. Pause is then playback({ action: 'pause' }) as usual, the recorder
+// keeps receiving. Moving inside the ring re-opens the callback media at the indexed offset, the
+// demuxed stream has no usable duration to seek with.
+//
+// Times given to and returned by timeshift() are milliseconds behind the live edge, measured by
+// when the bytes arrived. The player position is where its input reads, so it leads the picture
+// by the input caching (a few hundred ms with the default latency profiles).
+
+static constexpr int64_t MIN_WINDOW_MINUTES = 1;
+
+enum class TimeshiftSeekMode
+{
+    LIVE,
+    BEHIND,
+    REWIND,
+    FORWARD
+};
+
+// Seeks run off the JS thread: stopping the old input and opening the new one both block
+class TimeshiftSeekWorker : public Napi::AsyncWorker
+{
+public:
+    TimeshiftSeekWorker(Napi::Env env, VlcPlayer *player, Napi::Promise::Deferred deferred,
+                        std::shared_ptr<TimeshiftSession> session, TimeshiftSeekMode mode, int64_t value_ms,
+                        const std::map<std::string, std::string> &media_options, uint64_t generation)
+        : Napi::AsyncWorker(env, "VlcTimeshiftSeek"),
+          player_(player),
+          player_ref_(Napi::Persistent(player->Value())),
+          deferred_(deferred),
+          session_(std::move(session)),
+          mode_(mode),
+          value_ms_(value_ms),
+          media_options_(media_options),
+          generation_(generation),
+          superseded_(false)
+    {
+    }
+
+protected:
+    void Execute() override
+    {
+        TRACE_SCOPE("timeshift.seek");
+
+        // Serialised with open(), a newer channel makes the seek a no-op
+        std::lock_guard<std::mutex> open_lock(player_->open_mutex_);
+
+        if (player_->disposed_ || player_->open_generation_.load() != generation_)
+        {
+            superseded_ = true;
+            return;
+        }
+
+        std::shared_ptr<TimeshiftBuffer> buffer = session_->Buffer();
+        if (!buffer)
+        {
+            SetError("Timeshift is not recording");
+            return;
+        }
+
+        TimeshiftStats stats = session_->GetStats();
+        int64_t target = stats.live_ms;
+        switch (mode_)
+        {
+        case TimeshiftSeekMode::LIVE:
+            break;
+        case TimeshiftSeekMode::BEHIND:
+            target = stats.live_ms - value_ms_;
+            break;
+        case TimeshiftSeekMode::REWIND:
+            target = stats.position_ms - value_ms_;
+            break;
+        case TimeshiftSeekMode::FORWARD:
+            target = stats.position_ms + value_ms_;
+            break;
+        }
+        target = std::max(stats.oldest_ms, std::min(target, stats.live_ms));
+
+        uint64_t offset = buffer->OffsetAt(target);
+        VlcPlayer::Log("Timeshift seek to %lld ms behind live (offset %llu)", (long long)(stats.live_ms - target),
+                       (unsigned long long)offset);
+
+        VlcPlayer::PlayerLock lock(player_->player_mutex_);
+        if (!player_->media_player_ || player_->GetTimeshift() != session_)
+        {
+            superseded_ = true;
+            return;
+        }
+
+        libvlc_media_t *media = session_->CreateMedia(player_->vlc_instance_, offset);
+        if (!media)
+        {
+            SetError("Failed to create media");
+            return;
+        }
+        for (const auto &opt : media_options_)
+        {
+            std::string option_str = opt.first + "=" + opt.second;
+            libvlc_media_add_option(media, option_str.c_str());
+        }
+
+        libvlc_media_player_set_media(player_->media_player_, media);
+        libvlc_media_release(media);
+        player_->track_cache_.Invalidate();
+        player_->latency_.OnSeek();
+        libvlc_media_player_play(player_->media_player_);
+
+        stats_ = session_->GetStats();
+    }
+
+    void OnOK() override
+    {
+        Napi::Env env = Env();
+
+        if (superseded_)
+        {
+            Napi::Object result = Napi::Object::New(env);
+            result.Set("superseded", Napi::Boolean::New(env, true));
+            deferred_.Resolve(result);
+            return;
+        }
+
+        deferred_.Resolve(VlcPlayer::TimeshiftStatsToObject(env, *session_, stats_));
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    VlcPlayer *player_;
+    Napi::ObjectReference player_ref_;
+    Napi::Promise::Deferred deferred_;
+    std::shared_ptr<TimeshiftSession> session_;
+    TimeshiftSeekMode mode_;
+    int64_t value_ms_;
+    std::map<std::string, std::string> media_options_;
+    uint64_t generation_;
+    bool superseded_;
+    TimeshiftStats stats_;
+};
+
+// Copies a span of the ring into a standalone .ts file, the recording goes on meanwhile
+class TimeshiftExportWorker : public Napi::AsyncWorker
+{
+public:
+    TimeshiftExportWorker(Napi::Env env, Napi::Promise::Deferred deferred, std::shared_ptr<TimeshiftSession> session,
+                          const std::string &file, int64_t from_ms, int64_t to_ms)
+        : Napi::AsyncWorker(env, "VlcTimeshiftExport"),
+          deferred_(deferred),
+          session_(std::move(session)),
+          file_(file),
+          from_ms_(from_ms),
+          to_ms_(to_ms),
+          bytes_(0),
+          duration_ms_(0)
+    {
+    }
+
+protected:
+    void Execute() override
+    {
+        TRACE_SCOPE("timeshift.export");
+
+        std::shared_ptr<TimeshiftBuffer> buffer = session_->Buffer();
+        if (!buffer)
+        {
+            SetError("Timeshift is not recording");
+            return;
+        }
+
+        // Negative = not given: from the oldest byte, up to the live edge
+        int64_t live = buffer->LiveTime();
+        uint64_t from = from_ms_ >= 0 ? buffer->OffsetAt(live - from_ms_) : 0;
+        uint64_t to = to_ms_ >= 0 ? buffer->OffsetAt(live - to_ms_) : buffer->Head();
+        if (to <= from)
+        {
+            SetError("Empty export range");
+            return;
+        }
+
+        std::string error;
+        bytes_ = buffer->Export(from, to, file_, &error);
+        if (bytes_ < 0)
+        {
+            SetError(error);
+            return;
+        }
+        int64_t end_ms = to_ms_ >= 0 ? buffer->TimeAt(to) : live;
+        duration_ms_ = end_ms - buffer->TimeAt(from);
+    }
+
+    void OnOK() override
+    {
+        Napi::Env env = Env();
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("file", Napi::String::New(env, file_));
+        result.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_)));
+        result.Set("durationMs", Napi::Number::New(env, static_cast<double>(duration_ms_)));
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error &error) override
+    {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    std::shared_ptr<TimeshiftSession> session_;
+    std::string file_;
+    int64_t from_ms_;
+    int64_t to_ms_;
+    int64_t bytes_;
+    int64_t duration_ms_;
+};
+
+/**
+ * open({ timeshift: true | { minutes?, maxBytes?, directory? } })
+ *   minutes   - kept behind the live edge (default 30)
+ *   maxBytes  - size of the data ring, the window shrinks when the stream fills it first (default 2 GiB)
+ *   directory - ring and index files (default system temp directory), removed when the channel changes
+ */
+bool VlcPlayer::ParseTimeshiftOption(Napi::Env env, const Napi::Value &value, TimeshiftOptions *options)
+{
+    if (!value.IsObject())
+        return true;
+
+    Napi::Object obj = value.As<Napi::Object>();
+    if (obj.Has("minutes"))
+    {
+        if (!obj.Get("minutes").IsNumber())
+        {
+            Napi::TypeError::New(env, "timeshift.minutes must be a number").ThrowAsJavaScriptException();
+            return false;
+        }
+        int64_t minutes = std::max(MIN_WINDOW_MINUTES, obj.Get("minutes").As<Napi::Number>().Int64Value());
+        options->window_ms = minutes * 60000;
+    }
+    if (obj.Has("maxBytes"))
+    {
+        if (!obj.Get("maxBytes").IsNumber())
+        {
+            Napi::TypeError::New(env, "timeshift.maxBytes must be a number").ThrowAsJavaScriptException();
+            return false;
+        }
+        options->max_bytes = static_cast<uint64_t>(std::max<int64_t>(0, obj.Get("maxBytes").As<Napi::Number>().Int64Value()));
+    }
+    if (obj.Has("directory"))
+    {
+        if (!obj.Get("directory").IsString())
+        {
+            Napi::TypeError::New(env, "timeshift.directory must be a string").ThrowAsJavaScriptException();
+            return false;
+        }
+        options->directory = obj.Get("directory").As<Napi::String>().Utf8Value();
+    }
+    return true;
+}
+
+std::shared_ptr<TimeshiftSession> VlcPlayer::GetTimeshift()
+{
+    std::lock_guard<std::mutex> lock(timeshift_mutex_);
+    return timeshift_;
+}
+
+std::shared_ptr<TimeshiftSession> VlcPlayer::DetachTimeshift()
+{
+    std::shared_ptr<TimeshiftSession> session;
+    {
+        std::lock_guard<std::mutex> lock(timeshift_mutex_);
+        session.swap(timeshift_);
+    }
+    if (session)
+        session->Interrupt();
+    return session;
+}
+
+Napi::Object VlcPlayer::TimeshiftStatsToObject(Napi::Env env, const TimeshiftSession &session,
+                                               const TimeshiftStats &stats)
+{
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("recording", Napi::Boolean::New(env, stats.recording));
+    result.Set("finished", Napi::Boolean::New(env, stats.finished));
+    result.Set("url", Napi::String::New(env, session.Url()));
+    result.Set("directory", Napi::String::New(env, session.Directory()));
+    result.Set("liveMs", Napi::Number::New(env, static_cast<double>(stats.live_ms)));
+    result.Set("bufferedMs", Napi::Number::New(env, static_cast<double>(stats.live_ms - stats.oldest_ms)));
+    result.Set("behindLiveMs",
+               Napi::Number::New(env, static_cast<double>(std::max<int64_t>(0, stats.live_ms - stats.position_ms))));
+    result.Set("bufferedBytes", Napi::Number::New(env, static_cast<double>(stats.head - stats.tail)));
+    result.Set("capacityBytes", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+    return result;
+}
+
+/**
+ * timeshift() -> { recording, finished, url, directory, liveMs, bufferedMs, behindLiveMs,
+ *                  bufferedBytes, capacityBytes } | null
+ * timeshift({ seek: msBehindLive } | { live: true } | { rewind: ms } | { forward: ms }) -> Promise<status>
+ * timeshift({ export: { file, from?, to? } }) -> Promise<{ file, bytes, durationMs }>
+ *
+ * from / to are ms behind live (default: the whole ring). Seeks resume playback and resolve with
+ * { superseded: true } when open() changed the channel first.
+ */
+Napi::Value VlcPlayer::Timeshift(const Napi::CallbackInfo &info)
+{
+    Napi::Env env = info.Env();
+    std::shared_ptr<TimeshiftSession> session = GetTimeshift();
+
+    if (info.Length() < 1 || !info[0].IsObject())
+    {
+        if (!session)
+            return env.Null();
+        return TimeshiftStatsToObject(env, *session, session->GetStats());
+    }
+
+    if (!session)
+    {
+        Napi::Error::New(env, "No timeshift session, open the channel with { timeshift: true }")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Object options = info[0].As<Napi::Object>();
+
+    if (options.Has("export"))
+    {
+        if (!options.Get("export").IsObject())
+        {
+            Napi::TypeError::New(env, "export options object expected").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        Napi::Object exportOpts = options.Get("export").As<Napi::Object>();
+        if (!exportOpts.Has("file") || !exportOpts.Get("file").IsString())
+        {
+            Napi::TypeError::New(env, "export.file is required").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        std::string file = exportOpts.Get("file").As<Napi::String>().Utf8Value();
+        int64_t from = -1;
+        int64_t to = -1;
+        if (exportOpts.Has("from") && exportOpts.Get("from").IsNumber())
+            from = std::max<int64_t>(0, exportOpts.Get("from").As<Napi::Number>().Int64Value());
+        if (exportOpts.Has("to") && exportOpts.Get("to").IsNumber())
+            to = std::max<int64_t>(0, exportOpts.Get("to").As<Napi::Number>().Int64Value());
+
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        TimeshiftExportWorker *worker = new TimeshiftExportWorker(env, deferred, session, file, from, to);
+        worker->Queue();
+        return deferred.Promise();
+    }
+
+    TimeshiftSeekMode mode;
+    int64_t value = 0;
+    if (options.Has("live") && options.Get("live").ToBoolean().Value())
+    {
+        mode = TimeshiftSeekMode::LIVE;
+    }
+    else if (options.Has("seek") && options.Get("seek").IsNumber())
+    {
+        mode = TimeshiftSeekMode::BEHIND;
+        value = options.Get("seek").As<Napi::Number>().Int64Value();
+    }
+    else if (options.Has("rewind") && options.Get("rewind").IsNumber())
+    {
+        mode = TimeshiftSeekMode::REWIND;
+        value = options.Get("rewind").As<Napi::Number>().Int64Value();
+    }
+    else if (options.Has("forward") && options.Get("forward").IsNumber())
+    {
+        mode = TimeshiftSeekMode::FORWARD;
+        value = options.Get("forward").As<Napi::Number>().Int64Value();
+    }
+    else
+    {
+        Napi::TypeError::New(env, "One of seek, live, rewind, forward or export expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    // A seek inside the ring must not be undone by a drag still coalescing on the old media
+    if (scrub_)
+        scrub_->Cancel();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    TimeshiftSeekWorker *worker = new TimeshiftSeekWorker(env, this, deferred, session, mode, std::max<int64_t>(0, value),
+                                                          media_options_, open_generation_.load());
+    worker->Queue();
+    return deferred.Promise();
+}
@@ -0,0 +1,844 @@
+#include "vlc_timeshift_buffer.h"
+#include "vlc_instance_pool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static constexpr size_t PIPE_CHUNK = 64 * 1024;
+static constexpr size_t EXPORT_CHUNK = 1024 * 1024;
+static constexpr uint64_t MIN_DATA_CAPACITY = 16ull << 20;
+
+static inline uint64_t AlignDown(uint64_t value, uint64_t alignment)
+{
+    return value - value % alignment;
+}
+
+static inline uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return AlignDown(value + alignment - 1, alignment);
+}
+
+#ifdef _WIN32
+static constexpr char PATH_SEPARATOR = '\\';
+#else
+static constexpr char PATH_SEPARATOR = '/';
+#endif
+
+static std::string TempDirectory()
+{
+#ifdef _WIN32
+    char path[MAX_PATH + 1];
+    DWORD length = GetTempPathA(sizeof(path), path);
+    if (length == 0 || length > MAX_PATH)
+        return ".";
+    std::string directory(path, length);
+#else
+    const char *env = getenv("TMPDIR");
+    std::string directory = env && *env ? env : "/tmp";
+#endif
+    while (directory.size() > 1 && directory.back() == PATH_SEPARATOR)
+        directory.pop_back();
+    return directory;
+}
+
+static unsigned long ProcessId()
+{
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<unsigned long>(getpid());
+#endif
+}
+
+// Values of a sout chain option are unescaped by libVLC, Windows paths need their backslashes doubled
+static std::string SoutQuote(const std::string &value)
+{
+    std::string quoted = "\"";
+    for (char c : value)
+    {
+        if (c == '\\' || c == '"')
+            quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// =================================================================================================
+// MappedFile - File-backed shared mapping (the index)
+// =================================================================================================
+
+class MappedFile
+{
+public:
+    static std::unique_ptr<MappedFile> Create(const std::string &path, size_t size)
+    {
+        std::unique_ptr<MappedFile> file(new MappedFile());
+        file->size_ = size;
+
+#ifdef _WIN32
+        file->file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_TEMPORARY, nullptr);
+        if (file->file_ == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        uint64_t size64 = static_cast<uint64_t>(size);
+        file->mapping_ = CreateFileMappingA(file->file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+                                            static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+        if (!file->mapping_)
+            return nullptr;
+
+        file->data_ = static_cast<uint8_t *>(MapViewOfFile(file->mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+        if (!file->data_)
+            return nullptr;
+#else
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0)
+            return nullptr;
+
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            close(fd);
+            return nullptr;
+        }
+
+        void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return nullptr;
+        file->data_ = static_cast<uint8_t *>(data);
+#endif
+
+        // A freshly extended file reads as zeros on both platforms
+        return file;
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+#else
+        if (data_)
+            munmap(data_, size_);
+#endif
+    }
+
+    uint8_t *Data() const { return data_; }
+
+private:
+    MappedFile() = default;
+
+    uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+// =================================================================================================
+// TimeshiftBuffer
+// =================================================================================================
+
+std::shared_ptr<TimeshiftBuffer> TimeshiftBuffer::Create(const std::string &path, const TimeshiftOptions &options,
+                                                         std::string *error)
+{
+    std::shared_ptr<TimeshiftBuffer> buffer(new TimeshiftBuffer());
+    buffer->data_path_ = path + ".ts";
+    buffer->index_path_ = path + ".idx";
+    buffer->window_ms_ = std::max<int64_t>(options.window_ms, INDEX_INTERVAL_MS);
+    buffer->started_ = std::chrono::steady_clock::now();
+
+    uint64_t capacity = AlignDown(std::max(options.max_bytes, MIN_DATA_CAPACITY), TS_PACKET_SIZE);
+
+    // The data file stays sparse, only what the stream fills takes disk space
+#ifdef _WIN32
+    buffer->data_file_ = CreateFileA(buffer->data_path_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                     CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (buffer->data_file_ == INVALID_HANDLE_VALUE)
+    {
+        *error = "Failed to create " + buffer->data_path_;
+        return nullptr;
+    }
+#else
+    buffer->data_fd_ = open(buffer->data_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (buffer->data_fd_ < 0 || ftruncate(buffer->data_fd_, static_cast<off_t>(capacity)) != 0)
+    {
+        *error = "Failed to create " + buffer->data_path_ + ": " + strerror(errno);
+        return nullptr;
+    }
+#endif
+
+    // Sized for the window, a slow stream that fits the data ring longer is trimmed by index age
+    uint64_t entries = static_cast<uint64_t>(buffer->window_ms_ / INDEX_INTERVAL_MS) + 64;
+    size_t index_size = sizeof(TimeshiftIndexHeader) + entries * sizeof(TimeshiftIndexEntry);
+    buffer->index_file_ = MappedFile::Create(buffer->index_path_, index_size);
+    if (!buffer->index_file_)
+    {
+        *error = "Failed to map " + buffer->index_path_;
+        return nullptr;
+    }
+
+    TimeshiftIndexHeader *header = new (buffer->index_file_->Data()) TimeshiftIndexHeader();
+    header->magic = TIMESHIFT_INDEX_MAGIC;
+    header->version = TIMESHIFT_INDEX_VERSION;
+    header->capacity = static_cast<uint32_t>(entries);
+    header->reserved = 0;
+    header->data_capacity = capacity;
+    header->started_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+    header->count = 0;
+    header->head = 0;
+    header->tail = 0;
+
+    buffer->header_ = header;
+    buffer->entries_ = reinterpret_cast<TimeshiftIndexEntry *>(buffer->index_file_->Data() + sizeof(TimeshiftIndexHeader));
+    return buffer;
+}
+
+TimeshiftBuffer::~TimeshiftBuffer()
+{
+    index_file_.reset();
+#ifdef _WIN32
+    if (data_file_ != INVALID_HANDLE_VALUE)
+        CloseHandle(data_file_);
+#else
+    if (data_fd_ >= 0)
+        close(data_fd_);
+#endif
+
+    if (!data_path_.empty())
+        std::remove(data_path_.c_str());
+    if (!index_path_.empty())
+        std::remove(index_path_.c_str());
+}
+
+int64_t TimeshiftBuffer::Now() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_).count();
+}
+
+const TimeshiftIndexEntry &TimeshiftBuffer::EntryLocked(uint64_t n) const
+{
+    return entries_[n % header_->capacity];
+}
+
+bool TimeshiftBuffer::WriteAt(uint64_t offset, const uint8_t *data, size_t size)
+{
+    uint64_t capacity = header_->data_capacity;
+    while (size > 0)
+    {
+        uint64_t position = offset % capacity;
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size, capacity - position));
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD written = 0;
+        if (!WriteFile(data_file_, data, static_cast<DWORD>(chunk), &written, &overlapped) || written == 0)
+            return false;
+        chunk = written;
+#else
+        ssize_t written = pwrite(data_fd_, data, chunk, static_cast<off_t>(position));
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        chunk = static_cast<size_t>(written);
+#endif
+        offset += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+bool TimeshiftBuffer::ReadAt(uint64_t offset, uint8_t *data, size_t size)
+{
+    uint64_t capacity = header_->data_capacity;
+    while (size > 0)
+    {
+        uint64_t position = offset % capacity;
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size, capacity - position));
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD read = 0;
+        if (!ReadFile(data_file_, data, static_cast<DWORD>(chunk), &read, &overlapped) || read == 0)
+            return false;
+        chunk = read;
+#else
+        ssize_t read = pread(data_fd_, data, chunk, static_cast<off_t>(position));
+        if (read < 0 && errno == EINTR)
+            continue;
+        if (read <= 0)
+            return false;
+        chunk = static_cast<size_t>(read);
+#endif
+        offset += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+void TimeshiftBuffer::TrimLocked(uint64_t new_head)
+{
+    uint64_t capacity = header_->data_capacity;
+    uint64_t count = header_->count;
+    uint64_t tail = header_->tail;
+
+    // The bytes about to be written overwrite the oldest ones
+    uint64_t min_tail = new_head > capacity ? new_head - capacity : 0;
+
+    // Entries pushed out of the index ring, and the ones older than the window
+    if (count > header_->capacity)
+        first_entry_ = std::max(first_entry_, count - header_->capacity);
+    while (first_entry_ < count && EntryLocked(first_entry_).time_ms < live_ms_ - window_ms_)
+        first_entry_++;
+    if (first_entry_ < count)
+        min_tail = std::max(min_tail, EntryLocked(first_entry_).offset);
+
+    if (min_tail <= tail)
+        return;
+
+    // Readers resynchronise at tail, keep it on an indexed packet boundary
+    while (first_entry_ < count && EntryLocked(first_entry_).offset < min_tail)
+        first_entry_++;
+    uint64_t new_tail = first_entry_ < count ? EntryLocked(first_entry_).offset : AlignUp(min_tail, TS_PACKET_SIZE);
+    header_->tail = std::min(new_tail, std::max(new_head, header_->head.load()));
+}
+
+bool TimeshiftBuffer::Append(const uint8_t *data, size_t size)
+{
+    uint64_t capacity = header_->data_capacity;
+
+    // Larger writes than a quarter of the ring are split so tail never jumps over a reader's read
+    while (size > 0)
+    {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size, capacity / 4));
+        uint64_t head;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            head = header_->head;
+            live_ms_ = Now();
+
+            uint64_t entry_offset = AlignUp(head, TS_PACKET_SIZE);
+            if ((last_entry_ms_ < 0 || live_ms_ - last_entry_ms_ >= INDEX_INTERVAL_MS) && entry_offset < head + chunk)
+            {
+                uint64_t count = header_->count;
+                entries_[count % header_->capacity] = {live_ms_, entry_offset};
+                header_->count = count + 1;
+                last_entry_ms_ = live_ms_;
+            }
+
+            TrimLocked(head + chunk);
+        }
+
+        if (!WriteAt(head, data, chunk))
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            header_->head = head + chunk;
+        }
+        data_cv_.notify_all();
+
+        data += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+void TimeshiftBuffer::Finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    data_cv_.notify_all();
+}
+
+uint64_t TimeshiftBuffer::Interrupt()
+{
+    uint64_t epoch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        epoch = ++epoch_;
+    }
+    data_cv_.notify_all();
+    return epoch;
+}
+
+ssize_t TimeshiftBuffer::Read(uint64_t *offset, uint8_t *data, size_t size, uint64_t epoch)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;)
+    {
+        if (epoch_ != epoch)
+            return 0;
+
+        // Overwritten while paused too long: continue with the oldest data still there
+        if (*offset < header_->tail)
+            *offset = header_->tail;
+
+        uint64_t head = header_->head;
+        if (*offset >= head)
+        {
+            if (finished_)
+                return 0;
+            data_cv_.wait_for(lock, std::chrono::milliseconds(200));
+            continue;
+        }
+
+        uint64_t at = *offset;
+        size_t count = static_cast<size_t>(std::min<uint64_t>(size, head - at));
+        lock.unlock();
+        bool ok = ReadAt(at, data, count);
+        lock.lock();
+
+        if (!ok)
+            return -1;
+
+        // The writer lapped us during the copy, the bytes may be torn
+        if (header_->tail > at)
+            continue;
+
+        *offset = at + count;
+        return static_cast<ssize_t>(count);
+    }
+}
+
+uint64_t TimeshiftBuffer::OffsetAt(int64_t time_ms)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t count = header_->count;
+    uint64_t tail = header_->tail;
+
+    // Last entry at or before time_ms
+    uint64_t lo = first_entry_;
+    uint64_t hi = count;
+    if (lo == hi || EntryLocked(lo).time_ms > time_ms)
+        return tail;
+    while (hi - lo > 1)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (EntryLocked(mid).time_ms <= time_ms)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return std::max(EntryLocked(lo).offset, tail);
+}
+
+int64_t TimeshiftBuffer::TimeAt(uint64_t offset)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t count = header_->count;
+
+    // Last entry at or before offset
+    uint64_t lo = first_entry_;
+    uint64_t hi = count;
+    if (lo == hi)
+        return live_ms_;
+    if (EntryLocked(lo).offset > offset)
+        return EntryLocked(lo).time_ms;
+    while (hi - lo > 1)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (EntryLocked(mid).offset <= offset)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return EntryLocked(lo).time_ms;
+}
+
+int64_t TimeshiftBuffer::LiveTime()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_ms_;
+}
+
+uint64_t TimeshiftBuffer::Head()
+{
+    return header_->head.load();
+}
+
+int64_t TimeshiftBuffer::Export(uint64_t from, uint64_t to, const std::string &file, std::string *error)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        *error = "Failed to create " + file;
+        return -1;
+    }
+
+    std::vector<uint8_t> chunk(EXPORT_CHUNK);
+    uint64_t offset = AlignDown(from, TS_PACKET_SIZE);
+    int64_t written = 0;
+
+    for (;;)
+    {
+        uint64_t count;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (offset < header_->tail)
+                offset = header_->tail;
+            uint64_t end = std::min<uint64_t>(to, header_->head);
+            if (offset >= end)
+                break;
+            count = std::min<uint64_t>(end - offset, chunk.size());
+        }
+
+        if (!ReadAt(offset, chunk.data(), static_cast<size_t>(count)))
+        {
+            *error = "Failed to read the timeshift ring";
+            return -1;
+        }
+
+        // Overwritten during the copy, skip to what is still there
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (header_->tail > offset)
+                continue;
+        }
+
+        out.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(count));
+        if (!out)
+        {
+            *error = "Failed to write " + file;
+            return -1;
+        }
+        offset += count;
+        written += static_cast<int64_t>(count);
+    }
+
+    return written;
+}
+
+TimeshiftStats TimeshiftBuffer::GetStats()
+{
+    TimeshiftStats stats;
+    stats.head = header_->head;
+    stats.tail = header_->tail;
+    stats.capacity = header_->data_capacity;
+    stats.oldest_ms = TimeAt(stats.tail);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.finished = finished_;
+    stats.live_ms = live_ms_;
+    return stats;
+}
+
+// =================================================================================================
+// TimeshiftSession - Recorder and pipe
+// =================================================================================================
+
+struct TimeshiftCursor
+{
+    std::shared_ptr<TimeshiftBuffer> buffer;
+    TimeshiftSession *session;
+    uint64_t start;
+    uint64_t offset;
+    uint64_t epoch;
+};
+
+TimeshiftSession::TimeshiftSession(const std::string &url, const TimeshiftOptions &options)
+    : url_(url), options_(options)
+{
+    static std::atomic<uint32_t> next_id{0};
+
+    directory_ = options.directory.empty() ? TempDirectory() : options.directory;
+    name_ = "zenith-timeshift-" + std::to_string(ProcessId()) + "-" + std::to_string(++next_id);
+}
+
+TimeshiftSession::~TimeshiftSession()
+{
+    Stop();
+}
+
+std::shared_ptr<TimeshiftBuffer> TimeshiftSession::Buffer()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffer_;
+}
+
+bool TimeshiftSession::CreatePipe(std::string *error)
+{
+#ifdef _WIN32
+    pipe_path_ = "\\\\.\\pipe\\" + name_;
+    pipe_ = CreateNamedPipeA(pipe_path_.c_str(), PIPE_ACCESS_INBOUND, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT, 1,
+                             0, static_cast<DWORD>(PIPE_CHUNK * 16), 0, nullptr);
+    if (pipe_ == INVALID_HANDLE_VALUE)
+    {
+        *error = "Failed to create pipe " + pipe_path_;
+        return false;
+    }
+#else
+    pipe_path_ = directory_ + PATH_SEPARATOR + name_ + ".pipe";
+    unlink(pipe_path_.c_str());
+    if (mkfifo(pipe_path_.c_str(), 0600) != 0)
+    {
+        *error = "Failed to create pipe " + pipe_path_ + ": " + strerror(errno);
+        pipe_path_.clear();
+        return false;
+    }
+#endif
+    return true;
+}
+
+void TimeshiftSession::PipeLoop()
+{
+    std::vector<uint8_t> chunk(PIPE_CHUNK);
+
+#ifdef _WIN32
+    // The recorder's file output connects when its input starts
+    if (ConnectNamedPipe(pipe_, nullptr) || GetLastError() == ERROR_PIPE_CONNECTED)
+    {
+        while (!pipe_stop_)
+        {
+            DWORD read = 0;
+            if (!ReadFile(pipe_, chunk.data(), static_cast<DWORD>(chunk.size()), &read, nullptr) || read == 0)
+                break; // ERROR_BROKEN_PIPE: the recorder stopped
+            if (!buffer_->Append(chunk.data(), read))
+                break;
+        }
+    }
+#else
+    // Blocks until the recorder's file output opens the other end
+    int fd = open(pipe_path_.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        while (!pipe_stop_)
+        {
+            ssize_t read_bytes = read(fd, chunk.data(), chunk.size());
+            if (read_bytes < 0 && errno == EINTR)
+                continue;
+            if (read_bytes <= 0)
+                break; // The recorder closed the pipe
+            if (!buffer_->Append(chunk.data(), static_cast<size_t>(read_bytes)))
+                break;
+        }
+        close(fd);
+    }
+#endif
+
+    recording_ = false;
+    buffer_->Finish();
+}
+
+// A recorder that never opened the pipe leaves the pipe thread waiting for a writer
+void TimeshiftSession::UnblockPipe()
+{
+#ifdef _WIN32
+    HANDLE writer = CreateFileA(pipe_path_.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (writer != INVALID_HANDLE_VALUE)
+        CloseHandle(writer);
+#else
+    int fd = open(pipe_path_.c_str(), O_WRONLY | O_NONBLOCK);
+    if (fd >= 0)
+        close(fd);
+#endif
+}
+
+void TimeshiftSession::ClosePipe()
+{
+#ifdef _WIN32
+    if (pipe_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(pipe_);
+        pipe_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (!pipe_path_.empty())
+        unlink(pipe_path_.c_str());
+#endif
+    pipe_path_.clear();
+}
+
+bool TimeshiftSession::Start(libvlc_instance_t *instance, const std::map<std::string, std::string> &media_options,
+                             std::string *error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (stopped_ || buffer_)
+    {
+        *error = "Timeshift session already used";
+        return false;
+    }
+
+    std::shared_ptr<TimeshiftBuffer> buffer =
+        TimeshiftBuffer::Create(directory_ + PATH_SEPARATOR + name_, options_, error);
+    if (!buffer)
+        return false;
+    buffer_ = buffer;
+
+    if (!CreatePipe(error))
+        return false;
+
+    recorder_ = VlcInstancePool::Get().AcquirePlayer();
+    if (!recorder_)
+    {
+        *error = "Failed to create the timeshift recorder";
+        ClosePipe();
+        return false;
+    }
+
+    bool is_url = url_.find("://") != std::string::npos;
+    libvlc_media_t *media = is_url ? libvlc_media_new_location(instance, url_.c_str())
+                                   : libvlc_media_new_path(instance, url_.c_str());
+    if (!media)
+    {
+        *error = "Failed to create media";
+        VlcInstancePool::Get().ReturnPlayer(recorder_);
+        recorder_ = nullptr;
+        ClosePipe();
+        return false;
+    }
+
+    for (const auto &opt : media_options)
+    {
+        std::string option_str = opt.first + "=" + opt.second;
+        libvlc_media_add_option(media, option_str.c_str());
+    }
+
+    // Remux every elementary stream, so track selection still works when played back
+    std::string sout = ":sout=#std{access=file,mux=ts,dst=" + SoutQuote(pipe_path_) + "}";
+    libvlc_media_add_option(media, sout.c_str());
+    libvlc_media_add_option(media, ":sout-all");
+    libvlc_media_add_option(media, ":no-sout-display");
+
+    recording_ = true;
+    pipe_thread_ = std::thread(&TimeshiftSession::PipeLoop, this);
+
+    libvlc_media_player_set_media(recorder_, media);
+    libvlc_media_release(media);
+    if (libvlc_media_player_play(recorder_) != 0)
+    {
+        *error = "Failed to start the timeshift recorder";
+        return false; // Stop() unwinds the thread and the recorder
+    }
+    return true;
+}
+
+void TimeshiftSession::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_)
+        return;
+    stopped_ = true;
+
+    if (buffer_)
+        buffer_->Interrupt();
+
+    pipe_stop_ = true;
+    if (recorder_)
+    {
+        // Closes the recorder's end of the pipe, the pipe thread sees end of file
+        VlcInstancePool::Get().ReturnPlayer(recorder_);
+        recorder_ = nullptr;
+    }
+
+    if (pipe_thread_.joinable())
+    {
+        UnblockPipe();
+        pipe_thread_.join();
+    }
+    ClosePipe();
+    recording_ = false;
+}
+
+void TimeshiftSession::Interrupt()
+{
+    if (std::shared_ptr<TimeshiftBuffer> buffer = Buffer())
+        buffer->Interrupt();
+}
+
+TimeshiftStats TimeshiftSession::GetStats()
+{
+    std::shared_ptr<TimeshiftBuffer> buffer = Buffer();
+    if (!buffer)
+        return TimeshiftStats();
+
+    TimeshiftStats stats = buffer->GetStats();
+    stats.recording = recording_;
+    stats.position_ms = buffer->TimeAt(read_offset_);
+    return stats;
+}
+
+// =================================================================================================
+// TimeshiftSession - Callback media
+// =================================================================================================
+
+libvlc_media_t *TimeshiftSession::CreateMedia(libvlc_instance_t *instance, uint64_t offset)
+{
+    std::shared_ptr<TimeshiftBuffer> buffer = Buffer();
+    if (!buffer)
+        return nullptr;
+
+    // The input about to be replaced may sit in Read(), waiting for the recorder
+    buffer->Interrupt();
+    start_offset_ = offset;
+    read_offset_ = offset;
+
+    libvlc_media_t *media = libvlc_media_new_callbacks(instance, OpenCallback, ReadCallback, SeekCallback,
+                                                       CloseCallback, this);
+    if (media)
+        libvlc_media_add_option(media, ":demux=ts");
+    return media;
+}
+
+int TimeshiftSession::OpenCallback(void *opaque, void **datap, uint64_t *sizep)
+{
+    TimeshiftSession *session = static_cast<TimeshiftSession *>(opaque);
+    std::shared_ptr<TimeshiftBuffer> buffer = session->Buffer();
+    if (!buffer)
+        return -1;
+
+    uint64_t start = session->start_offset_;
+    *datap = new TimeshiftCursor{buffer, session, start, start, buffer->Epoch()};
+    *sizep = UINT64_MAX; // Growing, unknown size
+    return 0;
+}
+
+ssize_t TimeshiftSession::ReadCallback(void *opaque, unsigned char *buf, size_t len)
+{
+    TimeshiftCursor *cursor = static_cast<TimeshiftCursor *>(opaque);
+    ssize_t read = cursor->buffer->Read(&cursor->offset, buf, len, cursor->epoch);
+    if (read > 0 && cursor->epoch == cursor->buffer->Epoch())
+        cursor->session->read_offset_ = cursor->offset;
+    return read;
+}
+
+// Makes the access seekable and therefore pausable, the demuxer's own seeks stay in this media
+int TimeshiftSession::SeekCallback(void *opaque, uint64_t offset)
+{
+    TimeshiftCursor *cursor = static_cast<TimeshiftCursor *>(opaque);
+    cursor->offset = cursor->start + offset;
+    return 0;
+}
+
+void TimeshiftSession::CloseCallback(void *opaque)
+{
+    delete static_cast<TimeshiftCursor *>(opaque);
+}
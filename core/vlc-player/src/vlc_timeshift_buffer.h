@@ -0,0 +1,244 @@
+#ifndef VLC_TIMESHIFT_BUFFER_H
+#define VLC_TIMESHIFT_BUFFER_H
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <vlc/vlc.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// =================================================================================================
+// Timeshift - Bounded on-disk ring of a live TS stream, played back through media callbacks
+// =================================================================================================
+// A recorder (a pool player without outputs) remuxes the live input to MPEG-TS and writes it
+// into a local pipe. A reader thread appends the pipe data to a fixed-size data file used as a
+// ring, and records a (receive time, byte offset) entry every INDEX_INTERVAL_MS in an index file
+// that is memory-mapped, so offsets for a time are found without touching the data.
+//
+//   "<name>.ts"   Data ring, capacity bytes, byte N of the recording lives at N % capacity
+//   "<name>.idx"  TimeshiftIndexHeader + TimeshiftIndexEntry ring
+//
+// The visible player opens a libvlc_media_new_callbacks() media reading from the ring. Pausing
+// is the input not reading (the recorder keeps going), rewind and jump-to-live re-open the
+// callback media at another offset. Nothing of it goes back to the network.
+//
+// Offsets count bytes since the recording started and never wrap. Everything below tail was
+// overwritten (ring full or older than the window), head is the live edge. Index offsets are
+// multiples of the TS packet size, so a reader started at one begins on a packet boundary.
+
+static constexpr uint32_t TIMESHIFT_INDEX_MAGIC = 0x5A545349; // "ZTSI"
+static constexpr uint32_t TIMESHIFT_INDEX_VERSION = 1;
+static constexpr uint64_t TS_PACKET_SIZE = 188;
+
+struct TimeshiftIndexEntry
+{
+    int64_t time_ms; // Receive time, from the start of the recording
+    uint64_t offset;
+};
+
+struct TimeshiftIndexHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity; // Entries
+    uint32_t reserved;
+    uint64_t data_capacity;
+    int64_t started_ms;          // Wall clock (ms since the epoch) of offset 0
+    std::atomic<uint64_t> count; // Entries written, the ring keeps the last capacity of them
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+};
+
+struct TimeshiftOptions
+{
+    std::string directory;           // Empty = system temp directory
+    int64_t window_ms = 30 * 60000;  // Kept behind the live edge
+    uint64_t max_bytes = 2ull << 30; // Data ring capacity
+};
+
+struct TimeshiftStats
+{
+    bool recording = false;
+    bool finished = false; // Recorder input ended, nothing more will arrive
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t capacity = 0;
+    int64_t live_ms = 0;     // Receive time of the live edge
+    int64_t oldest_ms = 0;   // Receive time of tail
+    int64_t position_ms = 0; // Receive time of the bytes the player reads (ahead of the picture by its cache)
+};
+
+class MappedFile;
+
+// =================================================================================================
+// TimeshiftBuffer - Data ring and index
+// =================================================================================================
+
+class TimeshiftBuffer
+{
+public:
+    static constexpr int64_t INDEX_INTERVAL_MS = 500;
+
+    /**
+     * Creates (and truncates) the data and index files, nullptr with error set on failure
+     */
+    static std::shared_ptr<TimeshiftBuffer> Create(const std::string &path, const TimeshiftOptions &options,
+                                                   std::string *error);
+    ~TimeshiftBuffer();
+
+    // Writer (pipe thread)
+    bool Append(const uint8_t *data, size_t size);
+    void Finish();
+
+    /**
+     * Blocking read from *offset, which moves past the returned bytes. Starts over at tail when
+     * *offset was overwritten. 0 once the recording finished and the reader caught up, or when
+     * epoch no longer matches (Interrupt()), -1 on an I/O error.
+     */
+    ssize_t Read(uint64_t *offset, uint8_t *data, size_t size, uint64_t epoch);
+
+    /**
+     * Wakes readers blocked in Read() and makes them return 0, returns the new epoch
+     */
+    uint64_t Interrupt();
+    uint64_t Epoch() const { return epoch_.load(); }
+
+    // Index lookups (receive time from the start of the recording)
+    uint64_t OffsetAt(int64_t time_ms);
+    int64_t TimeAt(uint64_t offset);
+    int64_t LiveTime();
+
+    /**
+     * Copies [from, to) into a new file, stops early at the live edge. Returns the bytes written,
+     * -1 with error set on failure.
+     */
+    int64_t Export(uint64_t from, uint64_t to, const std::string &file, std::string *error);
+
+    TimeshiftStats GetStats();
+    uint64_t Head();
+
+private:
+    TimeshiftBuffer() = default;
+
+    bool WriteAt(uint64_t offset, const uint8_t *data, size_t size);
+    bool ReadAt(uint64_t offset, uint8_t *data, size_t size);
+    int64_t Now() const;
+
+    // Caller holds mutex_
+    void TrimLocked(uint64_t new_head);
+    const TimeshiftIndexEntry &EntryLocked(uint64_t n) const;
+
+    std::string data_path_;
+    std::string index_path_;
+#ifdef _WIN32
+    HANDLE data_file_ = INVALID_HANDLE_VALUE;
+#else
+    int data_fd_ = -1;
+#endif
+    std::unique_ptr<MappedFile> index_file_;
+    TimeshiftIndexHeader *header_ = nullptr;
+    TimeshiftIndexEntry *entries_ = nullptr;
+
+    int64_t window_ms_ = 0;
+    std::chrono::steady_clock::time_point started_;
+
+    std::mutex mutex_;
+    uint64_t first_entry_ = 0;   // Oldest index entry still pointing into the ring
+    int64_t last_entry_ms_ = -1;
+    int64_t live_ms_ = 0;        // Receive time of the last append
+    std::condition_variable data_cv_;
+    bool finished_ = false;
+    std::atomic<uint64_t> epoch_{0};
+};
+
+// =================================================================================================
+// TimeshiftSession - Recorder, pipe reader and the callback media source of one channel
+// =================================================================================================
+
+class TimeshiftSession
+{
+public:
+    TimeshiftSession(const std::string &url, const TimeshiftOptions &options);
+    ~TimeshiftSession();
+
+    /**
+     * Creates the ring and starts recording url on a pool player (worker thread).
+     * media_options are the ones open() would add (latency profile, hardware decoder).
+     */
+    bool Start(libvlc_instance_t *instance, const std::map<std::string, std::string> &media_options,
+               std::string *error);
+
+    /**
+     * Stops the recorder and the pipe thread and wakes the reader, the ring stays readable
+     * (exports) until the session is destroyed, which removes the files. Idempotent.
+     */
+    void Stop();
+
+    /**
+     * Media reading from the ring at offset, the previous one stops reading (its blocked read
+     * returns end of stream so the input stopping it does not wait on the recorder)
+     */
+    libvlc_media_t *CreateMedia(libvlc_instance_t *instance, uint64_t offset);
+
+    /**
+     * Ends the current reader without a new one (before stopping the player)
+     */
+    void Interrupt();
+
+    std::shared_ptr<TimeshiftBuffer> Buffer(); // nullptr until Start() succeeded
+    const std::string &Url() const { return url_; }
+    const std::string &Directory() const { return directory_; }
+    uint64_t ReadOffset() const { return read_offset_.load(); }
+    bool IsRecording() const { return recording_.load(); }
+    TimeshiftStats GetStats();
+
+private:
+    // libvlc_media_new_callbacks(): open gets the session, the others the cursor it created
+    static int OpenCallback(void *opaque, void **datap, uint64_t *sizep);
+    static ssize_t ReadCallback(void *opaque, unsigned char *buf, size_t len);
+    static int SeekCallback(void *opaque, uint64_t offset);
+    static void CloseCallback(void *opaque);
+
+    bool CreatePipe(std::string *error);
+    void PipeLoop();
+    void UnblockPipe();
+    void ClosePipe();
+
+    std::string url_;
+    TimeshiftOptions options_;
+    std::string directory_;
+    std::string name_;
+    std::string pipe_path_;
+    std::shared_ptr<TimeshiftBuffer> buffer_;
+
+    std::mutex mutex_; // Start / Stop, buffer_
+    bool stopped_ = false;
+    libvlc_media_player_t *recorder_ = nullptr;
+    std::thread pipe_thread_;
+    std::atomic<bool> recording_{false};
+    std::atomic<bool> pipe_stop_{false};
+#ifdef _WIN32
+    HANDLE pipe_ = INVALID_HANDLE_VALUE;
+#endif
+
+    // Callback media: where the current one starts, what its input read last
+    std::atomic<uint64_t> start_offset_{0};
+    std::atomic<uint64_t> read_offset_{0};
+};
+
+#endif // VLC_TIMESHIFT_BUFFER_H
@@ -0,0 +1,390 @@
+#include "vlc_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// =================================================================================================
+// Trace Rings
+// =================================================================================================
+
+namespace
+{
+    struct TraceSlot
+    {
+        std::atomic<uint64_t> sequence{0}; // 2 * index + 1 while written, 2 * index + 2 when complete
+        std::atomic<const char *> name{nullptr};
+        std::atomic<int64_t> begin_us{0};
+        std::atomic<int64_t> duration_us{0};
+        std::atomic<uint32_t> tid{0};
+    };
+
+    struct TraceRing
+    {
+        std::atomic<bool> owned{true};    // False once the owning thread exited
+        std::atomic<uint32_t> tid{0};     // Of the current owner
+        std::atomic<uint64_t> head{0};    // Events ever written
+        std::atomic<uint64_t> cleared{0}; // Events below this index are hidden from dumps
+        TraceSlot slots[Trace::RING_EVENTS];
+    };
+
+    struct TraceRegistry
+    {
+        std::mutex mutex; // Registration, naming and dumps only
+        std::vector<std::unique_ptr<TraceRing>> rings;
+        std::vector<std::string> thread_names; // By tid - 1
+    };
+
+    TraceRegistry &Registry()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    // Hands the ring back to the registry when the thread exits
+    struct TraceThreadSlot
+    {
+        TraceRing *ring = nullptr;
+        uint32_t tid = 0;
+
+        ~TraceThreadSlot()
+        {
+            if (ring)
+                ring->owned.store(false, std::memory_order_release);
+        }
+    };
+
+    thread_local TraceThreadSlot trace_thread;
+
+    uint32_t ThreadIdLocked(TraceRegistry &registry)
+    {
+        if (trace_thread.tid == 0)
+        {
+            registry.thread_names.emplace_back();
+            trace_thread.tid = static_cast<uint32_t>(registry.thread_names.size());
+        }
+        return trace_thread.tid;
+    }
+
+    TraceRing *ThreadRing()
+    {
+        if (trace_thread.ring)
+            return trace_thread.ring;
+
+        TraceRegistry &registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        uint32_t tid = ThreadIdLocked(registry);
+
+        TraceRing *ring = nullptr;
+        for (auto &candidate : registry.rings)
+        {
+            bool expected = false;
+            if (candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                ring = candidate.get();
+                break;
+            }
+        }
+        if (!ring)
+        {
+            registry.rings.push_back(std::make_unique<TraceRing>());
+            ring = registry.rings.back().get();
+        }
+
+        ring->tid.store(tid, std::memory_order_relaxed);
+        trace_thread.ring = ring;
+        return ring;
+    }
+
+    void AppendJsonString(std::string *out, const char *text)
+    {
+        out->push_back('"');
+        for (const char *c = text; *c; c++)
+        {
+            unsigned char ch = static_cast<unsigned char>(*c);
+            if (ch == '"' || ch == '\\')
+            {
+                out->push_back('\\');
+                out->push_back(*c);
+            }
+            else if (ch < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                out->append(escaped);
+            }
+            else
+            {
+                out->push_back(*c);
+            }
+        }
+        out->push_back('"');
+    }
+}
+
+std::atomic<bool> Trace::enabled_{false};
+
+void Trace::SetEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t Trace::NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void Trace::Record(const char *name, int64_t begin_us, int64_t end_us)
+{
+    TraceRing *ring = ThreadRing();
+
+    uint64_t index = ring->head.load(std::memory_order_relaxed);
+    TraceSlot &slot = ring->slots[index & (RING_EVENTS - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin_us.store(begin_us, std::memory_order_relaxed);
+    slot.duration_us.store(end_us - begin_us, std::memory_order_relaxed);
+    slot.tid.store(ring->tid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+void Trace::SetThreadName(const char *name)
+{
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    uint32_t tid = ThreadIdLocked(registry);
+    registry.thread_names[tid - 1] = name ? name : "";
+}
+
+std::string Trace::DumpJson()
+{
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::string out;
+    out.reserve(64 * 1024);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+
+    for (size_t i = 0; i < registry.thread_names.size(); i++)
+    {
+        if (registry.thread_names[i].empty())
+            continue;
+        out.append(first ? "" : ",");
+        out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        out.append(std::to_string(i + 1));
+        out.append(",\"args\":{\"name\":");
+        AppendJsonString(&out, registry.thread_names[i].c_str());
+        out.append("}}");
+        first = false;
+    }
+
+    char event[160];
+    for (auto &ring : registry.rings)
+    {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > RING_EVENTS ? head - RING_EVENTS : 0;
+        begin = std::max(begin, ring->cleared.load(std::memory_order_relaxed));
+
+        for (uint64_t index = begin; index < head; index++)
+        {
+            TraceSlot &slot = ring->slots[index & (RING_EVENTS - 1)];
+
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2)
+                continue; // Being overwritten by a newer lap
+
+            const char *name = slot.name.load(std::memory_order_relaxed);
+            int64_t ts = slot.begin_us.load(std::memory_order_relaxed);
+            int64_t duration = slot.duration_us.load(std::memory_order_relaxed);
+            uint32_t tid = slot.tid.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || !name)
+                continue;
+
+            out.append(first ? "{\"name\":" : ",{\"name\":");
+            AppendJsonString(&out, name);
+            snprintf(event, sizeof(event), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld}", tid,
+                     static_cast<long long>(ts), static_cast<long long>(duration));
+            out.append(event);
+            first = false;
+        }
+    }
+
+    out.append("]}");
+    return out;
+}
+
+void Trace::Clear()
+{
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (auto &ring : registry.rings)
+        ring->cleared.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+size_t Trace::EventCount()
+{
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    size_t count = 0;
+    for (auto &ring : registry.rings)
+    {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = std::max(head > RING_EVENTS ? head - RING_EVENTS : 0,
+                                  ring->cleared.load(std::memory_order_relaxed));
+        count += static_cast<size_t>(head - begin);
+    }
+    return count;
+}
+
+size_t Trace::ThreadCount()
+{
+    TraceRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.rings.size();
+}
+
+// =================================================================================================
+// LogSink
+// =================================================================================================
+
+LogSink &LogSink::Get()
+{
+    static LogSink sink;
+    return sink;
+}
+
+LogSink::LogSink()
+    : cells_(new Cell[QUEUE_LINES])
+{
+    for (size_t i = 0; i < QUEUE_LINES; i++)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+
+    // Crash debugging: nothing may sit in the queue when the process dies
+    const char *sync = getenv("VLC_NODE_SYNC_LOG");
+    synchronous_ = sync && *sync && strcmp(sync, "0") != 0;
+}
+
+LogSink::~LogSink()
+{
+    stopping_ = true;
+    if (thread_.joinable())
+    {
+        wake_cv_.notify_one();
+        thread_.join();
+    }
+    Drain();
+}
+
+void LogSink::SetSynchronous(bool synchronous)
+{
+    synchronous_ = synchronous;
+    if (synchronous)
+    {
+        // Let the writer thread print what is still queued before lines get printed in place
+        wake_ = true;
+        wake_cv_.notify_one();
+    }
+}
+
+void LogSink::Write(const char *prefix, const char *format, va_list args)
+{
+    if (synchronous_.load(std::memory_order_relaxed))
+    {
+        fputs(prefix, stdout);
+        vprintf(format, args);
+        fputc('\n', stdout);
+        fflush(stdout);
+        return;
+    }
+
+    EnsureThread();
+
+    // Bounded MPMC queue (Vyukov), producers only contend on enqueue_pos_
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;)
+    {
+        cell = &cells_[pos & (QUEUE_LINES - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t used = static_cast<size_t>(snprintf(cell->text, LINE_SIZE, "%s", prefix));
+    if (used < LINE_SIZE)
+        vsnprintf(cell->text + used, LINE_SIZE - used, format, args);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    if (!wake_.exchange(true, std::memory_order_acq_rel))
+        wake_cv_.notify_one();
+}
+
+void LogSink::EnsureThread()
+{
+    std::call_once(thread_once_, [this]()
+                   { thread_ = std::thread(&LogSink::Loop, this); });
+}
+
+bool LogSink::Drain()
+{
+    bool printed = false;
+    for (;;)
+    {
+        Cell &cell = cells_[dequeue_pos_ & (QUEUE_LINES - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+            break;
+
+        fputs(cell.text, stdout);
+        fputc('\n', stdout);
+        cell.sequence.store(dequeue_pos_ + QUEUE_LINES, std::memory_order_release);
+        dequeue_pos_++;
+        printed = true;
+    }
+
+    if (printed)
+        fflush(stdout);
+    return printed;
+}
+
+void LogSink::Loop()
+{
+    Trace::SetThreadName("log-sink");
+
+    while (!stopping_)
+    {
+        Drain();
+
+        // Producers never take the mutex, the timeout only covers a notify that raced the wait
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, std::chrono::seconds(1), [this]()
+                          { return stopping_.load() || wake_.exchange(false); });
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef VLC_TRACE_H
+#define VLC_TRACE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// =================================================================================================
+// Tracing - Per-thread event rings dumped as Chrome trace JSON
+// =================================================================================================
+// Every thread that records gets its own fixed ring of complete events ("ph":"X"), so the
+// writer side is a handful of relaxed stores with no lock and no allocation. When the ring
+// wraps, the oldest events are overwritten. Each slot carries a sequence number that works as
+// a seqlock: the dump copies a slot and keeps it only if nothing wrote to it meanwhile. Event
+// names must be string literals (only the pointer is stored).
+//
+// Disabled tracing costs one relaxed load per TRACE_SCOPE, and rings are only allocated once a
+// thread records while tracing is enabled. Rings of exited threads are reused by new ones,
+// VLC creates threads per media and the registry must not grow with every zap.
+
+class Trace
+{
+public:
+    static constexpr size_t RING_EVENTS = 4096; // Per thread, power of two
+
+    static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enabled);
+
+    static int64_t NowUs();
+
+    /**
+     * Record a complete event on the calling thread's ring
+     */
+    static void Record(const char *name, int64_t begin_us, int64_t end_us);
+
+    /**
+     * Name the calling thread in dumps (copied, unlike event names)
+     */
+    static void SetThreadName(const char *name);
+
+    /**
+     * Chrome trace event format, load it in chrome://tracing or ui.perfetto.dev
+     */
+    static std::string DumpJson();
+
+    /**
+     * Forget recorded events, writers are not disturbed
+     */
+    static void Clear();
+
+    static size_t EventCount();
+    static size_t ThreadCount();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name)
+        : name_(Trace::Enabled() ? name : nullptr),
+          begin_us_(name_ ? Trace::NowUs() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (name_)
+            Trace::Record(name_, begin_us_, Trace::NowUs());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name_;
+    int64_t begin_us_;
+};
+
+#define VLC_TRACE_CONCAT_(a, b) a##b
+#define VLC_TRACE_CONCAT(a, b) VLC_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope VLC_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+// =================================================================================================
+// LogSink - Asynchronous stdout writer behind VlcPlayer::Log
+// =================================================================================================
+// Lines are formatted by the caller straight into a slot of a bounded lock-free queue and a
+// writer thread prints them, so logging from a VLC callback or under a player lock never waits
+// for the terminal. When the queue is full the line is dropped and counted. Synchronous mode
+// prints in place like before, for crashes where queued lines would be lost.
+
+class LogSink
+{
+public:
+    static constexpr size_t QUEUE_LINES = 1024; // Power of two
+    static constexpr size_t LINE_SIZE = 512;    // Longer lines are truncated
+
+    static LogSink &Get();
+
+    void Write(const char *prefix, const char *format, va_list args);
+
+    void SetSynchronous(bool synchronous);
+    bool IsSynchronous() const { return synchronous_.load(std::memory_order_relaxed); }
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    ~LogSink();
+
+private:
+    LogSink();
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        char text[LINE_SIZE];
+    };
+
+    void EnsureThread();
+    bool Drain(); // Writer thread, true if anything was printed
+    void Loop();
+
+    std::atomic<bool> synchronous_{false};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::unique_ptr<Cell[]> cells_;
+    std::atomic<size_t> enqueue_pos_{0};
+    size_t dequeue_pos_ = 0; // Writer thread only
+
+    std::once_flag thread_once_;
+    std::thread thread_;
+    std::mutex wake_mutex_; // Only the writer thread ever waits on it
+    std::condition_variable wake_cv_;
+    std::atomic<bool> wake_{false};
+    std::atomic<bool> stopping_{false};
+};
+
+#endif // VLC_TRACE_H
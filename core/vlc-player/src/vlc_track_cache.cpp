@@ -0,0 +1,61 @@
+#include "vlc_track_cache.h"
+
+// =================================================================================================
+// TrackCache
+// =================================================================================================
+
+void TrackCache::Invalidate()
+{
+    invalidated_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void TrackCache::ReadList(libvlc_track_description_t *list, std::vector<MediaTrackSnapshot> *tracks)
+{
+    tracks->clear();
+    for (libvlc_track_description_t *t = list; t; t = t->p_next)
+    {
+        tracks->push_back({t->i_id, t->psz_name ? t->psz_name : ""});
+    }
+    if (list)
+        libvlc_track_description_list_release(list);
+}
+
+TrackLists TrackCache::Get(libvlc_media_player_t *player, uint64_t *version)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // An invalidation racing the read below leaves the counter ahead, the next Get() reads again
+    uint64_t invalidated = invalidated_.load(std::memory_order_acquire);
+    if (invalidated == read_at_ || !player)
+    {
+        stats_.hits++;
+    }
+    else
+    {
+        TrackLists lists;
+        ReadList(libvlc_audio_get_track_description(player), &lists.audio);
+        ReadList(libvlc_video_get_spu_description(player), &lists.subtitle);
+        ReadList(libvlc_video_get_track_description(player), &lists.video);
+        lists.audio_current = libvlc_audio_get_track(player);
+        lists.subtitle_current = libvlc_video_get_spu(player);
+        lists.video_current = libvlc_video_get_track(player);
+
+        read_at_ = invalidated;
+        stats_.refreshes++;
+        if (!lists.SameTracks(lists_))
+            version_++;
+        lists_ = std::move(lists);
+    }
+
+    if (version)
+        *version = version_;
+    return lists_;
+}
+
+TrackCacheStats TrackCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrackCacheStats stats = stats_;
+    stats.invalidations = invalidated_.load(std::memory_order_relaxed) - 1;
+    return stats;
+}
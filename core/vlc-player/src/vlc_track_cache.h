@@ -0,0 +1,89 @@
+#ifndef VLC_TRACK_CACHE_H
+#define VLC_TRACK_CACHE_H
+
+// Windows-specific type definitions needed by VLC headers
+#ifdef _WIN32
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vlc/vlc.h>
+
+// =================================================================================================
+// Track Cache - Track lists read once per elementary stream change
+// =================================================================================================
+// The track description lists are rebuilt by libVLC under its input lock on every query, and
+// they are asked for a lot: getMediaInfo(), each length change, every context menu. A stream
+// set only changes with the ESAdded / ESDeleted / ESSelected events (and a new media), so the
+// lists are copied once after such a change and served from the copy until the next one.
+//
+// The version only moves when a re-read finds a different track set, so a burst of ES events for
+// the same tracks (every open emits one per stream) tells the JS side nothing new.
+
+struct MediaTrackSnapshot
+{
+    int id;
+    std::string name;
+
+    bool operator==(const MediaTrackSnapshot &other) const
+    {
+        return id == other.id && name == other.name;
+    }
+};
+
+struct TrackLists
+{
+    std::vector<MediaTrackSnapshot> audio;
+    std::vector<MediaTrackSnapshot> subtitle;
+    std::vector<MediaTrackSnapshot> video;
+    int audio_current = -1;
+    int subtitle_current = -1;
+    int video_current = -1;
+
+    // Selections are left out, they reach JS as currentVideo changes
+    bool SameTracks(const TrackLists &other) const
+    {
+        return audio == other.audio && subtitle == other.subtitle && video == other.video;
+    }
+};
+
+struct TrackCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t refreshes = 0;     // Lists re-read from libVLC
+    uint64_t invalidations = 0;
+};
+
+class TrackCache
+{
+public:
+    /**
+     * Any thread (libVLC event thread for the ES events): the next Get() re-reads the lists
+     */
+    void Invalidate();
+
+    /**
+     * Cached lists, re-read from the player first when invalidated. The caller keeps the player
+     * alive (player_mutex_ held). version, when given, receives the content version.
+     */
+    TrackLists Get(libvlc_media_player_t *player, uint64_t *version = nullptr);
+
+    TrackCacheStats GetStats();
+
+private:
+    static void ReadList(libvlc_track_description_t *list, std::vector<MediaTrackSnapshot> *tracks);
+
+    std::atomic<uint64_t> invalidated_{1}; // Bumped per invalidation, starts stale
+    std::mutex mutex_;
+    uint64_t read_at_ = 0; // invalidated_ value the lists were read at
+    uint64_t version_ = 0;
+    TrackLists lists_;
+    TrackCacheStats stats_;
+};
+
+#endif // VLC_TRACK_CACHE_H
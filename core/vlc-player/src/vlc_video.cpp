@@ -10,13 +10,139 @@ Napi::Value VlcPlayer::Video(const Napi::CallbackInfo& info) {
     if (info.Length() < 1 || !info[0].IsObject()) return env.Undefined();
 
     Napi::Object options = info[0].As<Napi::Object>();
-    std::lock_guard<std::mutex> lock(mutex_);
+    PlayerLock lock(player_mutex_);
 
     if (!media_player_) return env.Undefined();
 
+    // Memory rendering: takes effect on the next open()/play()
+    if (options.Has("frameSlots")) {
+        int slots = options.Get("frameSlots").As<Napi::Number>().Int32Value();
+        frame_ring_.SetSlotCount(static_cast<size_t>(std::max(slots, 0)));
+    }
+
+    if (options.Has("chroma")) {
+        std::string name = options.Get("chroma").As<Napi::String>().Utf8Value();
+        FrameChroma chroma;
+        if (!ParseFrameChroma(name, &chroma)) {
+            Napi::TypeError::New(env, "chroma must be one of RV32, I420, NV12").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        video_chroma_ = chroma;
+    }
+
+    // Hardware decoder for the next open(), the decoder of the current media stays
+    if (options.Has("hwDecode")) {
+        std::string name = options.Get("hwDecode").As<Napi::String>().Utf8Value();
+        HwDecoder decoder;
+        if (!ParseHwDecoder(name, &decoder)) {
+            Napi::TypeError::New(env, "hwDecode must be one of auto, vaapi, vdpau, d3d11va, dxva2, none")
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        // libVLC falls back to software on its own, just say why it will
+        if (const std::vector<HwDecoderCaps>* caps = ProbedHwDecoders()) {
+            for (const HwDecoderCaps& cap : *caps) {
+                if (cap.decoder == decoder && !cap.available) {
+                    Log("WARNING: hwDecode=%s unavailable (%s), decoding will fall back to software",
+                        name.c_str(), cap.detail.c_str());
+                }
+            }
+        }
+
+        hw_decode_ = decoder;
+        hw_decode_set_ = true;
+    }
+
+    // { width, height } box, "window" to follow window({ resize }), null for source size.
+    // Applies from the next video output (open(), or play() after stop()), not mid-playback.
+    if (options.Has("renderSize")) {
+        Napi::Value size = options.Get("renderSize");
+        std::lock_guard<std::mutex> vmem_lock(vmem_mutex_);
+        render_size_follow_window_ = false;
+
+        if (size.IsObject()) {
+            Napi::Object box = size.As<Napi::Object>();
+            int width = box.Has("width") ? box.Get("width").As<Napi::Number>().Int32Value() : 0;
+            int height = box.Has("height") ? box.Get("height").As<Napi::Number>().Int32Value() : 0;
+            SetRenderSize(static_cast<unsigned>(std::max(width, 0)), static_cast<unsigned>(std::max(height, 0)));
+        } else if (size.IsString() && size.As<Napi::String>().Utf8Value() == "window") {
+            render_size_follow_window_ = true;
+        } else {
+            SetRenderSize(0, 0);
+        }
+    }
+
+    if (options.Has("memoryRender")) {
+        bool enabled = options.Get("memoryRender").As<Napi::Boolean>().Value();
+        memory_render_ = enabled;
+
+        // Switching back to the window happens in play() where Bind() resets the vout
+        if (enabled) {
+            SetupVideoCallbacks();
+        }
+    }
+
+    // Blend the OSDs into the decoded RV32 frames instead of drawing them over the window
+    if (options.Has("osdOverlay") && osd_window_) {
+        std::lock_guard<std::mutex> window_lock(window_mutex_);
+        osd_window_->SetOSDFrameOverlay(options.Get("osdOverlay").ToBoolean().Value());
+    }
+
+    // Decode into a named shared-memory ring readable from another process (FrameReader).
+    // Slots are allocated at format negotiation and a running vout never negotiates again, so
+    // the ring can only move while no video is playing: set it before open() or after stop().
+    if (options.Has("sharedFrames")) {
+        Napi::Value value = options.Get("sharedFrames");
+        std::lock_guard<std::mutex> vmem_lock(vmem_mutex_);
+        std::shared_ptr<SharedFrameWriter> writer;
+
+        std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+        if (value.IsString() && !SharedFrameWriter::IsValidName(name)) {
+            Napi::TypeError::New(env, "sharedFrames name may only contain A-Z, a-z, 0-9, '-' and '_'")
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        bool unchanged = value.IsString() ? shared_frames_ && shared_frames_->Name() == name : !shared_frames_;
+        if (!unchanged && memory_render_ && libvlc_media_player_has_vout(media_player_) > 0) {
+            Napi::Error::New(env, "sharedFrames can only change while no video is playing (before open() or after stop())")
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        if (value.IsString()) {
+            if (unchanged) {
+                writer = shared_frames_;
+            } else {
+                writer = SharedFrameWriter::Create(name);
+                if (!writer) {
+                    Napi::Error::New(env, "Failed to create shared frame ring '" + name + "'").ThrowAsJavaScriptException();
+                    return env.Undefined();
+                }
+            }
+        }
+
+        if (writer != shared_frames_) {
+            shared_frames_ = writer;
+            frame_ring_.SetProvider(writer);
+        }
+    }
+
+    // Push a coalesced "frame" event on display instead of polling getFrame()
+    if (options.Has("frameEvents")) {
+        frame_events_enabled_ = options.Get("frameEvents").As<Napi::Boolean>().Value();
+    }
+
+    if (options.Has("frameRate")) {
+        double fps = options.Get("frameRate").As<Napi::Number>().DoubleValue();
+        frame_event_interval_us_ = fps > 0 ? static_cast<int64_t>(1000000.0 / fps) : 0;
+    }
+
     if (options.Has("track")) {
         int track = options.Get("track").As<Napi::Number>().Int32Value();
         libvlc_video_set_track(media_player_, track);
+        track_cache_.Invalidate();
 
         EmitCurrentVideo([track](Napi::Env env, Napi::Object& cv) {
             cv.Set("videoTrack", Napi::Number::New(env, track));
@@ -62,8 +188,10 @@ Napi::Value VlcPlayer::Video(const Napi::CallbackInfo& info) {
         std::string mode = options.Get("deinterlace").As<Napi::String>().Utf8Value();
         if (mode == "off") {
             libvlc_video_set_deinterlace(media_player_, nullptr);
+            deinterlace_mode_.clear();
         } else {
             libvlc_video_set_deinterlace(media_player_, mode.c_str());
+            deinterlace_mode_ = mode;
         }
 
         EmitCurrentVideo([mode](Napi::Env env, Napi::Object& cv) {
@@ -82,3 +210,66 @@ Napi::Value VlcPlayer::Video(const Napi::CallbackInfo& info) {
 
     return env.Undefined();
 }
+
+// =================================================================================================
+// Hardware Decoder Probe
+// =================================================================================================
+
+Napi::Array VlcPlayer::HwDecoderCapsToArray(Napi::Env env, const std::vector<HwDecoderCaps>& caps) {
+    Napi::Array result = Napi::Array::New(env, caps.size());
+    for (size_t i = 0; i < caps.size(); i++) {
+        Napi::Object decoder = Napi::Object::New(env);
+        decoder.Set("name", Napi::String::New(env, HwDecoderName(caps[i].decoder)));
+        decoder.Set("available", Napi::Boolean::New(env, caps[i].available));
+        decoder.Set("detail", Napi::String::New(env, caps[i].detail));
+
+        Napi::Array codecs = Napi::Array::New(env, caps[i].codecs.size());
+        for (size_t c = 0; c < caps[i].codecs.size(); c++) {
+            codecs.Set(static_cast<uint32_t>(c), Napi::String::New(env, caps[i].codecs[c]));
+        }
+        decoder.Set("codecs", codecs);
+
+        result.Set(static_cast<uint32_t>(i), decoder);
+    }
+    return result;
+}
+
+// Driver initialisation can take a while, the probe runs once on a worker thread
+class HwProbeWorker : public Napi::AsyncWorker {
+public:
+    HwProbeWorker(Napi::Env env, Napi::Promise::Deferred deferred)
+        : Napi::AsyncWorker(env, "VlcHwProbe"),
+          deferred_(deferred) {
+    }
+
+protected:
+    void Execute() override {
+        ProbeHwDecoders();
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(VlcPlayer::HwDecoderCapsToArray(Env(), ProbeHwDecoders()));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+};
+
+// VlcPlayer.hwDecoders() -> Promise<[{ name, available, detail, codecs }]>
+Napi::Value VlcPlayer::HwDecoders(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    if (const std::vector<HwDecoderCaps>* caps = ProbedHwDecoders()) {
+        deferred.Resolve(HwDecoderCapsToArray(env, *caps));
+        return deferred.Promise();
+    }
+
+    HwProbeWorker* worker = new HwProbeWorker(env, deferred);
+    worker->Queue();
+    return deferred.Promise();
+}
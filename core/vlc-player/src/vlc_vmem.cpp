@@ -1,6 +1,17 @@
 #include "vlc_player.h"
+#include "vlc_frame_buffers.h"
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
+
+// Picture identifiers handed to VLC encode the ring slot (slot + 1, so nullptr means "no slot")
+static inline void *SlotToPicture(int slot) {
+    return reinterpret_cast<void*>(static_cast<intptr_t>(slot) + 1);
+}
+
+static inline int PictureToSlot(void* picture) {
+    return static_cast<int>(reinterpret_cast<intptr_t>(picture)) - 1;
+}
 
 // Video memory callback implementations
 void VlcPlayer::SetupVideoCallbacks() {
@@ -9,29 +20,8 @@ void VlcPlayer::SetupVideoCallbacks() {
     // Set video format callback
     libvlc_video_set_format_callbacks(
         media_player_,
-        [](void** opaque, char* chroma, unsigned* width, unsigned* height, unsigned* pitches, unsigned* lines) -> unsigned {
-            VlcPlayer* player = static_cast<VlcPlayer*>(*opaque);
-            
-            // Request RGBA format
-            memcpy(chroma, "RV32", 4);
-            
-            // Store dimensions
-            player->video_width_ = *width;
-            player->video_height_ = *height;
-            player->video_pitch_ = *width * 4; // 4 bytes per pixel (RGBA)
-            *pitches = player->video_pitch_;
-            *lines = *height;
-            
-            // Allocate frame buffer
-            std::lock_guard<std::mutex> lock(player->frame_mutex_);
-            player->frame_buffer_.resize(player->video_pitch_ * player->video_height_);
-            
-            printf("[VLC] Video format: %ux%u, pitch: %u\n", *width, *height, player->video_pitch_);
-            fflush(stdout);
-            
-            return 1;
-        },
-        nullptr // cleanup callback
+        VlcPlayer::VideoFormatCallback,
+        VlcPlayer::VideoCleanupCallback
     );
 
     // Set video callbacks
@@ -44,51 +34,233 @@ void VlcPlayer::SetupVideoCallbacks() {
     );
 }
 
+unsigned VlcPlayer::VideoFormatCallback(void** opaque, char* chroma, unsigned* width, unsigned* height,
+                                        unsigned* pitches, unsigned* lines) {
+    TRACE_SCOPE("vmem.format");
+    VlcPlayer* player = static_cast<VlcPlayer*>(*opaque);
+
+    // Scale down to video({ renderSize }) so memory follows the display size, not the source
+    player->source_width_ = *width;
+    player->source_height_ = *height;
+    FitFrameSize(*width, *height, player->render_width_, player->render_height_, width, height);
+
+    // Output chroma requested via video({ chroma }), VLC converts to it if needed
+    FrameChroma requested = player->video_chroma_.load();
+    FrameFormat format = MakeFrameFormat(requested, *width, *height);
+    memcpy(chroma, format.chroma, 4);
+
+    for (int i = 0; i < format.plane_count; i++) {
+        pitches[i] = format.planes[i].pitch;
+        lines[i] = format.planes[i].lines;
+    }
+
+    // Allocate every slot of the ring up front, no allocations happen per frame
+    player->frame_ring_.Configure(format);
+
+    // video({ osdOverlay }) lays the OSDs out on the frame
+    if (player->osd_window_) {
+        player->osd_window_->SetOSDFrameSize(*width, *height);
+    }
+
+    Log("Video format: %s %ux%u, pitch: %u, planes: %d, slots: %zu",
+        format.chroma, *width, *height, format.pitch, format.plane_count,
+        player->frame_ring_.GetSlotCount());
+
+    return 1;
+}
+
+void VlcPlayer::VideoCleanupCallback(void* opaque) {
+    VlcPlayer* player = static_cast<VlcPlayer*>(opaque);
+
+    // JS-side buffers keep their own reference to the storage, only the ring lets go here
+    player->frame_ring_.Reset();
+}
+
 void* VlcPlayer::VideoLockCallback(void* opaque, void** planes) {
+    TRACE_SCOPE("vmem.lock");
     VlcPlayer* player = static_cast<VlcPlayer*>(opaque);
-    std::lock_guard<std::mutex> lock(player->frame_mutex_);
-    
-    if (!player->frame_buffer_.empty()) {
-        *planes = player->frame_buffer_.data();
+
+    int slot = -1;
+    uint8_t* pixels = player->frame_ring_.AcquireWriteSlot(&slot);
+    if (!pixels) {
+        return nullptr;
+    }
+
+    const FrameFormat& format = player->frame_ring_.GetProducerFormat();
+    for (int i = 0; i < format.plane_count; i++) {
+        planes[i] = pixels + format.planes[i].offset;
     }
-    
-    return nullptr; // picture identifier (not used)
+    return SlotToPicture(slot);
 }
 
 void VlcPlayer::VideoUnlockCallback(void* opaque, void* picture, void* const* planes) {
-    // Nothing to do - we're using a persistent buffer
+    // Slots are persistent and published on display, nothing to do here
     (void)opaque;
     (void)picture;
     (void)planes;
 }
 
 void VlcPlayer::VideoDisplayCallback(void* opaque, void* picture) {
+    TRACE_SCOPE("vmem.display");
     VlcPlayer* player = static_cast<VlcPlayer*>(opaque);
-    player->frame_ready_ = true;
-    (void)picture;
+    if (!picture) return;
+
+    int slot = PictureToSlot(picture);
+
+    // libVLC 3 unlocks after display, so the OSD overlay goes on here, before readers can see the slot
+    if (player->osd_window_ && player->osd_window_->IsOSDFrameOverlay()) {
+        // Blending is only done on packed RGB, YUV frames go out without OSDs
+        const FrameFormat& format = player->frame_ring_.GetProducerFormat();
+        uint8_t* pixels = player->frame_ring_.ProducerPixels(slot);
+        if (pixels && strcmp(format.chroma, FrameChromaName(FrameChroma::RV32)) == 0) {
+            std::shared_ptr<const OSDSurface> overlay = player->osd_window_->GetOSDFrameOverlay();
+            if (overlay) {
+                overlay->BlendOnto(pixels, static_cast<int>(format.pitch),
+                                   static_cast<int>(format.width), static_cast<int>(format.height));
+            }
+        }
+    }
+
+    player->frame_ring_.Publish(slot);
+
+    if (player->frame_events_enabled_) {
+        player->EmitFrame();
+    }
+}
+
+void VlcPlayer::SetRenderSize(unsigned width, unsigned height) {
+    render_width_ = width;
+    render_height_ = height;
+
+    if (!media_player_ || !memory_render_ || libvlc_media_player_has_vout(media_player_) == 0) {
+        return; // Picked up by the next format negotiation
+    }
+
+    // libVLC 3 reuses a running vout while the source format is unchanged, so the format
+    // callback only runs again for the next output. Until then frames keep their size and
+    // the consumer scales them. Only say so when the size would change noticeably.
+    FrameFormat current = frame_ring_.GetFormat();
+    unsigned target_width = 0;
+    unsigned target_height = 0;
+    FitFrameSize(source_width_, source_height_, width, height, &target_width, &target_height);
+
+    unsigned tolerance_x = current.width / 8;
+    unsigned tolerance_y = current.height / 8;
+    if (current.width > 0 &&
+        static_cast<unsigned>(std::abs(static_cast<int>(target_width) - static_cast<int>(current.width))) <= tolerance_x &&
+        static_cast<unsigned>(std::abs(static_cast<int>(target_height) - static_cast<int>(current.height))) <= tolerance_y) {
+        return;
+    }
+
+    Log("Render size %ux%u deferred to the next video output, frames stay %ux%u",
+        target_width, target_height, current.width, current.height);
 }
 
+/**
+ * getFrame()                   -> Buffer copy of the latest frame (or null)
+ * getFrame({ zeroCopy: true }) -> { slot, sequence, generation } (or null)
+ *
+ * In zero-copy mode read the slot through the ArrayBuffers returned by getFrameBuffers().
+ * Decoding never waits for the reader: if every slot is busy the new frame is dropped.
+ */
 Napi::Value VlcPlayer::GetFrame(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    
-    if (!frame_ready_ || frame_buffer_.empty()) {
+
+    bool zero_copy = false;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Object options = info[0].As<Napi::Object>();
+        if (options.Has("zeroCopy")) {
+            zero_copy = options.Get("zeroCopy").As<Napi::Boolean>().Value();
+        }
+    }
+
+    // The returned frame stays IN_USE (protected from the decoder) until the next getFrame()
+    FrameSlotInfo latest;
+    std::shared_ptr<FrameStorage> storage = frame_ring_.HoldLatest(&latest);
+    if (!storage) {
+        return env.Null();
+    }
+
+    if (zero_copy) {
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("slot", Napi::Number::New(env, latest.slot));
+        result.Set("sequence", Napi::Number::New(env, static_cast<double>(latest.sequence)));
+        result.Set("generation", Napi::Number::New(env, latest.generation));
+        return result;
+    }
+
+    return Napi::Buffer<uint8_t>::Copy(env, storage->Slot(latest.slot), storage->FrameSize());
+}
+
+/**
+ * getFrameBuffers() -> { generation, frameSize, external, buffers: ArrayBuffer[] } (or null)
+ *
+ * With external: true each ArrayBuffer is a view of one ring slot. Wrap them once and re-fetch
+ * only when getFrame() reports a different generation (format change reallocates the ring).
+ * The storage stays alive until every ArrayBuffer of that generation is collected.
+ * Hosts that forbid external buffers (Electron's V8 memory cage) get copies instead,
+ * external: false, which do not follow later frames: use getFrame() there.
+ */
+Napi::Value VlcPlayer::GetFrameBuffers(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    uint32_t generation = 0;
+    std::shared_ptr<FrameStorage> storage = frame_ring_.GetStorage(&generation);
+    if (!storage) {
         return env.Null();
     }
-    
-    // Create a Node.js Buffer from the frame data
-    // Note: This creates a copy of the data
-    return Napi::Buffer<uint8_t>::Copy(env, frame_buffer_.data(), frame_buffer_.size());
+
+    bool external = true;
+    Napi::Array buffers = Napi::Array::New(env, storage->SlotCount());
+    for (size_t i = 0; i < storage->SlotCount(); i++) {
+        Napi::ArrayBuffer buffer = NewFrameArrayBuffer(env, storage, storage->Slot(i), storage->FrameSize(), &external);
+        if (buffer.IsEmpty()) {
+            return env.Undefined();
+        }
+        buffers.Set(static_cast<uint32_t>(i), buffer);
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("generation", Napi::Number::New(env, generation));
+    result.Set("frameSize", Napi::Number::New(env, static_cast<double>(storage->FrameSize())));
+    result.Set("external", Napi::Boolean::New(env, external));
+    result.Set("buffers", buffers);
+
+    return result;
 }
 
 Napi::Value VlcPlayer::GetVideoFormat(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    
+
+    FrameFormat current = frame_ring_.GetFormat();
+
     Napi::Object format = Napi::Object::New(env);
-    format.Set("width", Napi::Number::New(env, video_width_));
-    format.Set("height", Napi::Number::New(env, video_height_));
-    format.Set("pitch", Napi::Number::New(env, video_pitch_));
-    
+    format.Set("width", Napi::Number::New(env, current.width));
+    format.Set("height", Napi::Number::New(env, current.height));
+    format.Set("pitch", Napi::Number::New(env, current.pitch));
+    format.Set("chroma", Napi::String::New(env, current.chroma));
+    format.Set("sourceWidth", Napi::Number::New(env, source_width_.load()));
+    format.Set("sourceHeight", Napi::Number::New(env, source_height_.load()));
+    format.Set("frameSize", Napi::Number::New(env, static_cast<double>(current.frame_size)));
+    format.Set("slots", Napi::Number::New(env, frame_ring_.GetSlotCount()));
+
+    // Plane layout inside every slot (Y/U/V for I420, Y/UV for NV12)
+    Napi::Array planes = Napi::Array::New(env, current.plane_count);
+    for (int i = 0; i < current.plane_count; i++) {
+        Napi::Object plane = Napi::Object::New(env);
+        plane.Set("offset", Napi::Number::New(env, static_cast<double>(current.planes[i].offset)));
+        plane.Set("pitch", Napi::Number::New(env, current.planes[i].pitch));
+        plane.Set("lines", Napi::Number::New(env, current.planes[i].lines));
+        planes.Set(static_cast<uint32_t>(i), plane);
+    }
+    format.Set("planes", planes);
+    format.Set("decodedFrames", Napi::Number::New(env, static_cast<double>(frame_ring_.GetDecodedFrames())));
+    format.Set("droppedFrames", Napi::Number::New(env, static_cast<double>(frame_ring_.GetDroppedFrames())));
+
+    {
+        std::lock_guard<std::mutex> lock(vmem_mutex_);
+        format.Set("sharedFrames", shared_frames_ ? Napi::Value(Napi::String::New(env, shared_frames_->Name())) : env.Null());
+    }
+
     return format;
 }
@@ -1,9 +1,37 @@
 #include "vlc_player.h"
+#include <algorithm>
 
 // =================================================================================================
 // Unified Window API
 // =================================================================================================
 
+// resize: { x, y, width, height } numbers, x / y only when with_position. Throws on a bad object.
+static bool ReadResize(Napi::Env env, Napi::Value value, bool with_position, int *x, int *y, int *width,
+                       int *height)
+{
+    if (!value.IsObject())
+    {
+        Napi::TypeError::New(env, "resize must be an object").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    Napi::Object resize = value.As<Napi::Object>();
+    const char *keys[] = {"x", "y", "width", "height"};
+    int *targets[] = {x, y, width, height};
+    for (int i = with_position ? 0 : 2; i < 4; i++)
+    {
+        Napi::Value field = resize.Get(keys[i]);
+        if (!field.IsNumber())
+        {
+            Napi::TypeError::New(env, std::string("resize.") + keys[i] + " must be a number")
+                .ThrowAsJavaScriptException();
+            return false;
+        }
+        *targets[i] = field.As<Napi::Number>().Int32Value();
+    }
+    return true;
+}
+
 Napi::Value VlcPlayer::Window(const Napi::CallbackInfo &info)
 {
     Napi::Env env = info.Env();
@@ -15,7 +43,52 @@ Napi::Value VlcPlayer::Window(const Napi::CallbackInfo &info)
     }
 
     Napi::Object options = info[0].As<Napi::Object>();
-    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Memory rendering has no native window: the resize only drives the render size, window
+    // style options are refused instead of being dropped
+    if (memory_render_)
+    {
+        for (const char *key : {"visible", "screenMode"})
+        {
+            if (options.Has(key))
+            {
+                Napi::TypeError::New(env, std::string(key) + " has no effect with memory rendering")
+                    .ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+
+        int width = 0;
+        int height = 0;
+        if (options.Has("resize") && !ReadResize(env, options.Get("resize"), false, nullptr, nullptr, &width, &height))
+        {
+            return env.Undefined();
+        }
+
+        if (options.Has("osdSurface"))
+        {
+            std::lock_guard<std::mutex> window_lock(window_mutex_);
+            osd_window_->SetOSDSurfaceMode(options.Get("osdSurface").ToBoolean().Value());
+        }
+
+        if (options.Has("resize") && render_size_follow_window_)
+        {
+            PlayerLock lock(player_mutex_);
+            std::lock_guard<std::mutex> vmem_lock(vmem_mutex_);
+            SetRenderSize(static_cast<unsigned>(std::max(width, MIN_WINDOW_SIZE)),
+                          static_cast<unsigned>(std::max(height, MIN_WINDOW_SIZE)));
+        }
+        return Napi::Boolean::New(env, true);
+    }
+
+    // Native window calls only wait for other window calls, never for the player
+    std::lock_guard<std::mutex> lock(window_mutex_);
+
+    // Composite every OSD into one overlay window, applies before the window exists too
+    if (options.Has("osdSurface"))
+    {
+        osd_window_->SetOSDSurfaceMode(options.Get("osdSurface").ToBoolean().Value());
+    }
 
     if (!osd_window_->IsCreated())
     {
@@ -26,11 +99,12 @@ Napi::Value VlcPlayer::Window(const Napi::CallbackInfo &info)
     // Handle resize (for sticky mode positioning, etc.)
     if (options.Has("resize"))
     {
-        Napi::Object resize = options.Get("resize").As<Napi::Object>();
-        int x = resize.Get("x").As<Napi::Number>().Int32Value();
-        int y = resize.Get("y").As<Napi::Number>().Int32Value();
-        int width = resize.Get("width").As<Napi::Number>().Int32Value();
-        int height = resize.Get("height").As<Napi::Number>().Int32Value();
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        if (!ReadResize(env, options.Get("resize"), true, &x, &y, &width, &height))
+            return env.Undefined();
 
         osd_window_->SetBounds(x, y, width, height);
     }